@@ -151,6 +151,8 @@ enum class MediaLibraryBusinessCode : uint32_t {
 	INVOKE_ANALYSIS_TOOL,
     CANCEL_ANALYSIS_TOOL,
     SET_PHOTO_CRITICAL,
+    PAH_SYSTEM_BATCH_CREATE_ASSETS,
+    PAH_SYSTEM_BATCH_COMMIT_ASSETS,
     ASSETS_BUSINESS_CODE_END = 19999,
     ALBUMS_BUSINESS_CODE_START = 20000,
     DELETE_HIGH_LIGHT_ALBUMS,
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIA_IPC_MEDIA_BULK_TRANSPORT_H
+#define OHOS_MEDIA_IPC_MEDIA_BULK_TRANSPORT_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "message_parcel.h"
+
+namespace OHOS::Media::IPC {
+/**
+ * @brief Read-only bytes of one bulk payload. Small payloads are owned by the buffer, large ones stay in the
+ * ashmem region sent by the peer and are unmapped when the buffer is released.
+ */
+class MediaBulkBuffer {
+public:
+    MediaBulkBuffer(std::vector<uint8_t> &&bytes);
+    MediaBulkBuffer(void *mappedAddr, size_t size);
+    ~MediaBulkBuffer();
+    MediaBulkBuffer(const MediaBulkBuffer &) = delete;
+    MediaBulkBuffer &operator=(const MediaBulkBuffer &) = delete;
+
+    const uint8_t *Data() const;
+    size_t Size() const;
+
+private:
+    std::vector<uint8_t> bytes_;
+    void *mappedAddr_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Moves one bulk payload through a MessageParcel. Payloads up to ASHMEM_THRESHOLD travel inline as raw data,
+ * larger ones are written by the filler straight into an ashmem region, and only its fd goes through the parcel.
+ */
+class MediaBulkTransport {
+public:
+    // fills exactly size bytes at buffer, the buffer is either heap memory or the mapped ashmem region
+    using Filler = std::function<bool(uint8_t *buffer, size_t size)>;
+
+    static bool Write(size_t size, const Filler &filler, MessageParcel &parcel);
+    static std::shared_ptr<MediaBulkBuffer> Read(MessageParcel &parcel);
+
+private:
+    static bool WriteInline(size_t size, const Filler &filler, MessageParcel &parcel);
+    static bool WriteAshmem(size_t size, const Filler &filler, MessageParcel &parcel);
+    static std::shared_ptr<MediaBulkBuffer> ReadInline(size_t size, MessageParcel &parcel);
+    static std::shared_ptr<MediaBulkBuffer> ReadAshmem(size_t size, MessageParcel &parcel);
+};
+}  // namespace OHOS::Media::IPC
+#endif  // OHOS_MEDIA_IPC_MEDIA_BULK_TRANSPORT_H
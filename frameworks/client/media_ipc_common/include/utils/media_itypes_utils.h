@@ -16,10 +16,13 @@
 #ifndef OHOS_MEDIA_IPC_ITYPES_MEDIA_UTIL_H
 #define OHOS_MEDIA_IPC_ITYPES_MEDIA_UTIL_H
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 
+#include "media_bulk_transport.h"
 #include "message_parcel.h"
 
 namespace OHOS::Media::IPC::ITypeMediaUtil {
@@ -259,16 +262,40 @@ bool Unmarshalling(std::unordered_map<K, V> &val, MessageParcel &parcel)
 }
 
 /**
- * @brief The following two functions are used in scenarios where IPC communication parameters are extremely large,
- * serializing objects to shared memory and deserializing objects from shared memory. The upper limit of shared memory
- * is 128M. Note: For large amounts of data, this function can only be called once per IPC.
+ * @brief Read-only view of a string vector sent by MarshalStrVec. The offsets are copied and validated once, the
+ * strings are read in place from the received buffer, which may be the ashmem region mapped from the peer, and stay
+ * valid while the view lives.
+ */
+class StrVecView {
+public:
+    bool Init(std::shared_ptr<MediaBulkBuffer> buffer, size_t offset);
+    size_t Size() const;
+    std::string_view At(size_t index) const;
+
+private:
+    std::shared_ptr<MediaBulkBuffer> buffer_;
+    size_t count_ = 0;
+    std::vector<uint64_t> offsets_;
+    const char *chars_ = nullptr;
+};
+
+/**
+ * @brief The following functions are used in scenarios where IPC communication parameters are extremely large.
+ * Objects are laid out as columns in one buffer, which travels inline when small and through shared memory otherwise,
+ * see MediaBulkTransport. The upper limit of shared memory is 128M.
  */
 bool MarshalStrVec(const std::vector<std::string> &strVec, MessageParcel &parcel);
 
 bool UnmarshalStrVec(std::vector<std::string> &strVec, MessageParcel &parcel);
 
+bool UnmarshalStrVec(StrVecView &view, MessageParcel &parcel);
+
 bool MarshalMapVec(const std::vector<std::unordered_map<std::string, std::string>> &val, MessageParcel &parcel);
 
 bool UnmarshalMapVec(std::vector<std::unordered_map<std::string, std::string>> &val, MessageParcel &parcel);
+
+bool MarshalInt32Vec(const std::vector<int32_t> &val, MessageParcel &parcel);
+
+bool UnmarshalInt32Vec(std::vector<int32_t> &val, MessageParcel &parcel);
 }  // namespace OHOS::Media::IPC::ITypeMediaUtil
 #endif  // OHOS_MEDIA_IPC_ITYPES_MEDIA_UTIL_H
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define MLOG_TAG "Media_IPC"
+
+#include "media_bulk_transport.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ashmem.h"
+#include "media_log.h"
+
+namespace OHOS::Media::IPC {
+// Maximum value of IPC shared memory
+static const size_t MAX_IPC_SIZE = 128 * 1024 * 1024;
+// MessageParcel moves raw data above this size into ashmem on its own, but with extra copies on both sides
+static const size_t ASHMEM_THRESHOLD = 32 * 1024;
+static const char *BULK_ASHMEM_NAME = "media_bulk_transport";
+
+enum class BulkTransportMode : int32_t {
+    INLINE = 0,
+    ASHMEM = 1,
+};
+
+MediaBulkBuffer::MediaBulkBuffer(std::vector<uint8_t> &&bytes) : bytes_(std::move(bytes)), size_(bytes_.size()) {}
+
+MediaBulkBuffer::MediaBulkBuffer(void *mappedAddr, size_t size) : mappedAddr_(mappedAddr), size_(size) {}
+
+MediaBulkBuffer::~MediaBulkBuffer()
+{
+    if (mappedAddr_ != nullptr) {
+        munmap(mappedAddr_, size_);
+        mappedAddr_ = nullptr;
+    }
+}
+
+const uint8_t *MediaBulkBuffer::Data() const
+{
+    return mappedAddr_ != nullptr ? static_cast<const uint8_t *>(mappedAddr_) : bytes_.data();
+}
+
+size_t MediaBulkBuffer::Size() const
+{
+    return size_;
+}
+
+bool MediaBulkTransport::Write(size_t size, const Filler &filler, MessageParcel &parcel)
+{
+    CHECK_AND_RETURN_RET_LOG(size >= 1 && size <= MAX_IPC_SIZE, false, "invalid bulk size: %{public}zu", size);
+    CHECK_AND_RETURN_RET_LOG(filler != nullptr, false, "filler is null");
+    CHECK_AND_RETURN_RET_LOG(parcel.WriteUint32(static_cast<uint32_t>(size)), false, "Write size failed.");
+    return size <= ASHMEM_THRESHOLD ? WriteInline(size, filler, parcel) : WriteAshmem(size, filler, parcel);
+}
+
+bool MediaBulkTransport::WriteInline(size_t size, const Filler &filler, MessageParcel &parcel)
+{
+    CHECK_AND_RETURN_RET_LOG(parcel.WriteInt32(static_cast<int32_t>(BulkTransportMode::INLINE)), false,
+        "Write mode failed.");
+    std::vector<uint8_t> buffer(size);
+    CHECK_AND_RETURN_RET_LOG(filler(buffer.data(), size), false, "fill inline buffer failed");
+    return parcel.WriteRawData(reinterpret_cast<const void *>(buffer.data()), size);
+}
+
+bool MediaBulkTransport::WriteAshmem(size_t size, const Filler &filler, MessageParcel &parcel)
+{
+    CHECK_AND_RETURN_RET_LOG(parcel.WriteInt32(static_cast<int32_t>(BulkTransportMode::ASHMEM)), false,
+        "Write mode failed.");
+    int fd = AshmemCreate(BULK_ASHMEM_NAME, size);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, false, "AshmemCreate failed, size: %{public}zu", size);
+    if (AshmemSetProt(fd, PROT_READ | PROT_WRITE) < 0) {
+        MEDIA_ERR_LOG("AshmemSetProt failed");
+        close(fd);
+        return false;
+    }
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        MEDIA_ERR_LOG("mmap failed, size: %{public}zu", size);
+        close(fd);
+        return false;
+    }
+    bool isFilled = filler(static_cast<uint8_t *>(addr), size);
+    munmap(addr, size);
+    // the receiver only gets a read-only region
+    if (!isFilled || AshmemSetProt(fd, PROT_READ) < 0) {
+        MEDIA_ERR_LOG("fill ashmem failed, isFilled: %{public}d", isFilled);
+        close(fd);
+        return false;
+    }
+    // the parcel keeps its own dup of the fd
+    bool ret = parcel.WriteFileDescriptor(fd);
+    close(fd);
+    return ret;
+}
+
+std::shared_ptr<MediaBulkBuffer> MediaBulkTransport::Read(MessageParcel &parcel)
+{
+    size_t size = static_cast<size_t>(parcel.ReadUint32());
+    CHECK_AND_RETURN_RET_LOG(size >= 1 && size <= MAX_IPC_SIZE, nullptr, "invalid bulk size: %{public}zu", size);
+    int32_t mode = parcel.ReadInt32();
+    if (mode == static_cast<int32_t>(BulkTransportMode::INLINE)) {
+        return ReadInline(size, parcel);
+    }
+    if (mode == static_cast<int32_t>(BulkTransportMode::ASHMEM)) {
+        return ReadAshmem(size, parcel);
+    }
+    MEDIA_ERR_LOG("invalid bulk mode: %{public}d", mode);
+    return nullptr;
+}
+
+std::shared_ptr<MediaBulkBuffer> MediaBulkTransport::ReadInline(size_t size, MessageParcel &parcel)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(parcel.ReadRawData(size));
+    CHECK_AND_RETURN_RET_LOG(data != nullptr, nullptr, "ReadRawData failed.");
+    // inline payloads are small, own them so the buffer does not depend on the parcel lifetime
+    return std::make_shared<MediaBulkBuffer>(std::vector<uint8_t>(data, data + size));
+}
+
+std::shared_ptr<MediaBulkBuffer> MediaBulkTransport::ReadAshmem(size_t size, MessageParcel &parcel)
+{
+    int fd = parcel.ReadFileDescriptor();
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, nullptr, "ReadFileDescriptor failed.");
+    // a region the sender can still write could change under the receiver after it has been validated
+    int prot = AshmemGetProt(fd);
+    if (prot != PROT_READ) {
+        MEDIA_ERR_LOG("ashmem is not read-only, prot: %{public}d", prot);
+        close(fd);
+        return nullptr;
+    }
+    int ashmemSize = AshmemGetSize(fd);
+    if (ashmemSize < 0 || static_cast<size_t>(ashmemSize) < size) {
+        MEDIA_ERR_LOG("ashmem size %{public}d is less than %{public}zu", ashmemSize, size);
+        close(fd);
+        return nullptr;
+    }
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    CHECK_AND_RETURN_RET_LOG(addr != MAP_FAILED, nullptr, "mmap failed, size: %{public}zu", size);
+    return std::make_shared<MediaBulkBuffer>(addr, size);
+}
+}  // namespace OHOS::Media::IPC
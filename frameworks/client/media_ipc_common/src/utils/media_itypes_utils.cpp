@@ -15,205 +15,252 @@
 
 #include "media_itypes_utils.h"
 
-#include <sstream>
+#include <cinttypes>
+#include <securec.h>
 
 #include "media_log.h"
 
 namespace OHOS::Media::IPC::ITypeMediaUtil {
 // Maximum value of IPC shared memory
 static const size_t MAX_IPC_SIZE = 128 * 1024 * 1024;
+static const size_t SLOT_SIZE = sizeof(uint64_t);
 
-template <typename T>
-bool WriteBasicTypeToStream(std::ostringstream &oss, const T &value)
+static inline void PutSlot(uint8_t *buffer, size_t slot, uint64_t value)
 {
-    oss.write(reinterpret_cast<const char *>(&value), sizeof(value));
-    return oss.good();
+    (void)memcpy_s(buffer + slot * SLOT_SIZE, SLOT_SIZE, &value, SLOT_SIZE);
 }
 
-bool WriteStringToStream(std::ostringstream &oss, const std::string &str)
+static inline uint64_t GetSlot(const uint8_t *buffer, size_t slot)
 {
-    // write string length
-    size_t len = str.length();
-    if (!WriteBasicTypeToStream(oss, len)) {
-        return false;
-    }
-    // write string data
-    if (len > 0) {
-        oss.write(str.data(), len);
-    }
-    return oss.good();
+    uint64_t value = 0;
+    (void)memcpy_s(&value, SLOT_SIZE, buffer + slot * SLOT_SIZE, SLOT_SIZE);
+    return value;
 }
 
-bool WriteStrVecToStream(std::ostringstream &oss, const std::vector<std::string> &strVec)
+/**
+ * String column layout: [count][offsets[count + 1]][chars]. Offsets are relative to chars, so the i-th string is
+ * chars[offsets[i], offsets[i + 1]) and can be read without parsing the strings before it.
+ */
+static bool GetStrColumnSize(const std::vector<const std::string *> &strs, size_t &size)
 {
-    // write vector size
-    size_t len = strVec.size();
-    if (!WriteBasicTypeToStream(oss, len)) {
+    if (strs.size() > MAX_IPC_SIZE / SLOT_SIZE) {
         return false;
     }
-    for (const auto &str : strVec) {
-        if (!WriteStringToStream(oss, str)) {
+    size = (strs.size() + 2) * SLOT_SIZE;
+    for (const auto *str : strs) {
+        if (str->size() > MAX_IPC_SIZE - size) {
             return false;
         }
+        size += str->size();
     }
-    return oss.good();
+    return true;
 }
 
-bool WriteMapVecToStream(std::ostringstream &oss,
-                         const std::vector<std::unordered_map<std::string, std::string>> &mapVec)
+static bool FillStrColumn(const std::vector<const std::string *> &strs, uint8_t *buffer, size_t size)
 {
-    size_t len = mapVec.size();
-    if (!WriteBasicTypeToStream(oss, len)) {
-        return false;
-    }
-    for (const auto &map : mapVec) {
-        len = map.size();
-        if (!WriteBasicTypeToStream(oss, len)) {
+    size_t count = strs.size();
+    size_t headSize = (count + 2) * SLOT_SIZE;
+    uint8_t *chars = buffer + headSize;
+    size_t charsSize = size - headSize;
+    uint64_t offset = 0;
+    PutSlot(buffer, 0, count);
+    PutSlot(buffer, 1, offset);
+    for (size_t i = 0; i < count; i++) {
+        const std::string &str = *strs[i];
+        if (!str.empty() && memcpy_s(chars + offset, charsSize - offset, str.data(), str.size()) != EOK) {
             return false;
         }
-        for (const auto &entry : map) {
-            if ((!WriteStringToStream(oss, entry.first)) || (!WriteStringToStream(oss, entry.second))) {
-                return false;
-            }
-        }
+        offset += str.size();
+        PutSlot(buffer, i + 2, offset);
     }
-    return oss.good();
+    return true;
 }
 
-template <typename T>
-bool ReadStreamToBasicType(std::istringstream &iss, T &value)
+/**
+ * The buffer may be an ashmem region the peer still has mapped, so every slot is fetched from it exactly once into
+ * local memory and only the local copy is validated and used afterwards.
+ */
+static bool CopySlots(const uint8_t *data, size_t firstSlot, size_t count, std::vector<uint64_t> &slots)
 {
-    iss.read(reinterpret_cast<char *>(&value), sizeof(value));
-    return iss.good();
+    slots.resize(count);
+    size_t bytes = count * SLOT_SIZE;
+    return bytes == 0 || memcpy_s(slots.data(), bytes, data + firstSlot * SLOT_SIZE, bytes) == EOK;
 }
 
-bool ReadStreamToString(std::istringstream &iss, std::string &str)
+bool StrVecView::Init(std::shared_ptr<MediaBulkBuffer> buffer, size_t offset)
 {
-    // Get string length
-    size_t len;
-    if (!ReadStreamToBasicType(iss, len)) {
-        return false;
-    }
-    // Get string content
-    if (len > 0 && len < MAX_IPC_SIZE) {
-        str.resize(len, '\0');
-        iss.read(str.data(), len);
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr && offset <= buffer->Size(), false, "invalid buffer");
+    const uint8_t *data = buffer->Data() + offset;
+    size_t size = buffer->Size() - offset;
+    CHECK_AND_RETURN_RET_LOG(size >= 2 * SLOT_SIZE, false, "string column is too short: %{public}zu", size);
+    uint64_t count = GetSlot(data, 0);
+    CHECK_AND_RETURN_RET_LOG(count <= size / SLOT_SIZE - 2, false, "invalid string count: %{public}" PRIu64, count);
+    size_t headSize = (static_cast<size_t>(count) + 2) * SLOT_SIZE;
+    size_t charsSize = size - headSize;
+    std::vector<uint64_t> offsets;
+    CHECK_AND_RETURN_RET_LOG(CopySlots(data, 1, static_cast<size_t>(count) + 1, offsets), false,
+        "copy string offsets failed");
+    uint64_t prev = 0;
+    for (size_t i = 0; i < offsets.size(); i++) {
+        CHECK_AND_RETURN_RET_LOG(offsets[i] >= prev && offsets[i] <= charsSize, false,
+            "invalid string offset at %{public}zu", i);
+        prev = offsets[i];
     }
-    return iss.good();
+    buffer_ = buffer;
+    count_ = static_cast<size_t>(count);
+    offsets_ = std::move(offsets);
+    chars_ = reinterpret_cast<const char *>(data + headSize);
+    return true;
 }
 
-bool ReadStreamToStrVec(std::istringstream &iss, std::vector<std::string> &strVec)
+size_t StrVecView::Size() const
 {
-    // Get vec length
-    size_t len;
-    if (!ReadStreamToBasicType(iss, len)) {
-        return false;
-    }
-    for (size_t i = 0; i < len; i++) {
-        std::string str;
-        if (!ReadStreamToString(iss, str)) {
-            return false;
-        }
-        strVec.push_back(str);
-    }
-    return iss.good();
+    return count_;
 }
 
-bool ReadStreamToMapVec(std::istringstream &iss,
-                        std::vector<std::unordered_map<std::string, std::string>> &mapVec)
+std::string_view StrVecView::At(size_t index) const
 {
-    size_t len;
-    if (!ReadStreamToBasicType(iss, len)) {
-        return false;
+    if (index >= count_) {
+        return std::string_view();
     }
-    for (size_t i = 0; i < len; i++) {
-        std::unordered_map<std::string, std::string> map;
-        size_t mapLen;
-        if (!ReadStreamToBasicType(iss, mapLen)) {
-            return false;
-        }
-        for (size_t j = 0; j < mapLen; j++) {
-            std::string key;
-            std::string value;
-            if (!ReadStreamToString(iss, key) || !ReadStreamToString(iss, value)) {
-                return false;
-            }
-            map[key] = value;
-        }
-        mapVec.push_back(map);
-    }
-    return iss.good();
+    uint64_t begin = offsets_[index];
+    uint64_t end = offsets_[index + 1];
+    return std::string_view(chars_ + begin, static_cast<size_t>(end - begin));
 }
 
 bool MarshalStrVec(const std::vector<std::string> &strVec, MessageParcel &parcel)
 {
-    std::ostringstream oss;
-    if (!WriteStrVecToStream(oss, strVec)) {
-        MEDIA_ERR_LOG("WriteStrVecToStream failed.");
-        return false;
+    std::vector<const std::string *> strs;
+    strs.reserve(strVec.size());
+    for (const auto &str : strVec) {
+        strs.push_back(&str);
     }
-    std::string str = oss.str();
-    size_t size = str.length();
-    if (size < 1 || size > MAX_IPC_SIZE) {
+    size_t size = 0;
+    if (!GetStrColumnSize(strs, size)) {
         MEDIA_ERR_LOG("The length of strVec converted to string is invalid.");
         return false;
     }
-    if (!parcel.WriteUint32(static_cast<uint32_t>(size))) {
-        MEDIA_ERR_LOG("Write size failed.");
-        return false;
-    }
-    return parcel.WriteRawData(reinterpret_cast<const void *>(str.data()), size);
+    return MediaBulkTransport::Write(size, [&strs](uint8_t *buffer, size_t size) {
+        return FillStrColumn(strs, buffer, size);
+    }, parcel);
+}
+
+bool UnmarshalStrVec(StrVecView &view, MessageParcel &parcel)
+{
+    std::shared_ptr<MediaBulkBuffer> buffer = MediaBulkTransport::Read(parcel);
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, false, "Read strVec failed.");
+    return view.Init(buffer, 0);
 }
 
 bool UnmarshalStrVec(std::vector<std::string> &strVec, MessageParcel &parcel)
 {
-    size_t size = static_cast<size_t>(parcel.ReadUint32());
-    if (size < 1 || size > MAX_IPC_SIZE) {
-        MEDIA_ERR_LOG("The length of strVec converted to string is invalid.");
+    StrVecView view;
+    if (!UnmarshalStrVec(view, parcel)) {
         return false;
     }
-    const char *buffer = reinterpret_cast<const char *>(parcel.ReadRawData(size));
-    if (buffer == nullptr) {
-        MEDIA_ERR_LOG("ReadRawData failed.");
-        return false;
+    strVec.reserve(strVec.size() + view.Size());
+    for (size_t i = 0; i < view.Size(); i++) {
+        strVec.emplace_back(view.At(i));
     }
-    std::istringstream iss(std::string(buffer, size));
-    return ReadStreamToStrVec(iss, strVec);
+    return true;
 }
 
+/**
+ * Map vector layout: [rowCount][rowStarts[rowCount + 1]] followed by a string column holding key and value of every
+ * entry in turn, row i owns the entries [rowStarts[i], rowStarts[i + 1]).
+ */
 bool MarshalMapVec(const std::vector<std::unordered_map<std::string, std::string>> &val, MessageParcel &parcel)
 {
-    std::ostringstream oss;
-    if (!WriteMapVecToStream(oss, val)) {
-        MEDIA_ERR_LOG("WriteMapVecToStream failed.");
-        return false;
-    }
-    std::string str = oss.str();
-    size_t size = str.length();
-    if (size < 1 || size > MAX_IPC_SIZE) {
+    size_t rowCount = val.size();
+    if (rowCount > MAX_IPC_SIZE / SLOT_SIZE) {
         MEDIA_ERR_LOG("The length of MapVec converted to string is invalid.");
         return false;
     }
-    if (!parcel.WriteUint32(static_cast<uint32_t>(size))) {
-        MEDIA_ERR_LOG("Write size failed.");
+    std::vector<const std::string *> strs;
+    for (const auto &map : val) {
+        for (const auto &entry : map) {
+            strs.push_back(&entry.first);
+            strs.push_back(&entry.second);
+        }
+    }
+    size_t headSize = (rowCount + 2) * SLOT_SIZE;
+    size_t columnSize = 0;
+    if (!GetStrColumnSize(strs, columnSize) || columnSize > MAX_IPC_SIZE - headSize) {
+        MEDIA_ERR_LOG("The length of MapVec converted to string is invalid.");
         return false;
     }
-    return parcel.WriteRawData(reinterpret_cast<const void *>(str.data()), size);
+    return MediaBulkTransport::Write(headSize + columnSize, [&val, &strs, headSize](uint8_t *buffer, size_t size) {
+        uint64_t rowStart = 0;
+        PutSlot(buffer, 0, val.size());
+        PutSlot(buffer, 1, rowStart);
+        for (size_t i = 0; i < val.size(); i++) {
+            rowStart += val[i].size();
+            PutSlot(buffer, i + 2, rowStart);
+        }
+        return FillStrColumn(strs, buffer + headSize, size - headSize);
+    }, parcel);
 }
 
 bool UnmarshalMapVec(std::vector<std::unordered_map<std::string, std::string>> &val, MessageParcel &parcel)
 {
-    size_t size = static_cast<size_t>(parcel.ReadUint32());
-    if (size < 1 || size > MAX_IPC_SIZE) {
-        MEDIA_ERR_LOG("The length of mapVec converted to string is invalid.");
-        return false;
+    std::shared_ptr<MediaBulkBuffer> buffer = MediaBulkTransport::Read(parcel);
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, false, "Read mapVec failed.");
+    const uint8_t *data = buffer->Data();
+    size_t size = buffer->Size();
+    CHECK_AND_RETURN_RET_LOG(size >= 2 * SLOT_SIZE, false, "mapVec is too short: %{public}zu", size);
+    uint64_t rowCount = GetSlot(data, 0);
+    CHECK_AND_RETURN_RET_LOG(rowCount <= size / SLOT_SIZE - 2, false,
+        "invalid row count: %{public}" PRIu64, rowCount);
+    std::vector<uint64_t> rowStarts;
+    CHECK_AND_RETURN_RET_LOG(CopySlots(data, 1, static_cast<size_t>(rowCount) + 1, rowStarts), false,
+        "copy row starts failed");
+    size_t headSize = (static_cast<size_t>(rowCount) + 2) * SLOT_SIZE;
+    StrVecView column;
+    CHECK_AND_RETURN_RET_LOG(column.Init(buffer, headSize), false, "invalid mapVec column");
+    CHECK_AND_RETURN_RET_LOG(rowStarts[0] == 0 && rowStarts.back() <= column.Size() / 2 &&
+        rowStarts.back() * 2 == column.Size(), false, "row starts do not match the column");
+    for (size_t i = 1; i < rowStarts.size(); i++) {
+        CHECK_AND_RETURN_RET_LOG(rowStarts[i - 1] <= rowStarts[i], false, "invalid row start at %{public}zu", i);
+    }
+
+    val.reserve(val.size() + static_cast<size_t>(rowCount));
+    for (size_t i = 0; i < rowCount; i++) {
+        std::unordered_map<std::string, std::string> map;
+        map.reserve(static_cast<size_t>(rowStarts[i + 1] - rowStarts[i]));
+        for (uint64_t j = rowStarts[i]; j < rowStarts[i + 1]; j++) {
+            map.emplace(column.At(static_cast<size_t>(j * 2)), column.At(static_cast<size_t>(j * 2 + 1)));
+        }
+        val.emplace_back(std::move(map));
     }
-    const char *buffer = reinterpret_cast<const char *>(parcel.ReadRawData(size));
-    if (buffer == nullptr) {
-        MEDIA_ERR_LOG("ReadRawData failed.");
+    return true;
+}
+
+bool MarshalInt32Vec(const std::vector<int32_t> &val, MessageParcel &parcel)
+{
+    if (val.size() > (MAX_IPC_SIZE - SLOT_SIZE) / sizeof(int32_t)) {
+        MEDIA_ERR_LOG("The length of int32Vec is invalid: %{public}zu", val.size());
         return false;
     }
-    std::istringstream iss(std::string(buffer, size));
-    return ReadStreamToMapVec(iss, val);
+    size_t bytes = val.size() * sizeof(int32_t);
+    return MediaBulkTransport::Write(SLOT_SIZE + bytes, [&val, bytes](uint8_t *buffer, size_t size) {
+        PutSlot(buffer, 0, val.size());
+        return bytes == 0 || memcpy_s(buffer + SLOT_SIZE, size - SLOT_SIZE, val.data(), bytes) == EOK;
+    }, parcel);
+}
+
+bool UnmarshalInt32Vec(std::vector<int32_t> &val, MessageParcel &parcel)
+{
+    std::shared_ptr<MediaBulkBuffer> buffer = MediaBulkTransport::Read(parcel);
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, false, "Read int32Vec failed.");
+    const uint8_t *data = buffer->Data();
+    size_t size = buffer->Size();
+    CHECK_AND_RETURN_RET_LOG(size >= SLOT_SIZE, false, "int32Vec is too short: %{public}zu", size);
+    uint64_t count = GetSlot(data, 0);
+    CHECK_AND_RETURN_RET_LOG(count == (size - SLOT_SIZE) / sizeof(int32_t), false,
+        "invalid int32 count: %{public}" PRIu64, count);
+    size_t oldSize = val.size();
+    val.resize(oldSize + static_cast<size_t>(count));
+    size_t bytes = static_cast<size_t>(count) * sizeof(int32_t);
+    return bytes == 0 || memcpy_s(val.data() + oldSize, bytes, data + SLOT_SIZE, bytes) == EOK;
 }
 }  // namespace OHOS::Media::IPC::ITypeMediaUtil
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORKS_INNERKITSIMPL_MEDIA_LIBRARY_INCLUDE_MEDIA_FILE_COPY_ENGINE_H
+#define FRAMEWORKS_INNERKITSIMPL_MEDIA_LIBRARY_INCLUDE_MEDIA_FILE_COPY_ENGINE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OHOS::Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+
+enum class FileCopyMethod : int32_t {
+    NONE = 0,
+    REFLINK,
+    COPY_FILE_RANGE,
+    PARALLEL_COPY_FILE_RANGE,
+    SENDFILE,
+};
+
+struct FileCopyStats {
+    FileCopyMethod method {FileCopyMethod::NONE};
+    int64_t bytes {0};
+    int64_t files {0};
+    int64_t costMs {0};
+
+    EXPORT double GetThroughputMBps() const;
+};
+
+struct FileCopyTask {
+    std::string srcPath;
+    std::string destPath;
+    bool isSuccess {false};
+};
+
+// Called after every copied chunk with the chunk size, returning false cancels the copy.
+using FileCopyChunkCallback = std::function<bool(uint64_t)>;
+
+/**
+ * Kernel side file copy shared by MediaFileUtils. A copy first tries to share extents with FICLONE,
+ * then moves data with copy_file_range (split by byte range over a few threads for large files),
+ * and falls back to sendfile when the file system supports neither. Only file content is copied,
+ * mode and timestamps of the destination are whatever the caller opened it with.
+ */
+class MediaFileCopyEngine {
+public:
+    // destFd must be empty and positioned at 0, size is the number of bytes to copy from offset 0 of srcFd
+    EXPORT static bool CopyFd(int32_t srcFd, int32_t destFd, int64_t size, FileCopyStats &stats);
+    // single threaded variant reporting every chunk, returns E_OK, E_SCENE_HAS_CANCEL or E_ERR
+    EXPORT static int32_t CopyFdInChunks(int32_t srcFd, int32_t destFd, int64_t size, size_t chunkSize,
+        const FileCopyChunkCallback &onChunk, FileCopyStats &stats);
+    // copies many files with a bounded number of in-flight copies, returns E_OK when every task succeeded
+    EXPORT static int32_t CopyFilesInBatch(std::vector<FileCopyTask> &tasks, FileCopyStats &stats);
+
+private:
+    static bool TryReflink(int32_t srcFd, int32_t destFd);
+    static int32_t CopyRange(int32_t srcFd, int32_t destFd, int64_t offset, int64_t length);
+    static bool CopyRangeInParallel(int32_t srcFd, int32_t destFd, int64_t offset, int64_t length);
+    static bool SendFileFrom(int32_t srcFd, int32_t destFd, int64_t offset, int64_t length);
+    static void ReportThroughput(const std::string &scene, const FileCopyStats &stats);
+};
+} // namespace OHOS::Media
+
+#endif // FRAMEWORKS_INNERKITSIMPL_MEDIA_LIBRARY_INCLUDE_MEDIA_FILE_COPY_ENGINE_H
@@ -30,6 +30,7 @@
 // LCOV_EXCL_START
 namespace OHOS::Media {
 #define EXPORT __attribute__ ((visibility ("default")))
+struct FileCopyStats;
 EXPORT const std::string MOVING_PHOTO_URI_SPLIT = ";";
 EXPORT const uint8_t MOVING_PHOTO_IMAGE_POS = 0;
 EXPORT const uint8_t MOVING_PHOTO_VIDEO_POS = 1;
@@ -121,6 +122,7 @@ public:
         unsigned short curRecursionDepth = 0);
     EXPORT static bool CopyFileAndDelSrc(const std::string &srcFile, const std::string &destFile);
     EXPORT static bool CopyFileUtil(const std::string &filePath, const std::string &newPath);
+    EXPORT static bool CopyFileUtil(const std::string &filePath, const std::string &newPath, FileCopyStats &stats);
     EXPORT static int32_t SegmentedCopyFileUtile(const std::string &filePath, const std::string &newPath,
         std::function<void(uint64_t)> progressCallback, const std::string &requestId);
     EXPORT static bool CopyFileSafe(const std::string &filePath, const std::string &newPath);
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define MLOG_TAG "FileCopyEngine"
+
+#include "media_file_copy_engine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+#include "media_file_utils.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+using namespace std;
+
+namespace OHOS::Media {
+constexpr int32_t RANGE_COPY_DONE = 0;
+constexpr int32_t RANGE_COPY_UNSUPPORTED = 1;
+constexpr int32_t RANGE_COPY_FAILED = -1;
+constexpr int64_t MAX_COPY_RANGE_SIZE = 0x7FFFF000;
+constexpr int64_t MAX_SENDFILE_SIZE = 0x7FFFF000;
+// files below this size are copied by one thread, the split only pays off for videos
+constexpr int64_t PARALLEL_COPY_MIN_SIZE = 64 * 1024 * 1024;
+constexpr int64_t PARALLEL_SEGMENT_MIN_SIZE = 16 * 1024 * 1024;
+constexpr int64_t SEGMENT_ALIGN_SIZE = 1024 * 1024;
+constexpr uint32_t MAX_PARALLEL_COPY_WORKERS = 4;
+constexpr uint32_t MAX_BATCH_COPY_WORKERS = 4;
+constexpr int64_t REPORT_THROUGHPUT_MIN_SIZE = 16 * 1024 * 1024;
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+constexpr double MSEC_PER_SEC = 1000.0;
+
+static int64_t GetSteadyTimeMs()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool IsCopyUnsupported(int err)
+{
+    return err == EXDEV || err == EINVAL || err == ENOSYS || err == EOPNOTSUPP || err == ENOTTY || err == EPERM ||
+        err == EBADF;
+}
+
+double FileCopyStats::GetThroughputMBps() const
+{
+    if (bytes <= 0) {
+        return 0;
+    }
+    // sub-millisecond copies (reflink, tiny files) are reported against 1ms
+    int64_t cost = max<int64_t>(costMs, 1);
+    return static_cast<double>(bytes) / BYTES_PER_MB / (static_cast<double>(cost) / MSEC_PER_SEC);
+}
+
+bool MediaFileCopyEngine::TryReflink(int32_t srcFd, int32_t destFd)
+{
+    if (ioctl(destFd, FICLONE, srcFd) == 0) {
+        return true;
+    }
+    MEDIA_DEBUG_LOG("reflink not available, errno: %{public}d", errno);
+    return false;
+}
+
+int32_t MediaFileCopyEngine::CopyRange(int32_t srcFd, int32_t destFd, int64_t offset, int64_t length)
+{
+    loff_t inOffset = static_cast<loff_t>(offset);
+    loff_t outOffset = static_cast<loff_t>(offset);
+    int64_t left = length;
+    while (left > 0) {
+        size_t copySize = static_cast<size_t>(min(left, MAX_COPY_RANGE_SIZE));
+        ssize_t ret = copy_file_range(srcFd, &inOffset, destFd, &outOffset, copySize, 0);
+        if (ret < 0) {
+            CHECK_AND_CONTINUE(errno != EINTR);
+            bool unsupported = IsCopyUnsupported(errno) && left == length;
+            CHECK_AND_RETURN_RET(!unsupported, RANGE_COPY_UNSUPPORTED);
+            MEDIA_ERR_LOG("copy_file_range failed, errno: %{public}d", errno);
+            return RANGE_COPY_FAILED;
+        }
+        // some virtual file systems report 0 instead of an error, treat it like an unsupported source
+        CHECK_AND_RETURN_RET(ret != 0, left == length ? RANGE_COPY_UNSUPPORTED : RANGE_COPY_FAILED);
+        left -= static_cast<int64_t>(ret);
+    }
+    return RANGE_COPY_DONE;
+}
+
+bool MediaFileCopyEngine::CopyRangeInParallel(int32_t srcFd, int32_t destFd, int64_t offset, int64_t length)
+{
+    uint32_t hardwareThreads = max(thread::hardware_concurrency(), 1u);
+    int64_t maxWorkersBySize = max<int64_t>(length / PARALLEL_SEGMENT_MIN_SIZE, 1);
+    uint32_t workers = static_cast<uint32_t>(min<int64_t>(
+        min(MAX_PARALLEL_COPY_WORKERS, hardwareThreads), maxWorkersBySize));
+    int64_t segment = (length + workers - 1) / workers;
+    segment = (segment + SEGMENT_ALIGN_SIZE - 1) / SEGMENT_ALIGN_SIZE * SEGMENT_ALIGN_SIZE;
+
+    atomic<bool> isSuccess {true};
+    vector<thread> threads;
+    int64_t end = offset + length;
+    for (int64_t begin = offset + segment; begin < end; begin += segment) {
+        int64_t segmentLength = min(segment, end - begin);
+        threads.emplace_back([srcFd, destFd, begin, segmentLength, &isSuccess]() {
+            if (CopyRange(srcFd, destFd, begin, segmentLength) != RANGE_COPY_DONE) {
+                isSuccess.store(false);
+            }
+        });
+    }
+    // the calling thread takes the first segment instead of idling on join
+    if (CopyRange(srcFd, destFd, offset, min(segment, length)) != RANGE_COPY_DONE) {
+        isSuccess.store(false);
+    }
+    for (auto &worker : threads) {
+        worker.join();
+    }
+    return isSuccess.load();
+}
+
+bool MediaFileCopyEngine::SendFileFrom(int32_t srcFd, int32_t destFd, int64_t offset, int64_t length)
+{
+    CHECK_AND_RETURN_RET_LOG(lseek(destFd, static_cast<off_t>(offset), SEEK_SET) != -1, false,
+        "Failed to seek dest file, errno: %{public}d", errno);
+    off_t copied = static_cast<off_t>(offset);
+    off_t totalSize = static_cast<off_t>(offset + length);
+    while (copied < totalSize) {
+        off_t leftSize = totalSize - copied;
+        size_t sendSize = static_cast<size_t>(min<off_t>(leftSize, static_cast<off_t>(MAX_SENDFILE_SIZE)));
+        ssize_t ret = sendfile(destFd, srcFd, &copied, sendSize);
+        if (ret == E_ERR) {
+            CHECK_AND_CONTINUE(errno != EINTR);
+            MEDIA_ERR_LOG("Failed to sendfile, errno: %{public}d", errno);
+            return false;
+        }
+        CHECK_AND_RETURN_RET_LOG(ret != 0, false,
+            "sendfile returned 0 before copy finished, copied: %{public}lld, total: %{public}lld",
+            static_cast<long long>(copied), static_cast<long long>(totalSize));
+    }
+    return true;
+}
+
+void MediaFileCopyEngine::ReportThroughput(const string &scene, const FileCopyStats &stats)
+{
+    MEDIA_INFO_LOG("%{public}s method: %{public}d, files: %{public}lld, bytes: %{public}lld, cost: %{public}lld ms, "
+        "throughput: %{public}.2f MB/s", scene.c_str(), static_cast<int32_t>(stats.method),
+        static_cast<long long>(stats.files), static_cast<long long>(stats.bytes),
+        static_cast<long long>(stats.costMs), stats.GetThroughputMBps());
+}
+
+bool MediaFileCopyEngine::CopyFd(int32_t srcFd, int32_t destFd, int64_t size, FileCopyStats &stats)
+{
+    CHECK_AND_RETURN_RET_LOG(srcFd >= 0 && destFd >= 0 && size >= 0, false, "invalid copy argument");
+    int64_t startTime = GetSteadyTimeMs();
+    stats.method = FileCopyMethod::NONE;
+    bool isSuccess = true;
+    if (size > 0 && TryReflink(srcFd, destFd)) {
+        stats.method = FileCopyMethod::REFLINK;
+    } else if (size > 0) {
+        // the first segment doubles as the copy_file_range capability probe
+        int64_t probeSize = size >= PARALLEL_COPY_MIN_SIZE ? PARALLEL_SEGMENT_MIN_SIZE : size;
+        int32_t ret = CopyRange(srcFd, destFd, 0, probeSize);
+        if (ret == RANGE_COPY_DONE && probeSize < size) {
+            stats.method = FileCopyMethod::PARALLEL_COPY_FILE_RANGE;
+            if (!CopyRangeInParallel(srcFd, destFd, probeSize, size - probeSize)) {
+                MEDIA_WARN_LOG("parallel copy failed, retry with sendfile");
+                ret = RANGE_COPY_UNSUPPORTED;
+            }
+        } else if (ret == RANGE_COPY_DONE) {
+            stats.method = FileCopyMethod::COPY_FILE_RANGE;
+        }
+        if (ret != RANGE_COPY_DONE) {
+            stats.method = FileCopyMethod::SENDFILE;
+            isSuccess = SendFileFrom(srcFd, destFd, 0, size);
+        }
+    }
+    stats.costMs = GetSteadyTimeMs() - startTime;
+    stats.bytes = isSuccess ? size : 0;
+    stats.files = isSuccess ? 1 : 0;
+    if (isSuccess && size >= REPORT_THROUGHPUT_MIN_SIZE) {
+        ReportThroughput("CopyFd", stats);
+    }
+    return isSuccess;
+}
+
+int32_t MediaFileCopyEngine::CopyFdInChunks(int32_t srcFd, int32_t destFd, int64_t size, size_t chunkSize,
+    const FileCopyChunkCallback &onChunk, FileCopyStats &stats)
+{
+    CHECK_AND_RETURN_RET_LOG(srcFd >= 0 && destFd >= 0 && size >= 0 && chunkSize > 0, E_ERR,
+        "invalid copy argument");
+    int64_t startTime = GetSteadyTimeMs();
+    stats.method = FileCopyMethod::COPY_FILE_RANGE;
+    int64_t copied = 0;
+    if (size > 0 && TryReflink(srcFd, destFd)) {
+        stats.method = FileCopyMethod::REFLINK;
+        copied = size;
+        CHECK_AND_RETURN_RET(!onChunk || onChunk(static_cast<uint64_t>(size)), E_SCENE_HAS_CANCEL);
+    }
+    while (copied < size) {
+        int64_t copySize = min(static_cast<int64_t>(chunkSize), size - copied);
+        bool isCopied = false;
+        if (stats.method == FileCopyMethod::COPY_FILE_RANGE) {
+            int32_t ret = CopyRange(srcFd, destFd, copied, copySize);
+            CHECK_AND_RETURN_RET(ret != RANGE_COPY_FAILED, E_ERR);
+            isCopied = ret == RANGE_COPY_DONE;
+            stats.method = isCopied ? stats.method : FileCopyMethod::SENDFILE;
+        }
+        if (!isCopied) {
+            CHECK_AND_RETURN_RET(SendFileFrom(srcFd, destFd, copied, copySize), E_ERR);
+        }
+        copied += copySize;
+        CHECK_AND_RETURN_RET(!onChunk || onChunk(static_cast<uint64_t>(copySize)), E_SCENE_HAS_CANCEL);
+    }
+    stats.costMs = GetSteadyTimeMs() - startTime;
+    stats.bytes = size;
+    stats.files = 1;
+    if (size >= REPORT_THROUGHPUT_MIN_SIZE) {
+        ReportThroughput("CopyFdInChunks", stats);
+    }
+    return E_OK;
+}
+
+int32_t MediaFileCopyEngine::CopyFilesInBatch(vector<FileCopyTask> &tasks, FileCopyStats &stats)
+{
+    CHECK_AND_RETURN_RET(!tasks.empty(), E_OK);
+    int64_t startTime = GetSteadyTimeMs();
+    atomic<size_t> nextTask {0};
+    atomic<int64_t> bytes {0};
+    atomic<int64_t> files {0};
+    // workers pull from a shared cursor, so at most one copy per worker is in flight at any time
+    auto worker = [&tasks, &nextTask, &bytes, &files]() {
+        for (size_t index = nextTask.fetch_add(1); index < tasks.size(); index = nextTask.fetch_add(1)) {
+            FileCopyTask &task = tasks[index];
+            FileCopyStats taskStats;
+            task.isSuccess = MediaFileUtils::CopyFileUtil(task.srcPath, task.destPath, taskStats);
+            if (task.isSuccess) {
+                bytes.fetch_add(taskStats.bytes);
+                files.fetch_add(1);
+            }
+        }
+    };
+    uint32_t workers = static_cast<uint32_t>(min<size_t>(MAX_BATCH_COPY_WORKERS, tasks.size()));
+    vector<thread> threads;
+    for (uint32_t i = 1; i < workers; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    stats.method = FileCopyMethod::NONE;
+    stats.bytes = bytes.load();
+    stats.files = files.load();
+    stats.costMs = GetSteadyTimeMs() - startTime;
+    ReportThroughput("CopyFilesInBatch", stats);
+    CHECK_AND_RETURN_RET_LOG(stats.files == static_cast<int64_t>(tasks.size()), E_FAIL,
+        "batch copy failed, total: %{public}zu, success: %{public}lld", tasks.size(),
+        static_cast<long long>(stats.files));
+    return E_OK;
+}
+} // namespace OHOS::Media
@@ -39,6 +39,7 @@
 #include "avmetadatahelper.h"
 #include "directory_ex.h"
 #include "hmdfs.h"
+#include "media_file_copy_engine.h"
 #include "ipc_skeleton.h"
 #include "media_file_uri.h"
 #include "media_log.h"
@@ -118,7 +119,6 @@ const int32_t ASPECT_RATIO_MAX = 1000;
 const double ASPECT_RATIO_MIN = 0.001;
 const double ASPECT_RATIO_PRECISION = 1000.0;
 const size_t BUFFER_SIZE = 4 * 1024 * 1024;
-const size_t MAX_SENDFILE_SIZE = 0x7FFFF000;
 
 const UChar MASK = 0x002A;  // '*'
 const UChar DOT = 0x002E;   // '.'
@@ -775,30 +775,24 @@ int32_t MediaFileUtils::SegmentedCopyFileUtile(const string &filePath, const str
         return errCode;
     }
     if (fstat(source, &fst) == E_SUCCESS) {
-        off_t offset = 0;
-        int64_t size = static_cast<int64_t>(fst.st_size);
-        ssize_t sent = 0;
-        while (size >= 0) {
-            sent = sendfile(dest, source, &offset, BUFFER_SIZE);
-            if (sent == -1) {
-                MEDIA_ERR_LOG("sendfile failed, errno: %{public}d", errno);
-                break;
-            }
-            if (MediaFileUtils::CheckCancelCopy(requestId)) {
-                MEDIA_ERR_LOG("sendfile need cancel newPath:%{public}s", newPath.c_str());
-                CHECK_AND_PRINT_LOG(DeleteFile(newPath), "delete newPath:%{private}s failed", newPath.c_str());
-                close(source);
-                close(dest);
-                return E_SCENE_HAS_CANCEL;
-            }
-            size -= static_cast<int64_t>(sent);
+        FileCopyStats stats;
+        auto onChunk = [&progressCallback, &requestId](uint64_t copied) {
+            CHECK_AND_RETURN_RET(!MediaFileUtils::CheckCancelCopy(requestId), false);
             if (progressCallback) {
-                progressCallback(static_cast<uint64_t>(sent));
+                progressCallback(copied);
             }
-            CHECK_AND_BREAK(sent != 0);
+            return true;
+        };
+        int32_t ret = MediaFileCopyEngine::CopyFdInChunks(source, dest, static_cast<int64_t>(fst.st_size),
+            BUFFER_SIZE, onChunk, stats);
+        if (ret == E_SCENE_HAS_CANCEL) {
+            MEDIA_ERR_LOG("copy need cancel newPath:%{public}s", newPath.c_str());
+            CHECK_AND_PRINT_LOG(DeleteFile(newPath), "delete newPath:%{private}s failed", newPath.c_str());
+            close(source);
+            close(dest);
+            return E_SCENE_HAS_CANCEL;
         }
-
-        if (size == 0) {
+        if (ret == E_OK) {
             errCode = E_OK;
         }
     }
@@ -807,26 +801,13 @@ int32_t MediaFileUtils::SegmentedCopyFileUtile(const string &filePath, const str
     return errCode;
 }
 
-static bool SendFileWithRetry(int32_t dest, int32_t source, off_t totalSize, off_t &copied)
+bool MediaFileUtils::CopyFileUtil(const string &filePath, const string &newPath)
 {
-    while (copied < totalSize) {
-        off_t leftSize = totalSize - copied;
-        const off_t maxSendfileSize = static_cast<off_t>(MAX_SENDFILE_SIZE);
-        size_t sendSize = static_cast<size_t>(leftSize > maxSendfileSize ? maxSendfileSize : leftSize);
-        ssize_t ret = sendfile(dest, source, &copied, sendSize);
-        if (ret == E_ERR) {
-            CHECK_AND_CONTINUE(errno != EINTR);
-            MEDIA_ERR_LOG("Failed to sendfile, errno: %{public}d", errno);
-            return false;
-        }
-        CHECK_AND_RETURN_RET_LOG(ret != 0, false,
-            "sendfile returned 0 before copy finished, copied: %{public}lld, total: %{public}lld",
-            static_cast<long long>(copied), static_cast<long long>(totalSize));
-    }
-    return true;
+    FileCopyStats stats;
+    return CopyFileUtil(filePath, newPath, stats);
 }
 
-bool MediaFileUtils::CopyFileUtil(const string &filePath, const string &newPath)
+bool MediaFileUtils::CopyFileUtil(const string &filePath, const string &newPath, FileCopyStats &stats)
 {
     struct stat fst{};
     bool errCode = false;
@@ -859,15 +840,9 @@ bool MediaFileUtils::CopyFileUtil(const string &filePath, const string &newPath)
     CHECK_AND_RETURN_RET_LOG(fstat(srcFd.Get(), &fst) == E_SUCCESS, errCode,
         "Failed to fstat source file, errno: %{public}d", errno);
 
-    off_t total_size = fst.st_size;
-    off_t copied = 0;
-    CHECK_AND_RETURN_RET_LOG(SendFileWithRetry(destFd.Get(), srcFd.Get(), total_size, copied), errCode,
-        "Failed to copy content by sendfile");
-
-    if (copied == total_size) {
-        errCode = true;
-    }
-
+    CHECK_AND_RETURN_RET_LOG(MediaFileCopyEngine::CopyFd(srcFd.Get(), destFd.Get(),
+        static_cast<int64_t>(fst.st_size), stats), errCode, "Failed to copy content");
+    errCode = true;
     return errCode;
 }
 
@@ -2656,6 +2631,8 @@ int32_t MediaFileUtils::CopyDirectory(const std::string &srcDir, const std::stri
         return E_FAIL;
     }
  
+    // directories are created while walking, file content is copied afterwards as one batch
+    std::vector<FileCopyTask> copyTasks;
     for (const auto& entry : std::filesystem::recursive_directory_iterator(srcDir)) {
         std::string srcFilePath = entry.path();
         std::string tmpFilePath = srcFilePath;
@@ -2667,16 +2644,21 @@ int32_t MediaFileUtils::CopyDirectory(const std::string &srcDir, const std::stri
             }
         } else if (entry.is_regular_file()) {
             CHECK_AND_CONTINUE(!IsTranscodeFile(srcFilePath));
-            if (!CopyFileUtil(srcFilePath, dstFilePath)) {
-                MEDIA_ERR_LOG("Copy file from %{public}s to %{public}s failed.",
-                    DesensitizePath(srcFilePath).c_str(), DesensitizePath(dstFilePath).c_str());
-                return E_FAIL;
-            }
+            copyTasks.push_back({srcFilePath, dstFilePath});
         } else {
             MEDIA_ERR_LOG("Unhandled path type, path:%{public}s", DesensitizePath(srcFilePath).c_str());
             return E_FAIL;
         }
     }
+    FileCopyStats stats;
+    if (MediaFileCopyEngine::CopyFilesInBatch(copyTasks, stats) != E_OK) {
+        for (const auto &task : copyTasks) {
+            CHECK_AND_CONTINUE(!task.isSuccess);
+            MEDIA_ERR_LOG("Copy file from %{public}s to %{public}s failed.",
+                DesensitizePath(task.srcPath).c_str(), DesensitizePath(task.destPath).c_str());
+        }
+        return E_FAIL;
+    }
     return E_OK;
 }
 
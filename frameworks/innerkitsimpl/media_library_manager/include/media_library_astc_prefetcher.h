@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORKS_INNERKITSIMPL_MEDIA_LIBRARY_ASTC_PREFETCHER_H
+#define FRAMEWORKS_INNERKITSIMPL_MEDIA_LIBRARY_ASTC_PREFETCHER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "medialibrary_kvstore.h"
+
+namespace OHOS::Media {
+enum AstcMemoryLevel : int32_t {
+    ASTC_MEMORY_LEVEL_NORMAL = 0,
+    ASTC_MEMORY_LEVEL_MODERATE = 1,
+    ASTC_MEMORY_LEVEL_CRITICAL = 2,
+};
+
+struct AstcScrollState {
+    // offset of the first visible item and the number of visible items, one page is count items
+    int32_t start = 0;
+    int32_t count = 0;
+    // 1: towards larger offsets, -1: towards smaller offsets, 0: inferred from the previous window
+    int32_t direction = 0;
+    // items per second, 0: inferred from the previous window
+    int32_t speed = 0;
+};
+
+struct AstcPrefetchStats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t prefetchedPages = 0;
+    uint64_t cancelledPages = 0;
+    uint64_t evictedPages = 0;
+    uint64_t invalidatedKeys = 0;
+    size_t cachedBytes = 0;
+};
+
+/**
+ * @brief Reads month and year astc pages ahead of the visible window on a background thread, so that GetBatchAstcs
+ * is served from memory while scrolling. Pages that fall out of the read-ahead range are cancelled, and the cache is
+ * bounded by bytes and shrunk on memory pressure. Keys whose thumbnail changed are invalidated.
+ */
+class AstcPrefetcher {
+public:
+    // reads one page, keys are returned in ascending order and values[i] belongs to keys[i]
+    using PageLoader = std::function<int32_t(KvStoreValueType type, int32_t start, int32_t count,
+        std::vector<std::string> &keys, std::vector<std::vector<uint8_t>> &values)>;
+
+    static AstcPrefetcher &GetInstance();
+    AstcPrefetcher(PageLoader loader, size_t capacityBytes);
+    ~AstcPrefetcher();
+    AstcPrefetcher(const AstcPrefetcher &) = delete;
+    AstcPrefetcher &operator=(const AstcPrefetcher &) = delete;
+
+    void UpdateScrollState(KvStoreValueType type, const AstcScrollState &state);
+    // keys must be in ascending order, values[i] is left empty for every key that is not cached
+    size_t Lookup(KvStoreValueType type, const std::vector<std::string> &keys,
+        std::vector<std::vector<uint8_t>> &values);
+    void OnMemoryLevel(int32_t level);
+    // drops the cached astc of both the month and year keys, pages being read are discarded when they complete
+    void Invalidate(const std::vector<std::string> &keys);
+    void Clear();
+    bool WaitForIdle(int32_t timeoutMs);
+    AstcPrefetchStats GetStats();
+
+private:
+    struct PageId {
+        KvStoreValueType type = KvStoreValueType::MONTH_ASTC;
+        int32_t start = 0;
+        int32_t count = 0;
+        bool operator==(const PageId &other) const
+        {
+            return type == other.type && start == other.start && count == other.count;
+        }
+    };
+
+    struct Page {
+        PageId id;
+        std::vector<std::string> keys;
+        std::vector<std::vector<uint8_t>> values;
+        size_t bytes = 0;
+    };
+
+    using PageIter = std::list<Page>::iterator;
+
+    void WorkerLoop();
+    void StartWorkerIfNeeded();
+    void InferScrollState(KvStoreValueType type, AstcScrollState &state);
+    std::vector<PageId> GetTargetPages(KvStoreValueType type, const AstcScrollState &state);
+    bool IsTarget(const PageId &id);
+    bool IsCachedOrLoading(const PageId &id);
+    void InsertPage(Page &&page);
+    void EvictPage(PageIter iter);
+    void TrimToCapacity();
+    static std::string GetPageKey(const PageId &id);
+    static std::string GetIndexKey(KvStoreValueType type, const std::string &key);
+
+    PageLoader loader_;
+    size_t maxCapacity_ = 0;
+    size_t capacity_ = 0;
+    int32_t memoryLevel_ = ASTC_MEMORY_LEVEL_NORMAL;
+
+    std::mutex mutex_;
+    std::condition_variable workCv_;
+    std::condition_variable idleCv_;
+    std::thread worker_;
+    bool isStopped_ = false;
+    bool isLoading_ = false;
+    PageId loadingPage_;
+    // bumped by Invalidate, a page read across an invalidation may hold a stale astc
+    uint64_t invalidateVersion_ = 0;
+
+    std::deque<PageId> pendingPages_;
+    std::vector<PageId> targetPages_;
+    KvStoreValueType lastType_ = KvStoreValueType::MONTH_ASTC;
+    AstcScrollState lastState_;
+    int64_t lastUpdateTime_ = 0;
+
+    // least recently used page at the front
+    std::list<Page> pages_;
+    std::unordered_map<std::string, PageIter> pageMap_;
+    std::unordered_map<std::string, std::pair<PageIter, size_t>> keyIndex_;
+    AstcPrefetchStats stats_;
+};
+} // namespace OHOS::Media
+#endif // FRAMEWORKS_INNERKITSIMPL_MEDIA_LIBRARY_ASTC_PREFETCHER_H
@@ -17,6 +17,7 @@
 
 #include "media_library_manager.h"
 
+#include <algorithm>
 #include <fcntl.h>
 #include <sys/xattr.h>
 
@@ -25,6 +26,8 @@
 #include "iservice_registry.h"
 #include "os_account_manager.h"
 #include "media_asset_rdbstore.h"
+#include "media_library_astc_prefetcher.h"
+#include "media_library_notify_callback.h"
 #include "media_common_client.h"
 #include "media_file_uri.h"
 #include "media_file_utils.h"
@@ -33,6 +36,7 @@
 #include "media_log.h"
 #include "medialibrary_errno.h"
 #include "medialibrary_manager_notify_observer_manager.h"
+#include "photo_asset_change_info.h"
 #include "medialibrary_kvstore_manager.h"
 #include "medialibrary_tracer.h"
 #include "media_app_uri_permission_column.h"
@@ -923,6 +927,82 @@ std::unique_ptr<PixelMap> MediaLibraryManager::GetThumbnail(const Uri &uri)
     return pixelmap;
 }
 
+static int32_t BatchQueryAstcsFromKvStore(KvStoreValueType valueType, vector<string> &keys,
+    vector<vector<uint8_t>> &astcBatch)
+{
+    auto kvStore = MediaLibraryKvStoreManager::GetInstance().GetKvStore(KvStoreRoleType::VISITOR, valueType);
+    CHECK_AND_RETURN_RET_LOG(kvStore != nullptr, E_DB_FAIL, "BatchQueryAstcs kvStore is nullptr");
+    return kvStore->BatchQuery(keys, astcBatch);
+}
+
+// astc read ahead by the prefetcher is served from memory, only the rest goes to the kv store
+static int32_t BatchQueryAstcs(KvStoreValueType valueType, vector<string> &keys, vector<vector<uint8_t>> &astcBatch)
+{
+    CHECK_AND_RETURN_RET(!keys.empty(), BatchQueryAstcsFromKvStore(valueType, keys, astcBatch));
+    // BatchQuery returns the values in ascending order of the keys
+    sort(keys.begin(), keys.end());
+    vector<vector<uint8_t>> cachedValues;
+    size_t hitNum = AstcPrefetcher::GetInstance().Lookup(valueType, keys, cachedValues);
+    CHECK_AND_RETURN_RET(hitNum > 0, BatchQueryAstcsFromKvStore(valueType, keys, astcBatch));
+    vector<string> missKeys;
+    for (size_t i = 0; i < keys.size(); i++) {
+        CHECK_AND_EXECUTE(!cachedValues[i].empty(), missKeys.push_back(keys[i]));
+    }
+    vector<vector<uint8_t>> missValues;
+    if (!missKeys.empty()) {
+        int32_t status = BatchQueryAstcsFromKvStore(valueType, missKeys, missValues);
+        CHECK_AND_RETURN_RET(status == E_OK, status);
+        CHECK_AND_RETURN_RET_LOG(missValues.size() == missKeys.size(), E_ERR,
+            "BatchQueryAstcs size mismatch, keys: %{public}zu, values: %{public}zu", missKeys.size(),
+            missValues.size());
+    }
+    size_t missIndex = 0;
+    for (auto &value : cachedValues) {
+        astcBatch.emplace_back(value.empty() ? std::move(missValues[missIndex++]) : std::move(value));
+    }
+    return E_OK;
+}
+
+// drops prefetched astc of assets whose thumbnail was regenerated or removed
+class AstcPrefetchInvalidator : public PhotoAssetChangeCallback {
+public:
+    void OnChange(const PhotoAssetChangeInfos &changeInfos) override
+    {
+        vector<string> keys;
+        for (const auto &changeData : changeInfos.assetChangeDatas) {
+            CHECK_AND_CONTINUE(changeData.isDeleted || changeData.isContentChanged ||
+                changeData.thumbnailChangeStatus != AccurateRefresh::ThumbnailChangeStatus::THUMBNAIL_NOT_CHANGE);
+            AddKvStoreKey(changeData.assetBeforeChange, keys);
+            AddKvStoreKey(changeData.assetAfterChange, keys);
+        }
+        CHECK_AND_RETURN(!keys.empty());
+        AstcPrefetcher::GetInstance().Invalidate(keys);
+    }
+
+private:
+    static void AddKvStoreKey(const shared_ptr<PhotoAssetChangeInfo> &info, vector<string> &keys)
+    {
+        CHECK_AND_RETURN(info != nullptr && info->fileId_ > 0 && info->dateTakenMs_ >= 0);
+        string key;
+        if (MediaFileUtils::GenerateKvStoreKey(to_string(info->fileId_), to_string(info->dateTakenMs_), key)) {
+            keys.push_back(std::move(key));
+        }
+    }
+};
+
+void MediaLibraryManager::RegisterAstcPrefetchInvalidator()
+{
+    static std::mutex invalidatorMutex;
+    static shared_ptr<AstcPrefetchInvalidator> invalidator = nullptr;
+    std::lock_guard<std::mutex> lock(invalidatorMutex);
+    CHECK_AND_RETURN(invalidator == nullptr);
+    auto callback = make_shared<AstcPrefetchInvalidator>();
+    int32_t ret = MediaLibraryManagerNotifyObserverManager::GetInstance().RegisterAssetCallback(
+        GetDataShareHelper(), Notification::NotifyUriType::PHOTO_URI, callback);
+    CHECK_AND_RETURN_LOG(ret == E_OK, "Register astc prefetch invalidator failed, ret: %{public}d", ret);
+    invalidator = callback;
+}
+
 static int32_t GetAstcsByOffset(const vector<string> &uriBatch, vector<vector<uint8_t>> &astcBatch)
 {
     UriParams uriParams;
@@ -952,12 +1032,11 @@ static int32_t GetAstcsByOffset(const vector<string> &uriBatch, vector<vector<ui
 
     vector<string> newTimeIdBatch;
     MediaAssetRdbStore::GetInstance()->QueryTimeIdBatch(start, count, newTimeIdBatch);
-    auto kvStore = MediaLibraryKvStoreManager::GetInstance().GetKvStore(KvStoreRoleType::VISITOR, valueType);
-    if (kvStore == nullptr) {
-        MEDIA_ERR_LOG("GetAstcsByOffset kvStore is nullptr");
-        return E_DB_FAIL;
-    }
-    int32_t status = kvStore->BatchQuery(newTimeIdBatch, astcBatch);
+    AstcScrollState scrollState;
+    scrollState.start = start;
+    scrollState.count = count;
+    AstcPrefetcher::GetInstance().UpdateScrollState(valueType, scrollState);
+    int32_t status = BatchQueryAstcs(valueType, newTimeIdBatch, astcBatch);
     if (status != E_OK) {
         MEDIA_ERR_LOG("GetAstcsByOffset failed, status %{public}d", status);
         return status;
@@ -989,9 +1068,7 @@ static int32_t GetAstcsBatch(const vector<string> &uriBatch, vector<vector<uint8
         return E_INVALID_URI;
     }
 
-    auto kvStore = MediaLibraryKvStoreManager::GetInstance().GetKvStore(KvStoreRoleType::VISITOR, valueType);
-    CHECK_AND_RETURN_RET_LOG(kvStore != nullptr, E_DB_FAIL, "GetAstcsBatch kvStore is nullptr");
-    int32_t status = kvStore->BatchQuery(timeIdBatch, astcBatch);
+    int32_t status = BatchQueryAstcs(valueType, timeIdBatch, astcBatch);
     CHECK_AND_RETURN_RET_LOG(status == E_OK, status, "GetAstcsBatch failed, status %{public}d", status);
     return E_OK;
 }
@@ -1003,12 +1080,39 @@ int32_t MediaLibraryManager::GetBatchAstcs(const vector<string> &uriBatch, vecto
         return E_INVALID_URI;
     }
     if (uriBatch.at(0).find(CONST_ML_URI_OFFSET) != std::string::npos) {
+        RegisterAstcPrefetchInvalidator();
         return GetAstcsByOffset(uriBatch, astcBatch);
     } else {
         return GetAstcsBatch(uriBatch, astcBatch);
     }
 }
 
+void MediaLibraryManager::ReportAstcScrollState(const Size &size, int32_t start, int32_t count, int32_t direction,
+    int32_t speed)
+{
+    KvStoreValueType valueType;
+    if (size.width == DEFAULT_MONTH_THUMBNAIL_SIZE && size.height == DEFAULT_MONTH_THUMBNAIL_SIZE) {
+        valueType = KvStoreValueType::MONTH_ASTC;
+    } else if (size.width == DEFAULT_YEAR_THUMBNAIL_SIZE && size.height == DEFAULT_YEAR_THUMBNAIL_SIZE) {
+        valueType = KvStoreValueType::YEAR_ASTC;
+    } else {
+        MEDIA_ERR_LOG("ReportAstcScrollState invalid image size");
+        return;
+    }
+    AstcScrollState scrollState;
+    scrollState.start = start;
+    scrollState.count = count;
+    scrollState.direction = direction;
+    scrollState.speed = speed;
+    RegisterAstcPrefetchInvalidator();
+    AstcPrefetcher::GetInstance().UpdateScrollState(valueType, scrollState);
+}
+
+void MediaLibraryManager::TrimAstcCache(int32_t memoryLevel)
+{
+    AstcPrefetcher::GetInstance().OnMemoryLevel(memoryLevel);
+}
+
 unique_ptr<PixelMap> MediaLibraryManager::DecodeAstc(UniqueFd &uniqueFd)
 {
     if (uniqueFd.Get() < 0) {
@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "AstcPrefetcher"
+
+#include "media_library_astc_prefetcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
+#include "application_context.h"
+#include "media_asset_rdbstore.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+#include "medialibrary_kvstore_manager.h"
+#include "medialibrary_tracer.h"
+
+using namespace std;
+
+namespace OHOS::Media {
+static constexpr size_t DEFAULT_CAPACITY_BYTES = 24 * 1024 * 1024;
+static constexpr int32_t MAX_PREFETCH_PAGES = 3;
+// pages are read far enough ahead to cover this much scrolling at the current speed
+static constexpr int64_t LOOKAHEAD_MS = 1000;
+static constexpr int64_t MS_PER_SECOND = 1000;
+// a window reported after this long is a new scroll, its speed is not derived from the previous one
+static constexpr int64_t SCROLL_IDLE_MS = 2000;
+// memory level reported by EnvironmentCallback::OnMemoryLevel, the low and critical levels follow it
+static constexpr int32_t SYSTEM_MEMORY_LEVEL_MODERATE = 0;
+
+static int64_t GetSteadyTimeMs()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int32_t LoadAstcPage(KvStoreValueType type, int32_t start, int32_t count, vector<string> &keys,
+    vector<vector<uint8_t>> &values)
+{
+    MediaLibraryTracer tracer;
+    tracer.Start("AstcPrefetcher::LoadAstcPage");
+    int32_t ret = MediaAssetRdbStore::GetInstance()->QueryTimeIdBatch(start, count, keys);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "QueryTimeIdBatch failed, ret: %{public}d", ret);
+    CHECK_AND_RETURN_RET(!keys.empty(), E_OK);
+    auto kvStore = MediaLibraryKvStoreManager::GetInstance().GetKvStore(KvStoreRoleType::VISITOR, type);
+    CHECK_AND_RETURN_RET_LOG(kvStore != nullptr, E_DB_FAIL, "kvStore is nullptr");
+    ret = kvStore->BatchQuery(keys, values);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "BatchQuery failed, ret: %{public}d", ret);
+    // BatchQuery sorts the keys in descending order but returns the values in ascending order
+    sort(keys.begin(), keys.end());
+    return E_OK;
+}
+
+// trims the cache on system memory pressure and drops it while the app is in the background
+class AstcCacheTrimCallback : public AbilityRuntime::EnvironmentCallback,
+    public AbilityRuntime::ApplicationStateChangeCallback {
+public:
+    explicit AstcCacheTrimCallback(AstcPrefetcher &prefetcher) : prefetcher_(prefetcher) {}
+    ~AstcCacheTrimCallback() override = default;
+
+    void OnConfigurationUpdated(const AppExecFwk::Configuration &config) override {}
+
+    void OnMemoryLevel(const int level) override
+    {
+        prefetcher_.OnMemoryLevel(level == SYSTEM_MEMORY_LEVEL_MODERATE ? ASTC_MEMORY_LEVEL_MODERATE :
+            ASTC_MEMORY_LEVEL_CRITICAL);
+    }
+
+    void NotifyApplicationForeground() override
+    {
+        prefetcher_.OnMemoryLevel(ASTC_MEMORY_LEVEL_NORMAL);
+    }
+
+    void NotifyApplicationBackground() override
+    {
+        prefetcher_.OnMemoryLevel(ASTC_MEMORY_LEVEL_CRITICAL);
+    }
+
+private:
+    AstcPrefetcher &prefetcher_;
+};
+
+static void RegisterTrimCallback(AstcPrefetcher &prefetcher)
+{
+    auto context = AbilityRuntime::Context::GetApplicationContext();
+    CHECK_AND_RETURN_LOG(context != nullptr, "application context is nullptr, the cache is only trimmed on request");
+    // the application context keeps the state change callback as a weak pointer
+    static auto callback = make_shared<AstcCacheTrimCallback>(prefetcher);
+    context->RegisterEnvironmentCallback(callback);
+    context->RegisterApplicationStateChangeCallback(callback);
+}
+
+AstcPrefetcher &AstcPrefetcher::GetInstance()
+{
+    // never destroyed, so process exit does not join the worker while the kv store it reads is torn down
+    static AstcPrefetcher *instance = []() {
+        auto prefetcher = new AstcPrefetcher(LoadAstcPage, DEFAULT_CAPACITY_BYTES);
+        RegisterTrimCallback(*prefetcher);
+        return prefetcher;
+    }();
+    return *instance;
+}
+
+AstcPrefetcher::AstcPrefetcher(PageLoader loader, size_t capacityBytes)
+    : loader_(std::move(loader)), maxCapacity_(capacityBytes), capacity_(capacityBytes)
+{
+}
+
+AstcPrefetcher::~AstcPrefetcher()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        isStopped_ = true;
+        pendingPages_.clear();
+    }
+    workCv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+string AstcPrefetcher::GetPageKey(const PageId &id)
+{
+    return to_string(static_cast<int32_t>(id.type)) + "_" + to_string(id.count) + "_" + to_string(id.start);
+}
+
+string AstcPrefetcher::GetIndexKey(KvStoreValueType type, const string &key)
+{
+    return to_string(static_cast<int32_t>(type)) + "_" + key;
+}
+
+void AstcPrefetcher::StartWorkerIfNeeded()
+{
+    if (!worker_.joinable() && !isStopped_) {
+        worker_ = thread([this]() { WorkerLoop(); });
+    }
+}
+
+void AstcPrefetcher::InferScrollState(KvStoreValueType type, AstcScrollState &state)
+{
+    int64_t now = GetSteadyTimeMs();
+    int64_t elapsed = now - lastUpdateTime_;
+    bool isSameScroll = lastUpdateTime_ > 0 && type == lastType_ && elapsed <= SCROLL_IDLE_MS;
+    int32_t delta = state.start - lastState_.start;
+    if (state.direction == 0 && isSameScroll) {
+        state.direction = delta == 0 ? lastState_.direction : (delta > 0 ? 1 : -1);
+    }
+    if (state.direction == 0) {
+        state.direction = 1;
+    }
+    if (state.speed == 0 && isSameScroll && elapsed > 0) {
+        state.speed = static_cast<int32_t>(static_cast<int64_t>(abs(delta)) * MS_PER_SECOND / elapsed);
+    }
+    lastType_ = type;
+    lastState_ = state;
+    lastUpdateTime_ = now;
+}
+
+vector<AstcPrefetcher::PageId> AstcPrefetcher::GetTargetPages(KvStoreValueType type, const AstcScrollState &state)
+{
+    int32_t pageNum = 1 + static_cast<int32_t>(static_cast<int64_t>(state.speed) * LOOKAHEAD_MS /
+        MS_PER_SECOND / state.count);
+    pageNum = min(pageNum, memoryLevel_ == ASTC_MEMORY_LEVEL_MODERATE ? 1 : MAX_PREFETCH_PAGES);
+    // pages are aligned to the window size, so windows moving by a few items keep hitting the same pages
+    int32_t firstPage = state.start / state.count;
+    int32_t lastPage = (state.start + state.count - 1) / state.count;
+    vector<PageId> targets;
+    for (int32_t i = 1; i <= pageNum; i++) {
+        int32_t page = state.direction > 0 ? lastPage + i : firstPage - i;
+        if (page < 0) {
+            break;
+        }
+        targets.push_back({ type, page * state.count, state.count });
+    }
+    return targets;
+}
+
+void AstcPrefetcher::UpdateScrollState(KvStoreValueType type, const AstcScrollState &state)
+{
+    CHECK_AND_RETURN_LOG(state.start >= 0 && state.count > 0, "invalid window, start: %{public}d, count: %{public}d",
+        state.start, state.count);
+    lock_guard<mutex> lock(mutex_);
+    AstcScrollState scrollState = state;
+    InferScrollState(type, scrollState);
+    CHECK_AND_RETURN(memoryLevel_ < ASTC_MEMORY_LEVEL_CRITICAL && !isStopped_);
+    targetPages_ = GetTargetPages(type, scrollState);
+    // pending pages outside the new read-ahead range are cancelled before they are read
+    for (const auto &id : pendingPages_) {
+        if (!IsTarget(id)) {
+            stats_.cancelledPages++;
+        }
+    }
+    pendingPages_.clear();
+    for (const auto &id : targetPages_) {
+        if (!IsCachedOrLoading(id)) {
+            pendingPages_.push_back(id);
+        }
+    }
+    CHECK_AND_RETURN(!pendingPages_.empty());
+    StartWorkerIfNeeded();
+    workCv_.notify_one();
+}
+
+bool AstcPrefetcher::IsTarget(const PageId &id)
+{
+    return find(targetPages_.begin(), targetPages_.end(), id) != targetPages_.end();
+}
+
+bool AstcPrefetcher::IsCachedOrLoading(const PageId &id)
+{
+    return (isLoading_ && loadingPage_ == id) || pageMap_.count(GetPageKey(id)) > 0;
+}
+
+void AstcPrefetcher::WorkerLoop()
+{
+    while (true) {
+        unique_lock<mutex> lock(mutex_);
+        workCv_.wait(lock, [this]() { return isStopped_ || !pendingPages_.empty(); });
+        if (isStopped_) {
+            break;
+        }
+        Page page;
+        page.id = pendingPages_.front();
+        pendingPages_.pop_front();
+        isLoading_ = true;
+        loadingPage_ = page.id;
+        uint64_t invalidateVersion = invalidateVersion_;
+        lock.unlock();
+
+        int32_t ret = loader_(page.id.type, page.id.start, page.id.count, page.keys, page.values);
+
+        lock.lock();
+        isLoading_ = false;
+        bool isLoaded = ret == E_OK && page.keys.size() == page.values.size();
+        CHECK_AND_PRINT_LOG(isLoaded, "load page failed, start: %{public}d, ret: %{public}d", page.id.start, ret);
+        // empty keys mean the page is past the end of the timeline
+        if (isLoaded && !page.keys.empty()) {
+            // the window may have moved on or a thumbnail may have changed while the page was read
+            if (IsTarget(page.id) && memoryLevel_ < ASTC_MEMORY_LEVEL_CRITICAL &&
+                invalidateVersion == invalidateVersion_) {
+                InsertPage(std::move(page));
+            } else {
+                stats_.cancelledPages++;
+            }
+        }
+        if (pendingPages_.empty()) {
+            idleCv_.notify_all();
+        }
+    }
+}
+
+void AstcPrefetcher::InsertPage(Page &&page)
+{
+    for (const auto &value : page.values) {
+        page.bytes += value.size();
+    }
+    CHECK_AND_RETURN_LOG(page.bytes <= capacity_, "page is larger than the cache, bytes: %{public}zu", page.bytes);
+    string pageKey = GetPageKey(page.id);
+    pages_.push_back(std::move(page));
+    PageIter iter = prev(pages_.end());
+    pageMap_[pageKey] = iter;
+    for (size_t i = 0; i < iter->keys.size(); i++) {
+        // ungenerated astc is not cached, it is looked up again on demand
+        if (!iter->values[i].empty()) {
+            keyIndex_[GetIndexKey(iter->id.type, iter->keys[i])] = { iter, i };
+        }
+    }
+    stats_.cachedBytes += iter->bytes;
+    stats_.prefetchedPages++;
+    TrimToCapacity();
+}
+
+void AstcPrefetcher::EvictPage(PageIter iter)
+{
+    for (size_t i = 0; i < iter->keys.size(); i++) {
+        auto indexIter = keyIndex_.find(GetIndexKey(iter->id.type, iter->keys[i]));
+        // a key may have moved to a newer page after an insert or delete shifted the offsets
+        if (indexIter != keyIndex_.end() && indexIter->second.first == iter) {
+            keyIndex_.erase(indexIter);
+        }
+    }
+    pageMap_.erase(GetPageKey(iter->id));
+    stats_.cachedBytes -= iter->bytes;
+    stats_.evictedPages++;
+    pages_.erase(iter);
+}
+
+void AstcPrefetcher::TrimToCapacity()
+{
+    while (stats_.cachedBytes > capacity_ && !pages_.empty()) {
+        EvictPage(pages_.begin());
+    }
+}
+
+size_t AstcPrefetcher::Lookup(KvStoreValueType type, const vector<string> &keys, vector<vector<uint8_t>> &values)
+{
+    values.assign(keys.size(), vector<uint8_t>());
+    lock_guard<mutex> lock(mutex_);
+    size_t hitNum = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto indexIter = keyIndex_.find(GetIndexKey(type, keys[i]));
+        if (indexIter == keyIndex_.end()) {
+            continue;
+        }
+        PageIter page = indexIter->second.first;
+        values[i] = page->values[indexIter->second.second];
+        pages_.splice(pages_.end(), pages_, page);
+        hitNum++;
+    }
+    stats_.hitCount += hitNum;
+    stats_.missCount += keys.size() - hitNum;
+    return hitNum;
+}
+
+void AstcPrefetcher::OnMemoryLevel(int32_t level)
+{
+    lock_guard<mutex> lock(mutex_);
+    MEDIA_INFO_LOG("OnMemoryLevel: %{public}d, cachedBytes: %{public}zu, hit: %{public}" PRIu64
+        ", miss: %{public}" PRIu64, level, stats_.cachedBytes, stats_.hitCount, stats_.missCount);
+    memoryLevel_ = level;
+    if (level >= ASTC_MEMORY_LEVEL_CRITICAL) {
+        capacity_ = 0;
+        stats_.cancelledPages += pendingPages_.size();
+        pendingPages_.clear();
+        idleCv_.notify_all();
+    } else {
+        capacity_ = level == ASTC_MEMORY_LEVEL_MODERATE ? maxCapacity_ / 2 : maxCapacity_;
+    }
+    TrimToCapacity();
+}
+
+void AstcPrefetcher::Invalidate(const vector<string> &keys)
+{
+    CHECK_AND_RETURN(!keys.empty());
+    lock_guard<mutex> lock(mutex_);
+    invalidateVersion_++;
+    for (const auto &key : keys) {
+        for (auto type : { KvStoreValueType::MONTH_ASTC, KvStoreValueType::YEAR_ASTC }) {
+            auto indexIter = keyIndex_.find(GetIndexKey(type, key));
+            CHECK_AND_CONTINUE(indexIter != keyIndex_.end());
+            PageIter page = indexIter->second.first;
+            vector<uint8_t> &value = page->values[indexIter->second.second];
+            page->bytes -= value.size();
+            stats_.cachedBytes -= value.size();
+            vector<uint8_t>().swap(value);
+            keyIndex_.erase(indexIter);
+            stats_.invalidatedKeys++;
+        }
+    }
+}
+
+void AstcPrefetcher::Clear()
+{
+    lock_guard<mutex> lock(mutex_);
+    stats_.cancelledPages += pendingPages_.size();
+    pendingPages_.clear();
+    targetPages_.clear();
+    while (!pages_.empty()) {
+        EvictPage(pages_.begin());
+    }
+    lastUpdateTime_ = 0;
+    idleCv_.notify_all();
+}
+
+bool AstcPrefetcher::WaitForIdle(int32_t timeoutMs)
+{
+    unique_lock<mutex> lock(mutex_);
+    return idleCv_.wait_for(lock, chrono::milliseconds(timeoutMs),
+        [this]() { return pendingPages_.empty() && !isLoading_; });
+}
+
+AstcPrefetchStats AstcPrefetcher::GetStats()
+{
+    lock_guard<mutex> lock(mutex_);
+    return stats_;
+}
+} // namespace OHOS::Media
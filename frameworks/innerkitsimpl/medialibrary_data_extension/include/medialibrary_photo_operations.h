@@ -80,6 +80,13 @@ struct FileSizeResult {
     std::vector<std::string> movingPhotoExtraDataFiles;
 };
 
+struct BatchCreatedAsset {
+    int32_t fileId = -1;
+    std::string uri;
+    // write fd of the empty file, owned by the caller
+    int32_t fd = -1;
+};
+
 class AlbumData {
 public:
     AlbumData() = default;
@@ -111,6 +118,9 @@ public:
 class MediaLibraryPhotoOperations : public MediaLibraryAssetOperations {
 public:
     EXPORT static int32_t Create(MediaLibraryCommand &cmd);
+    EXPORT static int32_t BatchCreate(std::vector<std::unique_ptr<MediaLibraryCommand>> &cmds,
+        std::vector<BatchCreatedAsset> &createdAssets);
+    EXPORT static int32_t BatchCommit(const std::vector<int32_t> &fileIds, const std::string &bundleName);
     EXPORT static std::shared_ptr<NativeRdb::ResultSet> Query(MediaLibraryCommand &cmd,
         const std::vector<std::string> &columns);
     EXPORT static int32_t Update(MediaLibraryCommand &cmd);
@@ -224,6 +234,10 @@ private:
     static int32_t CreateV9(MediaLibraryCommand &cmd);
     static int32_t CreateV10(MediaLibraryCommand &cmd);
     static int32_t HandleCreateV10(MediaLibraryCommand &cmd);
+    static int32_t PrepareBatchCreateAsset(MediaLibraryCommand &cmd, FileAsset &fileAsset, std::string &extension);
+    static int32_t InsertBatchCreateAssets(std::vector<std::unique_ptr<MediaLibraryCommand>> &cmds,
+        std::vector<FileAsset> &fileAssets, const std::vector<std::string> &extensions);
+    static void RemoveBatchCreateAssets(const std::vector<FileAsset> &fileAssets);
     static int32_t HandleTrans(FileAsset &fileAsset, const string &extention,
         MediaLibraryCommand &cmd, bool isContains, int32_t &outRow);
     static void SetFileAssetFromCmd(FileAsset &fileAsset, MediaLibraryCommand &cmd,
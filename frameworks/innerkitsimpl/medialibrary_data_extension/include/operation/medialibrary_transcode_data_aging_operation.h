@@ -58,6 +58,8 @@ public:
     EXPORT void AgingTmpCompatibleDuplicates();
     EXPORT void InterruptAgingTmpCompatibleDuplicates();
     EXPORT int32_t AgingTmpCompatibleDuplicate(int32_t fileId, const std::string &filePath);
+    EXPORT static void LoadTmpCompatibleDupCache();
+    EXPORT static void TouchTmpCompatibleDup(const std::string &fileId);
 private:
     std::atomic_bool isAgingDup_ {false};
     static std::unique_ptr<MediaLibraryTranscodeDataAgingOperation> instance_;
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIALIBRARY_TMP_COMPATIBLE_DUP_CACHE_H
+#define OHOS_MEDIALIBRARY_TMP_COMPATIBLE_DUP_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dfx_transcode.h"
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+struct TmpCompatibleDupInfo {
+    int32_t fileId = 0;
+    // data of the source photo, the duplicate is transcode.jpg in its edit data dir
+    std::string path;
+    int64_t size = 0;
+    int64_t lastAccessTime = 0;
+    TranscodeType transcodeType = TranscodeType::DEFAULT;
+};
+
+struct TmpCompatibleDupResult {
+    int32_t ret = 0;
+    size_t size = 0;
+    int32_t dupExist = 0;
+    TranscodeType transcodeType = TranscodeType::DEFAULT;
+    // the duplicate was encoded by a concurrent request for the same file
+    bool isCoalesced = false;
+};
+
+/**
+ * @brief Keeps the temporary compatible duplicates within a byte budget. Every duplicate is ordered by its last
+ * access, a new duplicate pushing the total over the budget evicts the least recently accessed ones. Concurrent
+ * requests for the same file share a single transcoding, the followers wait for the result of the first request.
+ */
+class TmpCompatibleDupCache {
+public:
+    using Creator = std::function<void(TmpCompatibleDupResult &result)>;
+    using Evictor = std::function<int32_t(const TmpCompatibleDupInfo &info)>;
+
+    EXPORT static TmpCompatibleDupCache &GetInstance();
+    EXPORT explicit TmpCompatibleDupCache(int64_t budget);
+
+    EXPORT void SetEvictor(Evictor evictor);
+    // runs the creator once for the concurrent requests of the same file
+    EXPORT TmpCompatibleDupResult Create(int32_t fileId, const Creator &creator);
+    // records a duplicate encoded just now and evicts the least recently accessed ones over the budget
+    EXPORT void Add(const TmpCompatibleDupInfo &info);
+    EXPORT void Touch(int32_t fileId);
+    EXPORT void Remove(int32_t fileId);
+    // 0 if the file has no recorded duplicate
+    EXPORT int64_t GetLastAccessTime(int32_t fileId);
+    EXPORT int64_t GetTotalSize();
+    EXPORT size_t GetCount();
+    // loads the duplicates left by the previous run, the most recently transcoded first
+    EXPORT void Load(const std::vector<TmpCompatibleDupInfo> &infos);
+    EXPORT bool IsLoaded();
+    EXPORT void Clear();
+
+private:
+    struct Entry {
+        TmpCompatibleDupInfo info;
+        std::list<int32_t>::iterator lruIt;
+    };
+    struct Flight {
+        bool isDone = false;
+        TmpCompatibleDupResult result;
+    };
+
+    void InsertLocked(const TmpCompatibleDupInfo &info);
+    void RemoveLocked(int32_t fileId);
+    std::vector<TmpCompatibleDupInfo> CollectVictimsLocked(int32_t keepFileId);
+    void Evict(const std::vector<TmpCompatibleDupInfo> &victims);
+
+    int64_t budget_;
+    std::mutex mutex_;
+    Evictor evictor_;
+    // most recently accessed first
+    std::list<int32_t> lru_;
+    std::unordered_map<int32_t, Entry> entries_;
+    int64_t totalSize_ = 0;
+    bool isLoaded_ = false;
+
+    std::unordered_map<int32_t, std::shared_ptr<Flight>> flights_;
+    std::condition_variable flightCv_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIALIBRARY_TMP_COMPATIBLE_DUP_CACHE_H
@@ -48,6 +48,7 @@
 #include "media_file_access_utils.h"
 #include "media_clone_pending_record_utils.h"
 #include "preferred_compatible_mode_check_utils.h"
+#include "tmp_compatible_dup_cache.h"
 
 namespace OHOS::Media {
 using namespace std;
@@ -2646,6 +2647,18 @@ static void SetMovingPhotoSize(size_t &size, const std::shared_ptr<NativeRdb::Re
     }
 }
 
+static void AddTmpCompatibleDupToCache(int32_t fileId, const std::string &path, size_t size,
+    TranscodeType transcodeType)
+{
+    TmpCompatibleDupInfo info;
+    info.fileId = fileId;
+    info.path = path;
+    info.size = static_cast<int64_t>(size);
+    info.lastAccessTime = MediaFileUtils::UTCTimeMilliSeconds();
+    info.transcodeType = transcodeType;
+    TmpCompatibleDupCache::GetInstance().Add(info);
+}
+
 int32_t MediaLibraryAlbumFusionUtils::CreateTmpCompatibleDup(int32_t fileId, const std::string &path, size_t &size,
     int32_t &dupExist, TranscodeType& transcodeType)
 {
@@ -2680,6 +2693,7 @@ int32_t MediaLibraryAlbumFusionUtils::CreateTmpCompatibleDup(int32_t fileId, con
     }
     if (err == E_OK) {
         int32_t ret = PhotoFileOperation().CreateTmpCompatibleDup(srcInfo, size, width, height, transcodeType);
+        CHECK_AND_EXECUTE(ret != E_OK, AddTmpCompatibleDupToCache(fileId, srcInfo.data, size, transcodeType));
         SetMovingPhotoSize(size, resultSet);
         return ret;
     }
@@ -63,6 +63,7 @@
 #include "medialibrary_story_operations.h"
 #include "medialibrary_vision_operations.h"
 #include "medialibrary_location_operations.h"
+#include "search_index_progress_counter.h"
 #endif
 #include "medialibrary_album_operations.h"
 #include "medialibrary_app_uri_permission_operations.h"
@@ -97,6 +98,7 @@
 #include "photo_map_operations.h"
 #include "power_efficiency_manager.h"
 #include "preferences_helper.h"
+#include "preferences_write_back.h"
 #include "resource_type.h"
 #include "result_set_utils.h"
 #include "shooting_mode_column.h"
@@ -1074,6 +1076,7 @@ __attribute__((no_sanitize("cfi"))) void MediaLibraryDataManager::ClearMediaLibr
         watch->DoStop();
     }
     MediaLibraryUnistoreManager::GetInstance().Stop();
+    PreferencesWriteBack::GetInstance().Stop();
     extension_ = nullptr;
 
 #ifdef MEDIALIBRARY_SECURE_ALBUM_ENABLE
@@ -1848,7 +1851,16 @@ int32_t MediaLibraryDataManager::UpdateInternal(MediaLibraryCommand &cmd, Native
     // ModifyInfoByIdInDb can finish the default update of smartalbum and smartmap,
     // so no need to distinct them in switch-case deliberately
     cmd.SetValueBucket(value);
+#ifdef MEDIALIBRARY_FEATURE_ANALYSIS_DATA
+    std::vector<int32_t> fileIds = SearchIndexProgressCounter::GetInstance().QueryChangingFileIds(cmd);
+    int32_t ret = MediaLibraryObjectUtils::ModifyInfoByIdInDb(cmd);
+    if (ret >= 0) {
+        SearchIndexProgressCounter::GetInstance().UpdateFiles(fileIds);
+    }
+    return ret;
+#else
     return MediaLibraryObjectUtils::ModifyInfoByIdInDb(cmd);
+#endif
 }
 
 static void RestoreInvalidatedPos(AsyncTaskData *data)
@@ -3625,6 +3637,9 @@ int32_t MediaLibraryDataManager::BatchInsertMediaAnalysisData(MediaLibraryComman
             int32_t ret = rdbStore->BatchInsert(outRowId, cmd.GetTableName(), insertValues);
             bool cond = (ret != NativeRdb::E_OK || outRowId < 0);
             CHECK_AND_RETURN_RET_LOG(!cond, E_FAIL, "Batch insert media analysis values fail, err = %{public}d", ret);
+#ifdef MEDIALIBRARY_FEATURE_ANALYSIS_DATA
+            SearchIndexProgressCounter::GetInstance().UpdateFiles(cmd.GetTableName(), insertValues);
+#endif
             return outRowId;
         }
         default:
@@ -907,6 +907,7 @@ int32_t MediaLibraryObjectUtils::OpenFile(MediaLibraryCommand &cmd, const string
         TranscodeType transcodeType = TranscodeType::DEFAULT;
         SetTranscodeType(fileAsset, transcodeType);
         MediaLibraryTranscodeDataAgingOperation::DoTranscodeDfx(ACCESS_MEDIALIB, transcodeType);
+        MediaLibraryTranscodeDataAgingOperation::TouchTmpCompatibleDup(fileId);
     }
     if (mode.find(MEDIA_FILEMODE_WRITEONLY) != string::npos) {
         auto watch = MediaLibraryInotify::GetInstance();
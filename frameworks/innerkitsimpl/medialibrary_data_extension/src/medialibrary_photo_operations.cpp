@@ -17,6 +17,7 @@
 
 #include <grp.h>
 #include <regex>
+#include <unistd.h>
 #include <unordered_set>
 #include "album_plugin_base.h"
 #include "directory_ex.h"
@@ -100,6 +101,7 @@
 #include "medialibrary_rdb_helper.h"
 #include "medialibrary_rdb_operations.h"
 #include "medialibrary_unistore_manager.h"
+#include "media_app_uri_permission_column.h"
 
 using namespace OHOS::DataShare;
 using namespace std;
@@ -838,6 +840,7 @@ int32_t MediaLibraryPhotoOperations::Open(MediaLibraryCommand &cmd, const string
         TranscodeType transcodeType = TranscodeType::DEFAULT;
         SetTranscodeType(fileAsset, transcodeType);
         MediaLibraryTranscodeDataAgingOperation::DoTranscodeDfx(ACCESS_MEDIALIB, transcodeType);
+        MediaLibraryTranscodeDataAgingOperation::TouchTmpCompatibleDup(id);
     }
     return ret;
 }
@@ -1157,6 +1160,236 @@ int32_t MediaLibraryPhotoOperations::CreateV10(MediaLibraryCommand &cmd)
     return ret;
 }
 
+int32_t MediaLibraryPhotoOperations::PrepareBatchCreateAsset(MediaLibraryCommand &cmd, FileAsset &fileAsset,
+    string &extension)
+{
+    ValuesBucket &values = cmd.GetValueBucket();
+    CHECK_AND_RETURN_RET(MediaValuesBucketUtils::GetString(values, CONST_ASSET_EXTENTION, extension),
+        E_HAS_DB_ERROR);
+    int32_t mediaType = 0;
+    CHECK_AND_RETURN_RET(MediaValuesBucketUtils::GetInt(values, PhotoColumn::MEDIA_TYPE, mediaType), E_HAS_DB_ERROR);
+    string title;
+    string displayName;
+    bool isContains = false;
+    if (MediaValuesBucketUtils::GetString(values, PhotoColumn::MEDIA_TITLE, title)) {
+        displayName = title + "." + extension;
+        SetAssetDisplayName(displayName, fileAsset, isContains);
+    }
+    // the file is opened for write on creation, BatchCommit publishes it
+    fileAsset.SetTimePending(UNCLOSE_FILE_TIMEPENDING);
+    fileAsset.SetMimeType(MimeTypeUtils::GetMimeTypeFromExtension(extension));
+    int32_t fileSourceType = 0;
+    MediaValuesBucketUtils::GetInt(values, PhotoColumn::PHOTO_FILE_SOURCE_TYPE, fileSourceType);
+    SetFileAssetFromCmd(fileAsset, cmd, mediaType, fileSourceType);
+    return CheckWithType(isContains, displayName, extension, mediaType);
+}
+
+int32_t MediaLibraryPhotoOperations::InsertBatchCreateAssets(vector<unique_ptr<MediaLibraryCommand>> &cmds,
+    vector<FileAsset> &fileAssets, const vector<string> &extensions)
+{
+    int32_t imageNum = 0;
+    int32_t videoNum = 0;
+    for (const auto &fileAsset : fileAssets) {
+        if (fileAsset.GetMediaType() == MediaType::MEDIA_TYPE_VIDEO) {
+            videoNum++;
+        } else {
+            imageNum++;
+        }
+    }
+    // one update per media type reserves the unique ids of the whole batch
+    int32_t imageUniqueId = 0;
+    int32_t videoUniqueId = 0;
+    int32_t errCode = CreateAssetUniqueIds(MediaType::MEDIA_TYPE_IMAGE, imageNum, imageUniqueId);
+    CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "Reserve image unique ids failed, num: %{public}d", imageNum);
+    errCode = CreateAssetUniqueIds(MediaType::MEDIA_TYPE_VIDEO, videoNum, videoUniqueId);
+    CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "Reserve video unique ids failed, num: %{public}d", videoNum);
+    for (size_t i = 0; i < fileAssets.size(); i++) {
+        bool isVideo = fileAssets[i].GetMediaType() == MediaType::MEDIA_TYPE_VIDEO;
+        int32_t uniqueId = isVideo ? ++videoUniqueId : ++imageUniqueId;
+        string filePath;
+        errCode = CreateAssetPathById(uniqueId, fileAssets[i].GetMediaType(), extensions[i], filePath);
+        CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "Create Asset Path failed, errCode=%{public}d", errCode);
+        fileAssets[i].SetPath(filePath);
+        CHECK_AND_CONTINUE(fileAssets[i].GetDisplayName().empty());
+        // same display name as SetAssetPath gives an asset created without title
+        string fileName = MediaFileUtils::GetFileName(filePath);
+        fileAssets[i].SetDisplayName(fileName.substr(0, fileName.find('_')) + '_' +
+            fileName.substr(fileName.rfind('_') + 1));
+    }
+
+    std::shared_ptr<TransactionOperations> trans = make_shared<TransactionOperations>(__func__);
+    std::function<int(void)> func = [&]()->int {
+        for (size_t i = 0; i < fileAssets.size(); i++) {
+            int32_t outRow = InsertAssetInDb(trans, *cmds[i], fileAssets[i]);
+            CHECK_AND_RETURN_RET_LOG(outRow > 0, E_HAS_DB_ERROR, "insert file in db failed, error = %{public}d",
+                outRow);
+            fileAssets[i].SetId(outRow);
+        }
+        return E_OK;
+    };
+    errCode = trans->RetryTrans(func);
+    CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "BatchCreate: trans retry fail!, ret:%{public}d", errCode);
+    AuditLog auditLog = { true, "USER BEHAVIOR", "ADD", "io", static_cast<uint32_t>(fileAssets.size()), "running",
+        "ok" };
+    HiAudit::GetInstance().Write(auditLog);
+    return E_OK;
+}
+
+void MediaLibraryPhotoOperations::RemoveBatchCreateAssets(const vector<FileAsset> &fileAssets)
+{
+    vector<string> fileIds;
+    for (const auto &fileAsset : fileAssets) {
+        CHECK_AND_PRINT_LOG(MediaFileUtils::DeleteFile(fileAsset.GetPath()) || errno == ENOENT,
+            "Delete file failed, errno: %{public}d", errno);
+        fileIds.push_back(to_string(fileAsset.GetId()));
+    }
+    auto rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
+    CHECK_AND_RETURN_LOG(rdbStore != nullptr, "Failed to get rdbStore");
+    int32_t deletedRows = 0;
+    NativeRdb::AbsRdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
+    predicates.In(MediaColumn::MEDIA_ID, fileIds);
+    int32_t ret = rdbStore->Delete(deletedRows, predicates);
+    CHECK_AND_PRINT_LOG(ret == NativeRdb::E_OK, "Delete batch created assets failed, ret: %{public}d", ret);
+    NativeRdb::AbsRdbPredicates permissionPredicates(AppUriPermissionColumn::APP_URI_PERMISSION_TABLE);
+    permissionPredicates.In(AppUriPermissionColumn::FILE_ID, fileIds);
+    ret = rdbStore->Delete(deletedRows, permissionPredicates);
+    CHECK_AND_PRINT_LOG(ret == NativeRdb::E_OK, "Delete batch created permissions failed, ret: %{public}d", ret);
+}
+
+int32_t MediaLibraryPhotoOperations::BatchCreate(vector<unique_ptr<MediaLibraryCommand>> &cmds,
+    vector<BatchCreatedAsset> &createdAssets)
+{
+    MediaLibraryTracer tracer;
+    tracer.Start("MediaLibraryPhotoOperations::BatchCreate");
+    CHECK_AND_RETURN_RET_LOG(!cmds.empty(), E_INVALID_VALUES, "cmds is empty");
+    vector<FileAsset> fileAssets(cmds.size());
+    vector<string> extensions(cmds.size());
+    for (size_t i = 0; i < cmds.size(); i++) {
+        CHECK_AND_RETURN_RET_LOG(cmds[i] != nullptr, E_INVALID_VALUES, "cmd is nullptr, index: %{public}zu", i);
+        int32_t errCode = PrepareBatchCreateAsset(*cmds[i], fileAssets[i], extensions[i]);
+        CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "Invalid asset, index: %{public}zu", i);
+    }
+    int32_t errCode = InsertBatchCreateAssets(cmds, fileAssets, extensions);
+    CHECK_AND_RETURN_RET(errCode == E_OK, errCode);
+
+    // every file is created and opened here, the client writes through the fds without a call per asset
+    createdAssets.clear();
+    for (auto &fileAsset : fileAssets) {
+        BatchCreatedAsset createdAsset;
+        createdAsset.fileId = fileAsset.GetId();
+        createdAsset.uri = CreateExtUriForV10Asset(fileAsset);
+        errCode = MediaFileUtils::CreateAsset(fileAsset.GetPath());
+        if (errCode == E_OK) {
+            createdAsset.fd = OpenFileWithPrivacy(fileAsset.GetPath(), MEDIA_FILEMODE_WRITEONLY,
+                to_string(fileAsset.GetId()));
+        }
+        if (createdAsset.fd < 0) {
+            MEDIA_ERR_LOG("Create batch asset file failed, fileId: %{public}d, errCode: %{public}d, errno: %{public}d",
+                fileAsset.GetId(), errCode, errno);
+            for (const auto &openedAsset : createdAssets) {
+                close(openedAsset.fd);
+            }
+            createdAssets.clear();
+            RemoveBatchCreateAssets(fileAssets);
+            return E_HAS_FS_ERROR;
+        }
+        createdAssets.push_back(createdAsset);
+    }
+    MEDIA_INFO_LOG("BatchCreate num: %{public}zu", createdAssets.size());
+    return E_OK;
+}
+
+int32_t MediaLibraryPhotoOperations::BatchCommit(const vector<int32_t> &fileIds, const string &bundleName)
+{
+    MediaLibraryTracer tracer;
+    tracer.Start("MediaLibraryPhotoOperations::BatchCommit");
+    unordered_set<int32_t> idSet(fileIds.begin(), fileIds.end());
+    CHECK_AND_RETURN_RET_LOG(!fileIds.empty() && idSet.size() == fileIds.size(), E_INVALID_VALUES,
+        "fileIds are empty or duplicated");
+    vector<string> ids;
+    for (int32_t fileId : fileIds) {
+        ids.push_back(to_string(fileId));
+    }
+    // only the unpublished assets created by the caller may be committed
+    NativeRdb::AbsRdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
+    predicates.In(MediaColumn::MEDIA_ID, ids);
+    predicates.EqualTo(MediaColumn::MEDIA_TIME_PENDING, to_string(UNCLOSE_FILE_TIMEPENDING));
+    predicates.EqualTo(MediaColumn::MEDIA_OWNER_PACKAGE, bundleName);
+    vector<string> columns = { MediaColumn::MEDIA_ID, MediaColumn::MEDIA_FILE_PATH, MediaColumn::MEDIA_NAME };
+    vector<shared_ptr<FileAsset>> fileAssets;
+    int32_t errCode = GetFileAssetVectorFromDb(predicates, OperationObject::FILESYSTEM_PHOTO, fileAssets, columns);
+    CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "Query batch assets failed, errCode: %{public}d", errCode);
+    CHECK_AND_RETURN_RET_LOG(fileAssets.size() == fileIds.size(), E_INVALID_VALUES,
+        "Only %{public}zu of %{public}zu assets can be committed", fileAssets.size(), fileIds.size());
+
+    // all or nothing, a file left empty fails the whole batch before anything is published
+    vector<size_t> sizes;
+    for (const auto &fileAsset : fileAssets) {
+        size_t size = 0;
+        bool isValid = MediaFileUtils::GetFileSize(fileAsset->GetPath(), size) && size > 0;
+        CHECK_AND_RETURN_RET_LOG(isValid, E_INVALID_VALUES, "File of asset %{public}d is not written",
+            fileAsset->GetId());
+        sizes.push_back(size);
+    }
+
+    std::shared_ptr<TransactionOperations> trans = make_shared<TransactionOperations>(__func__);
+    AccurateRefresh::AssetAccurateRefresh assetRefresh(AccurateRefresh::BATCH_COMMIT_ASSETS_BUSSINESS_NAME, trans);
+    NativeRdb::AbsRdbPredicates publishPredicates(PhotoColumn::PHOTOS_TABLE);
+    publishPredicates.In(MediaColumn::MEDIA_ID, ids);
+    publishPredicates.EqualTo(MediaColumn::MEDIA_TIME_PENDING, to_string(UNCLOSE_FILE_TIMEPENDING));
+    int64_t dateModified = MediaFileUtils::UTCTimeMilliSeconds();
+    std::function<int(void)> func = [&]()->int {
+        for (size_t i = 0; i < fileAssets.size(); i++) {
+            ValuesBucket sizeValues;
+            sizeValues.PutLong(MediaColumn::MEDIA_SIZE, static_cast<int64_t>(sizes[i]));
+            NativeRdb::AbsRdbPredicates sizePredicates(PhotoColumn::PHOTOS_TABLE);
+            sizePredicates.EqualTo(MediaColumn::MEDIA_ID, to_string(fileAssets[i]->GetId()));
+            int32_t changedRows = 0;
+            int32_t ret = trans->Update(changedRows, sizeValues, sizePredicates);
+            CHECK_AND_RETURN_RET_LOG(ret == NativeRdb::E_OK && changedRows == 1, E_HAS_DB_ERROR,
+                "Update size failed, fileId: %{public}d, ret: %{public}d", fileAssets[i]->GetId(), ret);
+        }
+        // the assets turn visible together, so the refresh sees the batch as one change
+        ValuesBucket values;
+        values.PutLong(MediaColumn::MEDIA_TIME_PENDING, 0);
+        values.PutLong(MediaColumn::MEDIA_DATE_MODIFIED, dateModified);
+        int32_t changedRows = 0;
+        int32_t ret = assetRefresh.Update(changedRows, values, publishPredicates);
+        CHECK_AND_RETURN_RET_LOG(ret == AccurateRefresh::ACCURATE_REFRESH_RET_OK &&
+            changedRows == static_cast<int32_t>(fileAssets.size()), E_HAS_DB_ERROR,
+            "Publish batch assets failed, ret: %{public}d, changedRows: %{public}d", ret, changedRows);
+        return E_OK;
+    };
+    errCode = trans->RetryTrans(func);
+    CHECK_AND_RETURN_RET_LOG(errCode == E_OK, errCode, "BatchCommit: trans retry fail!, ret:%{public}d", errCode);
+    assetRefresh.RefreshAlbum(static_cast<NotifyAlbumType>(NotifyAlbumType::SYS_ALBUM | NotifyAlbumType::USER_ALBUM |
+        NotifyAlbumType::SOURCE_ALBUM));
+    assetRefresh.Notify();
+
+    auto watch = MediaLibraryNotify::GetInstance();
+    for (const auto &fileAsset : fileAssets) {
+        string uri = MediaFileUtils::GetUriByExtrConditions(PhotoColumn::PHOTO_URI_PREFIX,
+            to_string(fileAsset->GetId()), MediaFileUtils::GetExtraUri(fileAsset->GetDisplayName(),
+            fileAsset->GetPath()));
+        if (watch != nullptr) {
+            watch->Notify(uri, NotifyType::NOTIFY_ADD);
+        }
+        // metadata and thumbnails follow in the background, the album counts are already refreshed above
+        DefaultScanInfo scanInfo;
+        scanInfo.SetFilePath(fileAsset->GetPath());
+        scanInfo.SetFileId(fileAsset->GetId());
+        ScanConfig config = ScanConfigBuilder()
+            .SetNeedGenerateThumbnail(true)
+            .SetForceScan(true)
+            .SetSkipAlbumUpdate(true)
+            .SetDefaultScanInfo(scanInfo)
+            .Build();
+        MediaLibraryObjectUtils::ScanFileAsync(config);
+    }
+    MEDIA_INFO_LOG("BatchCommit num: %{public}zu", fileAssets.size());
+    return E_OK;
+}
+
 int32_t MediaLibraryPhotoOperations::DeletePhoto(const shared_ptr<FileAsset> &fileAsset, MediaLibraryApi api,
     shared_ptr<AccurateRefresh::AssetAccurateRefresh> assetRefresh)
 {
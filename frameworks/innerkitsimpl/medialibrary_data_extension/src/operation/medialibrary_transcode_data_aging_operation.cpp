@@ -89,6 +89,7 @@
 #include "media_file_manager_temp_file_aging_task.h"
 #include "media_edit_utils.h"
 #include "transcode_compatible_info_operations.h"
+#include "tmp_compatible_dup_cache.h"
 
 using namespace std;
 using namespace OHOS::NativeRdb;
@@ -154,6 +155,8 @@ void MediaLibraryTranscodeDataAgingOperation::DeleteTransCodeInfo(const std::str
     int32_t result = rdbStore->Update(updateCmd, rowId);
     CHECK_AND_RETURN_LOG(result == NativeRdb::E_OK && rowId > 0,
         "Update TransCodePhoto failed. Result %{public}d, in function %{public}s:", result, functionName.c_str());
+    CHECK_AND_EXECUTE(!MediaFileUtils::IsValidInteger(fileId),
+        TmpCompatibleDupCache::GetInstance().Remove(std::stoi(fileId)));
     MEDIA_INFO_LOG("Successfully delete transcode info, in function %{public}s:", functionName.c_str());
     return;
 }
@@ -361,9 +364,75 @@ int32_t MediaLibraryTranscodeDataAgingOperation::AgingTmpCompatibleDuplicate(int
         exist_compatible_duplicate = 0 where file_id =)" + std::to_string(fileId);
     result = rdbStore->ExecuteSql(updateSql);
     CHECK_AND_RETURN_RET_LOG(result == NativeRdb::E_OK, E_INNER_FAIL, "[HeifDup] Failed to update rdb");
+    TmpCompatibleDupCache::GetInstance().Remove(fileId);
     return result;
 }
 
+static TranscodeType GetTranscodeType(const std::string &mimeType, int32_t width, int32_t height)
+{
+    bool isHeif = (mimeType == "image/heic" || mimeType == "image/heif");
+    bool isHighPixel = IsHighPixelPicture(width, height);
+    if (isHeif) {
+        return isHighPixel ? TranscodeType::HIGH_PIXEL_HEIF : TranscodeType::HEIF;
+    }
+    return isHighPixel ? TranscodeType::HIGH_PIXEL : TranscodeType::DEFAULT;
+}
+
+static int32_t EvictTmpCompatibleDup(const TmpCompatibleDupInfo &info)
+{
+    auto dataAging = MediaLibraryTranscodeDataAgingOperation::GetInstance();
+    CHECK_AND_RETURN_RET_LOG(dataAging != nullptr, E_INNER_FAIL, "[HeifDup] dataAging is nullptr");
+    int32_t ret = dataAging->AgingTmpCompatibleDuplicate(info.fileId, info.path);
+    CHECK_AND_RETURN_RET(ret == E_OK, ret);
+    auto dfxManager = DfxManager::GetInstance();
+    CHECK_AND_EXECUTE(dfxManager == nullptr, dfxManager->HandleTranscodeCacheAccess(CACHE_EVICTED,
+        info.transcodeType));
+    return E_OK;
+}
+
+void MediaLibraryTranscodeDataAgingOperation::LoadTmpCompatibleDupCache()
+{
+    auto &cache = TmpCompatibleDupCache::GetInstance();
+    CHECK_AND_RETURN(!cache.IsLoaded());
+    auto rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
+    CHECK_AND_RETURN_LOG(rdbStore != nullptr, "[HeifDup] Failed to get rdbStore");
+
+    const std::string querySql = R"(SELECT file_id, data, trans_code_file_size, transcode_time, mime_type, width,
+        height FROM Photos WHERE exist_compatible_duplicate = 1 ORDER BY transcode_time DESC)";
+    auto resultSet = rdbStore->QuerySql(querySql);
+    CHECK_AND_RETURN_LOG(resultSet != nullptr, "[HeifDup] Query duplicates, resultSet is nullptr.");
+    std::vector<TmpCompatibleDupInfo> infos;
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        TmpCompatibleDupInfo info;
+        info.fileId = GetInt32Val(MediaColumn::MEDIA_ID, resultSet);
+        info.path = GetStringVal(MediaColumn::MEDIA_FILE_PATH, resultSet);
+        info.size = GetInt64Val(PhotoColumn::PHOTO_TRANS_CODE_FILE_SIZE, resultSet);
+        info.lastAccessTime = GetInt64Val(PhotoColumn::PHOTO_TRANSCODE_TIME, resultSet);
+        info.transcodeType = GetTranscodeType(GetStringVal(MediaColumn::MEDIA_MIME_TYPE, resultSet),
+            GetInt32Val(PhotoColumn::PHOTO_WIDTH, resultSet), GetInt32Val(PhotoColumn::PHOTO_HEIGHT, resultSet));
+        infos.push_back(std::move(info));
+    }
+    resultSet->Close();
+    cache.SetEvictor(EvictTmpCompatibleDup);
+    cache.Load(infos);
+}
+
+void MediaLibraryTranscodeDataAgingOperation::TouchTmpCompatibleDup(const std::string &fileId)
+{
+    CHECK_AND_RETURN(MediaFileUtils::IsValidInteger(fileId));
+    TmpCompatibleDupCache::GetInstance().Touch(std::stoi(fileId));
+}
+
+static int32_t RefreshTranscodeTime(const std::shared_ptr<MediaLibraryRdbStore> &rdbStore, int32_t fileId,
+    int64_t lastAccessTime)
+{
+    const std::string updateSql = "UPDATE Photos SET transcode_time = ? WHERE file_id = ?";
+    std::vector<NativeRdb::ValueObject> bindArgs = { lastAccessTime, fileId };
+    int32_t ret = rdbStore->ExecuteSql(updateSql, bindArgs);
+    CHECK_AND_RETURN_RET_LOG(ret == NativeRdb::E_OK, E_INNER_FAIL, "[HeifDup] Failed to refresh transcode time");
+    return E_OK;
+}
+
 static int32_t GetExistsDupSize(const std::shared_ptr<MediaLibraryRdbStore> &rdbStore,
     int32_t &totalCount, int64_t &totalSize)
 {
@@ -391,6 +460,7 @@ void MediaLibraryTranscodeDataAgingOperation::AgingTmpCompatibleDuplicatesThread
 
     auto rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
     CHECK_AND_RETURN_LOG(rdbStore != nullptr, "[HeifDup] Failed to get rdbStore");
+    LoadTmpCompatibleDupCache();
 
     // transcode_time < current_Time - 24 hours
     int64_t threshold = MediaFileUtils::UTCTimeMilliSeconds() - transcodeTimeThreshold;
@@ -412,6 +482,13 @@ void MediaLibraryTranscodeDataAgingOperation::AgingTmpCompatibleDuplicatesThread
 
         do {
             int32_t id = GetInt32Val(MediaColumn::MEDIA_ID, resultSet);
+            // a duplicate opened within the threshold is kept, its access time takes the place of the transcode time
+            int64_t lastAccessTime = TmpCompatibleDupCache::GetInstance().GetLastAccessTime(id);
+            if (lastAccessTime >= threshold) {
+                CHECK_AND_PRINT_LOG(RefreshTranscodeTime(rdbStore, id, lastAccessTime) == E_OK,
+                    "[HeifDup] Keep recently accessed duplicate failed, fileId: %{public}d", id);
+                continue;
+            }
             std::string path = GetStringVal(MediaColumn::MEDIA_FILE_PATH, resultSet);
             auto ret = AgingTmpCompatibleDuplicate(id, std::move(path));
             CHECK_AND_CONTINUE(ret == E_OK);
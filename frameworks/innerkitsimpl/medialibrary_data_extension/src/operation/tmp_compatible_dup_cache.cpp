@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "TmpCompatibleDupCache"
+
+#include "tmp_compatible_dup_cache.h"
+
+#include <cinttypes>
+#include <iterator>
+
+#include "media_file_utils.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+
+namespace OHOS {
+namespace Media {
+// transcode.jpg of a 12M pixel photo takes 3 to 5 MB, the budget keeps about a hundred of them
+static constexpr int64_t TMP_COMPATIBLE_DUP_BUDGET = 512 * 1024 * 1024;
+
+TmpCompatibleDupCache &TmpCompatibleDupCache::GetInstance()
+{
+    static TmpCompatibleDupCache instance(TMP_COMPATIBLE_DUP_BUDGET);
+    return instance;
+}
+
+TmpCompatibleDupCache::TmpCompatibleDupCache(int64_t budget) : budget_(budget) {}
+
+void TmpCompatibleDupCache::SetEvictor(Evictor evictor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    evictor_ = std::move(evictor);
+}
+
+TmpCompatibleDupResult TmpCompatibleDupCache::Create(int32_t fileId, const Creator &creator)
+{
+    std::shared_ptr<Flight> flight;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = flights_.find(fileId);
+        if (it != flights_.end()) {
+            flight = it->second;
+            flightCv_.wait(lock, [&flight] { return flight->isDone; });
+            TmpCompatibleDupResult result = flight->result;
+            // the duplicate is on disk and recorded by the first request
+            result.dupExist = result.ret == E_OK ? 1 : result.dupExist;
+            result.isCoalesced = true;
+            MEDIA_INFO_LOG("[HeifDup] Coalesced with the running transcoding, fileId: %{public}d, ret: %{public}d",
+                fileId, result.ret);
+            return result;
+        }
+        flight = std::make_shared<Flight>();
+        flights_.emplace(fileId, flight);
+    }
+
+    TmpCompatibleDupResult result;
+    creator(result);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flight->result = result;
+        flight->isDone = true;
+        flights_.erase(fileId);
+    }
+    flightCv_.notify_all();
+    return result;
+}
+
+void TmpCompatibleDupCache::InsertLocked(const TmpCompatibleDupInfo &info)
+{
+    RemoveLocked(info.fileId);
+    lru_.push_front(info.fileId);
+    entries_.emplace(info.fileId, Entry { info, lru_.begin() });
+    totalSize_ += info.size;
+}
+
+void TmpCompatibleDupCache::RemoveLocked(int32_t fileId)
+{
+    auto it = entries_.find(fileId);
+    CHECK_AND_RETURN(it != entries_.end());
+    totalSize_ -= it->second.info.size;
+    lru_.erase(it->second.lruIt);
+    entries_.erase(it);
+}
+
+std::vector<TmpCompatibleDupInfo> TmpCompatibleDupCache::CollectVictimsLocked(int32_t keepFileId)
+{
+    std::vector<TmpCompatibleDupInfo> victims;
+    while (totalSize_ > budget_ && !lru_.empty()) {
+        int32_t fileId = lru_.back();
+        // a single duplicate larger than the budget is still kept until the next one arrives
+        CHECK_AND_BREAK(fileId != keepFileId);
+        victims.push_back(entries_.at(fileId).info);
+        RemoveLocked(fileId);
+    }
+    return victims;
+}
+
+void TmpCompatibleDupCache::Evict(const std::vector<TmpCompatibleDupInfo> &victims)
+{
+    CHECK_AND_RETURN(!victims.empty());
+    Evictor evictor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        evictor = evictor_;
+    }
+    int64_t evictSize = 0;
+    for (const auto &info : victims) {
+        evictSize += info.size;
+        CHECK_AND_CONTINUE(evictor != nullptr);
+        int32_t ret = evictor(info);
+        CHECK_AND_PRINT_LOG(ret == E_OK, "[HeifDup] Evict failed, fileId: %{public}d, ret: %{public}d",
+            info.fileId, ret);
+    }
+    MEDIA_INFO_LOG("[HeifDup] Evicted num: %{public}zu, size: %{public}" PRId64 ", total: %{public}" PRId64,
+        victims.size(), evictSize, GetTotalSize());
+}
+
+void TmpCompatibleDupCache::Add(const TmpCompatibleDupInfo &info)
+{
+    std::vector<TmpCompatibleDupInfo> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        InsertLocked(info);
+        victims = CollectVictimsLocked(info.fileId);
+    }
+    Evict(victims);
+}
+
+void TmpCompatibleDupCache::Touch(int32_t fileId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(fileId);
+    CHECK_AND_RETURN(it != entries_.end());
+    it->second.info.lastAccessTime = MediaFileUtils::UTCTimeMilliSeconds();
+    lru_.splice(lru_.begin(), lru_, it->second.lruIt);
+}
+
+void TmpCompatibleDupCache::Remove(int32_t fileId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveLocked(fileId);
+}
+
+int64_t TmpCompatibleDupCache::GetLastAccessTime(int32_t fileId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(fileId);
+    return it == entries_.end() ? 0 : it->second.info.lastAccessTime;
+}
+
+int64_t TmpCompatibleDupCache::GetTotalSize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totalSize_;
+}
+
+size_t TmpCompatibleDupCache::GetCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void TmpCompatibleDupCache::Load(const std::vector<TmpCompatibleDupInfo> &infos)
+{
+    std::vector<TmpCompatibleDupInfo> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CHECK_AND_RETURN(!isLoaded_);
+        for (const auto &info : infos) {
+            // duplicates recorded since the start are newer than the ones left by the previous run
+            CHECK_AND_CONTINUE(entries_.count(info.fileId) == 0);
+            lru_.push_back(info.fileId);
+            entries_.emplace(info.fileId, Entry { info, std::prev(lru_.end()) });
+            totalSize_ += info.size;
+        }
+        isLoaded_ = true;
+        victims = CollectVictimsLocked(lru_.empty() ? 0 : lru_.front());
+    }
+    MEDIA_INFO_LOG("[HeifDup] Loaded num: %{public}zu, total: %{public}" PRId64, infos.size(), GetTotalSize());
+    Evict(victims);
+}
+
+bool TmpCompatibleDupCache::IsLoaded()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isLoaded_;
+}
+
+void TmpCompatibleDupCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    entries_.clear();
+    totalSize_ = 0;
+    isLoaded_ = false;
+}
+} // namespace Media
+} // namespace OHOS
@@ -17,10 +17,12 @@
 #include "background_cloud_file_processor_test.h"
 
 #include <chrono>
+#include <deque>
 #include <thread>
 
 #define private public
 #include "background_cloud_file_processor.h"
+#include "background_cloud_file_download_scheduler.h"
 #undef private
 
 #include "media_file_utils.h"
@@ -177,7 +179,7 @@ std::vector<std::string> QueryCurDownloadFiles()
     }
 
     BackgroundCloudFileProcessor::DownloadFiles downloadFiles;
-    BackgroundCloudFileProcessor::ParseDownloadFiles(resultSet, downloadFiles);
+    BackgroundCloudFileProcessor::ParseDownloadFiles(resultSet, downloadFiles, freeRatio);
     if (downloadFiles.uris.empty()) {
         MEDIA_INFO_LOG("No cloud files need to be downloaded");
         return curDownloadFiles;
@@ -185,6 +187,91 @@ std::vector<std::string> QueryCurDownloadFiles()
     return downloadFiles.uris;
 }
 
+// Local stand-in for the cloud download service: downloads the files of a batch one after another at a fixed
+// bandwidth and reports each of them once the simulated clock passes its finish time.
+class SimulatedDownloadService {
+public:
+    explicit SimulatedDownloadService(int64_t bytesPerSecond) : bytesPerSecond_(bytesPerSecond) {}
+
+    void Start(const vector<CloudDownloadCandidate> &batch, int64_t nowMs)
+    {
+        int64_t startMs = std::max(nowMs, busyUntilMs_);
+        for (const auto &candidate : batch) {
+            startMs += candidate.size * SEC_TO_MSEC / bytesPerSecond_;
+            CloudDownloadResult result = failResult_;
+            if (failNum_ > 0) {
+                failNum_--;
+            } else {
+                result = CloudDownloadResult::SUCCESS;
+            }
+            downloading_.push_back({ candidate.uri, startMs, result });
+        }
+        busyUntilMs_ = startMs;
+    }
+
+    void Advance(BackgroundCloudFileDownloadScheduler &scheduler, int64_t nowMs)
+    {
+        while (!downloading_.empty() && downloading_.front().finishMs <= nowMs) {
+            auto file = downloading_.front();
+            downloading_.pop_front();
+            scheduler.OnFileFinished(file.uri, file.result, file.finishMs);
+            if (file.result == CloudDownloadResult::SUCCESS) {
+                successNum_++;
+            }
+        }
+    }
+
+    void InjectFailures(int32_t failNum, CloudDownloadResult result)
+    {
+        failNum_ = failNum;
+        failResult_ = result;
+    }
+
+    int32_t GetSuccessNum() const
+    {
+        return successNum_;
+    }
+
+private:
+    struct DownloadingFile {
+        string uri;
+        int64_t finishMs;
+        CloudDownloadResult result;
+    };
+
+    int64_t bytesPerSecond_;
+    int64_t busyUntilMs_ = 0;
+    deque<DownloadingFile> downloading_;
+    int32_t failNum_ = 0;
+    CloudDownloadResult failResult_ = CloudDownloadResult::FAILED;
+    int32_t successNum_ = 0;
+};
+
+static vector<CloudDownloadCandidate> MakeCandidates(int32_t count, int64_t size, int64_t nowMs)
+{
+    vector<CloudDownloadCandidate> candidates;
+    for (int32_t index = 0; index < count; ++index) {
+        CloudDownloadCandidate candidate;
+        candidate.uri = "file://media/Photo/" + to_string(index + 1);
+        candidate.fileId = index + 1;
+        candidate.dateTaken = nowMs - index * SEC_TO_MSEC;
+        candidate.size = size;
+        candidates.push_back(candidate);
+    }
+    return candidates;
+}
+
+static void RunCycles(BackgroundCloudFileDownloadScheduler &scheduler, SimulatedDownloadService &service,
+    int32_t cycleNum, int64_t &nowMs, double freeRatio = 0.5)
+{
+    for (int32_t cycle = 0; cycle < cycleNum; ++cycle) {
+        service.Advance(scheduler, nowMs);
+        service.Start(scheduler.StartBatch(freeRatio, 1, nowMs), nowMs);
+        nowMs += DOWNLOAD_INTERVAL;
+    }
+    service.Advance(scheduler, nowMs);
+}
+
 void BackgroundCloudFileProcessorTest::SetUpTestCase()
 {
     MEDIA_INFO_LOG("BackgroundCloudFileProcessorTest SetUpTestCase");
@@ -492,5 +579,122 @@ HWTEST_F(BackgroundCloudFileProcessorTest, Bcfpt_OnDownloadProcessTest_NormalObj
     callBack->OnDownloadProcess(progress);
     MEDIA_INFO_LOG("Bcfpt_OnDownloadProcessTest_NormalObj End");
 }
+
+HWTEST_F(BackgroundCloudFileProcessorTest, Bcfpt_DownloadScheduler_FastAndSlowLink_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_FastAndSlowLink_Test_001 Start");
+    const int64_t fileSize = 2 * 1000 * 1000;
+    int64_t nowMs = 1000 * DOWNLOAD_INTERVAL;
+
+    // a fast link finishes every batch early, the batches grow to the limit of a request
+    BackgroundCloudFileDownloadScheduler fastScheduler(DOWNLOAD_INTERVAL);
+    SimulatedDownloadService fastService(10 * 1000 * 1000);
+    fastScheduler.AddCandidates(MakeCandidates(300, fileSize, nowMs), nowMs);
+    RunCycles(fastScheduler, fastService, 10, nowMs);
+    EXPECT_EQ(fastScheduler.GetBatchLimit(), 30);
+    EXPECT_GT(fastService.GetSuccessNum(), 100);
+    EXPECT_GT(fastScheduler.GetThroughput(), 0);
+
+    // a link slower than one file per cycle keeps single file batches and never piles up requests
+    BackgroundCloudFileDownloadScheduler slowScheduler(DOWNLOAD_INTERVAL);
+    SimulatedDownloadService slowService(20 * 1000);
+    slowScheduler.AddCandidates(MakeCandidates(50, fileSize, nowMs), nowMs);
+    RunCycles(slowScheduler, slowService, 20, nowMs);
+    EXPECT_EQ(slowScheduler.GetBatchLimit(), 1);
+    EXPECT_GE(slowService.GetSuccessNum(), 10);
+    EXPECT_EQ(slowScheduler.GetPendingCount() + slowService.GetSuccessNum() +
+        static_cast<size_t>(slowScheduler.IsBatchRunning()), 50);
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_FastAndSlowLink_Test_001 End");
+}
+
+HWTEST_F(BackgroundCloudFileProcessorTest, Bcfpt_DownloadScheduler_Failures_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_Failures_Test_001 Start");
+    const int64_t fileSize = 1000 * 1000;
+    int64_t nowMs = 1000 * DOWNLOAD_INTERVAL;
+    BackgroundCloudFileDownloadScheduler scheduler(DOWNLOAD_INTERVAL);
+    SimulatedDownloadService service(10 * 1000 * 1000);
+    scheduler.AddCandidates(MakeCandidates(500, fileSize, nowMs), nowMs);
+    RunCycles(scheduler, service, 6, nowMs);
+    int32_t limit = scheduler.GetBatchLimit();
+    ASSERT_GT(limit, 1);
+
+    // network failures halve the batch and keep the files queued
+    size_t pendingCount = scheduler.GetPendingCount();
+    service.InjectFailures(limit, CloudDownloadResult::NETWORK_UNAVAILABLE);
+    RunCycles(scheduler, service, 1, nowMs);
+    EXPECT_EQ(scheduler.GetBatchLimit(), limit / 2);
+    EXPECT_EQ(scheduler.GetPendingCount(), pendingCount);
+
+    // a full storage falls back to single files, no batch starts below the low free ratio
+    service.InjectFailures(1, CloudDownloadResult::STORAGE_FULL);
+    RunCycles(scheduler, service, 1, nowMs);
+    EXPECT_EQ(scheduler.GetBatchLimit(), 1);
+    EXPECT_TRUE(scheduler.StartBatch(DEVICE_STORAGE_FREE_RATIO_LOW / 2, 1, nowMs).empty());
+
+    // files failing on their own are dropped once they reach the failure limit
+    BackgroundCloudFileDownloadScheduler failScheduler(DOWNLOAD_INTERVAL);
+    SimulatedDownloadService failService(10 * 1000 * 1000);
+    failScheduler.AddCandidates(MakeCandidates(1, fileSize, nowMs), nowMs);
+    failService.InjectFailures(DOWNLOAD_FAIL_MAX_TIMES, CloudDownloadResult::FAILED);
+    RunCycles(failScheduler, failService, DOWNLOAD_FAIL_MAX_TIMES + 1, nowMs);
+    EXPECT_EQ(failScheduler.GetPendingCount(), 0);
+    EXPECT_EQ(failService.GetSuccessNum(), 0);
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_Failures_Test_001 End");
+}
+
+HWTEST_F(BackgroundCloudFileProcessorTest, Bcfpt_DownloadScheduler_ViewingValue_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_ViewingValue_Test_001 Start");
+    int64_t nowMs = 1000 * DOWNLOAD_INTERVAL;
+    int64_t dayMs = 24 * 60 * 60 * SEC_TO_MSEC;
+    vector<CloudDownloadCandidate> candidates = MakeCandidates(3, 1000, nowMs);
+    candidates[0].dateTaken = nowMs - 3 * dayMs;
+    candidates[1].dateTaken = nowMs - 14 * dayMs;
+    candidates[1].isFavorite = true;
+    candidates[2].dateTaken = nowMs;
+
+    BackgroundCloudFileDownloadScheduler scheduler(DOWNLOAD_INTERVAL);
+    scheduler.AddCandidates(candidates, nowMs);
+    scheduler.AddCandidates({ candidates[0] }, nowMs);
+    EXPECT_EQ(scheduler.GetPendingCount(), 3);
+    vector<CloudDownloadCandidate> batch = scheduler.StartBatch(0.5, 3, nowMs);
+    ASSERT_EQ(batch.size(), 3);
+    EXPECT_EQ(batch[0].fileId, candidates[1].fileId);
+    EXPECT_EQ(batch[1].fileId, candidates[2].fileId);
+    EXPECT_EQ(batch[2].fileId, candidates[0].fileId);
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_ViewingValue_Test_001 End");
+}
+HWTEST_F(BackgroundCloudFileProcessorTest, Bcfpt_DownloadScheduler_NoProgress_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_NoProgress_Test_001 Start");
+    int64_t nowMs = 1000 * DOWNLOAD_INTERVAL;
+    BackgroundCloudFileDownloadScheduler scheduler(DOWNLOAD_INTERVAL);
+    scheduler.AddCandidates(MakeCandidates(10, 1000, nowMs), nowMs);
+
+    // batches that download nothing never grow, a refused start does not count against the files
+    for (int32_t i = 0; i < DOWNLOAD_FAIL_MAX_TIMES + 1; i++) {
+        vector<CloudDownloadCandidate> batch = scheduler.StartBatch(0.5, 1, nowMs);
+        ASSERT_EQ(batch.size(), 1);
+        scheduler.OnFileFinished(batch[0].uri, CloudDownloadResult::START_FAILED, nowMs + 1);
+        EXPECT_EQ(scheduler.GetBatchLimit(), 1);
+        batch = scheduler.StartBatch(0.5, 1, nowMs);
+        ASSERT_EQ(batch.size(), 1);
+        scheduler.OnFileFinished(batch[0].uri, CloudDownloadResult::STOPPED, nowMs + 1);
+        EXPECT_EQ(scheduler.GetBatchLimit(), 1);
+        nowMs += DOWNLOAD_INTERVAL;
+    }
+    EXPECT_EQ(scheduler.GetPendingCount(), 10);
+
+    // a batch is only given up after the timeout cycles, the caller stops its download first
+    vector<CloudDownloadCandidate> batch = scheduler.StartBatch(0.5, 1, nowMs);
+    ASSERT_EQ(batch.size(), 1);
+    EXPECT_FALSE(scheduler.IsBatchTimedOut(nowMs + DOWNLOAD_INTERVAL));
+    EXPECT_TRUE(scheduler.IsBatchTimedOut(nowMs + 3 * DOWNLOAD_INTERVAL));
+    EXPECT_EQ(scheduler.StartBatch(0.5, 1, nowMs + 3 * DOWNLOAD_INTERVAL).size(), 1);
+    EXPECT_FALSE(scheduler.IsBatchTimedOut(nowMs + 3 * DOWNLOAD_INTERVAL));
+    EXPECT_EQ(scheduler.GetPendingCount(), 9);
+    MEDIA_INFO_LOG("Bcfpt_DownloadScheduler_NoProgress_Test_001 End");
+}
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -44,6 +44,9 @@
 #include "media_analysis_data_service.h"
 #include "analysis_net_connect_observer.h"
 #include "media_upgrade.h"
+#include "medialibrary_search_operations.h"
+#include "search_column.h"
+#include "search_index_progress_counter.h"
 
 namespace OHOS {
 namespace Media {
@@ -63,6 +66,8 @@ static void CleanTestTables()
         PhotoColumn::PHOTOS_TABLE,
         PhotoAlbumColumns::TABLE,
         ANALYSIS_ALBUM_TABLE,
+        SEARCH_TOTAL_TABLE,
+        VISION_TOTAL_TABLE,
     };
     for (auto &dropTable : dropTableList) {
         std::string dropSql = "DROP TABLE IF EXISTS " + dropTable + ";";
@@ -81,6 +86,8 @@ static void SetTables()
         PhotoUpgrade::CREATE_PHOTO_TABLE,
         PhotoAlbumColumns::CREATE_TABLE,
         CREATE_ANALYSIS_ALBUM_FOR_ONCREATE,
+        CREATE_SEARCH_TOTAL_TABLE,
+        CREATE_TAB_ANALYSIS_TOTAL_FOR_ONCREATE,
     };
     for (auto &createTableSql : createTableSqlList) {
         int32_t ret = g_rdbStore->ExecuteSql(createTableSql);
@@ -386,6 +393,65 @@ HWTEST_F(MediaAnalysisDataServiceTest, GetIndexConstructProgress_QueryFailed, Te
     MEDIA_INFO_LOG("end GetIndexConstructProgress_QueryFailed");
 }
 
+// 辅助函数：插入参与索引进度统计的文件
+static void InsertIndexProgressFile(int32_t fileId, int32_t mediaType, int32_t ocr)
+{
+    std::vector<std::string> insertSqls = {
+        "INSERT INTO " + PhotoColumn::PHOTOS_TABLE + " (" + MediaColumn::MEDIA_ID + ", " + MediaColumn::MEDIA_TYPE +
+            ", " + MediaColumn::MEDIA_DATE_TRASHED + ", " + MediaColumn::MEDIA_HIDDEN + ", " +
+            MediaColumn::MEDIA_TIME_PENDING + ", " + PhotoColumn::PHOTO_CLEAN_FLAG + ", " +
+            PhotoColumn::PHOTO_BURST_COVER_LEVEL + ") VALUES (" + std::to_string(fileId) + ", " +
+            std::to_string(mediaType) + ", 0, 0, 0, 0, 1)",
+        "INSERT INTO " + SEARCH_TOTAL_TABLE + " (" + TBL_SEARCH_FILE_ID + ", " + TBL_SEARCH_PHOTO_STATUS + ", " +
+            TBL_SEARCH_CV_STATUS + ", " + TBL_SEARCH_GEO_STATUS + ") VALUES (" + std::to_string(fileId) + ", 3, 1, 1)",
+        "INSERT INTO " + VISION_TOTAL_TABLE + " (" + FILE_ID + ", " + OCR + ", " + FACE + ", " + LABEL +
+            ") VALUES (" + std::to_string(fileId) + ", " + std::to_string(ocr) + ", 3, 1)",
+    };
+    for (const auto &insertSql : insertSqls) {
+        int32_t ret = g_rdbStore->ExecuteSql(insertSql);
+        if (ret != NativeRdb::E_OK) {
+            MEDIA_ERR_LOG("Execute sql %{public}s failed", insertSql.c_str());
+        }
+    }
+}
+
+// 用例说明：测试索引进度计数的增量更新
+// - 覆盖场景：计数首次读取时全量统计，此后按文件增量更新
+// - 触发条件：修改一个未完成图片的分析状态后按文件 id 更新计数
+// - 业务验证：计数与全量查询结果一致，进度接口返回计数值
+HWTEST_F(MediaAnalysisDataServiceTest, SearchIndexProgressCounter_UpdateFiles, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("start SearchIndexProgressCounter_UpdateFiles");
+    InsertIndexProgressFile(1, MEDIA_TYPE_IMAGE, 1);
+    InsertIndexProgressFile(2, MEDIA_TYPE_IMAGE, 0);
+    InsertIndexProgressFile(3, MEDIA_TYPE_VIDEO, 0);
+    auto &counter = SearchIndexProgressCounter::GetInstance();
+    counter.Reset();
+
+    IndexProgressCounts counts;
+    ASSERT_EQ(counter.GetCounts(counts), E_OK);
+    EXPECT_EQ(counts.photoCompleteNum, 1);
+    EXPECT_EQ(counts.photoTotalNum, 2);
+    EXPECT_EQ(counts.videoCompleteNum, 1);
+    EXPECT_EQ(counts.videoTotalNum, 1);
+
+    std::string updateSql = "UPDATE " + VISION_TOTAL_TABLE + " SET " + OCR + " = 1 WHERE " + FILE_ID + " = 2";
+    ASSERT_EQ(g_rdbStore->ExecuteSql(updateSql), NativeRdb::E_OK);
+    counter.UpdateFiles(std::vector<int32_t>{ 2 });
+    ASSERT_EQ(counter.GetCounts(counts), E_OK);
+    EXPECT_EQ(counts.photoCompleteNum, 2);
+    EXPECT_EQ(counts.photoTotalNum, 2);
+
+    auto resultSet = MediaLibrarySearchOperations::QueryIndexConstructProgress();
+    ASSERT_NE(resultSet, nullptr);
+    ASSERT_EQ(resultSet->GoToFirstRow(), NativeRdb::E_OK);
+    EXPECT_EQ(GetInt32Val(PHOTO_COMPLETE_NUM, resultSet), 2);
+    EXPECT_EQ(GetInt32Val(VIDEO_TOTAL_NUM, resultSet), 1);
+    resultSet->Close();
+    counter.Reset();
+    MEDIA_INFO_LOG("end SearchIndexProgressCounter_UpdateFiles");
+}
+
 // 用例说明：测试 SetOrderPosition 参数校验失败
 // - 覆盖场景：SetOrderPosition 函数中参数转换失败
 // - 覆盖分支点：value.IsEmpty() 分支 (235行)
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "MediaAssetsControllerServiceTest"
+
+#include "batch_create_assets_test.h"
+
+#include <cinttypes>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "media_assets_controller_service.h"
+
+#include "create_asset_vo.h"
+#include "media_empty_obj_vo.h"
+#include "user_define_ipc_client.h"
+#include "media_file_uri.h"
+#include "media_file_utils.h"
+#include "medialibrary_command.h"
+#include "medialibrary_photo_operations.h"
+#include "medialibrary_rdbstore.h"
+#include "medialibrary_unittest_utils.h"
+#include "medialibrary_unistore_manager.h"
+#include "media_upgrade.h"
+
+namespace OHOS::Media {
+using namespace std;
+using namespace testing::ext;
+using namespace OHOS::NativeRdb;
+
+static shared_ptr<MediaLibraryRdbStore> g_rdbStore;
+static constexpr int32_t SLEEP_SECONDS = 3;
+static constexpr int32_t BENCHMARK_ASSET_NUM = 100;
+static const string FILE_CONTENT = "batch create assets test content";
+
+static int32_t ClearTable(const string &table)
+{
+    RdbPredicates predicates(table);
+
+    int32_t rows = 0;
+    int32_t err = g_rdbStore->Delete(rows, predicates);
+    if (err != E_OK) {
+        MEDIA_ERR_LOG("Failed to clear table, err: %{public}d", err);
+        return E_HAS_DB_ERROR;
+    }
+    return E_OK;
+}
+
+static void SetTables()
+{
+    vector<string> createTableSqlList = {
+        Media::PhotoUpgrade::CREATE_PHOTO_TABLE,
+        Media::PhotoAlbumColumns::CREATE_TABLE,
+    };
+    for (auto &createTableSql : createTableSqlList) {
+        int32_t ret = g_rdbStore->ExecuteSql(createTableSql);
+        if (ret != NativeRdb::E_OK) {
+            MEDIA_ERR_LOG("Execute sql %{private}s failed", createTableSql.c_str());
+            return;
+        }
+    }
+}
+
+static int64_t GetTimePending(int32_t fileId)
+{
+    vector<string> columns = { MediaColumn::MEDIA_TIME_PENDING };
+    NativeRdb::RdbPredicates rdbPredicate(PhotoColumn::PHOTOS_TABLE);
+    rdbPredicate.EqualTo(MediaColumn::MEDIA_ID, fileId);
+    auto resultSet = MediaLibraryRdbStore::Query(rdbPredicate, columns);
+    if (resultSet == nullptr || resultSet->GoToFirstRow() != NativeRdb::E_OK) {
+        MEDIA_ERR_LOG("Query asset failed, fileId:%{public}d", fileId);
+        return INT64_MIN;
+    }
+    int64_t timePending = GetInt64Val(MediaColumn::MEDIA_TIME_PENDING, resultSet);
+    resultSet->Close();
+    return timePending;
+}
+
+void BatchCreateAssetsTest::SetUpTestCase(void)
+{
+    MediaLibraryUnitTestUtils::Init();
+    g_rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
+    if (g_rdbStore == nullptr) {
+        MEDIA_ERR_LOG("Start BatchCreateAssetsTest failed, can not get g_rdbStore");
+        exit(1);
+    }
+    SetTables();
+    ClearTable(PhotoColumn::PHOTOS_TABLE);
+    MEDIA_INFO_LOG("SetUpTestCase");
+}
+
+void BatchCreateAssetsTest::TearDownTestCase(void)
+{
+    ClearTable(PhotoColumn::PHOTOS_TABLE);
+    MEDIA_INFO_LOG("TearDownTestCase");
+    std::this_thread::sleep_for(std::chrono::seconds(SLEEP_SECONDS));
+}
+
+void BatchCreateAssetsTest::SetUp()
+{
+    MEDIA_INFO_LOG("SetUp");
+}
+
+void BatchCreateAssetsTest::TearDown(void)
+{
+    MEDIA_INFO_LOG("TearDown");
+}
+
+static int32_t BatchCreateAssets(const vector<string> &titles, BatchCreateAssetsRespBody &respBody)
+{
+    BatchCreateAssetsReqBody reqBody;
+    for (const auto &title : titles) {
+        CreateAssetReqBody asset;
+        asset.mediaType = MEDIA_TYPE_IMAGE;
+        asset.title = title;
+        asset.extension = "jpg";
+        reqBody.assets.push_back(asset);
+    }
+    MessageParcel data;
+    if (reqBody.Marshalling(data) != true) {
+        MEDIA_ERR_LOG("reqBody.Marshalling failed");
+        return -1;
+    }
+
+    MessageParcel reply;
+    auto service = make_shared<MediaAssetsControllerService>();
+    service->BatchCreateAssets(data, reply);
+
+    IPC::MediaRespVo<BatchCreateAssetsRespBody> respVo;
+    if (respVo.Unmarshalling(reply) != true) {
+        MEDIA_ERR_LOG("respVo.Unmarshalling failed");
+        return -1;
+    }
+    respBody = respVo.GetBody();
+    return respVo.GetErrCode();
+}
+
+static int32_t BatchCommitAssets(const vector<int32_t> &fileIds)
+{
+    BatchCommitAssetsReqBody reqBody;
+    reqBody.fileIds = fileIds;
+    MessageParcel data;
+    if (reqBody.Marshalling(data) != true) {
+        MEDIA_ERR_LOG("reqBody.Marshalling failed");
+        return -1;
+    }
+
+    MessageParcel reply;
+    auto service = make_shared<MediaAssetsControllerService>();
+    service->BatchCommitAssets(data, reply);
+
+    IPC::MediaRespVo<MediaEmptyObjVo> respVo;
+    if (respVo.Unmarshalling(reply) != true) {
+        MEDIA_ERR_LOG("respVo.Unmarshalling failed");
+        return -1;
+    }
+    return respVo.GetErrCode();
+}
+
+static bool WriteAndClose(int32_t fd)
+{
+    ssize_t written = write(fd, FILE_CONTENT.c_str(), FILE_CONTENT.size());
+    close(fd);
+    return written == static_cast<ssize_t>(FILE_CONTENT.size());
+}
+
+static int32_t CreateByAsset(int32_t index)
+{
+    MediaLibraryCommand cmd(OperationObject::FILESYSTEM_PHOTO, OperationType::CREATE, MediaLibraryApi::API_10);
+    ValuesBucket values;
+    values.PutString(CONST_ASSET_EXTENTION, "jpg");
+    values.PutString(MediaColumn::MEDIA_TITLE, "single_" + to_string(index));
+    values.PutInt(MediaColumn::MEDIA_TYPE, MediaType::MEDIA_TYPE_IMAGE);
+    values.PutInt(PhotoColumn::PHOTO_SUBTYPE, static_cast<int32_t>(PhotoSubType::DEFAULT));
+    cmd.SetValueBucket(values);
+    cmd.SetBundleName("test_bundle_name");
+    int32_t fileId = MediaLibraryPhotoOperations::Create(cmd);
+    CHECK_AND_RETURN_RET(fileId > 0, fileId);
+
+    string uri = MediaFileUri(MediaType::MEDIA_TYPE_IMAGE, to_string(fileId), "", MEDIA_API_VERSION_V10).ToString();
+    Uri openUri(uri);
+    MediaLibraryCommand openCmd(openUri, OperationType::OPEN);
+    int32_t fd = MediaLibraryPhotoOperations::Open(openCmd, "w");
+    CHECK_AND_RETURN_RET(fd >= 0, fd);
+    CHECK_AND_RETURN_RET(WriteAndClose(fd), E_ERR);
+
+    MediaLibraryCommand closeCmd(OperationObject::FILESYSTEM_PHOTO, OperationType::CLOSE);
+    ValuesBucket closeValues;
+    closeValues.PutString(CONST_MEDIA_DATA_DB_URI, uri);
+    closeCmd.SetValueBucket(closeValues);
+    return MediaLibraryPhotoOperations::Close(closeCmd);
+}
+
+HWTEST_F(BatchCreateAssetsTest, BatchCreateAssets_Test_001, TestSize.Level0)
+{
+    MEDIA_INFO_LOG("Start BatchCreateAssets_Test_001");
+    BatchCreateAssetsRespBody respBody;
+    EXPECT_NE(BatchCreateAssets({}, respBody), E_OK);
+    EXPECT_NE(BatchCommitAssets({}), E_OK);
+
+    BatchCreateAssetsReqBody reqBody;
+    CreateAssetReqBody asset;
+    asset.mediaType = MEDIA_TYPE_IMAGE;
+    asset.extension = "xxx";
+    reqBody.assets.push_back(asset);
+    MessageParcel data;
+    ASSERT_TRUE(reqBody.Marshalling(data));
+    MessageParcel reply;
+    auto service = make_shared<MediaAssetsControllerService>();
+    service->BatchCreateAssets(data, reply);
+    IPC::MediaRespVo<BatchCreateAssetsRespBody> respVo;
+    ASSERT_TRUE(respVo.Unmarshalling(reply));
+    EXPECT_NE(respVo.GetErrCode(), E_OK);
+}
+
+HWTEST_F(BatchCreateAssetsTest, BatchCreateAssets_Test_002, TestSize.Level0)
+{
+    MEDIA_INFO_LOG("Start BatchCreateAssets_Test_002");
+    BatchCreateAssetsRespBody respBody;
+    ASSERT_EQ(BatchCreateAssets({"batch_001", "batch_002", ""}, respBody), E_OK);
+    ASSERT_EQ(respBody.assets.size(), 3);
+    ASSERT_EQ(respBody.fds.size(), 3);
+
+    vector<int32_t> fileIds;
+    for (size_t i = 0; i < respBody.assets.size(); i++) {
+        EXPECT_GT(respBody.assets[i].fileId, 0);
+        EXPECT_FALSE(respBody.assets[i].outUri.empty());
+        EXPECT_EQ(GetTimePending(respBody.assets[i].fileId), UNCLOSE_FILE_TIMEPENDING);
+        EXPECT_TRUE(WriteAndClose(respBody.fds[i]));
+        fileIds.push_back(respBody.assets[i].fileId);
+    }
+
+    EXPECT_EQ(BatchCommitAssets(fileIds), E_OK);
+    for (int32_t fileId : fileIds) {
+        EXPECT_EQ(GetTimePending(fileId), 0);
+    }
+    // a committed batch cannot be committed again
+    EXPECT_NE(BatchCommitAssets(fileIds), E_OK);
+}
+
+HWTEST_F(BatchCreateAssetsTest, BatchCommitAssets_Test_001, TestSize.Level0)
+{
+    MEDIA_INFO_LOG("Start BatchCommitAssets_Test_001");
+    BatchCreateAssetsRespBody respBody;
+    ASSERT_EQ(BatchCreateAssets({"unwritten_001", "unwritten_002"}, respBody), E_OK);
+    ASSERT_EQ(respBody.fds.size(), 2);
+    EXPECT_TRUE(WriteAndClose(respBody.fds[0]));
+    close(respBody.fds[1]);
+
+    vector<int32_t> fileIds = { respBody.assets[0].fileId, respBody.assets[1].fileId };
+    // the empty file fails the whole batch
+    EXPECT_NE(BatchCommitAssets(fileIds), E_OK);
+    EXPECT_EQ(GetTimePending(fileIds[0]), UNCLOSE_FILE_TIMEPENDING);
+    EXPECT_EQ(GetTimePending(fileIds[1]), UNCLOSE_FILE_TIMEPENDING);
+
+    EXPECT_NE(BatchCommitAssets({ fileIds[0], fileIds[0] }), E_OK);
+    EXPECT_NE(BatchCommitAssets({ fileIds[0], INT32_MAX }), E_OK);
+    EXPECT_EQ(GetTimePending(fileIds[0]), UNCLOSE_FILE_TIMEPENDING);
+}
+
+HWTEST_F(BatchCreateAssetsTest, BatchCreateAssets_Benchmark_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("Start BatchCreateAssets_Benchmark_001");
+    int64_t start = MediaFileUtils::UTCTimeMilliSeconds();
+    for (int32_t i = 0; i < BENCHMARK_ASSET_NUM; i++) {
+        ASSERT_EQ(CreateByAsset(i), E_OK);
+    }
+    int64_t singleCost = MediaFileUtils::UTCTimeMilliSeconds() - start;
+
+    vector<string> titles;
+    for (int32_t i = 0; i < BENCHMARK_ASSET_NUM; i++) {
+        titles.push_back("batch_" + to_string(i));
+    }
+    start = MediaFileUtils::UTCTimeMilliSeconds();
+    BatchCreateAssetsRespBody respBody;
+    ASSERT_EQ(BatchCreateAssets(titles, respBody), E_OK);
+    ASSERT_EQ(respBody.fds.size(), BENCHMARK_ASSET_NUM);
+    vector<int32_t> fileIds;
+    for (size_t i = 0; i < respBody.fds.size(); i++) {
+        ASSERT_TRUE(WriteAndClose(respBody.fds[i]));
+        fileIds.push_back(respBody.assets[i].fileId);
+    }
+    ASSERT_EQ(BatchCommitAssets(fileIds), E_OK);
+    int64_t batchCost = MediaFileUtils::UTCTimeMilliSeconds() - start;
+    MEDIA_INFO_LOG("Create %{public}d assets, per asset: %{public}" PRId64 "ms, batch: %{public}" PRId64 "ms",
+        BENCHMARK_ASSET_NUM, singleCost, batchCost);
+}
+} // namespace OHOS::Media
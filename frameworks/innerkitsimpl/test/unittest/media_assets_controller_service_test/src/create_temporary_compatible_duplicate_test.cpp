@@ -30,6 +30,10 @@
 #include "result_set_utils.h"
 #include "medialibrary_transcode_data_aging_operation.h"
 #include "media_upgrade.h"
+#include "tmp_compatible_dup_cache.h"
+
+#include <atomic>
+#include <thread>
 
 namespace OHOS::Media {
 using namespace testing::ext;
@@ -37,6 +41,9 @@ using namespace OHOS::NativeRdb;
 namespace {
 static std::shared_ptr<MediaLibraryRdbStore> g_rdbStore;
 static constexpr int32_t SLEEP_SECONDS = 1;
+static constexpr int64_t DUP_SIZE = 100;
+static constexpr int32_t CREATE_THREAD_NUM = 8;
+static constexpr int32_t CREATE_COST_MS = 100;
 } // namespace
 
 static void ClearPhotosTables()
@@ -231,4 +238,103 @@ HWTEST_F(CreateTemporaryCompatibleDuplicateTest, AgingTmpCompatibleDup_Test_001,
     dataAging->InterruptAgingTmpCompatibleDuplicates();
     ASSERT_GT(fileId, 0);
 }
-} // namespace OHOS::Media
\ No newline at end of file
+
+static TmpCompatibleDupInfo BuildDupInfo(int32_t fileId)
+{
+    TmpCompatibleDupInfo info;
+    info.fileId = fileId;
+    info.path = "/storage/cloud/files/Photo/666/" + std::to_string(fileId) + ".heic";
+    info.size = DUP_SIZE;
+    info.transcodeType = TranscodeType::HEIF;
+    return info;
+}
+
+HWTEST_F(CreateTemporaryCompatibleDuplicateTest, TmpCompatibleDupCache_EvictLeastRecentlyAccessed, TestSize.Level0)
+{
+    TmpCompatibleDupCache cache(DUP_SIZE * 3);
+    std::vector<int32_t> evictedIds;
+    cache.SetEvictor([&evictedIds](const TmpCompatibleDupInfo &info) {
+        evictedIds.push_back(info.fileId);
+        return E_OK;
+    });
+    cache.Add(BuildDupInfo(1));
+    cache.Add(BuildDupInfo(2));
+    cache.Add(BuildDupInfo(3));
+    cache.Touch(1);
+    cache.Add(BuildDupInfo(4));
+    ASSERT_EQ(evictedIds, std::vector<int32_t>({ 2 }));
+    EXPECT_EQ(cache.GetCount(), 3);
+    EXPECT_EQ(cache.GetTotalSize(), DUP_SIZE * 3);
+    EXPECT_GT(cache.GetLastAccessTime(1), 0);
+    EXPECT_EQ(cache.GetLastAccessTime(2), 0);
+
+    cache.Remove(3);
+    cache.Add(BuildDupInfo(5));
+    cache.Add(BuildDupInfo(6));
+    EXPECT_EQ(evictedIds, std::vector<int32_t>({ 2, 1 }));
+    EXPECT_EQ(cache.GetTotalSize(), DUP_SIZE * 3);
+}
+
+HWTEST_F(CreateTemporaryCompatibleDuplicateTest, TmpCompatibleDupCache_LoadKeepsNewest, TestSize.Level0)
+{
+    TmpCompatibleDupCache cache(DUP_SIZE * 2);
+    std::vector<int32_t> evictedIds;
+    cache.SetEvictor([&evictedIds](const TmpCompatibleDupInfo &info) {
+        evictedIds.push_back(info.fileId);
+        return E_OK;
+    });
+    cache.Add(BuildDupInfo(1));
+    cache.Load({ BuildDupInfo(1), BuildDupInfo(2), BuildDupInfo(3) });
+    EXPECT_TRUE(cache.IsLoaded());
+    EXPECT_EQ(evictedIds, std::vector<int32_t>({ 3 }));
+    EXPECT_EQ(cache.GetCount(), 2);
+    cache.Load({ BuildDupInfo(4) });
+    EXPECT_EQ(cache.GetCount(), 2);
+}
+
+HWTEST_F(CreateTemporaryCompatibleDuplicateTest, TmpCompatibleDupCache_CoalesceConcurrentCreate, TestSize.Level0)
+{
+    TmpCompatibleDupCache cache(DUP_SIZE * 3);
+    std::atomic<int32_t> createCount = 0;
+    std::atomic<int32_t> coalescedCount = 0;
+    std::atomic<int32_t> successCount = 0;
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < CREATE_THREAD_NUM; i++) {
+        threads.emplace_back([&]() {
+            auto result = cache.Create(1, [&](TmpCompatibleDupResult &result) {
+                createCount++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(CREATE_COST_MS));
+                result.ret = E_OK;
+                result.size = DUP_SIZE;
+                result.transcodeType = TranscodeType::HEIF;
+                cache.Add(BuildDupInfo(1));
+            });
+            CHECK_AND_EXECUTE(result.ret != E_OK, successCount++);
+            if (result.isCoalesced) {
+                coalescedCount++;
+                EXPECT_EQ(result.dupExist, 1);
+                EXPECT_EQ(result.transcodeType, TranscodeType::HEIF);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(successCount.load(), CREATE_THREAD_NUM);
+    EXPECT_EQ(createCount.load() + coalescedCount.load(), CREATE_THREAD_NUM);
+    EXPECT_GE(coalescedCount.load(), 1);
+    EXPECT_EQ(cache.GetCount(), 1);
+
+    // a failed creation is not cached, the next request runs the creator again
+    auto result = cache.Create(2, [](TmpCompatibleDupResult &result) { result.ret = E_INNER_FAIL; });
+    EXPECT_EQ(result.ret, E_INNER_FAIL);
+    int32_t retryCount = 0;
+    result = cache.Create(2, [&retryCount](TmpCompatibleDupResult &result) {
+        retryCount++;
+        result.ret = E_OK;
+    });
+    EXPECT_EQ(result.ret, E_OK);
+    EXPECT_EQ(retryCount, 1);
+    EXPECT_FALSE(result.isCoalesced);
+}
+} // namespace OHOS::Media
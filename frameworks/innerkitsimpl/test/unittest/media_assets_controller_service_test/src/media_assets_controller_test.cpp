@@ -26,6 +26,7 @@
 #undef private
 #undef protected
 
+#include "dfx_ipc_statistic.h"
 #include "user_define_ipc_client.h"
 #include "medialibrary_rdbstore.h"
 #include "medialibrary_unittest_utils.h"
@@ -40,6 +41,7 @@ using namespace OHOS::NativeRdb;
 
 static shared_ptr<MediaLibraryRdbStore> g_rdbStore;
 static constexpr int32_t SLEEP_SECONDS = 1;
+static constexpr size_t SINGLE_ASSET_MAX_REQUEST_BYTES = 64 * 1024;
 
 static int32_t ClearTable(const string &table)
 {
@@ -156,4 +158,68 @@ HWTEST_F(MediaAssetsControllerTest, OnRemoteRequest_Test_003, TestSize.Level0)
 
     MEDIA_INFO_LOG("OnRemoteRequest_Test_003 end");
 }
+
+HWTEST_F(MediaAssetsControllerTest, DispatchTable_Test_001, TestSize.Level0)
+{
+    MEDIA_INFO_LOG("DispatchTable_Test_001 enter");
+
+    auto controller = make_shared<MediaAssetsControllerService>();
+    EXPECT_TRUE(controller->Accept(static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_GET_ASSETS)));
+    EXPECT_TRUE(controller->Accept(static_cast<uint32_t>(MediaLibraryBusinessCode::SET_PHOTO_CRITICAL)));
+    EXPECT_FALSE(controller->Accept(static_cast<uint32_t>(MediaLibraryBusinessCode::ASSETS_BUSINESS_CODE_END)));
+    EXPECT_FALSE(controller->Accept(static_cast<uint32_t>(MediaLibraryBusinessCode::CAMERA_BUSINESS_CODE_END) + 1));
+    // the policy cached in the dispatch table matches the permission policy tables for every code
+    uint32_t end = static_cast<uint32_t>(MediaLibraryBusinessCode::CAMERA_BUSINESS_CODE_END);
+    for (uint32_t code = 0; code <= end; ++code) {
+        vector<vector<PermissionType>> expectedPolicy;
+        bool expectedBypass = false;
+        int32_t expectedRet = MediaAssetsControllerService::LookupPermissionPolicy(code, expectedPolicy,
+            expectedBypass);
+        vector<vector<PermissionType>> policy;
+        bool isBypass = false;
+        int32_t ret = controller->GetPermissionPolicy(code, policy, isBypass);
+        ASSERT_EQ(ret, expectedRet);
+        ASSERT_EQ(policy, expectedPolicy);
+        ASSERT_EQ(isBypass, expectedBypass);
+        if (controller->Accept(code)) {
+            ASSERT_EQ(ret, E_SUCCESS);
+        }
+    }
+
+    MEDIA_INFO_LOG("DispatchTable_Test_001 end");
+}
+
+HWTEST_F(MediaAssetsControllerTest, DispatchTable_Test_002, TestSize.Level0)
+{
+    MEDIA_INFO_LOG("DispatchTable_Test_002 enter");
+
+    auto controller = make_shared<MediaAssetsControllerService>();
+    uint32_t code = static_cast<uint32_t>(MediaLibraryBusinessCode::SET_CAMERA_SHOT_KEY);
+    auto histogram = DfxIpcStatistic::GetInstance().GetHistogram(code);
+    IpcCodeStatistic before = histogram->Snapshot(false);
+
+    // above the single asset limit, rejected before the handler decodes it
+    MessageParcel data;
+    string body(SINGLE_ASSET_MAX_REQUEST_BYTES + 1, 'a');
+    data.WriteBuffer(body.data(), body.size());
+    MessageParcel reply;
+    MessageOption option;
+    IPC::IPCContext context(option, E_SUCCESS);
+    controller->OnRemoteRequest(code, data, reply, context);
+    IPC::MediaRespVo<IPC::MediaEmptyObjVo> respVo;
+    ASSERT_EQ(respVo.Unmarshalling(reply), true);
+    EXPECT_EQ(respVo.GetErrCode(), E_IPC_INVAL_ARG);
+
+    MessageParcel smallData;
+    smallData.WriteInt32(INT32_MIN);
+    MessageParcel smallReply;
+    controller->OnRemoteRequest(code, smallData, smallReply, context);
+
+    IpcCodeStatistic after = histogram->Snapshot(false);
+    EXPECT_EQ(after.rejectCount, before.rejectCount + 1);
+    EXPECT_EQ(after.count, before.count + 1);
+    EXPECT_GT(after.totalPayloadBytes, before.totalPayloadBytes);
+
+    MEDIA_INFO_LOG("DispatchTable_Test_002 end");
+}
 }  // namespace OHOS::Media
\ No newline at end of file
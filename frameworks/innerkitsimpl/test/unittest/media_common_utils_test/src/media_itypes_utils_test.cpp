@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "media_itypes_utils_test.h"
+
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ashmem.h"
+#include "media_bulk_transport.h"
+#include "media_itypes_utils.h"
+
+namespace OHOS {
+namespace Media {
+using namespace testing::ext;
+using namespace OHOS::Media::IPC;
+
+static const int32_t BULK_MODE_INLINE = 0;
+static const int32_t BULK_MODE_ASHMEM = 1;
+// above the inline threshold of MediaBulkTransport
+static const size_t LARGE_STR_SIZE = 64 * 1024;
+
+// writes a hand-made inline payload: the slots followed by the chars
+static void WriteInlinePayload(const std::vector<uint64_t> &slots, const std::string &chars, MessageParcel &parcel)
+{
+    std::vector<uint8_t> bytes(slots.size() * sizeof(uint64_t) + chars.size());
+    if (!slots.empty()) {
+        (void)memcpy(bytes.data(), slots.data(), slots.size() * sizeof(uint64_t));
+    }
+    if (!chars.empty()) {
+        (void)memcpy(bytes.data() + slots.size() * sizeof(uint64_t), chars.data(), chars.size());
+    }
+    parcel.WriteUint32(static_cast<uint32_t>(bytes.size()));
+    parcel.WriteInt32(BULK_MODE_INLINE);
+    parcel.WriteRawData(bytes.data(), bytes.size());
+}
+
+void MediaITypesUtilsUnitTest::SetUpTestCase(void) {}
+
+void MediaITypesUtilsUnitTest::TearDownTestCase(void) {}
+
+// SetUp:Execute before each test case
+void MediaITypesUtilsUnitTest::SetUp() {}
+
+void MediaITypesUtilsUnitTest::TearDown(void) {}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_str_vec_round_trip_test_001, TestSize.Level1)
+{
+    std::vector<std::string> input = { "1", "", "/storage/cloud/files/Photo/1/IMG_001.jpg" };
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypeMediaUtil::MarshalStrVec(input, parcel));
+    std::vector<std::string> output;
+    ASSERT_TRUE(ITypeMediaUtil::UnmarshalStrVec(output, parcel));
+    EXPECT_EQ(output, input);
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_str_vec_round_trip_test_002, TestSize.Level1)
+{
+    std::vector<std::string> input = { std::string(LARGE_STR_SIZE, 'a'), "b" };
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypeMediaUtil::MarshalStrVec(input, parcel));
+    ITypeMediaUtil::StrVecView view;
+    ASSERT_TRUE(ITypeMediaUtil::UnmarshalStrVec(view, parcel));
+    ASSERT_EQ(view.Size(), input.size());
+    EXPECT_EQ(view.At(0), input[0]);
+    EXPECT_EQ(view.At(1), input[1]);
+    EXPECT_TRUE(view.At(2).empty());
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_map_vec_round_trip_test_001, TestSize.Level1)
+{
+    std::vector<std::unordered_map<std::string, std::string>> input = {
+        { { "file_id", "1" }, { "data", "/storage/cloud/files/Photo/1/IMG_001.jpg" } },
+        {},
+        { { "file_id", std::string(LARGE_STR_SIZE, '2') } },
+    };
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypeMediaUtil::MarshalMapVec(input, parcel));
+    std::vector<std::unordered_map<std::string, std::string>> output;
+    ASSERT_TRUE(ITypeMediaUtil::UnmarshalMapVec(output, parcel));
+    EXPECT_EQ(output, input);
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_int32_vec_round_trip_test_001, TestSize.Level1)
+{
+    std::vector<int32_t> input = { 1, -1, 0, INT32_MAX };
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypeMediaUtil::MarshalInt32Vec(input, parcel));
+    std::vector<int32_t> output;
+    ASSERT_TRUE(ITypeMediaUtil::UnmarshalInt32Vec(output, parcel));
+    EXPECT_EQ(output, input);
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_str_vec_malformed_test_001, TestSize.Level1)
+{
+    // count claims more offsets than the payload holds
+    MessageParcel countParcel;
+    WriteInlinePayload({ 100, 0, 1 }, "a", countParcel);
+    std::vector<std::string> output;
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, countParcel));
+
+    // offsets go backwards
+    MessageParcel orderParcel;
+    WriteInlinePayload({ 2, 0, 2, 1 }, "ab", orderParcel);
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, orderParcel));
+
+    // last offset points past the chars
+    MessageParcel rangeParcel;
+    WriteInlinePayload({ 1, 0, 8 }, "ab", rangeParcel);
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, rangeParcel));
+
+    // shorter than the count slot and the first offset
+    MessageParcel shortParcel;
+    WriteInlinePayload({ 0 }, "", shortParcel);
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, shortParcel));
+    EXPECT_TRUE(output.empty());
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_str_vec_malformed_test_002, TestSize.Level1)
+{
+    // the size announces more raw data than the parcel carries
+    MessageParcel truncatedParcel;
+    truncatedParcel.WriteUint32(1024);
+    truncatedParcel.WriteInt32(BULK_MODE_INLINE);
+    uint64_t count = 0;
+    truncatedParcel.WriteRawData(&count, sizeof(count));
+    std::vector<std::string> output;
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, truncatedParcel));
+
+    MessageParcel modeParcel;
+    modeParcel.WriteUint32(sizeof(count));
+    modeParcel.WriteInt32(-1);
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, modeParcel));
+
+    MessageParcel emptyParcel;
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalStrVec(output, emptyParcel));
+    EXPECT_TRUE(output.empty());
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_map_vec_malformed_test_001, TestSize.Level1)
+{
+    // one row holding one entry, but the column only has a key
+    MessageParcel columnParcel;
+    WriteInlinePayload({ 1, 0, 1, 1, 0, 1 }, "k", columnParcel);
+    std::vector<std::unordered_map<std::string, std::string>> output;
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalMapVec(output, columnParcel));
+
+    // row starts go backwards
+    MessageParcel orderParcel;
+    WriteInlinePayload({ 2, 0, 3, 2, 4, 0, 1, 2, 3, 4 }, "abcd", orderParcel);
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalMapVec(output, orderParcel));
+
+    // row count larger than the payload
+    MessageParcel countParcel;
+    WriteInlinePayload({ 64, 0 }, "", countParcel);
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalMapVec(output, countParcel));
+    EXPECT_TRUE(output.empty());
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_int32_vec_malformed_test_001, TestSize.Level1)
+{
+    // count does not match the bytes that follow
+    MessageParcel parcel;
+    WriteInlinePayload({ 3, 0 }, "", parcel);
+    std::vector<int32_t> output;
+    EXPECT_FALSE(ITypeMediaUtil::UnmarshalInt32Vec(output, parcel));
+    EXPECT_TRUE(output.empty());
+}
+
+HWTEST_F(MediaITypesUtilsUnitTest, medialib_bulk_transport_writable_ashmem_test_001, TestSize.Level1)
+{
+    size_t size = 2 * LARGE_STR_SIZE;
+    int fd = AshmemCreate("media_itypes_utils_test", size);
+    ASSERT_GE(fd, 0);
+    ASSERT_GE(AshmemSetProt(fd, PROT_READ | PROT_WRITE), 0);
+    MessageParcel parcel;
+    parcel.WriteUint32(static_cast<uint32_t>(size));
+    parcel.WriteInt32(BULK_MODE_ASHMEM);
+    parcel.WriteFileDescriptor(fd);
+    close(fd);
+    // the sender kept write access, so the receiver must not map it
+    EXPECT_EQ(MediaBulkTransport::Read(parcel), nullptr);
+}
+} // namespace Media
+} // namespace OHOS
@@ -101,6 +101,61 @@ HWTEST_F(LakeFileMonitorTest, media_file_change_processor_test_001, TestSize.Lev
     MEDIA_INFO_LOG("media_file_change_processor_test_001 end");
 }
 
+static FileMonitorService::FileMsgModel BuildFileMsg(const string &uri, int32_t opType, bool isFile = true)
+{
+    FileMonitorService::FileMsgModel model;
+    model.fileUri = uri;
+    model.opType = opType;
+    model.isFile = isFile;
+    model.isMediaData = true;
+    model.isContentChange = true;
+    return model;
+}
+
+/**
+ * @tc.number    : media_file_change_processor_test_002
+ * @tc.name      : MediaFileChangeProcessor::CoalesceFileChanges test
+ * @tc.desc      : 同一路径的增删改合并，删除后重建和目录消息按序分段
+ */
+HWTEST_F(LakeFileMonitorTest, media_file_change_processor_test_002, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("media_file_change_processor_test_002 start");
+
+    auto processor = MediaFileChangeProcessor::GetInstance();
+    string dir = FileScanUtils::GetCurrentInLakeLogicPrefix() + "/Pictures/";
+    vector<FileMonitorService::FileMsgModel> msgs = {
+        BuildFileMsg(dir + "a.jpg", 0),
+        BuildFileMsg(dir + "a.jpg", 1),
+        BuildFileMsg(dir + "b.jpg", 1),
+        BuildFileMsg(dir + "b.jpg", 1),
+        BuildFileMsg(dir + "c.jpg", 0),
+        BuildFileMsg(dir + "c.jpg", 2),
+        BuildFileMsg(dir + "d.jpg", 2),
+        BuildFileMsg(dir + "d.jpg", 0),
+        BuildFileMsg(dir + "sub", 1, false),
+        BuildFileMsg(dir + "e.txt", 0),
+        BuildFileMsg("/data/other/f.jpg", 0),
+    };
+    msgs[9].isMediaData = false;
+    auto segments = processor->CoalesceFileChanges(msgs);
+    ASSERT_EQ(segments.size(), 3);
+
+    ASSERT_EQ(segments[0].fileInfos.size(), 4);
+    EXPECT_FALSE(segments[0].isBarrier);
+    EXPECT_EQ(segments[0].fileInfos[0].opType, 0);
+    EXPECT_EQ(segments[0].fileInfos[1].opType, 1);
+    EXPECT_EQ(segments[0].fileInfos[2].opType, 2);
+    EXPECT_EQ(segments[0].fileInfos[3].fileUri, dir + "d.jpg");
+    EXPECT_EQ(segments[0].fileInfos[3].opType, 2);
+
+    ASSERT_EQ(segments[1].fileInfos.size(), 1);
+    EXPECT_EQ(segments[1].fileInfos[0].opType, 0);
+    EXPECT_TRUE(segments[2].isBarrier);
+    EXPECT_EQ(segments[2].fileInfos[0].fileUri, dir + "sub");
+
+    MEDIA_INFO_LOG("media_file_change_processor_test_002 end");
+}
+
 /**
  * @tc.number    : media_lake_clone_event_manager_test_001
  * @tc.name      : MediaLakeCloneEventManager test
@@ -21,8 +21,12 @@
 #include <vector>
 #include <unordered_map>
 
+#include "file_const.h"
 #include "media_column.h"
+#include "media_file_notify_info.h"
+#include "media_file_utils.h"
 #include "media_log.h"
+#include "media_move_file_manager_dir_processor.h"
 #include "medialibrary_errno.h"
 #include "medialibrary_rdbstore.h"
 #include "medialibrary_unistore_manager.h"
@@ -1647,5 +1651,119 @@ HWTEST_F(MediaLakeMonitorRdbUtilsTest, QueryAlbumByLPath_ExcludePaths_ReturnSucc
     MEDIA_INFO_LOG("QueryAlbumByLPath_ExcludePaths_ReturnSuccess end");
 }
 
+static void BuildFileManagerTree(const string &lPath, const string &path, int32_t depth, int32_t fanOut,
+    vector<ValuesBucket> &albums, vector<pair<string, string>> &albumDirs)
+{
+    ValuesBucket album;
+    album.PutInt(PhotoAlbumColumns::ALBUM_TYPE, TEST_ALBUM_TYPE);
+    album.PutInt(PhotoAlbumColumns::ALBUM_SUBTYPE, TEST_ALBUM_SUBTYPE);
+    album.PutString(PhotoAlbumColumns::ALBUM_NAME, lPath.substr(lPath.find_last_of('/') + 1));
+    album.PutString(PhotoAlbumColumns::ALBUM_LPATH, lPath);
+    albums.push_back(album);
+    albumDirs.emplace_back(lPath, path);
+    CHECK_AND_RETURN(depth > 0);
+    for (int32_t i = 0; i < fanOut; i++) {
+        // 非ASCII目录名的字节数与字符数不同
+        string name = (i == 1) ? "相册" + to_string(i) : "dir" + to_string(i);
+        BuildFileManagerTree(lPath + "/" + name, path + "/" + name, depth - 1, fanOut, albums, albumDirs);
+    }
+}
+
+static int32_t QueryCount(const string &sql)
+{
+    auto resultSet = g_rdbStore->QuerySql(sql);
+    CHECK_AND_RETURN_RET(resultSet != nullptr && resultSet->GoToFirstRow() == NativeRdb::E_OK, -1);
+    int32_t count = -1;
+    resultSet->GetInt(0, count);
+    resultSet->Close();
+    return count;
+}
+
+/**
+ * @tc.name      : MoveFileManagerDir_DeepTree_Benchmark
+ * @tc.desc      : 重命名多层非ASCII目录，相册与资产以集合语句整体迁移
+ */
+HWTEST_F(MediaLakeMonitorRdbUtilsTest, MoveFileManagerDir_DeepTree_Benchmark, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("MoveFileManagerDir_DeepTree_Benchmark start");
+    const int32_t depth = 4;
+    const int32_t fanOut = 4;
+    const int32_t assetNum = 3;
+    const string oldPath = FILE_MANAGER_SCAN_DIR + "/相册bench";
+    const string newPath = FILE_MANAGER_SCAN_DIR + "/bench_renamed";
+
+    vector<ValuesBucket> albums;
+    vector<pair<string, string>> albumDirs;
+    BuildFileManagerTree(FILE_MANAGER_LPATH_PREFIX + "/相册bench", oldPath, depth, fanOut, albums, albumDirs);
+    int64_t rowNum = 0;
+    ASSERT_EQ(MediaLibraryRdbStore::BatchInsert(rowNum, PhotoAlbumColumns::TABLE, albums), E_OK);
+
+    unordered_map<string, int32_t> albumIds;
+    auto resultSet = g_rdbStore->QuerySql("SELECT " + PhotoAlbumColumns::ALBUM_ID + ", " +
+        PhotoAlbumColumns::ALBUM_LPATH + " FROM " + PhotoAlbumColumns::TABLE);
+    ASSERT_NE(resultSet, nullptr);
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int32_t albumId = -1;
+        string lPath;
+        resultSet->GetInt(0, albumId);
+        resultSet->GetString(1, lPath);
+        albumIds[lPath] = albumId;
+    }
+    resultSet->Close();
+    vector<ValuesBucket> assets;
+    for (const auto &[lPath, path] : albumDirs) {
+        for (int32_t i = 0; i < assetNum; i++) {
+            ValuesBucket asset;
+            asset.PutInt(PhotoColumn::PHOTO_OWNER_ALBUM_ID, albumIds[lPath]);
+            asset.PutString(MediaColumn::MEDIA_FILE_PATH, TEST_PHOTO_PATH);
+            asset.PutString(PhotoColumn::PHOTO_STORAGE_PATH, path + "/IMG_" + to_string(i) + ".jpg");
+            asset.PutInt(PhotoColumn::PHOTO_FILE_SOURCE_TYPE, static_cast<int32_t>(FileSourceType::FILE_MANAGER));
+            asset.PutLong(MediaColumn::MEDIA_DATE_TAKEN, TEST_DATE_TAKEN);
+            assets.push_back(asset);
+        }
+    }
+    ASSERT_EQ(MediaLibraryRdbStore::BatchInsert(rowNum, PhotoColumn::PHOTOS_TABLE, assets), E_OK);
+
+    std::shared_ptr<MediaLibraryRdbStore> rdbStore = g_rdbStore;
+    MediaMoveFileManagerDirProcessor processor(rdbStore);
+    MediaNotifyInfo notifyInfo;
+    notifyInfo.beforePath = oldPath;
+    notifyInfo.afterPath = newPath;
+    int64_t startTime = MediaFileUtils::UTCTimeMilliSeconds();
+    processor.Process(notifyInfo);
+    int64_t cost = MediaFileUtils::UTCTimeMilliSeconds() - startTime;
+    MEDIA_INFO_LOG("Move dir tree, albums: %{public}zu, assets: %{public}zu, cost: %{public}" PRId64 "ms",
+        albums.size(), assets.size(), cost);
+
+    string newLPath = FILE_MANAGER_LPATH_PREFIX + "/bench_renamed";
+    int32_t newAlbumNum = QueryCount("SELECT COUNT(*) FROM " + PhotoAlbumColumns::TABLE + " WHERE " +
+        PhotoAlbumColumns::ALBUM_LPATH + " = '" + newLPath + "' OR " + PhotoAlbumColumns::ALBUM_LPATH +
+        " LIKE '" + newLPath + "/%'");
+    EXPECT_EQ(newAlbumNum, static_cast<int32_t>(albums.size()));
+    int32_t movedAssetNum = QueryCount("SELECT COUNT(*) FROM " + PhotoColumn::PHOTOS_TABLE + " p JOIN " +
+        PhotoAlbumColumns::TABLE + " a ON p." + PhotoColumn::PHOTO_OWNER_ALBUM_ID + " = a." +
+        PhotoAlbumColumns::ALBUM_ID + " WHERE a." + PhotoAlbumColumns::ALBUM_LPATH + " LIKE '" + newLPath +
+        "%' AND p." + PhotoColumn::PHOTO_STORAGE_PATH + " LIKE '" + newPath + "/%'");
+    EXPECT_EQ(movedAssetNum, static_cast<int32_t>(assets.size()));
+    string deepestDir = "/dir3/dir3/dir3/dir3";
+    int32_t deepestAssetNum = QueryCount("SELECT COUNT(*) FROM " + PhotoColumn::PHOTOS_TABLE + " p JOIN " +
+        PhotoAlbumColumns::TABLE + " a ON p." + PhotoColumn::PHOTO_OWNER_ALBUM_ID + " = a." +
+        PhotoAlbumColumns::ALBUM_ID + " WHERE a." + PhotoAlbumColumns::ALBUM_LPATH + " = '" + newLPath +
+        deepestDir + "' AND p." + PhotoColumn::PHOTO_STORAGE_PATH + " LIKE '" + newPath + deepestDir + "/IMG_%'");
+    EXPECT_EQ(deepestAssetNum, assetNum);
+    string nonAsciiDir = "/相册1/dir3";
+    int32_t nonAsciiAssetNum = QueryCount("SELECT COUNT(*) FROM " + PhotoColumn::PHOTOS_TABLE + " WHERE " +
+        PhotoColumn::PHOTO_STORAGE_PATH + " LIKE '" + newPath + nonAsciiDir + "/IMG_%'");
+    EXPECT_EQ(nonAsciiAssetNum, assetNum);
+    int32_t staleAssetNum = QueryCount("SELECT COUNT(*) FROM " + PhotoColumn::PHOTOS_TABLE + " WHERE " +
+        PhotoColumn::PHOTO_STORAGE_PATH + " LIKE '" + oldPath + "/%'");
+    EXPECT_EQ(staleAssetNum, 0);
+    int32_t pendingNum = QueryCount("SELECT COUNT(*) FROM " + PhotoColumn::PHOTOS_TABLE + " WHERE " +
+        MediaColumn::MEDIA_TIME_PENDING + " != 0");
+    EXPECT_EQ(pendingNum, 0);
+
+    MEDIA_INFO_LOG("MoveFileManagerDir_DeepTree_Benchmark end");
+}
+
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "burst_persist_stage_test.h"
+
+#include "camera_test_utils.h"
+#include "media_assets_service.h"
+#include "media_file_utils.h"
+#include "media_log.h"
+#include "media_upgrade.h"
+#include "medialibrary_rdbstore.h"
+#include "medialibrary_unistore_manager.h"
+#include "medialibrary_unittest_utils.h"
+#include "mock_camera_pipeline.h"
+#define private public
+#define protected public
+#include "burst_persist_stage.h"
+#include "multistages_camera_capture_manager.h"
+#undef private
+#undef protected
+#include "result_set_utils.h"
+#include "save_camera_photo_dto.h"
+
+namespace OHOS {
+namespace Media {
+using namespace std;
+using namespace testing::ext;
+static std::shared_ptr<MediaLibraryRdbStore> g_rdbStore;
+static const std::string BURST_DIR = "/storage/cloud/files/Photo/16/";
+static const std::string BURST_KEY = "burst_persist_stage_test";
+static constexpr int32_t BURST_FRAME_NUM = 10;
+static constexpr int32_t JPEG_IMAGE_FILE_TYPE = 1;
+
+static void SetTables()
+{
+    int32_t ret = g_rdbStore->ExecuteSql(PhotoUpgrade::CREATE_PHOTO_TABLE);
+    CHECK_AND_PRINT_LOG(ret == NativeRdb::E_OK, "Create photo table failed");
+}
+
+static void CleanTestTables()
+{
+    int32_t ret = g_rdbStore->ExecuteSql("DROP TABLE " + PhotoColumn::PHOTOS_TABLE + ";");
+    CHECK_AND_PRINT_LOG(ret == NativeRdb::E_OK, "Drop photo table failed");
+}
+
+void BurstPersistStageTest::SetUpTestCase(void)
+{
+    MediaLibraryUnitTestUtils::Init();
+    g_rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
+    if (g_rdbStore == nullptr) {
+        MEDIA_ERR_LOG("Start BurstPersistStageTest failed, can not get rdbstore");
+        exit(1);
+    }
+    SetTables();
+}
+
+void BurstPersistStageTest::TearDownTestCase(void)
+{
+    system("rm -rf /storage/cloud/files/*");
+    CleanTestTables();
+    g_rdbStore = nullptr;
+}
+
+void BurstPersistStageTest::SetUp()
+{
+    CleanTestTables();
+    SetTables();
+    EXPECT_EQ(MediaFileUtils::CreateDirectory(BURST_DIR), true);
+}
+
+void BurstPersistStageTest::TearDown(void)
+{
+    BurstPersistStage::GetInstance().Flush();
+    system("rm -rf /storage/cloud/files/*");
+    MultistagesCameraCaptureManager::GetInstance().fileId2PhotoId_.clear();
+    MultistagesCameraCaptureManager::GetInstance().pipeLinesMap_.clear();
+}
+
+// 预置一张连拍帧: 数据库中 is_temp = 1, 文件已由相机落盘
+static std::shared_ptr<MockCameraPipeline> CreateBurstFrame(int32_t index, bool needInsert = true)
+{
+    std::string displayName = "IMG_BURST" + std::to_string(index) + ".jpg";
+    std::string path = BURST_DIR + displayName;
+    std::string photoId = "1970_000000_0000_1" + std::to_string(index);
+    EXPECT_EQ(MediaFileUtils::CreateFile(path), true);
+
+    int64_t fileId = index + BURST_FRAME_NUM * BURST_FRAME_NUM;
+    if (needInsert) {
+        NativeRdb::ValuesBucket values;
+        values.Put(MediaColumn::MEDIA_FILE_PATH, path);
+        values.Put(MediaColumn::MEDIA_NAME, displayName);
+        values.Put(PhotoColumn::PHOTO_ID, photoId);
+        values.Put(PhotoColumn::PHOTO_IS_TEMP, 1);
+        values.Put(PhotoColumn::PHOTO_DIRTY, -1);
+        values.Put(PhotoColumn::PHOTO_QUALITY, static_cast<int32_t>(MultiStagesPhotoQuality::FULL));
+        values.Put(PhotoColumn::PHOTO_SUBTYPE, static_cast<int32_t>(PhotoSubType::BURST));
+        values.Put(PhotoColumn::PHOTO_BURST_KEY, BURST_KEY);
+        EXPECT_EQ(g_rdbStore->Insert(fileId, PhotoColumn::PHOTOS_TABLE, values), NativeRdb::E_OK);
+    }
+
+    FileAssetInfo info = {
+        .fileId = static_cast<int32_t>(fileId),
+        .photoId = photoId,
+        .path = path,
+        .displayName = displayName,
+        .mimeType = "image/jpeg",
+        .subtype = static_cast<int32_t>(PhotoSubType::BURST),
+    };
+    FileAsset fileAsset;
+    CameraTestUtils::CreateFileAsset(info, fileAsset);
+    auto pipeline = std::make_shared<MockCameraPipeline>();
+    pipeline->SetPipelineType(CameraPipelineType::YUV);
+    pipeline->Init(CameraAssetInfo(fileAsset));
+    MultistagesCameraCaptureManager::GetInstance().InsertCaptureData(info.fileId, photoId, pipeline);
+    return pipeline;
+}
+
+static int32_t QueryIsTemp(int32_t fileId)
+{
+    NativeRdb::AbsRdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
+    predicates.EqualTo(MediaColumn::MEDIA_ID, fileId);
+    auto resultSet = g_rdbStore->Query(predicates, { PhotoColumn::PHOTO_IS_TEMP });
+    if (resultSet == nullptr || resultSet->GoToFirstRow() != NativeRdb::E_OK) {
+        return -1;
+    }
+    int32_t isTemp = GetInt32Val(PhotoColumn::PHOTO_IS_TEMP, resultSet);
+    resultSet->Close();
+    return isTemp;
+}
+
+/**
+ * @tc.name: [连拍场景: 整组提交] BurstPersistStage_Accept_test001
+ * @tc.desc: 连拍帧接管后立即返回, 整组在一个事务内转正
+ *           [1] SaveCameraPhoto 返回成功
+ *           [2] 一组连拍只提交一次
+ *           [3] 所有连拍帧 is_temp = 0, 一阶段结束
+ */
+HWTEST_F(BurstPersistStageTest, BurstPersistStage_Accept_test001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("enter BurstPersistStage_Accept_test001");
+    BurstPersistStage::GetInstance().Flush();
+    uint64_t commitCount = BurstPersistStage::GetInstance().GetCommitCount();
+
+    vector<std::shared_ptr<MockCameraPipeline>> pipelines;
+    for (int32_t i = 0; i < BURST_FRAME_NUM; i++) {
+        auto pipeline = CreateBurstFrame(i);
+        pipelines.push_back(pipeline);
+        SaveCameraPhotoDto dto = {
+            .fileId = pipeline->GetAssetInfo().GetFileId(),
+            .imageFileType = JPEG_IMAGE_FILE_TYPE,
+        };
+        EXPECT_GT(MediaAssetsService::GetInstance().SaveCameraPhoto(dto), 0);
+    }
+    BurstPersistStage::GetInstance().Flush();
+
+    EXPECT_EQ(BurstPersistStage::GetInstance().GetPendingCount(), 0);
+    EXPECT_EQ(BurstPersistStage::GetInstance().GetCommitCount() - commitCount, 1);
+    for (const auto &pipeline : pipelines) {
+        EXPECT_EQ(QueryIsTemp(pipeline->GetAssetInfo().GetFileId()), 0);
+        EXPECT_EQ(pipeline->assetInfo_.isFirstStageFinished_, true);
+    }
+    MEDIA_INFO_LOG("end BurstPersistStage_Accept_test001");
+}
+
+/**
+ * @tc.name: [连拍场景: 部分帧失败] BurstPersistStage_Accept_test002
+ * @tc.desc: 组内记录不存在的帧不影响其他帧转正
+ *           [1] 记录存在的帧 is_temp = 0
+ *           [2] 所有帧一阶段结束
+ *           [3] 三方应用保存的连拍帧不参与合并
+ */
+HWTEST_F(BurstPersistStageTest, BurstPersistStage_Accept_test002, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("enter BurstPersistStage_Accept_test002");
+    auto savedPipeline = CreateBurstFrame(0);
+    auto missingPipeline = CreateBurstFrame(1, false);
+    for (const auto &pipeline : { savedPipeline, missingPipeline }) {
+        SaveCameraPhotoDto dto = {
+            .fileId = pipeline->GetAssetInfo().GetFileId(),
+            .imageFileType = JPEG_IMAGE_FILE_TYPE,
+        };
+        EXPECT_EQ(BurstPersistStage::IsBurstFrame(pipeline, dto), true);
+        EXPECT_GT(BurstPersistStage::GetInstance().Accept(pipeline, dto), 0);
+    }
+    BurstPersistStage::GetInstance().Flush();
+
+    EXPECT_EQ(QueryIsTemp(savedPipeline->GetAssetInfo().GetFileId()), 0);
+    EXPECT_EQ(QueryIsTemp(missingPipeline->GetAssetInfo().GetFileId()), -1);
+    EXPECT_EQ(savedPipeline->assetInfo_.isFirstStageFinished_, true);
+    EXPECT_EQ(missingPipeline->assetInfo_.isFirstStageFinished_, true);
+
+    SaveCameraPhotoDto discardDto = {
+        .fileId = savedPipeline->GetAssetInfo().GetFileId(),
+        .discardHighQualityPhoto = true,
+    };
+    EXPECT_EQ(BurstPersistStage::IsBurstFrame(savedPipeline, discardDto), false);
+    MEDIA_INFO_LOG("end BurstPersistStage_Accept_test002");
+}
+} // namespace Media
+} // namespace OHOS
@@ -17,6 +17,8 @@
 
 #include "media_assets_delete_service_test.h"
 
+#include <atomic>
+
 #include "media_log.h"
 #include "medialibrary_errno.h"
 #include "medialibrary_type_const.h"
@@ -1016,4 +1018,129 @@ HWTEST_F(CloudMediaAssetsDeleteTest, CopyAndMoveFileManagerLocalAssetToTrash_Not
     EXPECT_EQ(ret, E_INVALID_MODE);
 }
 
+// ClassifyAssetsForTrash routing
+HWTEST_F(CloudMediaAssetsDeleteTest, ClassifyAssetsForTrash_LocalDelete, TestSize.Level1)
+{
+    /**
+     * @tc.name: ClassifyAssetsForTrash_LocalDelete
+     * @tc.desc: Member, fdirty, single-position, trashed, burst and plain LOCAL_AND_CLOUD assets are split apart
+     * @tc.type: FUNCTION
+     */
+    MediaAssetsDeleteService service;
+    auto buildPhoto = [](int32_t fileId, int32_t position) {
+        PhotosPo photo;
+        photo.fileId = fileId;
+        photo.position = position;
+        photo.dateTrashed = 0;
+        photo.burstCoverLevel = static_cast<int32_t>(BurstCoverLevelType::COVER);
+        photo.fileSourceType = static_cast<int32_t>(FileSourceType::MEDIA);
+        photo.data = "/storage/cloud/files/Photo/1/IMG_" + std::to_string(fileId) + ".jpg";
+        photo.displayName = "IMG_" + std::to_string(fileId) + ".jpg";
+        return photo;
+    };
+    const int32_t localAndCloud = static_cast<int32_t>(PhotoPositionType::LOCAL_AND_CLOUD);
+    std::vector<PhotosPo> photosList;
+    photosList.emplace_back(buildPhoto(1, static_cast<int32_t>(PhotoPositionType::LOCAL)));
+    photosList.emplace_back(buildPhoto(2, static_cast<int32_t>(PhotoPositionType::CLOUD)));
+    PhotosPo member = buildPhoto(3, localAndCloud);
+    member.burstCoverLevel = static_cast<int32_t>(BurstCoverLevelType::MEMBER);
+    photosList.emplace_back(member);
+    PhotosPo fdirty = buildPhoto(4, localAndCloud);
+    fdirty.dirty = static_cast<int32_t>(DirtyType::TYPE_FDIRTY);
+    photosList.emplace_back(fdirty);
+    PhotosPo trashed = buildPhoto(5, localAndCloud);
+    trashed.dateTrashed = 1;
+    photosList.emplace_back(trashed);
+    PhotosPo burst = buildPhoto(6, localAndCloud);
+    burst.burstKey = "burst-key";
+    photosList.emplace_back(burst);
+    photosList.emplace_back(buildPhoto(7, localAndCloud));
+    PhotosPo fileManager = buildPhoto(8, localAndCloud);
+    fileManager.fileSourceType = static_cast<int32_t>(FileSourceType::FILE_MANAGER);
+    photosList.emplace_back(fileManager);
+
+    TrashClassifyResult result;
+    int32_t ret = service.ClassifyAssetsForTrash(photosList, true, result);
+    EXPECT_EQ(ret, E_OK);
+    ASSERT_EQ(result.directFileUris.size(), 2);
+    EXPECT_EQ(result.directFileUris[0], photosList[0].BuildFileUri());
+    EXPECT_EQ(result.directFileUris[1], fdirty.BuildFileUri());
+    ASSERT_EQ(result.chainAssets.size(), 1);
+    EXPECT_EQ(result.chainAssets[0].fileId.value_or(0), 6);
+    ASSERT_EQ(result.plans.size(), 2);
+    EXPECT_EQ(result.plans[0].photoInfo.fileId.value_or(0), 7);
+    EXPECT_EQ(result.plans[0].kind, TrashAssetKind::MEDIA);
+    EXPECT_EQ(result.plans[1].photoInfo.fileId.value_or(0), 8);
+    EXPECT_EQ(result.plans[1].kind, TrashAssetKind::FILE_MANAGER);
+
+    TrashClassifyResult cloudResult;
+    ret = service.ClassifyAssetsForTrash(photosList, false, cloudResult);
+    EXPECT_EQ(ret, E_OK);
+    ASSERT_EQ(cloudResult.directFileUris.size(), 2);
+    EXPECT_EQ(cloudResult.directFileUris[0], photosList[1].BuildFileUri());
+    EXPECT_EQ(cloudResult.plans.size(), 2);
+}
+
+// RunTrashPlanTasks visits every plan once
+HWTEST_F(CloudMediaAssetsDeleteTest, RunTrashPlanTasks_VisitsAllPlans, TestSize.Level1)
+{
+    /**
+     * @tc.name: RunTrashPlanTasks_VisitsAllPlans
+     * @tc.desc: Every plan is handed to exactly one worker
+     * @tc.type: FUNCTION
+     */
+    MediaAssetsDeleteService service;
+    const int32_t planCount = 37;
+    std::vector<TrashAssetPlan> plans(planCount);
+    std::atomic<int32_t> visitCount {0};
+    service.RunTrashPlanTasks(plans, [&visitCount](TrashAssetPlan &plan) {
+        EXPECT_FALSE(plan.isFileReady);
+        plan.isFileReady = true;
+        visitCount++;
+    });
+    EXPECT_EQ(visitCount.load(), planCount);
+    for (const auto &plan : plans) {
+        EXPECT_TRUE(plan.isFileReady);
+    }
+}
+
+// RevertLocalTrashPlans moves the files back after a rollback
+HWTEST_F(CloudMediaAssetsDeleteTest, RevertLocalTrashPlans_MovesFilesBack, TestSize.Level1)
+{
+    /**
+     * @tc.name: RevertLocalTrashPlans_MovesFilesBack
+     * @tc.desc: Files of ready plans return to the source path, plans not ready are left alone
+     * @tc.type: FUNCTION
+     */
+    MediaAssetsDeleteService service;
+    auto buildPhoto = [](const std::string &path) {
+        PhotosPo photo;
+        photo.fileId = 1;
+        photo.data = path;
+        photo.displayName = "IMG_REVERT.jpg";
+        photo.subtype = 0;
+        photo.originalSubtype = 0;
+        photo.movingPhotoEffectMode = 0;
+        photo.dateModified = MediaFileUtils::UTCTimeMilliSeconds();
+        return photo;
+    };
+    const std::string sourcePath = "/data/test/revert_trash_source.jpg";
+    const std::string targetPath = "/data/test/revert_trash_target.jpg";
+    MediaFileUtils::DeleteFile(sourcePath);
+    ASSERT_TRUE(MediaFileUtils::CreateFile(targetPath));
+    std::vector<TrashAssetPlan> plans(2);
+    plans[0].photoInfo = buildPhoto(sourcePath);
+    plans[0].targetPhotoInfo = buildPhoto(targetPath);
+    plans[0].isFileReady = true;
+    plans[1].photoInfo = buildPhoto("/data/test/revert_trash_not_ready.jpg");
+    plans[1].targetPhotoInfo = buildPhoto("/data/test/revert_trash_not_ready_target.jpg");
+
+    service.RevertLocalTrashPlans(plans);
+    EXPECT_TRUE(MediaFileUtils::IsFileExists(sourcePath));
+    EXPECT_FALSE(MediaFileUtils::IsFileExists(targetPath));
+    EXPECT_FALSE(plans[0].isFileReady);
+    EXPECT_FALSE(plans[1].isFileReady);
+    MediaFileUtils::DeleteFile(sourcePath);
+}
+
 }  // namespace OHOS::Media::CloudSync
@@ -16,6 +16,7 @@
 #include "media_library_lcd_aging_test.h"
 
 #include <fstream>
+#include <thread>
 
 #include "lcd_aging_manager.h"
 #include "lcd_aging_utils.h"
@@ -2484,5 +2485,136 @@ HWTEST_F(MediaLibraryLcdAgingTest, LcdAgingService_HasReleasableLcdImages_ThumbS
 
     CleanupLcdEnvironment(testIds);
 }
+
+HWTEST_F(MediaLibraryLcdAgingTest, lcd_aging_SortByAgingPriority_test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("lcd_aging_SortByAgingPriority_test_001: large, idle and rarely visited lcd ages first");
+    const int64_t oneDayMs = 24LL * 60 * 60 * 1000;
+    int64_t currentTime = MediaFileUtils::UTCTimeMilliSeconds();
+    vector<LcdAgingFileInfo> agingFileInfos(3);
+    agingFileInfos[0].fileId = 1;
+    agingFileInfos[0].lcdFileSize = 102400;
+    agingFileInfos[0].lcdVisitTime = currentTime - 40 * oneDayMs;
+    agingFileInfos[0].lcdVisitCount = 5;
+    agingFileInfos[1].fileId = 2;
+    agingFileInfos[1].lcdFileSize = 409600;
+    agingFileInfos[1].lcdVisitTime = currentTime - 90 * oneDayMs;
+    agingFileInfos[1].lcdVisitCount = 0;
+    agingFileInfos[2].fileId = 3;
+    agingFileInfos[2].lcdFileSize = 409600;
+    agingFileInfos[2].lcdVisitTime = currentTime - 90 * oneDayMs;
+    agingFileInfos[2].lcdVisitCount = 3;
+
+    EXPECT_GT(LcdAgingUtils::GetAgingPriority(agingFileInfos[1], currentTime),
+        LcdAgingUtils::GetAgingPriority(agingFileInfos[2], currentTime));
+    LcdAgingUtils::SortByAgingPriority(agingFileInfos);
+    ASSERT_EQ(agingFileInfos.size(), 3);
+    EXPECT_EQ(agingFileInfos[0].fileId, 2);
+    EXPECT_EQ(agingFileInfos[1].fileId, 3);
+    EXPECT_EQ(agingFileInfos[2].fileId, 1);
+}
+
+HWTEST_F(MediaLibraryLcdAgingTest, lcd_aging_GetFreeBytesTarget_test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("lcd_aging_GetFreeBytesTarget_test_001: target is only set under low space");
+    EXPECT_EQ(LcdAgingUtils::GetFreeBytesTarget(1000, 500), 0);
+    EXPECT_EQ(LcdAgingUtils::GetFreeBytesTarget(1000, 40), 60);
+    EXPECT_EQ(LcdAgingUtils::GetFreeBytesTarget(0, 40), 0);
+}
+
+HWTEST_F(MediaLibraryLcdAgingTest, lcd_aging_manager_CheckFreeBytesTarget_test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("lcd_aging_manager_CheckFreeBytesTarget_test_001: stop on freed bytes or deadline");
+    auto& manager = LcdAgingManager::GetInstance();
+    manager.freeBytesTarget_ = 0;
+    EXPECT_EQ(manager.CheckFreeBytesTarget(), E_OK);
+
+    manager.freeBytesTarget_ = 1024;
+    manager.agingDeadline_ = MediaFileUtils::UTCTimeSeconds() + 60;
+    manager.freedLcdBytes_ = 512;
+    EXPECT_EQ(manager.CheckFreeBytesTarget(), E_OK);
+    manager.freedLcdBytes_ = 1024;
+    EXPECT_EQ(manager.CheckFreeBytesTarget(), 4);
+
+    manager.freedLcdBytes_ = 0;
+    manager.agingDeadline_ = MediaFileUtils::UTCTimeSeconds() - 1;
+    EXPECT_EQ(manager.CheckFreeBytesTarget(), 5);
+
+    manager.freeBytesTarget_ = 0;
+    manager.agingDeadline_ = 0;
+    manager.freedLcdBytes_ = 0;
+}
+
+HWTEST_F(MediaLibraryLcdAgingTest, lcd_aging_manager_ExecuteDeleteLcdFiles_Parallel_test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("lcd_aging_manager_ExecuteDeleteLcdFiles_Parallel_test_001: delete lcd files on ffrt tasks");
+    const int32_t fileCount = 80;
+    const int32_t lcdFileSize = 100;
+    const int32_t failFileId = 1000;
+    LcdAgingManager::DeleteLcdFilesTask task;
+    for (int32_t i = 0; i < fileCount; ++i) {
+        LcdAgingFileInfo agingFileInfo;
+        agingFileInfo.fileId = failFileId + i;
+        agingFileInfo.path = "/storage/cloud/files/Photo/1/lcd_aging_parallel_" + to_string(i) + ".jpg";
+        agingFileInfo.localLcdPath = "/data/test/lcd_aging_parallel_" + to_string(i) + ".jpg";
+        agingFileInfo.lcdFileSize = lcdFileSize;
+        ofstream outFile(agingFileInfo.localLcdPath);
+        outFile << "lcd";
+        outFile.close();
+        task.agingFileInfos.push_back(agingFileInfo);
+    }
+    task.failFileIds.push_back(to_string(failFileId));
+
+    auto& manager = LcdAgingManager::GetInstance();
+    manager.freedLcdBytes_ = 0;
+    manager.ExecuteDeleteLcdFiles(task);
+
+    EXPECT_TRUE(MediaFileUtils::IsFileExists(task.agingFileInfos[0].localLcdPath));
+    for (int32_t i = 1; i < fileCount; ++i) {
+        EXPECT_FALSE(MediaFileUtils::IsFileExists(task.agingFileInfos[i].localLcdPath));
+    }
+    EXPECT_EQ(manager.freedLcdBytes_.load(), static_cast<int64_t>(fileCount - 1) * lcdFileSize);
+
+    MediaFileUtils::DeleteFile(task.agingFileInfos[0].localLcdPath);
+    manager.freedLcdBytes_ = 0;
+}
+
+HWTEST_F(MediaLibraryLcdAgingTest, lcd_aging_manager_AsyncDeleteLcdFiles_QueueFull_test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("lcd_aging_manager_AsyncDeleteLcdFiles_QueueFull_test_001: wait while the delete queue is full");
+    const size_t maxPendingTasks = 4;
+    auto& manager = LcdAgingManager::GetInstance();
+    {
+        std::lock_guard<std::mutex> lock(manager.deleteLcdFilesTaskMutex_);
+        // 模拟删除线程正在运行但未取走任务
+        manager.isDeleteLcdFilesWorkerRunning_ = true;
+        for (size_t i = 0; i < maxPendingTasks; ++i) {
+            manager.deleteLcdFilesTaskQueue_.push({});
+        }
+    }
+
+    std::atomic<bool> isPushed {false};
+    std::thread producer([&manager, &isPushed]() {
+        manager.AsyncDeleteLcdFiles({}, {});
+        isPushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(isPushed.load());
+
+    {
+        std::lock_guard<std::mutex> lock(manager.deleteLcdFilesTaskMutex_);
+        manager.deleteLcdFilesTaskQueue_.pop();
+    }
+    manager.deleteLcdFilesSpaceCv_.notify_all();
+    producer.join();
+    EXPECT_TRUE(isPushed.load());
+
+    {
+        std::lock_guard<std::mutex> lock(manager.deleteLcdFilesTaskMutex_);
+        EXPECT_EQ(manager.deleteLcdFilesTaskQueue_.size(), maxPendingTasks);
+        std::queue<LcdAgingManager::DeleteLcdFilesTask>().swap(manager.deleteLcdFilesTaskQueue_);
+        manager.isDeleteLcdFilesWorkerRunning_ = false;
+    }
+}
 } // namespace Media
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
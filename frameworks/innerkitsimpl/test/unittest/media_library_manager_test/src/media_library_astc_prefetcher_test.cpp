@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "MediaLibraryAstcPrefetcherTest"
+
+#include "media_library_astc_prefetcher_test.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+#include "media_library_astc_prefetcher.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+static constexpr int32_t TIMELINE_SIZE = 3000;
+static constexpr int32_t WINDOW_SIZE = 30;
+static constexpr size_t ASTC_SIZE = 64;
+static constexpr size_t PAGE_BYTES = ASTC_SIZE * WINDOW_SIZE;
+static constexpr size_t CAPACITY_BYTES = PAGE_BYTES * 8;
+static constexpr int32_t WAIT_TIMEOUT_MS = 5000;
+
+static string GetTimeId(int32_t offset)
+{
+    string timeId = to_string(offset);
+    return string(10 - timeId.size(), '0') + timeId;
+}
+
+static vector<string> GetWindowKeys(int32_t start, int32_t count)
+{
+    vector<string> keys;
+    for (int32_t i = start; i < min(start + count, TIMELINE_SIZE); i++) {
+        keys.push_back(GetTimeId(i));
+    }
+    return keys;
+}
+
+// serves a synthetic timeline whose time ids are the zero padded offsets, loads can be held to keep pages pending
+class FakeAstcStore {
+public:
+    AstcPrefetcher::PageLoader GetLoader()
+    {
+        return [this](KvStoreValueType type, int32_t start, int32_t count, vector<string> &keys,
+            vector<vector<uint8_t>> &values) {
+            unique_lock<mutex> lock(mutex_);
+            loadingNum_++;
+            cv_.notify_all();
+            cv_.wait(lock, [this]() { return !isHeld_; });
+            keys = GetWindowKeys(start, count);
+            values.assign(keys.size(), vector<uint8_t>(ASTC_SIZE, static_cast<uint8_t>(start)));
+            return E_OK;
+        };
+    }
+
+    void Hold()
+    {
+        lock_guard<mutex> lock(mutex_);
+        isHeld_ = true;
+    }
+
+    void Release()
+    {
+        lock_guard<mutex> lock(mutex_);
+        isHeld_ = false;
+        cv_.notify_all();
+    }
+
+    bool WaitForLoading(int32_t num)
+    {
+        unique_lock<mutex> lock(mutex_);
+        return cv_.wait_for(lock, chrono::milliseconds(WAIT_TIMEOUT_MS), [this, num]() { return loadingNum_ >= num; });
+    }
+
+private:
+    mutex mutex_;
+    condition_variable cv_;
+    bool isHeld_ = false;
+    int32_t loadingNum_ = 0;
+};
+
+static AstcScrollState MakeScrollState(int32_t start, int32_t direction, int32_t speed)
+{
+    AstcScrollState state;
+    state.start = start;
+    state.count = WINDOW_SIZE;
+    state.direction = direction;
+    state.speed = speed;
+    return state;
+}
+
+void MediaLibraryAstcPrefetcherTest::SetUpTestCase(void) {}
+
+void MediaLibraryAstcPrefetcherTest::TearDownTestCase(void) {}
+
+void MediaLibraryAstcPrefetcherTest::SetUp() {}
+
+void MediaLibraryAstcPrefetcherTest::TearDown() {}
+
+HWTEST_F(MediaLibraryAstcPrefetcherTest, astc_prefetcher_replay_scroll_trace_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("astc_prefetcher_replay_scroll_trace_001 Start");
+    // a fling forward followed by a slower scroll back, each step is one GetBatchAstcs of the visible window
+    vector<pair<int32_t, int32_t>> trace;
+    for (int32_t start = 0; start <= 1200; start += 10) {
+        trace.emplace_back(start, 1);
+    }
+    for (int32_t start = 1200; start >= 900; start -= 5) {
+        trace.emplace_back(start, -1);
+    }
+    FakeAstcStore store;
+    AstcPrefetcher prefetcher(store.GetLoader(), CAPACITY_BYTES);
+    size_t total = 0;
+    size_t hitNum = 0;
+    for (const auto &[start, direction] : trace) {
+        prefetcher.UpdateScrollState(KvStoreValueType::MONTH_ASTC, MakeScrollState(start, direction, 300));
+        vector<string> keys = GetWindowKeys(start, WINDOW_SIZE);
+        vector<vector<uint8_t>> values;
+        hitNum += prefetcher.Lookup(KvStoreValueType::MONTH_ASTC, keys, values);
+        total += keys.size();
+        // the frame interval lets the read-ahead keep up with the scroll
+        ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+        ASSERT_LE(prefetcher.GetStats().cachedBytes, CAPACITY_BYTES);
+    }
+    AstcPrefetchStats stats = prefetcher.GetStats();
+    MEDIA_INFO_LOG("replay hit: %{public}zu, total: %{public}zu, pages: %{public}d", hitNum, total,
+        static_cast<int32_t>(stats.prefetchedPages));
+    EXPECT_EQ(stats.hitCount + stats.missCount, total);
+    EXPECT_GT(stats.prefetchedPages, 0);
+    // only the windows before the first read-ahead completes miss
+    EXPECT_GE(hitNum * 10, total * 9);
+    MEDIA_INFO_LOG("astc_prefetcher_replay_scroll_trace_001 End");
+}
+
+HWTEST_F(MediaLibraryAstcPrefetcherTest, astc_prefetcher_cancel_out_of_range_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("astc_prefetcher_cancel_out_of_range_001 Start");
+    FakeAstcStore store;
+    AstcPrefetcher prefetcher(store.GetLoader(), CAPACITY_BYTES);
+    store.Hold();
+    // fast enough to read three pages ahead, the first one is held by the loader
+    prefetcher.UpdateScrollState(KvStoreValueType::MONTH_ASTC, MakeScrollState(300, 1, 3000));
+    ASSERT_TRUE(store.WaitForLoading(1));
+    prefetcher.UpdateScrollState(KvStoreValueType::MONTH_ASTC, MakeScrollState(300, -1, 3000));
+    store.Release();
+    ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+
+    AstcPrefetchStats stats = prefetcher.GetStats();
+    EXPECT_EQ(stats.cancelledPages, 3);
+    vector<vector<uint8_t>> values;
+    EXPECT_EQ(prefetcher.Lookup(KvStoreValueType::MONTH_ASTC, GetWindowKeys(330, WINDOW_SIZE), values), 0);
+    EXPECT_EQ(prefetcher.Lookup(KvStoreValueType::MONTH_ASTC, GetWindowKeys(270, WINDOW_SIZE), values),
+        static_cast<size_t>(WINDOW_SIZE));
+    // the month cache does not serve year lookups
+    EXPECT_EQ(prefetcher.Lookup(KvStoreValueType::YEAR_ASTC, GetWindowKeys(270, WINDOW_SIZE), values), 0);
+    MEDIA_INFO_LOG("astc_prefetcher_cancel_out_of_range_001 End");
+}
+
+HWTEST_F(MediaLibraryAstcPrefetcherTest, astc_prefetcher_memory_level_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("astc_prefetcher_memory_level_001 Start");
+    FakeAstcStore store;
+    AstcPrefetcher prefetcher(store.GetLoader(), PAGE_BYTES * 2);
+    prefetcher.UpdateScrollState(KvStoreValueType::YEAR_ASTC, MakeScrollState(0, 1, 3000));
+    ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+    AstcPrefetchStats stats = prefetcher.GetStats();
+    EXPECT_EQ(stats.prefetchedPages, 3);
+    EXPECT_EQ(stats.evictedPages, 1);
+    EXPECT_EQ(stats.cachedBytes, PAGE_BYTES * 2);
+
+    prefetcher.OnMemoryLevel(ASTC_MEMORY_LEVEL_MODERATE);
+    EXPECT_EQ(prefetcher.GetStats().cachedBytes, PAGE_BYTES);
+
+    prefetcher.OnMemoryLevel(ASTC_MEMORY_LEVEL_CRITICAL);
+    EXPECT_EQ(prefetcher.GetStats().cachedBytes, 0);
+    prefetcher.UpdateScrollState(KvStoreValueType::YEAR_ASTC, MakeScrollState(WINDOW_SIZE * 5, 1, 3000));
+    ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(prefetcher.GetStats().prefetchedPages, 3);
+
+    prefetcher.OnMemoryLevel(ASTC_MEMORY_LEVEL_NORMAL);
+    prefetcher.UpdateScrollState(KvStoreValueType::YEAR_ASTC, MakeScrollState(WINDOW_SIZE * 5, 1, 0));
+    ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+    EXPECT_EQ(prefetcher.GetStats().prefetchedPages, 4);
+    MEDIA_INFO_LOG("astc_prefetcher_memory_level_001 End");
+}
+HWTEST_F(MediaLibraryAstcPrefetcherTest, astc_prefetcher_invalidate_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("astc_prefetcher_invalidate_001 Start");
+    FakeAstcStore store;
+    AstcPrefetcher prefetcher(store.GetLoader(), CAPACITY_BYTES);
+    prefetcher.UpdateScrollState(KvStoreValueType::MONTH_ASTC, MakeScrollState(0, 1, 3000));
+    ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+    size_t cachedBytes = prefetcher.GetStats().cachedBytes;
+    vector<vector<uint8_t>> values;
+    ASSERT_EQ(prefetcher.Lookup(KvStoreValueType::MONTH_ASTC, GetWindowKeys(WINDOW_SIZE, 1), values), 1);
+
+    // the regenerated thumbnail is read from the kv store again
+    prefetcher.Invalidate({ GetTimeId(WINDOW_SIZE) });
+    EXPECT_EQ(prefetcher.Lookup(KvStoreValueType::MONTH_ASTC, GetWindowKeys(WINDOW_SIZE, 1), values), 0);
+    EXPECT_EQ(prefetcher.Lookup(KvStoreValueType::MONTH_ASTC, GetWindowKeys(WINDOW_SIZE + 1, 1), values), 1);
+    AstcPrefetchStats stats = prefetcher.GetStats();
+    EXPECT_EQ(stats.invalidatedKeys, 1);
+    EXPECT_EQ(stats.cachedBytes, cachedBytes - ASTC_SIZE);
+    MEDIA_INFO_LOG("astc_prefetcher_invalidate_001 End");
+}
+
+HWTEST_F(MediaLibraryAstcPrefetcherTest, astc_prefetcher_invalidate_loading_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("astc_prefetcher_invalidate_loading_001 Start");
+    FakeAstcStore store;
+    AstcPrefetcher prefetcher(store.GetLoader(), CAPACITY_BYTES);
+    store.Hold();
+    prefetcher.UpdateScrollState(KvStoreValueType::MONTH_ASTC, MakeScrollState(0, 1, 0));
+    ASSERT_TRUE(store.WaitForLoading(1));
+    // the page being read may already hold the astc from before the change
+    prefetcher.Invalidate({ GetTimeId(WINDOW_SIZE) });
+    store.Release();
+    ASSERT_TRUE(prefetcher.WaitForIdle(WAIT_TIMEOUT_MS));
+
+    AstcPrefetchStats stats = prefetcher.GetStats();
+    EXPECT_EQ(stats.prefetchedPages, 0);
+    EXPECT_EQ(stats.cancelledPages, 1);
+    EXPECT_EQ(stats.cachedBytes, 0);
+    MEDIA_INFO_LOG("astc_prefetcher_invalidate_loading_001 End");
+}
+} // namespace Media
+} // namespace OHOS
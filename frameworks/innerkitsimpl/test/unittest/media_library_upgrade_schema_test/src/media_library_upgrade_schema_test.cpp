@@ -1598,4 +1598,72 @@ HWTEST_F(UpgradeSchemaTest, Initialize_repeat_test_001, TestSize.Level1)
     int32_t ret2 = UpgradeManager::GetInstance().Initialize(config2);
     EXPECT_EQ(ret2, NativeRdb::E_OK) << "Second Initialize should succeed";
 }
+
+/**
+ * @brief 记录升级进度的观察者
+ */
+class ProgressRecordObserver : public IUpgradeObserver {
+public:
+    void OnUpgradeStart(const std::shared_ptr<IUpgradeTask>& task) override {}
+    void OnUpgradeComplete(const std::shared_ptr<IUpgradeTask>& task, int32_t ret) override
+    {
+        results.push_back(ret);
+    }
+    void OnUpgradeProgress(int32_t currentVersion, int32_t targetVersion,
+                           int32_t completedCount, int32_t totalCount) override
+    {
+        progress.emplace_back(completedCount, totalCount);
+    }
+
+    std::vector<int32_t> results;
+    std::vector<std::pair<int32_t, int32_t>> progress;
+};
+
+/**
+ * @brief 测试UpgradeExecutor::ExecuteTasks函数（同步任务分组事务执行）
+ *
+ * 该测试用例验证相邻的module级同步任务在同一事务内执行，失败任务不影响同组其他任务，
+ * 每个任务完成后均上报完成结果与进度。
+ */
+HWTEST_F(UpgradeSchemaTest, ExecuteTasks_group_transaction_test_001, TestSize.Level1)
+{
+    TestRdbCreateCallback createCallBack;
+    std::shared_ptr<NativeRdb::RdbStore> db = MakeStore(CREATE_DB_PATH, MEDIA_RDB_VERSION, createCallBack);
+    ASSERT_NE(db, nullptr) << "Failed to create db";
+
+    constexpr int32_t baseVersion = 100000;
+    auto makeTask = [](int32_t version, const std::string &sql) {
+        UpgradeModuleTask::Config config(version, "group_test_" + std::to_string(version), "Test", true,
+            [sql](NativeRdb::RdbStore &store) {
+                SqlBuilder builder;
+                return UpgradeHelper::ExecuteCommands(builder.AddRawSql(sql).Build(), store, true);
+            });
+        return std::static_pointer_cast<IUpgradeTask>(std::make_shared<UpgradeModuleTask>(config));
+    };
+    std::vector<std::shared_ptr<IUpgradeTask>> tasks = {
+        makeTask(baseVersion + 1, "CREATE TABLE IF NOT EXISTS group_table1 (id INTEGER)"),
+        makeTask(baseVersion + 2, "INVALID SQL STATEMENT"),
+        makeTask(baseVersion + 3, "CREATE TABLE IF NOT EXISTS group_table2 (id INTEGER)"),
+    };
+
+    auto observer = std::make_shared<ProgressRecordObserver>();
+    UpgradeExecutor executor;
+    executor.SetObserver(observer);
+    executor.SetRdbConfigPath(RDB_CONFIG_PATH_TEST);
+    executor.SetUpgradeEventPath(UPGRADE_EVENT_61_PATH);
+    int32_t ret = executor.ExecuteTasks(tasks, *db, baseVersion, true);
+    EXPECT_EQ(ret, NativeRdb::E_ERROR) << "ExecuteTasks should report the failed task";
+
+    std::vector<std::string> tableNames = GetTableNames(*db);
+    EXPECT_NE(std::find(tableNames.begin(), tableNames.end(), "group_table1"), tableNames.end());
+    EXPECT_NE(std::find(tableNames.begin(), tableNames.end(), "group_table2"), tableNames.end());
+
+    ASSERT_EQ(observer->results.size(), tasks.size());
+    EXPECT_EQ(observer->results[0], NativeRdb::E_OK);
+    EXPECT_NE(observer->results[1], NativeRdb::E_OK);
+    EXPECT_EQ(observer->results[2], NativeRdb::E_OK);
+    ASSERT_FALSE(observer->progress.empty());
+    EXPECT_EQ(observer->progress.back().first, static_cast<int32_t>(tasks.size()));
+    EXPECT_EQ(observer->progress.back().second, static_cast<int32_t>(tasks.size()));
+}
 }  // namespace OHOS::Media
\ No newline at end of file
@@ -72,7 +72,11 @@ void NotificationRegisterManagerTest::TearDown(void)
 {
     MEDIA_INFO_LOG("NotificationRegisterManagerTest TearDown start");
     auto observerManager = Notification::MediaObserverManager::GetObserverManager();
-    observerManager->observers_.clear();
+    for (const auto &[uri, observerInfos] : observerManager->GetObservers()) {
+        for (const auto &observerInfo : observerInfos) {
+            observerManager->RemoveObserver(observerInfo.observer->AsObject());
+        }
+    }
     observerManager->obsCallbackPecipients_.clear();
     MEDIA_INFO_LOG("NotificationRegisterManagerTest TearDown end");
 }
@@ -1238,5 +1242,37 @@ HWTEST_F(NotificationRegisterManagerTest, NotifyRegisterPermission_test_015, Tes
     EXPECT_NE(ret, E_OK);
     MEDIA_INFO_LOG("NotifyRegisterPermission_test_015::End");
 }
+
+HWTEST_F(NotificationRegisterManagerTest, ObserverSnapshot_test_001, TestSize.Level1) {
+    MEDIA_INFO_LOG("ObserverSnapshot_test_001::Start");
+    Notification::NotifyUriType photoUri = Notification::NotifyUriType::PHOTO_URI;
+    Notification::NotifyUriType singlePhotoUri = Notification::NotifyUriType::SINGLE_PHOTO_URI;
+    auto observerManager = Notification::MediaObserverManager::GetObserverManager();
+    ASSERT_NE(observerManager, nullptr);
+    sptr<IDataAbilityObserver> dataObserver = new (std::nothrow) IDataAbilityObserverTest();
+    ASSERT_NE(dataObserver, nullptr);
+    EXPECT_EQ(observerManager->AddObserver(photoUri, dataObserver), E_OK);
+    EXPECT_EQ(observerManager->AddObserver(singlePhotoUri, dataObserver), E_OK);
+    auto oldPhotoBucket = observerManager->GetObserverBucket(photoUri);
+    auto oldSingleBucket = observerManager->GetObserverBucket(singlePhotoUri);
+    ASSERT_NE(oldSingleBucket, nullptr);
+    std::string singleId = "1001";
+    EXPECT_EQ(observerManager->AddSingleObserverSingleIds(singlePhotoUri, dataObserver, singleId), E_OK);
+    // 已发布的bucket不受后续注册变更影响, 未变更uri的bucket在新快照中共享
+    EXPECT_TRUE(oldSingleBucket->singleIdIndex.empty());
+    EXPECT_EQ(observerManager->GetObserverBucket(photoUri), oldPhotoBucket);
+    EXPECT_NE(observerManager->GetObserverBucket(singlePhotoUri), oldSingleBucket);
+    EXPECT_EQ(observerManager->FindObserverBySingleId(singlePhotoUri, singleId).size(), 1);
+    EXPECT_TRUE(observerManager->FindObserverBySingleId(singlePhotoUri, "1002").empty());
+    uint32_t tokenId = observerManager->FindObserver(photoUri).front().callingTokenId;
+    EXPECT_TRUE(observerManager->FindSingleObserverWithUri(photoUri, tokenId));
+
+    EXPECT_EQ(observerManager->RemoveObserver(dataObserver->AsObject()), E_OK);
+    EXPECT_TRUE(observerManager->GetObservers().empty());
+    EXPECT_EQ(observerManager->GetObserverBucket(photoUri), nullptr);
+    EXPECT_FALSE(observerManager->FindSingleObserverWithUri(photoUri, tokenId));
+    EXPECT_TRUE(observerManager->FindObserverBySingleId(singlePhotoUri, singleId).empty());
+    MEDIA_INFO_LOG("ObserverSnapshot_test_001::End");
+}
 }
 }
\ No newline at end of file
@@ -61,7 +61,11 @@ void NotificationDistributionTest::TearDown(void)
 {
     MEDIA_INFO_LOG("NotificationDistributionTest TearDown start");
     auto observerManager = Notification::MediaObserverManager::GetObserverManager();
-    observerManager->observers_.clear();
+    for (const auto &[uri, observerInfos] : observerManager->GetObservers()) {
+        for (const auto &observerInfo : observerInfos) {
+            observerManager->RemoveObserver(observerInfo.observer->AsObject());
+        }
+    }
     MEDIA_INFO_LOG("NotificationDistributionTest TearDown end");
 }
 
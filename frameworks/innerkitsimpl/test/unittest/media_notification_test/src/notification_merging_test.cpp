@@ -68,7 +68,11 @@ void NotificationMergingTest::TearDown(void)
 {
     MEDIA_INFO_LOG("NotificationMergingTest TearDown start");
     auto observerManager = Notification::MediaObserverManager::GetObserverManager();
-    observerManager->observers_.clear();
+    for (const auto &[uri, observerInfos] : observerManager->GetObservers()) {
+        for (const auto &observerInfo : observerInfos) {
+            observerManager->RemoveObserver(observerInfo.observer->AsObject());
+        }
+    }
     observerManager->obsCallbackPecipients_.clear();
     MEDIA_INFO_LOG("NotificationMergingTest TearDown end");
 }
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORKS_SERVICES_MEDIA_CLOUD_ENHANCEMENT_INCLUDE_ENHANCEMENT_SERVICE_STAND_IN_H
+#define FRAMEWORKS_SERVICES_MEDIA_CLOUD_ENHANCEMENT_INCLUDE_ENHANCEMENT_SERVICE_STAND_IN_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "enhancement_thread_manager.h"
+
+namespace OHOS {
+namespace Media {
+/**
+ * Local stand-in of the cloud enhancement service. It posts results to an EnhancementThreadManager from several
+ * callback threads the way the service does, and replaces the save step with a fixed cost so that the worker pool
+ * can be loaded without the service or the database. The sequence of a result within its photo travels in
+ * statusCode.
+ */
+class EnhancementServiceStandIn {
+public:
+    EnhancementServiceStandIn(EnhancementThreadManager &manager, int32_t saveCostMs);
+    ~EnhancementServiceStandIn();
+
+    // each producer thread owns a slice of the photos and posts resultsPerPhoto results for each of them
+    void PostResults(const std::vector<std::string> &photoIds, int32_t resultsPerPhoto, int32_t producerCount);
+    void PostResult(const std::string &photoId, int32_t sequence);
+    bool WaitForSaved(size_t count, int32_t timeoutMs);
+    // holds every save step until Release, to queue results up behind busy workers
+    void Hold();
+    void Release();
+    bool WaitForRunning(size_t count, int32_t timeoutMs);
+
+    // photo ids in the order their save step started
+    std::vector<std::string> GetStartOrder();
+    int32_t GetMaxConcurrency();
+    bool IsPhotoOrderKept();
+
+private:
+    void Save(CloudEnhancementThreadTask &task);
+
+    EnhancementThreadManager &manager_;
+    int32_t saveCostMs_ {0};
+    std::mutex mutex_;
+    std::condition_variable savedVar_;
+    bool isHeld_ {false};
+    size_t runningCount_ {0};
+    size_t savedCount_ {0};
+    int32_t maxConcurrency_ {0};
+    bool isPhotoOrderKept_ {true};
+    std::set<std::string> runningIds_;
+    std::map<std::string, int32_t> lastSequences_;
+    std::vector<std::string> startOrder_;
+};
+} // namespace Media
+} // namespace OHOS
+
+#endif // FRAMEWORKS_SERVICES_MEDIA_CLOUD_ENHANCEMENT_INCLUDE_ENHANCEMENT_SERVICE_STAND_IN_H
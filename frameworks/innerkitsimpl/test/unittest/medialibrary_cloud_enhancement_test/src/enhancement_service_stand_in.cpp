@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "EnhancementServiceStandIn"
+
+#include "enhancement_service_stand_in.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "media_log.h"
+
+using namespace std;
+
+namespace OHOS {
+namespace Media {
+EnhancementServiceStandIn::EnhancementServiceStandIn(EnhancementThreadManager &manager, int32_t saveCostMs)
+    : manager_(manager), saveCostMs_(saveCostMs)
+{
+    manager_.SetTaskExecutor([this](CloudEnhancementThreadTask &task) { Save(task); });
+}
+
+EnhancementServiceStandIn::~EnhancementServiceStandIn()
+{
+    Release();
+    manager_.SetTaskExecutor(nullptr);
+}
+
+void EnhancementServiceStandIn::PostResult(const string &photoId, int32_t sequence)
+{
+    CloudEnhancementThreadTask task(photoId, sequence, nullptr, 0, true, nullptr, 0);
+    manager_.OnProducerCallback(task);
+}
+
+void EnhancementServiceStandIn::PostResults(const vector<string> &photoIds, int32_t resultsPerPhoto,
+    int32_t producerCount)
+{
+    vector<thread> producers;
+    for (int32_t producer = 0; producer < producerCount; producer++) {
+        producers.emplace_back([this, &photoIds, resultsPerPhoto, producer, producerCount]() {
+            for (int32_t sequence = 0; sequence < resultsPerPhoto; sequence++) {
+                for (size_t i = static_cast<size_t>(producer); i < photoIds.size();
+                    i += static_cast<size_t>(producerCount)) {
+                    PostResult(photoIds[i], sequence);
+                }
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+}
+
+void EnhancementServiceStandIn::Save(CloudEnhancementThreadTask &task)
+{
+    {
+        unique_lock<mutex> lock(mutex_);
+        if (runningIds_.count(task.taskId) > 0) {
+            MEDIA_ERR_LOG("results of photo %{public}s are saved at the same time", task.taskId.c_str());
+            isPhotoOrderKept_ = false;
+        }
+        auto it = lastSequences_.find(task.taskId);
+        if (it != lastSequences_.end() && it->second >= task.statusCode) {
+            MEDIA_ERR_LOG("result %{public}d of photo %{public}s is saved after %{public}d",
+                task.statusCode, task.taskId.c_str(), it->second);
+            isPhotoOrderKept_ = false;
+        }
+        lastSequences_[task.taskId] = task.statusCode;
+        runningIds_.insert(task.taskId);
+        runningCount_++;
+        maxConcurrency_ = max(maxConcurrency_, static_cast<int32_t>(runningCount_));
+        startOrder_.emplace_back(task.taskId);
+        savedVar_.notify_all();
+        savedVar_.wait(lock, [this]() { return !isHeld_; });
+    }
+    // stands for the file write and the database update of one result
+    this_thread::sleep_for(chrono::milliseconds(saveCostMs_));
+    lock_guard<mutex> lock(mutex_);
+    runningIds_.erase(task.taskId);
+    runningCount_--;
+    savedCount_++;
+    savedVar_.notify_all();
+}
+
+bool EnhancementServiceStandIn::WaitForSaved(size_t count, int32_t timeoutMs)
+{
+    unique_lock<mutex> lock(mutex_);
+    return savedVar_.wait_for(lock, chrono::milliseconds(timeoutMs),
+        [this, count]() { return savedCount_ >= count; });
+}
+
+void EnhancementServiceStandIn::Hold()
+{
+    lock_guard<mutex> lock(mutex_);
+    isHeld_ = true;
+}
+
+void EnhancementServiceStandIn::Release()
+{
+    lock_guard<mutex> lock(mutex_);
+    isHeld_ = false;
+    savedVar_.notify_all();
+}
+
+bool EnhancementServiceStandIn::WaitForRunning(size_t count, int32_t timeoutMs)
+{
+    unique_lock<mutex> lock(mutex_);
+    return savedVar_.wait_for(lock, chrono::milliseconds(timeoutMs),
+        [this, count]() { return runningCount_ >= count; });
+}
+
+vector<string> EnhancementServiceStandIn::GetStartOrder()
+{
+    lock_guard<mutex> lock(mutex_);
+    return startOrder_;
+}
+
+int32_t EnhancementServiceStandIn::GetMaxConcurrency()
+{
+    lock_guard<mutex> lock(mutex_);
+    return maxConcurrency_;
+}
+
+bool EnhancementServiceStandIn::IsPhotoOrderKept()
+{
+    lock_guard<mutex> lock(mutex_);
+    return isPhotoOrderKept_;
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "EnhancementThreadManagerUnitTest"
+
+#include "enhancement_thread_manager_test.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "enhancement_service_stand_in.h"
+#include "enhancement_thread_manager.h"
+#include "media_log.h"
+
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+static constexpr int32_t SAVE_COST_MS = 2;
+static constexpr int32_t WAIT_TIMEOUT_MS = 10000;
+static constexpr size_t MAX_WORKER_NUM = 4;
+
+static vector<string> MakePhotoIds(const string &prefix, int32_t count)
+{
+    vector<string> photoIds;
+    for (int32_t i = 0; i < count; i++) {
+        photoIds.emplace_back(prefix + to_string(i));
+    }
+    return photoIds;
+}
+
+void EnhancementThreadManagerTest::SetUpTestCase(void) {}
+
+void EnhancementThreadManagerTest::TearDownTestCase(void) {}
+
+void EnhancementThreadManagerTest::SetUp() {}
+
+void EnhancementThreadManagerTest::TearDown() {}
+
+HWTEST_F(EnhancementThreadManagerTest, thread_manager_keep_photo_order_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("thread_manager_keep_photo_order_001 Start");
+    const int32_t photoCount = 8;
+    const int32_t resultsPerPhoto = 10;
+    EnhancementThreadManager manager;
+    EnhancementServiceStandIn service(manager, SAVE_COST_MS);
+    service.PostResults(MakePhotoIds("order_", photoCount), resultsPerPhoto, 4);
+
+    EXPECT_TRUE(service.WaitForSaved(photoCount * resultsPerPhoto, WAIT_TIMEOUT_MS));
+    EXPECT_TRUE(service.IsPhotoOrderKept());
+    EXPECT_LE(service.GetMaxConcurrency(), static_cast<int32_t>(MAX_WORKER_NUM));
+    MEDIA_INFO_LOG("thread_manager_keep_photo_order_001 End");
+}
+
+HWTEST_F(EnhancementThreadManagerTest, thread_manager_prioritize_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("thread_manager_prioritize_001 Start");
+    const string visibleId = "visible_0";
+    vector<string> busyIds = MakePhotoIds("busy_", MAX_WORKER_NUM);
+    vector<string> backgroundIds = MakePhotoIds("background_", 12);
+    EnhancementThreadManager manager;
+    EnhancementServiceStandIn service(manager, 0);
+
+    // saturate the pool, everything posted afterwards has to queue up
+    service.Hold();
+    for (const auto &photoId : busyIds) {
+        service.PostResult(photoId, 0);
+    }
+    ASSERT_TRUE(service.WaitForRunning(MAX_WORKER_NUM, WAIT_TIMEOUT_MS));
+    for (const auto &photoId : backgroundIds) {
+        service.PostResult(photoId, 0);
+    }
+    manager.PrioritizeTask(visibleId);
+    service.PostResult(visibleId, 0);
+    EXPECT_EQ(manager.GetWorkerCount(), MAX_WORKER_NUM);
+    service.Release();
+
+    size_t total = busyIds.size() + backgroundIds.size() + 1;
+    EXPECT_TRUE(service.WaitForSaved(total, WAIT_TIMEOUT_MS));
+    vector<string> startOrder = service.GetStartOrder();
+    ASSERT_EQ(startOrder.size(), total);
+    EXPECT_EQ(startOrder[busyIds.size()], visibleId);
+    MEDIA_INFO_LOG("thread_manager_prioritize_001 End");
+}
+
+HWTEST_F(EnhancementThreadManagerTest, thread_manager_load_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("thread_manager_load_001 Start");
+    const int32_t photoCount = 200;
+    const int32_t resultsPerPhoto = 3;
+    EnhancementThreadManager manager;
+    EnhancementServiceStandIn service(manager, 1);
+    service.PostResults(MakePhotoIds("load_", photoCount), resultsPerPhoto, 8);
+    EXPECT_LE(manager.GetWorkerCount(), MAX_WORKER_NUM);
+
+    EXPECT_TRUE(service.WaitForSaved(photoCount * resultsPerPhoto, WAIT_TIMEOUT_MS));
+    EXPECT_TRUE(service.IsPhotoOrderKept());
+    EXPECT_LE(service.GetMaxConcurrency(), static_cast<int32_t>(MAX_WORKER_NUM));
+    MEDIA_INFO_LOG("thread_manager_load_001 End");
+}
+} // namespace Media
+} // namespace OHOS
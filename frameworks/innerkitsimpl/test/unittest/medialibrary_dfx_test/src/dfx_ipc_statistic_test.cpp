@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "DfxIpcStatisticTest"
+
+#include "dfx_ipc_statistic_test.h"
+
+#include <thread>
+#include <vector>
+
+#include "dfx_ipc_statistic.h"
+#include "media_log.h"
+
+namespace OHOS::Media {
+using namespace std;
+using namespace testing::ext;
+
+static constexpr uint32_t TEST_CODE_FAST = 0xFFFF0001;
+static constexpr uint32_t TEST_CODE_SLOW = 0xFFFF0002;
+static constexpr int32_t THREAD_NUM = 4;
+static constexpr int32_t RECORD_NUM_PER_THREAD = 1000;
+
+void DfxIpcStatisticTest::SetUpTestCase(void) {}
+
+void DfxIpcStatisticTest::TearDownTestCase(void) {}
+
+void DfxIpcStatisticTest::SetUp() {}
+
+void DfxIpcStatisticTest::TearDown() {}
+
+HWTEST_F(DfxIpcStatisticTest, DfxIpcHistogram_Percentile_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("DfxIpcHistogram_Percentile_Test_001 start");
+    DfxIpcHistogram histogram(TEST_CODE_FAST);
+    // 99 fast calls and one slow call, both the median and p99 are the upper bound of the fast bucket
+    for (int32_t i = 0; i < 99; i++) {
+        histogram.Record(50, 100);
+    }
+    histogram.Record(100000, 200000);
+    histogram.RecordReject();
+
+    IpcCodeStatistic statistic = histogram.Snapshot(false);
+    EXPECT_EQ(statistic.code, TEST_CODE_FAST);
+    EXPECT_EQ(statistic.count, 100);
+    EXPECT_EQ(statistic.rejectCount, 1);
+    EXPECT_EQ(statistic.totalCostUs, 99 * 50 + 100000);
+    EXPECT_EQ(statistic.maxCostUs, 100000);
+    EXPECT_EQ(statistic.p50CostUs, 64);
+    EXPECT_EQ(statistic.p99CostUs, 64);
+    EXPECT_EQ(statistic.p99PayloadBytes, 128);
+
+    statistic = histogram.Snapshot(true);
+    EXPECT_EQ(statistic.count, 100);
+    statistic = histogram.Snapshot(false);
+    EXPECT_EQ(statistic.count, 0);
+    EXPECT_EQ(statistic.maxCostUs, 0);
+    EXPECT_EQ(statistic.p99CostUs, 0);
+    MEDIA_INFO_LOG("DfxIpcHistogram_Percentile_Test_001 end");
+}
+
+HWTEST_F(DfxIpcStatisticTest, DfxIpcStatistic_Snapshot_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("DfxIpcStatistic_Snapshot_Test_001 start");
+    DfxIpcStatistic::GetInstance().Snapshot(true);
+    auto fast = DfxIpcStatistic::GetInstance().GetHistogram(TEST_CODE_FAST);
+    auto slow = DfxIpcStatistic::GetInstance().GetHistogram(TEST_CODE_SLOW);
+    EXPECT_EQ(fast, DfxIpcStatistic::GetInstance().GetHistogram(TEST_CODE_FAST));
+
+    vector<thread> threads;
+    for (int32_t i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([fast, slow]() {
+            for (int32_t j = 0; j < RECORD_NUM_PER_THREAD; j++) {
+                fast->Record(10, 10);
+                slow->Record(1000, 10);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    vector<IpcCodeStatistic> statistics = DfxIpcStatistic::GetInstance().Snapshot(true);
+    ASSERT_EQ(statistics.size(), 2);
+    EXPECT_EQ(statistics[0].code, TEST_CODE_SLOW);
+    EXPECT_EQ(statistics[0].count, THREAD_NUM * RECORD_NUM_PER_THREAD);
+    EXPECT_EQ(statistics[1].code, TEST_CODE_FAST);
+    EXPECT_EQ(statistics[1].totalCostUs, 10 * THREAD_NUM * RECORD_NUM_PER_THREAD);
+    EXPECT_TRUE(DfxIpcStatistic::GetInstance().Snapshot(false).empty());
+    MEDIA_INFO_LOG("DfxIpcStatistic_Snapshot_Test_001 end");
+}
+} // namespace OHOS::Media
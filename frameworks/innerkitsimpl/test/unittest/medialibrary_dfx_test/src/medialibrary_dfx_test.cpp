@@ -1176,6 +1176,11 @@ HWTEST_F(MediaLibraryDfxTest, medialib_dfx_ReportAncoOperationChangeInfo_test_00
     reportData.albumOptUpdateCount = 45;
     reportData.albumOptDeleteCount = 46;
     reportData.totalOptCount = 147;
+    reportData.burstCount = 3;
+    reportData.burstMsgCount = 147;
+    reportData.burstAppliedCount = 60;
+    reportData.burstTotalLatency = 900;
+    reportData.burstMaxLatency = 500;
     int32_t result = DfxReporter::ReportAncoOperationChangeInfo(reportData);
     EXPECT_EQ(result, E_OK);
 }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "PreferencesWriteBackTest"
+
+#include "preferences_write_back_test.h"
+
+#include <chrono>
+#include <thread>
+
+#include "media_log.h"
+#include "preferences_helper.h"
+#include "preferences_write_back.h"
+
+namespace OHOS::Media {
+using namespace std;
+using namespace testing::ext;
+
+static const string TEST_XML = "/data/test/preferences_write_back_test.xml";
+static const string TEST_KEY = "test_key";
+static constexpr int64_t TEST_DELAY_MS = 200;
+static constexpr int32_t WRITE_NUM = 100;
+
+// drops the cached preferences so that the next read comes from the file
+static int32_t ReadFromFile(const string &key)
+{
+    NativePreferences::PreferencesHelper::RemovePreferencesFromCache(TEST_XML);
+    int32_t errCode = 0;
+    auto prefs = NativePreferences::PreferencesHelper::GetPreferences(TEST_XML, errCode);
+    CHECK_AND_RETURN_RET_LOG(prefs != nullptr, -1, "get preferences error: %{public}d", errCode);
+    return prefs->GetInt(key, 0);
+}
+
+static shared_ptr<NativePreferences::Preferences> GetTestPreferences()
+{
+    int32_t errCode = 0;
+    return NativePreferences::PreferencesHelper::GetPreferences(TEST_XML, errCode);
+}
+
+void PreferencesWriteBackTest::SetUpTestCase(void) {}
+
+void PreferencesWriteBackTest::TearDownTestCase(void) {}
+
+void PreferencesWriteBackTest::SetUp()
+{
+    NativePreferences::PreferencesHelper::DeletePreferences(TEST_XML);
+}
+
+void PreferencesWriteBackTest::TearDown()
+{
+    NativePreferences::PreferencesHelper::DeletePreferences(TEST_XML);
+}
+
+HWTEST_F(PreferencesWriteBackTest, PreferencesWriteBack_Coalesce_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("PreferencesWriteBack_Coalesce_Test_001 start");
+    PreferencesWriteBack writeBack(TEST_DELAY_MS);
+    auto prefs = GetTestPreferences();
+    ASSERT_NE(prefs, nullptr);
+    for (int32_t i = 1; i <= WRITE_NUM; i++) {
+        prefs->PutInt(TEST_KEY, i);
+        writeBack.MarkDirty(prefs);
+    }
+    // every write lands in one pending flush and reads are served from memory meanwhile
+    EXPECT_EQ(writeBack.GetPendingCount(), 1);
+    EXPECT_EQ(prefs->GetInt(TEST_KEY, 0), WRITE_NUM);
+
+    this_thread::sleep_for(chrono::milliseconds(TEST_DELAY_MS * 5));
+    EXPECT_EQ(writeBack.GetPendingCount(), 0);
+    EXPECT_EQ(ReadFromFile(TEST_KEY), WRITE_NUM);
+    MEDIA_INFO_LOG("PreferencesWriteBack_Coalesce_Test_001 end");
+}
+
+HWTEST_F(PreferencesWriteBackTest, PreferencesWriteBack_Barrier_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("PreferencesWriteBack_Barrier_Test_001 start");
+    // a delay far beyond the test, only barriers and critical writes reach the file
+    PreferencesWriteBack writeBack(TEST_DELAY_MS * 1000);
+    auto prefs = GetTestPreferences();
+    ASSERT_NE(prefs, nullptr);
+    prefs->PutInt(TEST_KEY, 1);
+    writeBack.MarkDirty(prefs);
+    writeBack.FlushAll();
+    EXPECT_EQ(writeBack.GetPendingCount(), 0);
+    EXPECT_EQ(ReadFromFile(TEST_KEY), 1);
+
+    prefs = GetTestPreferences();
+    ASSERT_NE(prefs, nullptr);
+    prefs->PutInt(TEST_KEY, 2);
+    writeBack.MarkDirty(prefs, true);
+    EXPECT_EQ(writeBack.GetPendingCount(), 0);
+    EXPECT_EQ(ReadFromFile(TEST_KEY), 2);
+
+    prefs = GetTestPreferences();
+    ASSERT_NE(prefs, nullptr);
+    prefs->PutInt(TEST_KEY, 3);
+    writeBack.MarkDirty(prefs);
+    writeBack.Stop();
+    EXPECT_EQ(writeBack.GetPendingCount(), 0);
+    EXPECT_EQ(ReadFromFile(TEST_KEY), 3);
+
+    // the timer starts again with the next write after a stop
+    prefs = GetTestPreferences();
+    ASSERT_NE(prefs, nullptr);
+    prefs->PutInt(TEST_KEY, 4);
+    writeBack.MarkDirty(prefs);
+    EXPECT_EQ(writeBack.GetPendingCount(), 1);
+    writeBack.Stop();
+    EXPECT_EQ(ReadFromFile(TEST_KEY), 4);
+    MEDIA_INFO_LOG("PreferencesWriteBack_Barrier_Test_001 end");
+}
+HWTEST_F(PreferencesWriteBackTest, PreferencesWriteBack_Destroy_Test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("PreferencesWriteBack_Destroy_Test_001 start");
+    auto prefs = GetTestPreferences();
+    ASSERT_NE(prefs, nullptr);
+    {
+        // destroying an instance with a pending write neither blocks nor drops the delayed flush
+        PreferencesWriteBack writeBack(TEST_DELAY_MS);
+        prefs->PutInt(TEST_KEY, 1);
+        writeBack.MarkDirty(prefs);
+    }
+    this_thread::sleep_for(chrono::milliseconds(TEST_DELAY_MS * 5));
+    EXPECT_EQ(ReadFromFile(TEST_KEY), 1);
+    MEDIA_INFO_LOG("PreferencesWriteBack_Destroy_Test_001 end");
+}
+} // namespace OHOS::Media
@@ -19,6 +19,7 @@
 #include <fstream>
 #include <iterator>
 
+#include "media_file_copy_engine.h"
 #include "media_file_uri.h"
 #include "media_file_utils.h"
 #include "media_log.h"
@@ -291,6 +292,80 @@ HWTEST_F(MediaLibraryHelperUnitTest, MediaFileUtils_CheckFileDisplayName_Test_00
     EXPECT_EQ(MediaFileUtils::CheckFileDisplayName(displayName), 0);
 }
 
+HWTEST_F(MediaLibraryHelperUnitTest, MediaFileUtils_CopyFileUtil_Test_003, TestSize.Level1)
+{
+    string srcFile = "/data/test/copyfileutil_003_src";
+    string dstFile = "/data/test/copyfileutil_003_dst";
+    // large enough to take the parallel copy_file_range path when reflink is unavailable
+    const size_t fileSize = 80 * 1024 * 1024 + 123;
+    string content(fileSize, '\0');
+    for (size_t i = 0; i < fileSize; i++) {
+        content[i] = static_cast<char>(i % 251);
+    }
+    EXPECT_EQ(MediaFileUtils::CreateFile(srcFile), true);
+    EXPECT_EQ(MediaFileUtils::WriteStrToFile(srcFile, content), true);
+
+    FileCopyStats stats;
+    EXPECT_EQ(MediaFileUtils::CopyFileUtil(srcFile, dstFile, stats), true);
+    EXPECT_NE(stats.method, FileCopyMethod::NONE);
+    EXPECT_EQ(stats.bytes, static_cast<int64_t>(fileSize));
+    GTEST_LOG_(INFO) << "copy method: " << static_cast<int32_t>(stats.method) << ", throughput: " <<
+        stats.GetThroughputMBps() << " MB/s";
+    string copied;
+    EXPECT_EQ(MediaFileUtils::ReadStrFromFile(dstFile, copied), true);
+    EXPECT_EQ(copied == content, true);
+
+    EXPECT_EQ(MediaFileUtils::DeleteFile(srcFile), true);
+    EXPECT_EQ(MediaFileUtils::DeleteFile(dstFile), true);
+}
+
+HWTEST_F(MediaLibraryHelperUnitTest, MediaFileUtils_SegmentedCopyFileUtile_Test_001, TestSize.Level1)
+{
+    string srcFile = "/data/test/segmentedcopy_001_src";
+    string dstFile = "/data/test/segmentedcopy_001_dst";
+    string testString(1024 * 1024, 'a');
+    EXPECT_EQ(MediaFileUtils::CreateFile(srcFile), true);
+    EXPECT_EQ(MediaFileUtils::WriteStrToFile(srcFile, testString), true);
+
+    uint64_t progress = 0;
+    auto progressCallback = [&progress](uint64_t size) { progress += size; };
+    EXPECT_EQ(MediaFileUtils::SegmentedCopyFileUtile(srcFile, dstFile, progressCallback, "segmented_001"), E_OK);
+    EXPECT_EQ(progress, testString.size());
+    string copied;
+    EXPECT_EQ(MediaFileUtils::ReadStrFromFile(dstFile, copied), true);
+    EXPECT_EQ(copied, testString);
+
+    EXPECT_EQ(MediaFileUtils::DeleteFile(srcFile), true);
+    EXPECT_EQ(MediaFileUtils::DeleteFile(dstFile), true);
+}
+
+HWTEST_F(MediaLibraryHelperUnitTest, MediaFileUtils_CopyDirectory_Test_001, TestSize.Level1)
+{
+    string srcDir = "/data/test/copydirectory_batch_src";
+    string dstDir = "/data/test/copydirectory_batch_dst";
+    const int32_t fileCount = 32;
+    EXPECT_EQ(MediaFileUtils::CreateDirectory(srcDir), true);
+    EXPECT_EQ(MediaFileUtils::CreateDirectory(srcDir + "/sub"), true);
+    for (int32_t i = 0; i < fileCount; i++) {
+        EXPECT_EQ(MediaFileUtils::CreateFile(srcDir + "/sub/" + to_string(i)), true);
+        EXPECT_EQ(MediaFileUtils::WriteStrToFile(srcDir + "/sub/" + to_string(i), to_string(i)), true);
+    }
+    EXPECT_EQ(MediaFileUtils::CopyDirectory(srcDir, dstDir), E_OK);
+    for (int32_t i = 0; i < fileCount; i++) {
+        string copied;
+        EXPECT_EQ(MediaFileUtils::ReadStrFromFile(dstDir + "/sub/" + to_string(i), copied), true);
+        EXPECT_EQ(copied, to_string(i));
+    }
+
+    vector<FileCopyTask> tasks = {{srcDir + "/not_exist", dstDir + "/not_exist"}};
+    FileCopyStats stats;
+    EXPECT_NE(MediaFileCopyEngine::CopyFilesInBatch(tasks, stats), E_OK);
+    EXPECT_EQ(tasks[0].isSuccess, false);
+
+    EXPECT_EQ(MediaFileUtils::DeleteDir(srcDir), true);
+    EXPECT_EQ(MediaFileUtils::DeleteDir(dstDir), true);
+}
+
 HWTEST_F(MediaLibraryHelperUnitTest, MediaFileUtils_CheckAlbumName_Test_001, TestSize.Level1)
 {
     EXPECT_LT(MediaFileUtils::CheckAlbumName(".", true), 0);
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mtp_buffer_pool_test.h"
+#include "mtp_buffer_pool.h"
+#include "header_data.h"
+#include "media_mtp_utils.h"
+#include "mtp_constants.h"
+#include "mtp_packet.h"
+#include "mtp_packet_tools.h"
+#include "payload_data/resp_common_data.h"
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+const uint32_t TEST_TRANSACTION_ID = 7;
+const uint32_t TEST_PARAM_VALUE = 0x1234;
+const size_t TEST_CAPACITY = 1024;
+
+void MtpBufferPoolTest::SetUpTestCase(void) {}
+void MtpBufferPoolTest::TearDownTestCase(void) {}
+void MtpBufferPoolTest::SetUp()
+{
+    MtpBufferPool::GetInstance().Clear();
+}
+void MtpBufferPoolTest::TearDown(void)
+{
+    MtpBufferPool::GetInstance().Clear();
+}
+
+/*
+ * Feature: MediaLibraryMTP
+ * Function:
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: released buffers are reused and come back empty
+ */
+HWTEST_F(MtpBufferPoolTest, mtp_buffer_pool_test_001, TestSize.Level1)
+{
+    MtpBufferPool &pool = MtpBufferPool::GetInstance();
+    vector<uint8_t> buffer = pool.Acquire(TEST_CAPACITY);
+    EXPECT_GE(buffer.capacity(), TEST_CAPACITY);
+    buffer.assign(TEST_CAPACITY, 1);
+    const uint8_t *data = buffer.data();
+    pool.Release(std::move(buffer));
+    EXPECT_EQ(pool.GetIdleCount(), 1);
+
+    vector<uint8_t> reused = pool.Acquire(TEST_CAPACITY / 2);
+    EXPECT_TRUE(reused.empty());
+    EXPECT_EQ(reused.data(), data);
+    EXPECT_EQ(pool.GetIdleCount(), 0);
+}
+
+/*
+ * Feature: MediaLibraryMTP
+ * Function:
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: the pool stays bounded in count and buffer size
+ */
+HWTEST_F(MtpBufferPoolTest, mtp_buffer_pool_test_002, TestSize.Level1)
+{
+    MtpBufferPool &pool = MtpBufferPool::GetInstance();
+    pool.Release(pool.Acquire(MtpBufferPool::MAX_POOLED_CAPACITY + 1));
+    EXPECT_EQ(pool.GetIdleCount(), 0);
+
+    for (size_t i = 0; i < MtpBufferPool::MAX_IDLE_BUFFERS + 2; i++) {
+        pool.Release(vector<uint8_t>(TEST_CAPACITY));
+    }
+    EXPECT_EQ(pool.GetIdleCount(), MtpBufferPool::MAX_IDLE_BUFFERS);
+}
+
+/*
+ * Feature: MediaLibraryMTP
+ * Function:
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: single pass Maker writes the real container length into the header
+ */
+HWTEST_F(MtpBufferPoolTest, mtp_buffer_pool_test_003, TestSize.Level1)
+{
+    shared_ptr<MtpOperationContext> context = make_shared<MtpOperationContext>();
+    shared_ptr<HeaderData> header = make_shared<HeaderData>(RESPONSE_CONTAINER_TYPE, MTP_OK_CODE,
+        TEST_TRANSACTION_ID);
+    shared_ptr<RespCommonData> resp = make_shared<RespCommonData>();
+    resp->SetParam(1, TEST_PARAM_VALUE);
+    shared_ptr<PayloadData> payload = resp;
+    MtpPacket packet(context);
+    packet.Init(header, payload);
+    ASSERT_EQ(packet.Maker(false), MTP_SUCCESS);
+
+    uint32_t expected = PACKET_HEADER_LENGETH + sizeof(uint32_t);
+    ASSERT_EQ(packet.writeBuffer_.size(), expected);
+    EXPECT_EQ(packet.writeSize_, expected);
+    EXPECT_EQ(header->GetContainerLength(), expected);
+    EXPECT_EQ(MtpPacketTool::GetUInt32(packet.writeBuffer_[0], packet.writeBuffer_[1], packet.writeBuffer_[2],
+        packet.writeBuffer_[3]), expected);
+
+    packet.Reset();
+    EXPECT_TRUE(packet.writeBuffer_.empty());
+    EXPECT_EQ(MtpBufferPool::GetInstance().GetIdleCount(), 1);
+}
+} // namespace Media
+} // namespace OHOS
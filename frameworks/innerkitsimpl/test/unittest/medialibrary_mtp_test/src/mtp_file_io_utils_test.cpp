@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mtp_file_io_utils_test.h"
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "medialibrary_errno.h"
+#include "mtp_file_io_utils.h"
+using namespace std;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+// larger than a pipe, so the writer sees short writes while the reader drains it
+const size_t TEST_DATA_SIZE = 1024 * 1024 + 17;
+const size_t TEST_READ_SIZE = 4096;
+
+void MtpFileIoUtilsTest::SetUpTestCase(void) {}
+void MtpFileIoUtilsTest::TearDownTestCase(void) {}
+void MtpFileIoUtilsTest::SetUp() {}
+void MtpFileIoUtilsTest::TearDown(void) {}
+
+/*
+ * Feature: MediaLibraryMTP
+ * Function: WriteAll
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: a chunk larger than one write is written completely and in order
+ */
+HWTEST_F(MtpFileIoUtilsTest, mtp_file_io_utils_test_001, TestSize.Level1)
+{
+    vector<uint8_t> data(TEST_DATA_SIZE);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i % 251);
+    }
+    int pipeFds[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipeFds), 0);
+    vector<uint8_t> received;
+    thread reader([&pipeFds, &received] {
+        vector<uint8_t> buffer(TEST_READ_SIZE);
+        ssize_t ret = 0;
+        while ((ret = read(pipeFds[0], buffer.data(), buffer.size())) > 0) {
+            received.insert(received.end(), buffer.begin(), buffer.begin() + ret);
+        }
+    });
+    EXPECT_EQ(MtpFileIoUtils::WriteAll(pipeFds[1], data.data(), data.size()), MTP_SUCCESS);
+    close(pipeFds[1]);
+    reader.join();
+    close(pipeFds[0]);
+    EXPECT_TRUE(received == data);
+}
+
+/*
+ * Feature: MediaLibraryMTP
+ * Function: WriteAll ReadAhead
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: an empty chunk is a no-op, a bad fd fails, ReadAhead ignores bad ranges
+ */
+HWTEST_F(MtpFileIoUtilsTest, mtp_file_io_utils_test_002, TestSize.Level1)
+{
+    uint8_t byte = 1;
+    EXPECT_EQ(MtpFileIoUtils::WriteAll(-1, nullptr, 0), MTP_SUCCESS);
+    EXPECT_NE(MtpFileIoUtils::WriteAll(-1, &byte, 1), MTP_SUCCESS);
+    EXPECT_NE(MtpFileIoUtils::WriteAll(STDOUT_FILENO, nullptr, 1), MTP_SUCCESS);
+
+    char path[] = "/data/local/tmp/mtp_file_io_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    unlink(path);
+    EXPECT_EQ(MtpFileIoUtils::WriteAll(fd, &byte, 1), MTP_SUCCESS);
+    MtpFileIoUtils::ReadAhead(fd, 0, 1);
+    MtpFileIoUtils::ReadAhead(fd, -1, 1);
+    MtpFileIoUtils::ReadAhead(fd, 0, 0);
+    MtpFileIoUtils::ReadAhead(-1, 0, 1);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 1);
+    close(fd);
+}
+} // namespace Media
+} // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include "medialibrary_multistages_capture_test.h"
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -1286,5 +1287,37 @@ HWTEST_F(MediaLibraryMultiStagesPhotoCaptureTest, CheckMovingPhotoFlag_test_001,
     delete callback;
     MEDIA_INFO_LOG("CheckMovingPhotoFlag_test_001 End");
 }
+
+HWTEST_F(MediaLibraryMultiStagesPhotoCaptureTest, SaveImage_burst_test_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("SaveImage_burst_test_001 Start");
+    const int32_t frameCount = 30;
+    const size_t frameSize = 512 * 1024;
+    vector<uint8_t> frame(frameSize, 0x5a);
+    atomic<int32_t> failedCount {0};
+    vector<thread> writers;
+    for (int32_t i = 0; i < frameCount; i++) {
+        writers.emplace_back([i, &frame, &failedCount]() {
+            string path = "/data/test/burst_save_image_" + to_string(i) + ".jpg";
+            if (FileUtils::SaveImage(path, frame.data(), frame.size()) != E_OK) {
+                failedCount++;
+            }
+        });
+    }
+    for (auto &writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(failedCount.load(), 0);
+
+    for (int32_t i = 0; i < frameCount; i++) {
+        string path = "/data/test/burst_save_image_" + to_string(i) + ".jpg";
+        size_t size = 0;
+        EXPECT_EQ(MediaFileUtils::GetFileSize(path, size), true);
+        EXPECT_EQ(size, frameSize);
+        EXPECT_EQ(MediaFileUtils::IsFileExists(path + ".high"), false);
+        MediaFileUtils::DeleteFile(path);
+    }
+    MEDIA_INFO_LOG("SaveImage_burst_test_001 End");
+}
 }
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "MediaLibraryQueryShapeCacheTest"
+
+#include "medialibrary_query_shape_cache_test.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "ability_context_impl.h"
+#include "context.h"
+#include "dfx_query_statistic.h"
+#include "media_column.h"
+#include "media_log.h"
+#include "media_upgrade.h"
+#include "medialibrary_query_shape_cache.h"
+#include "medialibrary_rdbstore.h"
+#include "rdb_predicates.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace testing::ext;
+using namespace NativeRdb;
+
+namespace OHOS {
+namespace Media {
+
+static constexpr int32_t SLEEP_FIVE_SECONDS = 5;
+static constexpr int32_t TEST_PHOTO_NUM = 10;
+static shared_ptr<MediaLibraryRdbStore> rdbStorePtr = nullptr;
+
+static const vector<string> PHOTOS_QUERY_COLUMNS = {
+    PhotoColumn::MEDIA_ID,
+    PhotoColumn::MEDIA_NAME,
+    PhotoColumn::MEDIA_SIZE,
+};
+
+static void SetTables()
+{
+    CHECK_AND_RETURN_LOG(rdbStorePtr != nullptr, "can not get rdbStorePtr");
+    rdbStorePtr->ExecuteSql("DROP TABLE IF EXISTS " + PhotoColumn::PHOTOS_TABLE);
+    int32_t ret = rdbStorePtr->ExecuteSql(PhotoUpgrade::CREATE_PHOTO_TABLE);
+    CHECK_AND_RETURN_LOG(ret == NativeRdb::E_OK, "create photos table failed");
+    for (int32_t i = 1; i <= TEST_PHOTO_NUM; i++) {
+        ValuesBucket values;
+        values.Put(PhotoColumn::MEDIA_NAME, i % 2 == 0 ? "it's_" + to_string(i) + ".jpg" : "IMG_" + to_string(i));
+        values.Put(PhotoColumn::MEDIA_SIZE, static_cast<int64_t>(i * 1000));
+        int64_t rowId = -1;
+        MediaLibraryRdbStore::Insert(rowId, PhotoColumn::PHOTOS_TABLE, values);
+    }
+}
+
+void MediaLibraryQueryShapeCacheTest::SetUpTestCase(void)
+{
+    auto stageContext = std::make_shared<AbilityRuntime::ContextImpl>();
+    auto abilityContextImpl = std::make_shared<OHOS::AbilityRuntime::AbilityContextImpl>();
+    abilityContextImpl->SetStageContext(stageContext);
+    rdbStorePtr = std::make_shared<MediaLibraryRdbStore>(abilityContextImpl);
+    int32_t ret = rdbStorePtr->Init();
+    SetTables();
+    MEDIA_INFO_LOG("MediaLibraryQueryShapeCacheTest rdbstore start ret = %{public}d", ret);
+}
+
+void MediaLibraryQueryShapeCacheTest::TearDownTestCase(void)
+{
+    std::this_thread::sleep_for(std::chrono::seconds(SLEEP_FIVE_SECONDS));
+}
+
+void MediaLibraryQueryShapeCacheTest::SetUp() {}
+
+void MediaLibraryQueryShapeCacheTest::TearDown() {}
+
+static vector<string> GetRows(shared_ptr<ResultSet> resultSet)
+{
+    vector<string> rows;
+    CHECK_AND_RETURN_RET(resultSet != nullptr, rows);
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        string row;
+        for (int32_t i = 0; i < static_cast<int32_t>(PHOTOS_QUERY_COLUMNS.size()); i++) {
+            string value;
+            resultSet->GetString(i, value);
+            row += value + "|";
+        }
+        rows.push_back(row);
+    }
+    resultSet->Close();
+    return rows;
+}
+
+/**
+ * @tc.name: QueryShapeCache_Normalize_001
+ * @tc.desc: 整数、浮点和字符串字面量被替换为占位符，并按占位符顺序与原有参数合并
+ */
+HWTEST_F(MediaLibraryQueryShapeCacheTest, QueryShapeCache_Normalize_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("enter QueryShapeCache_Normalize_001");
+    string whereClause = "file_id = 5 AND display_name = 'it''s' AND size > ? AND t1.col2 = 0x1F "
+        "AND \"col 3\" = 'a' AND data = X'00' AND media_type IN (1, 2.5)";
+    vector<ValueObject> whereArgs = { ValueObject(string("100")) };
+    string shape;
+    vector<ValueObject> bindArgs;
+    size_t literalCount = 0;
+    ASSERT_TRUE(MediaLibraryQueryShapeCache::NormalizeWhereClause(whereClause, whereArgs, shape, bindArgs,
+        literalCount));
+    EXPECT_EQ(shape, "file_id = ? AND display_name = ? AND size > ? AND t1.col2 = 0x1F "
+        "AND \"col 3\" = ? AND data = X'00' AND media_type IN (?, ?)");
+    EXPECT_EQ(literalCount, 5);
+    ASSERT_EQ(bindArgs.size(), 6);
+    int64_t longValue = 0;
+    string stringValue;
+    double doubleValue = 0;
+    EXPECT_EQ(bindArgs[0].GetLong(longValue), NativeRdb::E_OK);
+    EXPECT_EQ(longValue, 5);
+    EXPECT_EQ(bindArgs[1].GetString(stringValue), NativeRdb::E_OK);
+    EXPECT_EQ(stringValue, "it's");
+    EXPECT_EQ(bindArgs[2].GetString(stringValue), NativeRdb::E_OK);
+    EXPECT_EQ(stringValue, "100");
+    EXPECT_EQ(bindArgs[3].GetString(stringValue), NativeRdb::E_OK);
+    EXPECT_EQ(stringValue, "a");
+    EXPECT_EQ(bindArgs[5].GetDouble(doubleValue), NativeRdb::E_OK);
+    EXPECT_EQ(doubleValue, 2.5);
+
+    // column positions in a subquery, unterminated quotes and missing arguments are not normalised
+    EXPECT_FALSE(MediaLibraryQueryShapeCache::NormalizeWhereClause(
+        "file_id IN (SELECT file_id FROM Photos ORDER BY 1)", {}, shape, bindArgs, literalCount));
+    EXPECT_FALSE(MediaLibraryQueryShapeCache::NormalizeWhereClause("title = 'a", {}, shape, bindArgs,
+        literalCount));
+    EXPECT_FALSE(MediaLibraryQueryShapeCache::NormalizeWhereClause("title = ?", {}, shape, bindArgs,
+        literalCount));
+    MEDIA_INFO_LOG("end QueryShapeCache_Normalize_001");
+}
+
+/**
+ * @tc.name: QueryShapeCache_Lru_001
+ * @tc.desc: 相同形状的查询命中缓存，超出容量时淘汰最久未使用的形状
+ */
+HWTEST_F(MediaLibraryQueryShapeCacheTest, QueryShapeCache_Lru_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("enter QueryShapeCache_Lru_001");
+    MediaLibraryQueryShapeCache cache(2);
+    QueryShapeStatistic before = DfxQueryStatistic::GetInstance().Snapshot(false);
+    string sql;
+    vector<ValueObject> bindArgs;
+    for (int32_t i = 1; i <= TEST_PHOTO_NUM; i++) {
+        RdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
+        predicates.SetWhereClause(PhotoColumn::MEDIA_ID + " = " + to_string(i));
+        ASSERT_TRUE(cache.GetQuerySql(predicates, PHOTOS_QUERY_COLUMNS, sql, bindArgs));
+        ASSERT_EQ(bindArgs.size(), 1);
+    }
+    RdbPredicates sizePredicates(PhotoColumn::PHOTOS_TABLE);
+    sizePredicates.SetWhereClause(PhotoColumn::MEDIA_SIZE + " > 1000");
+    ASSERT_TRUE(cache.GetQuerySql(sizePredicates, PHOTOS_QUERY_COLUMNS, sql, bindArgs));
+    RdbPredicates namePredicates(PhotoColumn::PHOTOS_TABLE);
+    namePredicates.SetWhereClause(PhotoColumn::MEDIA_NAME + " = 'IMG_1'");
+    ASSERT_TRUE(cache.GetQuerySql(namePredicates, PHOTOS_QUERY_COLUMNS, sql, bindArgs));
+    EXPECT_EQ(cache.GetSize(), 2);
+
+    QueryShapeStatistic after = DfxQueryStatistic::GetInstance().Snapshot(false);
+    EXPECT_EQ(after.hitCount - before.hitCount, TEST_PHOTO_NUM - 1);
+    EXPECT_EQ(after.missCount - before.missCount, 3);
+    EXPECT_EQ(after.evictCount - before.evictCount, 1);
+    EXPECT_EQ(after.literalCount - before.literalCount, TEST_PHOTO_NUM + 2);
+    // 未命中的端到端耗时包含sql构造耗时
+    EXPECT_GE(after.missCostUs - before.missCostUs, after.buildCostUs - before.buildCostUs);
+    MEDIA_INFO_LOG("end QueryShapeCache_Lru_001");
+}
+
+/**
+ * @tc.name: QueryShapeCache_Query_001
+ * @tc.desc: 通过形状缓存生成的sql与按谓词查询的结果一致
+ */
+HWTEST_F(MediaLibraryQueryShapeCacheTest, QueryShapeCache_Query_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("enter QueryShapeCache_Query_001");
+    ASSERT_NE(rdbStorePtr, nullptr);
+    vector<string> whereClauses = {
+        PhotoColumn::MEDIA_ID + " = 3",
+        PhotoColumn::MEDIA_ID + " IN (1, 2, 4) AND " + PhotoColumn::MEDIA_SIZE + " >= 2000",
+        PhotoColumn::MEDIA_NAME + " = 'it''s_4.jpg'",
+        "(" + PhotoColumn::MEDIA_SIZE + " / 1000) > 5",
+        PhotoColumn::MEDIA_NAME + " LIKE 'IMG%' AND " + PhotoColumn::MEDIA_SIZE + " < ?",
+    };
+    for (const auto &whereClause : whereClauses) {
+        RdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
+        predicates.SetWhereClause(whereClause);
+        if (whereClause.find('?') != string::npos) {
+            predicates.SetWhereArgs({ "9000" });
+        }
+        predicates.OrderByAsc(PhotoColumn::MEDIA_ID);
+        string sql;
+        vector<ValueObject> bindArgs;
+        ASSERT_TRUE(MediaLibraryQueryShapeCache::GetInstance().GetQuerySql(predicates, PHOTOS_QUERY_COLUMNS, sql,
+            bindArgs));
+        vector<string> expectedRows = GetRows(MediaLibraryRdbStore::GetRaw()->QueryByStep(predicates,
+            PHOTOS_QUERY_COLUMNS));
+        vector<string> rows = GetRows(MediaLibraryRdbStore::GetRaw()->QueryByStep(sql, bindArgs));
+        EXPECT_FALSE(expectedRows.empty());
+        EXPECT_EQ(rows, expectedRows);
+    }
+    MEDIA_INFO_LOG("end QueryShapeCache_Query_001");
+}
+
+/**
+ * @tc.name: QueryShapeCache_NetSavedCost_001
+ * @tc.desc: 净收益为未缓存时的sql构造耗时减去缓存路径的端到端耗时
+ */
+HWTEST_F(MediaLibraryQueryShapeCacheTest, QueryShapeCache_NetSavedCost_001, TestSize.Level1)
+{
+    MEDIA_INFO_LOG("enter QueryShapeCache_NetSavedCost_001");
+    QueryShapeStatistic statistic;
+    EXPECT_EQ(DfxQueryStatistic::GetNetSavedCostUs(statistic), 0);
+    statistic.hitCount = 10;
+    statistic.missCount = 2;
+    statistic.buildCostUs = 20;
+    statistic.hitCostUs = 15;
+    statistic.missCostUs = 30;
+    statistic.bypassCostUs = 5;
+    // 12 * 10 - (15 + 30 + 5)
+    EXPECT_EQ(DfxQueryStatistic::GetNetSavedCostUs(statistic), 70);
+    statistic.hitCostUs = 150;
+    EXPECT_EQ(DfxQueryStatistic::GetNetSavedCostUs(statistic), -65);
+    MEDIA_INFO_LOG("end QueryShapeCache_NetSavedCost_001");
+}
+
+} // namespace Media
+} // namespace OHOS
@@ -459,5 +459,30 @@ HWTEST_F(MediaLibraryRdbStoreUpdateTest, MediaLibraryRdbStore_Update_NoStrategyT
     EXPECT_EQ(ret, NativeRdb::E_OK);
 }
 
+/**
+ * @tc.name: [索引进度测试: 影响统计的写入] MediaLibraryRdbStore_IsIndexProgressChanged_001
+ * @tc.desc: 测试MediaLibraryRdbStore::IsIndexProgressChanged对写入的判定
+ *           [1] Photos表整行插入或删除需刷新计数
+ *           [2] Photos表隐藏、删除到回收站等列更新需刷新计数
+ *           [3] Photos表其他列更新及其他表写入不需刷新计数
+ */
+HWTEST_F(MediaLibraryRdbStoreUpdateTest, MediaLibraryRdbStore_IsIndexProgressChanged_001, TestSize.Level1)
+{
+    EXPECT_TRUE(MediaLibraryRdbStore::IsIndexProgressChanged(PhotoColumn::PHOTOS_TABLE, nullptr));
+
+    ValuesBucket hiddenValues;
+    hiddenValues.Put(MediaColumn::MEDIA_HIDDEN, 1);
+    EXPECT_TRUE(MediaLibraryRdbStore::IsIndexProgressChanged(PhotoColumn::PHOTOS_TABLE, &hiddenValues));
+    ValuesBucket trashedValues;
+    trashedValues.Put(MediaColumn::MEDIA_DATE_TRASHED, 1);
+    EXPECT_TRUE(MediaLibraryRdbStore::IsIndexProgressChanged(PhotoColumn::PHOTOS_TABLE, &trashedValues));
+
+    ValuesBucket nameValues;
+    nameValues.Put(MediaColumn::MEDIA_NAME, "test.jpg");
+    EXPECT_FALSE(MediaLibraryRdbStore::IsIndexProgressChanged(PhotoColumn::PHOTOS_TABLE, &nameValues));
+    EXPECT_FALSE(MediaLibraryRdbStore::IsIndexProgressChanged("test_no_strategy_table", nullptr));
+    EXPECT_FALSE(MediaLibraryRdbStore::IsIndexProgressChanged("test_no_strategy_table", &hiddenValues));
+}
+
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "metadata_header_parser_test.h"
+
+#define private public
+#include "metadata_extractor.h"
+#undef private
+
+#include <chrono>
+#include <dirent.h>
+#include <fstream>
+#include <vector>
+
+#include "image_source.h"
+#include "media_exif.h"
+#include "media_file_utils.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+#include "metadata_header_parser.h"
+#include "userfile_manager_types.h"
+
+using namespace std;
+using namespace OHOS;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+static const string TEST_DIR = "/storage/cloud/100/files/Documents/";
+static const string TEST_IMAGE_PATH = TEST_DIR + "CreateImageLcdTest_001.jpg";
+static const string TEST_VIDEO_PATH = TEST_DIR + "CreateVideoThumbnailTest_001.mp4";
+// optional on-device corpus, every file in it is checked against the full extractors
+static const string TEST_CORPUS_DIR = "/data/local/tmp/metadata_corpus/";
+static constexpr int32_t BENCHMARK_ROUNDS = 20;
+static constexpr double MS_PER_SECOND = 1000.0;
+
+void MediaLibraryMetadataHeaderParserTest::SetUpTestCase(void) {}
+
+void MediaLibraryMetadataHeaderParserTest::TearDownTestCase(void) {}
+
+void MediaLibraryMetadataHeaderParserTest::SetUp() {}
+
+void MediaLibraryMetadataHeaderParserTest::TearDown(void) {}
+
+static void PutBe16(vector<uint8_t> &buf, uint16_t value)
+{
+    buf.push_back(static_cast<uint8_t>(value >> 8));
+    buf.push_back(static_cast<uint8_t>(value));
+}
+
+static void PutBe32(vector<uint8_t> &buf, uint32_t value)
+{
+    PutBe16(buf, static_cast<uint16_t>(value >> 16));
+    PutBe16(buf, static_cast<uint16_t>(value));
+}
+
+static void PutStr(vector<uint8_t> &buf, const string &str)
+{
+    buf.insert(buf.end(), str.begin(), str.end());
+}
+
+static void PutIfdEntry(vector<uint8_t> &buf, uint16_t tag, uint16_t type, uint32_t count, uint32_t value)
+{
+    PutBe16(buf, tag);
+    PutBe16(buf, type);
+    PutBe32(buf, count);
+    PutBe32(buf, value);
+}
+
+static vector<uint8_t> Box(const string &type, const vector<uint8_t> &payload)
+{
+    vector<uint8_t> box;
+    PutBe32(box, static_cast<uint32_t>(payload.size() + 8));
+    PutStr(box, type);
+    box.insert(box.end(), payload.begin(), payload.end());
+    return box;
+}
+
+static void WriteFile(const string &path, const vector<uint8_t> &content)
+{
+    ofstream file(path, ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char *>(content.data()), content.size());
+}
+
+// JPEG with Orientation 6, DateTimeOriginal and GPS 30°30'0" S / 120°15'0" E, 640x480
+static vector<uint8_t> BuildExifJpeg()
+{
+    const uint32_t ifd0Offset = 8;
+    const uint32_t ifd0Size = 2 + 3 * 12 + 4;
+    const uint32_t exifIfdOffset = ifd0Offset + ifd0Size;
+    const uint32_t exifIfdSize = 2 + 12 + 4;
+    const uint32_t gpsIfdOffset = exifIfdOffset + exifIfdSize;
+    const uint32_t gpsIfdSize = 2 + 4 * 12 + 4;
+    const uint32_t dateOffset = gpsIfdOffset + gpsIfdSize;
+    const uint32_t latOffset = dateOffset + 20;
+    const uint32_t lonOffset = latOffset + 24;
+
+    vector<uint8_t> tiff;
+    PutStr(tiff, "MM");
+    PutBe16(tiff, 42);
+    PutBe32(tiff, ifd0Offset);
+    PutBe16(tiff, 3);
+    PutIfdEntry(tiff, 0x0112, 3, 1, 6 << 16);
+    PutIfdEntry(tiff, 0x8769, 4, 1, exifIfdOffset);
+    PutIfdEntry(tiff, 0x8825, 4, 1, gpsIfdOffset);
+    PutBe32(tiff, 0);
+    PutBe16(tiff, 1);
+    PutIfdEntry(tiff, 0x9003, 2, 20, dateOffset);
+    PutBe32(tiff, 0);
+    PutBe16(tiff, 4);
+    PutIfdEntry(tiff, 0x0001, 2, 2, 'S' << 24);
+    PutIfdEntry(tiff, 0x0002, 5, 3, latOffset);
+    PutIfdEntry(tiff, 0x0003, 2, 2, 'E' << 24);
+    PutIfdEntry(tiff, 0x0004, 5, 3, lonOffset);
+    PutBe32(tiff, 0);
+    PutStr(tiff, "2024:05:06 07:08:09");
+    tiff.push_back(0);
+    for (uint32_t value : { 30u, 1u, 30u, 1u, 0u, 1u, 120u, 1u, 15u, 1u, 0u, 1u }) {
+        PutBe32(tiff, value);
+    }
+
+    vector<uint8_t> jpeg = { 0xFF, 0xD8, 0xFF, 0xE1 };
+    PutBe16(jpeg, static_cast<uint16_t>(2 + 6 + tiff.size()));
+    PutStr(jpeg, string("Exif\0\0", 6));
+    jpeg.insert(jpeg.end(), tiff.begin(), tiff.end());
+    jpeg.insert(jpeg.end(), { 0xFF, 0xC0, 0x00, 0x11, 0x08 });
+    PutBe16(jpeg, 480);
+    PutBe16(jpeg, 640);
+    jpeg.insert(jpeg.end(), { 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01 });
+    jpeg.insert(jpeg.end(), { 0xFF, 0xD9 });
+    return jpeg;
+}
+
+// MP4 with a 1920x1080 video track rotated by 90 degrees, 5000 ms long
+static vector<uint8_t> BuildMp4()
+{
+    vector<uint8_t> ftyp;
+    PutStr(ftyp, "isom");
+    PutBe32(ftyp, 0);
+    PutStr(ftyp, "isommp42");
+
+    vector<uint8_t> mvhd(100, 0);
+    const size_t timescaleOffset = 12;
+    mvhd[timescaleOffset + 2] = 0x03;
+    mvhd[timescaleOffset + 3] = 0xE8;
+    mvhd[timescaleOffset + 6] = 0x13;
+    mvhd[timescaleOffset + 7] = 0x88;
+
+    vector<uint8_t> tkhd(4 + 36, 0);
+    for (int32_t value : { 0, 0x10000, 0, -0x10000, 0, 0, 0, 0, 0x40000000 }) {
+        PutBe32(tkhd, static_cast<uint32_t>(value));
+    }
+    PutBe32(tkhd, 1920u << 16);
+    PutBe32(tkhd, 1080u << 16);
+
+    vector<uint8_t> hdlr(8, 0);
+    PutStr(hdlr, "vide");
+    hdlr.resize(hdlr.size() + 13, 0);
+
+    vector<uint8_t> trak = Box("tkhd", tkhd);
+    vector<uint8_t> mdia = Box("mdia", Box("hdlr", hdlr));
+    trak.insert(trak.end(), mdia.begin(), mdia.end());
+    vector<uint8_t> moov = Box("mvhd", mvhd);
+    vector<uint8_t> trakBox = Box("trak", trak);
+    moov.insert(moov.end(), trakBox.begin(), trakBox.end());
+
+    vector<uint8_t> mp4 = Box("ftyp", ftyp);
+    vector<uint8_t> mdat = Box("mdat", vector<uint8_t>(1024, 0));
+    vector<uint8_t> moovBox = Box("moov", moov);
+    mp4.insert(mp4.end(), mdat.begin(), mdat.end());
+    mp4.insert(mp4.end(), moovBox.begin(), moovBox.end());
+    return mp4;
+}
+
+static vector<string> CollectCorpus()
+{
+    vector<string> corpus;
+    for (const auto &path : { TEST_IMAGE_PATH, TEST_VIDEO_PATH }) {
+        if (MediaFileUtils::IsFileExists(path)) {
+            corpus.push_back(path);
+        }
+    }
+    DIR *dir = opendir(TEST_CORPUS_DIR.c_str());
+    if (dir == nullptr) {
+        return corpus;
+    }
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_type == DT_REG) {
+            corpus.push_back(TEST_CORPUS_DIR + entry->d_name);
+        }
+    }
+    closedir(dir);
+    return corpus;
+}
+
+static bool IsVideo(const HeaderMetadata &header)
+{
+    return header.containerType == HeaderContainerType::MP4;
+}
+
+static unique_ptr<Metadata> ExtractByFullExtractor(const string &path, bool isVideo)
+{
+    unique_ptr<Metadata> data = make_unique<Metadata>();
+    data->SetFilePath(path);
+    data->SetFileExtension(MediaFileUtils::GetExtensionFromPath(path));
+    if (isVideo) {
+        data->SetFileMediaType(static_cast<MediaType>(MEDIA_TYPE_VIDEO));
+        EXPECT_EQ(MetadataExtractor::ExtractAVMetadata(data), E_OK);
+        return data;
+    }
+    data->SetFileMediaType(static_cast<MediaType>(MEDIA_TYPE_IMAGE));
+    uint32_t err = 0;
+    SourceOptions opts;
+    unique_ptr<ImageSource> imageSource = ImageSource::CreateImageSource(path, opts, err);
+    EXPECT_NE(imageSource, nullptr);
+    if (imageSource == nullptr) {
+        return data;
+    }
+    ImageInfo imageInfo;
+    if (imageSource->GetImageInfoFromExif(0, imageInfo) == 0) {
+        data->SetFileWidth(imageInfo.size.width);
+        data->SetFileHeight(imageInfo.size.height);
+        data->SetFileMimeType(imageInfo.encodedFormat);
+    }
+    int32_t orientation = 0;
+    if (imageSource->GetImagePropertyInt(0, PHOTO_DATA_IMAGE_ORIENTATION, orientation) == 0) {
+        data->SetOrientation(orientation);
+    }
+    return data;
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, Parse_exif_jpeg_test_001, TestSize.Level1)
+{
+    const string path = TEST_DIR + "medialib_header_parser_exif.jpg";
+    WriteFile(path, BuildExifJpeg());
+    HeaderMetadata header;
+    ASSERT_EQ(MetadataHeaderParser::Parse(path, header), E_OK);
+    EXPECT_EQ(header.containerType, HeaderContainerType::JPEG);
+    EXPECT_EQ(header.mimeType, "image/jpeg");
+    EXPECT_EQ(header.width, 640);
+    EXPECT_EQ(header.height, 480);
+    EXPECT_EQ(header.exifOrientation, 6);
+    EXPECT_EQ(header.rotation, 90);
+    EXPECT_TRUE(header.hasExif);
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, Parse_mp4_test_001, TestSize.Level1)
+{
+    const string path = TEST_DIR + "medialib_header_parser.mp4";
+    WriteFile(path, BuildMp4());
+    HeaderMetadata header;
+    ASSERT_EQ(MetadataHeaderParser::Parse(path, header), E_OK);
+    EXPECT_EQ(header.containerType, HeaderContainerType::MP4);
+    EXPECT_EQ(header.width, 1920);
+    EXPECT_EQ(header.height, 1080);
+    EXPECT_EQ(header.rotation, 90);
+    EXPECT_EQ(header.duration, 5000);
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, Parse_truncated_file_test_001, TestSize.Level1)
+{
+    const string path = TEST_DIR + "medialib_header_parser_truncated.jpg";
+    vector<uint8_t> jpeg = BuildExifJpeg();
+    const size_t truncatedSize = 64;
+    jpeg.resize(truncatedSize);
+    WriteFile(path, jpeg);
+    HeaderMetadata header;
+    EXPECT_NE(MetadataHeaderParser::Parse(path, header), E_OK);
+    EXPECT_NE(MetadataHeaderParser::Parse(TEST_DIR + "medialib_header_parser_nonexistent.jpg", header), E_OK);
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, ExtractBasicMetadata_fallback_test_001, TestSize.Level1)
+{
+    const string path = TEST_DIR + "medialib_header_parser_unknown.jpg";
+    WriteFile(path, vector<uint8_t>(128, 0));
+    unique_ptr<Metadata> data = make_unique<Metadata>();
+    data->SetFilePath(path);
+    data->SetFileMediaType(static_cast<MediaType>(MEDIA_TYPE_IMAGE));
+    EXPECT_NE(MetadataExtractor::ExtractBasicMetadata(data), E_OK);
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, Corpus_equivalence_test_001, TestSize.Level1)
+{
+    vector<string> corpus = CollectCorpus();
+    int32_t parsedCount = 0;
+    for (const auto &path : corpus) {
+        HeaderMetadata header;
+        if (MetadataHeaderParser::Parse(path, header) != E_OK) {
+            GTEST_LOG_(INFO) << "header parser falls back for " << path;
+            continue;
+        }
+        parsedCount++;
+        unique_ptr<Metadata> expected = ExtractByFullExtractor(path, IsVideo(header));
+        EXPECT_EQ(header.width, expected->GetFileWidth()) << path;
+        EXPECT_EQ(header.height, expected->GetFileHeight()) << path;
+        if (IsVideo(header)) {
+            EXPECT_EQ(header.duration, expected->GetFileDuration()) << path;
+            continue;
+        }
+        EXPECT_EQ(header.rotation, expected->GetOrientation()) << path;
+        if (header.containerType != HeaderContainerType::HEIF) {
+            EXPECT_EQ(header.mimeType, expected->GetFileMimeType()) << path;
+        }
+    }
+    GTEST_LOG_(INFO) << "header parser handled " << parsedCount << " of " << corpus.size() << " files";
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, Header_path_equivalence_test_001, TestSize.Level1)
+{
+    uint32_t err = 0;
+    SourceOptions opts;
+    unique_ptr<ImageSource> imageSource = ImageSource::CreateImageSource(TEST_IMAGE_PATH, opts, err);
+    ASSERT_NE(imageSource, nullptr);
+
+    HeaderMetadata header;
+    ASSERT_EQ(MetadataHeaderParser::Parse(TEST_IMAGE_PATH, header), E_OK);
+    if (header.hasExif || header.hasExtraMetadata) {
+        GTEST_LOG_(INFO) << "test image carries exif, header path not taken";
+        return;
+    }
+    unique_ptr<Metadata> byHeader = make_unique<Metadata>();
+    byHeader->SetFilePath(TEST_IMAGE_PATH);
+    ASSERT_EQ(MetadataExtractor::ExtractImageMetadataByHeader(header, byHeader), E_OK);
+
+    unique_ptr<Metadata> byImageSource = make_unique<Metadata>();
+    byImageSource->SetFilePath(TEST_IMAGE_PATH);
+    MetadataExtractor::ExtractImageExif(imageSource, byImageSource);
+    ImageInfo imageInfo;
+    ASSERT_EQ(imageSource->GetImageInfoFromExif(0, imageInfo), 0);
+    EXPECT_EQ(byHeader->GetFileWidth(), imageInfo.size.width);
+    EXPECT_EQ(byHeader->GetFileHeight(), imageInfo.size.height);
+    EXPECT_EQ(byHeader->GetFileMimeType(), imageInfo.encodedFormat);
+    EXPECT_EQ(byHeader->GetAllExif(), byImageSource->GetAllExif());
+    EXPECT_EQ(byHeader->GetFrontCamera(), byImageSource->GetFrontCamera());
+    EXPECT_EQ(imageSource->IsHdrImage(), false);
+}
+
+HWTEST_F(MediaLibraryMetadataHeaderParserTest, Benchmark_files_per_second_test_001, TestSize.Level1)
+{
+    vector<string> corpus = CollectCorpus();
+    ASSERT_FALSE(corpus.empty());
+    int32_t headerCount = 0;
+    auto start = chrono::steady_clock::now();
+    for (int32_t i = 0; i < BENCHMARK_ROUNDS; i++) {
+        for (const auto &path : corpus) {
+            HeaderMetadata header;
+            headerCount += (MetadataHeaderParser::Parse(path, header) == E_OK) ? 1 : 0;
+        }
+    }
+    double headerCost = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int32_t i = 0; i < BENCHMARK_ROUNDS; i++) {
+        for (const auto &path : corpus) {
+            HeaderMetadata header;
+            (void)MetadataHeaderParser::Parse(path, header);
+            (void)ExtractByFullExtractor(path, IsVideo(header));
+        }
+    }
+    double fullCost = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    double files = static_cast<double>(corpus.size() * BENCHMARK_ROUNDS);
+    GTEST_LOG_(INFO) << "header parser: " << files * MS_PER_SECOND / headerCost << " files/s, parsed "
+        << headerCount << ", full extractor: " << files * MS_PER_SECOND / fullCost << " files/s";
+    EXPECT_GT(headerCount, 0);
+}
+} // namespace Media
+} // namespace OHOS
@@ -4949,7 +4949,8 @@ napi_value FileAssetNapi::PhotoAccessHelperRequestPhoto(napi_env env, napi_callb
         .uri = obj->fileAssetPtr->GetUri(),
         .path = obj->fileAssetPtr->GetFilePath(),
         .size = asyncContext->size,
-        .type = type
+        .type = type,
+        .dateModified = obj->fileAssetPtr->GetDateModified()
     };
     static std::once_flag onceFlag;
     std::call_once(onceFlag, []() mutable {
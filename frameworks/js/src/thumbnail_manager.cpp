@@ -46,6 +46,7 @@
 #include "media_log.h"
 #include "media_file_utils.h"
 #include "media_library_manager.h"
+#include "media_column.h"
 
 #ifdef IMAGE_PURGEABLE_PIXELMAP
 #include "purgeable_pixelmap_builder.h"
@@ -56,6 +57,8 @@ const std::string MULTI_USER_URI_FLAG = "user=";
 const std::string MEDIALIBRARY_DATA_URI = "datashare:///media";
 const int UUID_STR_LENGTH = 37;
 constexpr int32_t MAX_THUMBNAIL_FILE_SIZE = 10 * 1024 * 1024; // 缩略图文件最大不超过10MB
+// a single pixel map takes at most a quarter of the cache, so that lcd images do not flush the grid thumbnails
+constexpr size_t MAX_CACHE_SHARE_DIVISOR = 4;
 
 namespace OHOS {
 namespace Media {
@@ -67,7 +70,7 @@ sptr<IRemoteObject> ThumbnailManager::token_ = nullptr;
 
 ThumbnailRequest::ThumbnailRequest(const RequestPhotoParams &params, napi_env env,
     napi_ref callback) : callback_(env, callback), requestPhotoType(params.type), uri_(params.uri),
-    path_(params.path), requestSize_(params.size)
+    path_(params.path), requestSize_(params.size), dateModified_(params.dateModified)
 {
 }
 
@@ -169,6 +172,129 @@ bool MMapFdPtr::IsValid()
     return isValid_;
 }
 
+RequestSharedPtr ThumbnailRequestQueue::Push(const RequestSharedPtr &request)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.push_back(request);
+    if (requests_.size() <= maxDepth_) {
+        return nullptr;
+    }
+    RequestSharedPtr dropped = requests_.front();
+    requests_.pop_front();
+    return dropped;
+}
+
+bool ThumbnailRequestQueue::Pop(RequestSharedPtr &request)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (requests_.empty()) {
+        return false;
+    }
+    request = requests_.front();
+    requests_.pop_front();
+    return true;
+}
+
+bool ThumbnailRequestQueue::Erase(const string &requestId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = requests_.begin(); it != requests_.end(); ++it) {
+        if ((*it)->GetUUID() == requestId) {
+            requests_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThumbnailRequestQueue::Empty()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_.empty();
+}
+
+string ThumbnailPixelMapCache::GetKey(const string &uri, const Size &size, int64_t dateModified)
+{
+    return uri + "_" + to_string(size.width) + "x" + to_string(size.height) + "_" + to_string(dateModified);
+}
+
+PixelMapPtr ThumbnailPixelMapCache::Get(const string &key)
+{
+    shared_ptr<PixelMap> pixelMap;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entryMap_.find(key);
+        if (it == entryMap_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        pixelMap = it->second->pixelMap;
+    }
+    int32_t errorCode = 0;
+    PixelMapPtr copy = pixelMap->Clone(errorCode);
+    CHECK_AND_PRINT_LOG(copy != nullptr, "Clone cached pixelmap failed, err: %{public}d", errorCode);
+    return copy;
+}
+
+void ThumbnailPixelMapCache::Put(const string &key, const string &fileId, PixelMap &pixelMap)
+{
+    size_t bytes = static_cast<size_t>(max(pixelMap.GetByteCount(), 0));
+    if (bytes == 0 || bytes > maxBytes_ / MAX_CACHE_SHARE_DIVISOR) {
+        return;
+    }
+    int32_t errorCode = 0;
+    shared_ptr<PixelMap> copy = pixelMap.Clone(errorCode);
+    CHECK_AND_RETURN_LOG(copy != nullptr, "Clone pixelmap for cache failed, err: %{public}d", errorCode);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entryMap_.find(key);
+    if (it != entryMap_.end()) {
+        EraseEntry(it->second);
+    }
+    entries_.push_front({ key, fileId, copy, bytes });
+    entryMap_[key] = entries_.begin();
+    totalBytes_ += bytes;
+    while (totalBytes_ > maxBytes_ || entries_.size() > maxCount_) {
+        EraseEntry(prev(entries_.end()));
+    }
+}
+
+void ThumbnailPixelMapCache::Invalidate(const string &fileId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileId.empty()) {
+        entries_.clear();
+        entryMap_.clear();
+        totalBytes_ = 0;
+        return;
+    }
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto current = it++;
+        if (current->fileId == fileId) {
+            EraseEntry(current);
+        }
+    }
+}
+
+void ThumbnailPixelMapCache::EraseEntry(EntryList::iterator it)
+{
+    totalBytes_ -= it->bytes;
+    entryMap_.erase(it->key);
+    entries_.erase(it);
+}
+
+void ThumbnailCacheObserver::OnChange(const ChangeInfo &changeInfo)
+{
+    if (changeInfo.uris_.empty()) {
+        cache_.Invalidate("");
+        return;
+    }
+    for (const auto &uri : changeInfo.uris_) {
+        // a notification for a whole table carries no file id and drops everything
+        cache_.Invalidate(MediaFileUtils::GetIdFromUri(uri.ToString()));
+    }
+}
+
 static string GenerateRequestId()
 {
     uuid_t uuid;
@@ -198,6 +324,9 @@ void ThumbnailManager::Init()
     }
     init_ = true;
     isThreadRunning_ = true;
+    cacheObserver_ = make_shared<ThumbnailCacheObserver>(pixelMapCache_);
+    UserFileClient::RegisterObserverExt(Uri(PhotoColumn::PHOTO_URI_PREFIX), cacheObserver_, true);
+    UserFileClient::RegisterObserverExt(Uri(AudioColumn::AUDIO_URI_PREFIX), cacheObserver_, true);
     for (auto i = 0; i < THREAD_NUM; i++) {
         threads_.emplace_back(
             std::thread([this, num = i]() { this->ImageWorker(num); })
@@ -231,7 +360,9 @@ void ThumbnailManager::RemovePhotoRequest(const string &requestId)
         if (ptr == nullptr) {
             return;
         }
-        // do not need delete from queue, just update remove status.
+        // a request already taken by a worker is skipped by its remove status
+        fastQueue_.Erase(requestId);
+        qualityQueue_.Erase(requestId);
         ptr->UpdateStatus(ThumbnailStatus::THUMB_REMOVE);
         ptr->ReleaseCallbackRef();
     }
@@ -240,6 +371,10 @@ void ThumbnailManager::RemovePhotoRequest(const string &requestId)
 
 ThumbnailManager::~ThumbnailManager()
 {
+    if (cacheObserver_ != nullptr) {
+        UserFileClient::UnregisterObserverExt(Uri(PhotoColumn::PHOTO_URI_PREFIX), cacheObserver_);
+        UserFileClient::UnregisterObserverExt(Uri(AudioColumn::AUDIO_URI_PREFIX), cacheObserver_);
+    }
     isThreadRunning_ = false;
     queueCv_.notify_all();
     for (auto &thread : threads_) {
@@ -256,18 +391,33 @@ void SetThreadName(const string &threadName, int num)
     pthread_setname_np(pthread_self(), name.c_str());
 }
 
+void ThumbnailManager::FailDroppedRequest(const RequestSharedPtr &request)
+{
+    NAPI_WARN_LOG("Request queue is full, drop the oldest request, uri=%{private}s", request->GetUri().c_str());
+    // the quality status makes the callback the last one of this request
+    request->UpdateStatus(ThumbnailStatus::THUMB_QUALITY);
+    request->error = E_FAIL;
+    NotifyImage(request);
+}
+
 void ThumbnailManager::AddFastPhotoRequest(const RequestSharedPtr &request)
 {
     request->UpdateStatus(ThumbnailStatus::THUMB_FAST);
-    fastQueue_.Push(request);
+    RequestSharedPtr dropped = fastQueue_.Push(request);
     queueCv_.notify_one();
+    if (dropped != nullptr) {
+        FailDroppedRequest(dropped);
+    }
 }
 
 void ThumbnailManager::AddQualityPhotoRequest(const RequestSharedPtr &request)
 {
     request->UpdateStatus(ThumbnailStatus::THUMB_QUALITY);
-    qualityQueue_.Push(request);
+    RequestSharedPtr dropped = qualityQueue_.Push(request);
     queueCv_.notify_one();
+    if (dropped != nullptr) {
+        FailDroppedRequest(dropped);
+    }
 }
 
 static bool GetFastThumbNewSize(const Size &size, Size &newSize)
@@ -604,6 +754,30 @@ void ThumbnailManager::DeleteRequestIdFromMap(const string &requestId)
     thumbRequest_.Erase(requestId);
 }
 
+// month and year thumbnails are mapped from their files without decoding, caching them saves nothing
+static bool IsDecodedThumbSize(const Size &size)
+{
+    ThumbnailType thumbType = GetThumbType(size.width, size.height);
+    return thumbType != ThumbnailType::MTH && thumbType != ThumbnailType::YEAR;
+}
+
+PixelMapPtr ThumbnailManager::GetCachedPixelMap(const RequestSharedPtr &request, const Size &size)
+{
+    if (!IsDecodedThumbSize(size)) {
+        return nullptr;
+    }
+    return pixelMapCache_.Get(ThumbnailPixelMapCache::GetKey(request->GetUri(), size, request->GetDateModified()));
+}
+
+void ThumbnailManager::CachePixelMap(const RequestSharedPtr &request, const Size &size, PixelMap &pixelMap)
+{
+    if (!IsDecodedThumbSize(size)) {
+        return;
+    }
+    pixelMapCache_.Put(ThumbnailPixelMapCache::GetKey(request->GetUri(), size, request->GetDateModified()),
+        MediaFileUtils::GetIdFromUri(request->GetUri()), pixelMap);
+}
+
 bool ThumbnailManager::RequestFastImage(const RequestSharedPtr &request)
 {
     MediaLibraryTracer tracer;
@@ -613,6 +787,11 @@ bool ThumbnailManager::RequestFastImage(const RequestSharedPtr &request)
         NAPI_ERR_LOG("Can not get fastThumb size, uri=%{private}s", request->GetUri().c_str());
         return false;
     }
+    PixelMapPtr cachedPixelMap = GetCachedPixelMap(request, fastSize);
+    if (cachedPixelMap != nullptr) {
+        request->SetFastPixelMap(move(cachedPixelMap));
+        return true;
+    }
     UniqueFd uniqueFd(OpenThumbnail(request->GetPath(), GetThumbType(fastSize.width, fastSize.height)));
     if (uniqueFd.Get() <= 0) {
         // Can not get fast image in sandbox
@@ -636,6 +815,7 @@ bool ThumbnailManager::RequestFastImage(const RequestSharedPtr &request)
         request->error = E_FAIL;
         return false;
     }
+    CachePixelMap(request, fastSize, *pixelMap);
     request->SetFastPixelMap(move(pixelMap));
     return true;
 }
@@ -663,8 +843,13 @@ void ThumbnailManager::DealWithQualityRequest(const RequestSharedPtr &request)
 {
     MediaLibraryTracer tracer;
     tracer.Start("ThumbnailManager::DealWithQualityRequest");
-    unique_ptr<PixelMap> pixelMapPtr =
-        QueryThumbnail(request->GetUri(), request->GetRequestSize(), request->GetPath());
+    unique_ptr<PixelMap> pixelMapPtr = GetCachedPixelMap(request, request->GetRequestSize());
+    if (pixelMapPtr == nullptr) {
+        pixelMapPtr = QueryThumbnail(request->GetUri(), request->GetRequestSize(), request->GetPath());
+        if (pixelMapPtr != nullptr) {
+            CachePixelMap(request, request->GetRequestSize(), *pixelMapPtr);
+        }
+    }
     if (pixelMapPtr == nullptr) {
         NAPI_ERR_LOG("Can not get pixelMap");
         request->error = E_FAIL;
@@ -144,7 +144,8 @@ void CloudUploadChecker::FillDbHeightAndWidth(const CheckedPhotoInfo &photoInfo,
     std::unique_ptr<Metadata> data = std::make_unique<Metadata>();
     CHECK_AND_RETURN_LOG(data != nullptr, "Data is nullptr");
     data->SetFilePath(photoInfo.path);
-    int32_t err = MetadataExtractor::ExtractImageMetadata(data);
+    data->SetFileMediaType(MEDIA_TYPE_IMAGE);
+    int32_t err = MetadataExtractor::ExtractBasicMetadata(data);
     CHECK_AND_RETURN_LOG(err == E_OK, "Extract image metadata err: %{public}d", err);
     int32_t height = data->GetFileHeight();
     int32_t width = data->GetFileWidth();
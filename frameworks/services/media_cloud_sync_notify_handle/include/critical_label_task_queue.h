@@ -19,7 +19,8 @@
 #ifdef MEDIALIBRARY_SECURE_ALBUM_ENABLE
 
 #include <iostream>
-#include <queue>
+#include <map>
+#include <set>
 #include <vector>
 #include <chrono>
 #include <ctime>
@@ -63,9 +64,21 @@ class TTLPriorityQueue {
 private:
     static inline std::unique_ptr<TTLPriorityQueue> instance_;
     static inline std::mutex instance_mutex_;
-    std::priority_queue<std::shared_ptr<Element>,
-            std::vector<std::shared_ptr<Element>>, ElementPtrCompare> pq;
-    std::unordered_set<std::string> signatures;
+    struct SlotChange {
+        bool isUsed {false};
+        bool isOnlySent {false};
+        AssetParams params;
+    };
+
+    // 按发送顺序排序, rbegin为下一个发送的元素, begin为队尾
+    std::set<std::shared_ptr<Element>, ElementPtrCompare> orderedElements;
+    // orderedElements中尚未发送的元素
+    std::set<std::shared_ptr<Element>, ElementPtrCompare> unsentElements;
+    // 按插入时间排序, 用于淘汰过期元素
+    std::set<std::pair<int64_t, std::string>> expiryIndex;
+    std::unordered_map<std::string, std::shared_ptr<Element>> elementsByName;
+    // 待写入xml的slot变更, 在mtx外统一落盘
+    std::map<int32_t, SlotChange> dirtySlots;
     std::thread t;
     mutable std::mutex mtx;
     mutable std::mutex xmlUpdateMutex;
@@ -82,18 +95,23 @@ private:
 
     void LoadPreferenceCriticalAssets();
     void UpdatePreferenceCriticalAssets(AssetParams assetParam);
+    void WriteSlot(const std::shared_ptr<NativePreferences::Preferences> &pref, int slot,
+        const AssetParams &assetParam);
     void ClearSlot(const std::shared_ptr<NativePreferences::Preferences> &pref, int slot);
     void RemovePreferenceCriticalAssets(const std::string &dpName);
+    void PersistDirtySlots();
     void CleanupExpiredItems();
     void CleanupExpiredItemsPeriodically();
     void UpdateFromXML(std::vector<AssetParams>& criticalAssets, std::shared_ptr<NativePreferences::Preferences> pref);
     bool AddElementInner(const AssetParams& dataParams);
     bool RemoveByNameInner(const std::string& name);
+    void InsertElementInner(const std::shared_ptr<Element>& element);
+    // 按值传入, 索引可能是element的唯一持有者
+    void EraseElementInner(std::shared_ptr<Element> element);
     void UpdateIsSentInXML(const std::string& displayName, bool isSent);
+    void MarkAsSent(const std::shared_ptr<Element>& element);
     void PopInsertBack(const std::shared_ptr<Element>& element);
     bool SendAsset(const std::shared_ptr<Element>& element);
-    std::shared_ptr<Element> GetBack(std::priority_queue<std::shared_ptr<Element>,
-            std::vector<std::shared_ptr<Element>>, ElementPtrCompare> queue);
     void CheckConditions(bool &doPass, const int &priority);
     bool UpdatePhotoRiskStatus(const std::string& displayName, const int32_t risk_status);
     bool QueueHasTaskToDo();
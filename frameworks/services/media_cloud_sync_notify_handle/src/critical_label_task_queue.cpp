@@ -96,14 +96,18 @@ public:
 bool ElementPtrCompare::operator()(const std::shared_ptr<Element>& a,
     const std::shared_ptr<Element>& b) const
 {
-    if (a->GetPriority() == b->GetPriority()) {
+    if (a->GetPriority() != b->GetPriority()) {
+        return a->GetPriority() < b->GetPriority();
+    }
+    if (a->GetInsertionTime() != b->GetInsertionTime()) {
         return a->GetInsertionTime() > b->GetInsertionTime();
     }
-    return a->GetPriority() < b->GetPriority();
+    return a->GenerateSignature() > b->GenerateSignature();
 }
 TTLPriorityQueue::TTLPriorityQueue() : slotUsed(MAX_SIZE, false)
 {
     LoadPreferenceCriticalAssets();
+    PersistDirtySlots();
     t = std::thread(&TTLPriorityQueue::CleanupExpiredItemsPeriodically, this);
 }
 
@@ -130,7 +134,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
     int32_t TTLPriorityQueue::GetRemainingQueueSize() const
     {
         std::lock_guard<std::mutex> lock(mtx);
-        return MAX_SIZE - pq.size();
+        return MAX_SIZE - orderedElements.size();
     }
 
     std::vector<std::string> TTLPriorityQueue::GetElementsTruncatedPaths() const
@@ -139,18 +143,34 @@ TTLPriorityQueue::~TTLPriorityQueue()
         return originalPathsInQueue;
     }
 
-    std::shared_ptr<Element> TTLPriorityQueue::GetBack(std::priority_queue<std::shared_ptr<Element>,
-        std::vector<std::shared_ptr<Element>>, ElementPtrCompare> queue)
+    void TTLPriorityQueue::InsertElementInner(const std::shared_ptr<Element>& element)
+    {
+        CHECK_AND_RETURN(elementsByName.find(element->GenerateSignature()) == elementsByName.end());
+        orderedElements.insert(element);
+        if (!element->IsSent()) {
+            unsentElements.insert(element);
+        }
+        expiryIndex.emplace(element->GetInsertionTime(), element->GenerateSignature());
+        elementsByName.emplace(element->GenerateSignature(), element);
+    }
+
+    void TTLPriorityQueue::EraseElementInner(std::shared_ptr<Element> element)
     {
-        while (queue.size() > 1) {
-            queue.pop();
+        std::string signature = element->GenerateSignature();
+        orderedElements.erase(element);
+        unsentElements.erase(element);
+        expiryIndex.erase(std::make_pair(element->GetInsertionTime(), signature));
+        elementsByName.erase(signature);
+        auto it = find(originalPathsInQueue.begin(), originalPathsInQueue.end(), element->original_path_);
+        if (it != originalPathsInQueue.end()) {
+            originalPathsInQueue.erase(it);
         }
-        return queue.top();
+        RemovePreferenceCriticalAssets(signature);
     }
 
     bool TTLPriorityQueue::AddElementInner(const AssetParams& dataParams)
     {
-        if (signatures.find(dataParams.truncated_path) != signatures.end()) {
+        if (elementsByName.find(dataParams.truncated_path) != elementsByName.end()) {
             MEDIA_DEBUG_LOG("Element with display_name %{public}s already exists. Skipping insertion.",
                 dataParams.truncated_path.c_str());
             return false;
@@ -161,8 +181,8 @@ TTLPriorityQueue::~TTLPriorityQueue()
 
         int realTimePriority = 2;
         int nonRealTimePriority = 1;
-        if (pq.size() >= MAX_SIZE) {
-            auto backElement = GetBack(pq);
+        if (orderedElements.size() >= MAX_SIZE) {
+            auto backElement = *orderedElements.begin();
             if (newElement->priority_ == realTimePriority && backElement->priority_== nonRealTimePriority) {
                 RemoveByNameInner(backElement->truncated_path_);
             } else {
@@ -175,8 +195,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
         UpdatePreferenceCriticalAssets(dataParams);
 
         originalPathsInQueue.push_back(dataParams.original_path);
-        pq.push(newElement);
-        signatures.insert(dataParams.truncated_path);
+        InsertElementInner(newElement);
         MEDIA_INFO_LOG("Element added with display_name %{public}s.", dataParams.truncated_path.c_str());
         return true;
     }
@@ -194,6 +213,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
             }
             result = AddElementInner(dataParams);
         }
+        PersistDirtySlots();
         if (result) {
             cv_.notify_one();
         }
@@ -202,33 +222,14 @@ TTLPriorityQueue::~TTLPriorityQueue()
 
     bool TTLPriorityQueue::RemoveByNameInner(const std::string& name)
     {
-        if (signatures.find(name) == signatures.end()) {
+        auto it = elementsByName.find(name);
+        if (it == elementsByName.end()) {
             MEDIA_INFO_LOG("Element with display_name %{public}s not found.", name.c_str());
             return false;
         }
 
-        std::priority_queue<std::shared_ptr<Element>,
-            std::vector<std::shared_ptr<Element>>, ElementPtrCompare> newQueue;
-        while (!pq.empty()) {
-            auto topElement = pq.top();
-            pq.pop();
-
-            if (topElement->GenerateSignature() != name) {
-                newQueue.push(topElement);
-            } else {
-                signatures.erase(name);
-                std::string original_path = topElement->original_path_;
-                auto it = find(originalPathsInQueue.begin(),
-                    originalPathsInQueue.end(), original_path);
-                if (it != originalPathsInQueue.end()) {
-                    originalPathsInQueue.erase(it);
-                }
-                MEDIA_INFO_LOG("Element removed with display_name %{public}s.", name.c_str());
-            }
-        }
-
-        RemovePreferenceCriticalAssets(name);
-        pq = newQueue;
+        EraseElementInner(it->second);
+        MEDIA_INFO_LOG("Element removed with display_name %{public}s.", name.c_str());
         return true;
     }
 
@@ -244,8 +245,9 @@ TTLPriorityQueue::~TTLPriorityQueue()
                 return true;
             }
             result = RemoveByNameInner(name);
-            needTrigger = result && pq.size() <= nonRealTimeTriggerSize;
+            needTrigger = result && orderedElements.size() <= nonRealTimeTriggerSize;
         }
+        PersistDirtySlots();
 
         if (needTrigger) {
             MEDIA_INFO_LOG("Size is less than 10 try to add element from non realtime");
@@ -258,26 +260,10 @@ TTLPriorityQueue::~TTLPriorityQueue()
     std::shared_ptr<Element> TTLPriorityQueue::Pop_non_send()
     {
         std::lock_guard<std::mutex> lock(mtx);
-
-        std::priority_queue<std::shared_ptr<Element>> tempQueue;
-        std::shared_ptr<Element> poppedElement = std::make_shared<Element>("", -1, -1, "", -1, false, "");
-
-        while (!pq.empty()) {
-            auto currentElement = pq.top();
-            pq.pop();
-            tempQueue.push(currentElement);
-            if (!currentElement->IsSent()) {
-                poppedElement = currentElement;
-                break;
-            }
-        }
-
-        while (!tempQueue.empty()) {
-            pq.push(tempQueue.top());
-            tempQueue.pop();
+        if (unsentElements.empty()) {
+            return std::make_shared<Element>("", -1, -1, "", -1, false, "");
         }
-
-        return poppedElement;
+        return *unsentElements.rbegin();
     }
 
     void TTLPriorityQueue::UpdateFromXML(std::vector<AssetParams>& criticalAssets,
@@ -298,6 +284,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
             params.added_time = pref->GetLong("CA_" + std::to_string(i) + "_ADDEDTIME", 0);
             params.is_sent = pref->GetBool("CA_" + std::to_string(i) + "_ISSENT", false);
             reverseCriticalAssetsMap.emplace(params.truncated_path, i);
+            slotUsed[i] = true;
 
             criticalAssets.push_back(params);
         }
@@ -309,9 +296,10 @@ TTLPriorityQueue::~TTLPriorityQueue()
         MEDIA_INFO_LOG("loadPreferenceCriticalAssets start");
         std::vector<AssetParams> criticalAssets;
         std::shared_ptr<NativePreferences::Preferences> pref = nullptr;
-        pq = std::priority_queue<std::shared_ptr<Element>,
-        std::vector<std::shared_ptr<Element>>, ElementPtrCompare>();
-        signatures.clear();
+        orderedElements.clear();
+        unsentElements.clear();
+        expiryIndex.clear();
+        elementsByName.clear();
 
         int32_t errcode = ERR_OK;
         pref = NativePreferences::PreferencesHelper::GetPreferences(CA_CONFIG_PATH, errcode);
@@ -332,8 +320,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
         for (const auto& asset : criticalAssets) {
             auto elementFromXml = std::make_shared<Element>(asset.truncated_path, asset.id,
                 asset.priority, asset.uri, asset.type, asset.is_sent, asset.original_path);
-            pq.push(elementFromXml);
-            signatures.insert(asset.truncated_path);
+            InsertElementInner(elementFromXml);
         }
 
         for (const auto& pendingAssetRemove : pendingRemoves) {
@@ -359,19 +346,6 @@ TTLPriorityQueue::~TTLPriorityQueue()
 
     void TTLPriorityQueue::UpdatePreferenceCriticalAssets(AssetParams assetParam)
     {
-        std::lock_guard<std::mutex> lock(xmlUpdateMutex);
-        MEDIA_INFO_LOG("updatePreferenceCriticalAssets start");
-        std::shared_ptr<NativePreferences::Preferences> pref = nullptr;
-        int32_t errcode = ERR_OK;
-        pref = NativePreferences::PreferencesHelper::GetPreferences(CA_CONFIG_PATH, errcode);
-
-        CHECK_AND_RETURN_LOG(pref != nullptr, "pref is nullptr, errCode: %{public}d", errcode);
-
-        int count = pref->GetInt("CA_COUNT", 0);
-        if (count < 0) {
-            count = 0;
-        }
-
         // check duplicate
         auto it = reverseCriticalAssetsMap.find(assetParam.truncated_path);
         if (it != reverseCriticalAssetsMap.end()) {
@@ -382,7 +356,17 @@ TTLPriorityQueue::~TTLPriorityQueue()
         int32_t slotIdx = FindFreeSlot();
         CHECK_AND_RETURN_LOG(slotIdx != -1, "size is full");
 
-        int slot = slotIdx;
+        SlotChange &change = dirtySlots[slotIdx];
+        change.isUsed = true;
+        change.isOnlySent = false;
+        change.params = assetParam;
+        reverseCriticalAssetsMap.emplace(assetParam.truncated_path, slotIdx);
+        slotUsed[slotIdx] = true;
+    }
+
+    void TTLPriorityQueue::WriteSlot(const std::shared_ptr<NativePreferences::Preferences> &pref, int slot,
+        const AssetParams &assetParam)
+    {
         // assets in xml always evaluated as non real-time
         auto preferencePriority = 1;
         pref->PutInt("CA_" + std::to_string(slot) + "_ID", assetParam.id);
@@ -393,11 +377,6 @@ TTLPriorityQueue::~TTLPriorityQueue()
         pref->PutInt("CA_" + std::to_string(slot) + "_TYPE", assetParam.type);
         pref->PutLong("CA_" + std::to_string(slot) + "_ADDEDTIME", assetParam.added_time);
         pref->PutBool("CA_" + std::to_string(slot) + "_ISSENT", assetParam.is_sent);
-
-        pref->PutInt("CA_COUNT", count + 1);
-        pref->FlushSync();
-        reverseCriticalAssetsMap.emplace(assetParam.truncated_path, slot);
-        slotUsed[slot] = true;
     }
 
     void TTLPriorityQueue::ClearSlot(const std::shared_ptr<NativePreferences::Preferences> &pref, int slot)
@@ -414,79 +393,97 @@ TTLPriorityQueue::~TTLPriorityQueue()
 
     void TTLPriorityQueue::RemovePreferenceCriticalAssets(const std::string &dpName)
     {
-        std::lock_guard<std::mutex> lock(xmlUpdateMutex);
-        MEDIA_INFO_LOG("removePreferenceCriticalAssets start");
-        std::shared_ptr<NativePreferences::Preferences> pref = nullptr;
-        int32_t errcode = ERR_OK;
-        pref = NativePreferences::PreferencesHelper::GetPreferences(CA_CONFIG_PATH, errcode);
-        CHECK_AND_RETURN_LOG(pref != nullptr, "pref is nullptr, errCode: %{public}d", errcode);
+        auto it = reverseCriticalAssetsMap.find(dpName);
+        CHECK_AND_RETURN_LOG(it != reverseCriticalAssetsMap.end(), "asset is not found");
 
-        int count = pref->GetInt("CA_COUNT", 0);
-        CHECK_AND_RETURN_LOG(count > 0, "There is no critical asset to remove in xml");
+        int32_t idx = it->second;
+        SlotChange &change = dirtySlots[idx];
+        change.isUsed = false;
+        change.isOnlySent = false;
+        reverseCriticalAssetsMap.erase(it);
+        slotUsed[idx] = false;
+    }
 
-        int idx = -1;
-        auto it = reverseCriticalAssetsMap.find(dpName);
-        if (it != reverseCriticalAssetsMap.end()) {
-            idx = it->second;
+    void TTLPriorityQueue::PersistDirtySlots()
+    {
+        // 先持有xmlUpdateMutex再取走变更, 保证同一slot的多次变更按内存中的顺序落盘
+        std::lock_guard<std::mutex> xmlLock(xmlUpdateMutex);
+        std::map<int32_t, SlotChange> changes;
+        int32_t usedCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (dirtySlots.empty()) {
+                return;
+            }
+            changes.swap(dirtySlots);
+            usedCount = static_cast<int32_t>(std::count(slotUsed.begin(), slotUsed.end(), true));
         }
+        MEDIA_INFO_LOG("persist %{public}zu changed slots start", changes.size());
+        int32_t errcode = ERR_OK;
+        std::shared_ptr<NativePreferences::Preferences> pref =
+            NativePreferences::PreferencesHelper::GetPreferences(CA_CONFIG_PATH, errcode);
+        CHECK_AND_RETURN_LOG(pref != nullptr, "pref is nullptr, errCode: %{public}d", errcode);
 
-        CHECK_AND_RETURN_LOG(idx != -1, "asset is not found");
-        
-        ClearSlot(pref, idx);
-
-        pref->PutInt("CA_COUNT", count - 1);
+        for (const auto &[slot, change] : changes) {
+            if (!change.isUsed) {
+                ClearSlot(pref, slot);
+            } else if (change.isOnlySent) {
+                pref->PutBool("CA_" + std::to_string(slot) + "_ISSENT", true);
+            } else {
+                WriteSlot(pref, slot, change.params);
+            }
+        }
+        pref->PutInt("CA_COUNT", usedCount);
         pref->FlushSync();
-
-        reverseCriticalAssetsMap.erase(dpName);
-        slotUsed[idx] = false;
     }
 
     void TTLPriorityQueue::CleanupExpiredItems()
     {
         std::lock_guard<std::mutex> lock(mtx);
-        while (!pq.empty() && pq.top()->IsExpired()) {
-            MEDIA_DEBUG_LOG("Expired item removed from queue");
-            const std::shared_ptr<Element> expired = pq.top();
-            std::string signature = expired->GenerateSignature();
-            std::string original_path = expired->original_path_;
-            RemovePreferenceCriticalAssets(signature);
-            signatures.erase(signature);
-            auto it = find(originalPathsInQueue.begin(),
-                originalPathsInQueue.end(), original_path);
-            if (it != originalPathsInQueue.end()) {
-                originalPathsInQueue.erase(it);
+        // 从最早插入的元素开始淘汰, 遇到未过期的元素即可停止
+        while (!expiryIndex.empty()) {
+            auto it = elementsByName.find(expiryIndex.begin()->second);
+            if (it == elementsByName.end()) {
+                expiryIndex.erase(expiryIndex.begin());
+                continue;
             }
-            pq.pop();
+            CHECK_AND_BREAK(it->second->IsExpired());
+            MEDIA_DEBUG_LOG("Expired item removed from queue");
+            EraseElementInner(it->second);
         }
     }
 
     void TTLPriorityQueue::UpdateIsSentInXML(const std::string& displayName, bool isSent)
     {
-        std::lock_guard<std::mutex> lock(xmlUpdateMutex);
-
-        MEDIA_INFO_LOG("updateIsSentInXML start for display_name %{public}s, isSent: %{public}d",
-            displayName.c_str(), isSent);
-
-        std::shared_ptr<NativePreferences::Preferences> pref = nullptr;
-        int32_t errcode = ERR_OK;
-        pref = NativePreferences::PreferencesHelper::GetPreferences(CA_CONFIG_PATH, errcode);
-
-        CHECK_AND_RETURN_LOG(pref != nullptr, "pref is nullptr, errCode: %{public}d", errcode);
-
         auto it = reverseCriticalAssetsMap.find(displayName);
         if (it == reverseCriticalAssetsMap.end()) {
             MEDIA_INFO_LOG("Element with display_name %{public}s not found in XML.", displayName.c_str());
             return;
         }
 
-        int slot = it->second;
-        pref->PutBool("CA_" + std::to_string(slot) + "_ISSENT", isSent);
-        pref->FlushSync();
-
+        auto changeIter = dirtySlots.find(it->second);
+        if (changeIter == dirtySlots.end()) {
+            SlotChange &change = dirtySlots[it->second];
+            change.isUsed = true;
+            change.isOnlySent = isSent;
+        } else if (changeIter->second.isUsed && !changeIter->second.isOnlySent) {
+            changeIter->second.params.is_sent = isSent;
+        }
         MEDIA_INFO_LOG("is_sent updated for display_name %{public}s to %{public}d",
             displayName.c_str(), isSent);
     }
 
+    void TTLPriorityQueue::MarkAsSent(const std::shared_ptr<Element>& element)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            element->MarkAsSent();
+            unsentElements.erase(element);
+            UpdateIsSentInXML(element->truncated_path_, true);
+        }
+        PersistDirtySlots();
+    }
+
     void TTLPriorityQueue::PopInsertBack(const std::shared_ptr<Element>& element)
     {
         AssetParams params;
@@ -554,8 +551,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
                 static_cast<int32_t>(PhotoRiskStatus::SUSPICIOUS));
             RemoveByName(element->truncated_path_);
         }
-        element->MarkAsSent();
-        UpdateIsSentInXML(element->truncated_path_, true);
+        MarkAsSent(element);
         return true;
     }
 
@@ -575,7 +571,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
 
     bool TTLPriorityQueue::QueueHasTaskToDo()
     {
-        if (pq.empty()) {
+        if (unsentElements.empty()) {
             return false;
         }
         auto instance = MedialibraryRelatedSystemStateManager::GetInstance();
@@ -587,34 +583,9 @@ TTLPriorityQueue::~TTLPriorityQueue()
 
         CHECK_AND_RETURN_RET_LOG(networkAvaliable != false, false,
             "MedialibraryRelatedSystemStateManager network is not connected");
-        bool suitableRealtime = false;
-        bool suitableNonRealtime = false;
-        std::priority_queue<std::shared_ptr<Element>> tempQueue;
-        bool queueHasAssetToUpload = false;
         const int32_t realtimePriority = 2;
-        while (!pq.empty()) {
-            auto currentElement = pq.top();
-            pq.pop();
-            tempQueue.push(currentElement);
-            if (!currentElement->IsSent()) {
-                queueHasAssetToUpload = true;
-                if (currentElement->priority_ == realtimePriority) {
-                    suitableRealtime = true;
-                } else {
-                    suitableNonRealtime = true;
-                }
-                break;
-            }
-        }
-
-        while (!tempQueue.empty()) {
-            pq.push(tempQueue.top());
-            tempQueue.pop();
-        }
-
-        CHECK_AND_RETURN_RET_LOG(queueHasAssetToUpload != false, false,
-            "MedialibraryRelatedSystemStateManager queue has no asset that not yet send.");
-        
+        bool suitableRealtime = (*unsentElements.rbegin())->priority_ == realtimePriority;
+        bool suitableNonRealtime = !suitableRealtime;
         if (suitableRealtime && (WatchSystemHandler::GetAllowNetworkSwitch() || isWifiConnected)) {
             return true;
         }
@@ -653,6 +624,7 @@ TTLPriorityQueue::~TTLPriorityQueue()
             }
             next_cleanup_time = now + std::chrono::milliseconds(TTL_PERIOD);
             CleanupExpiredItems();
+            PersistDirtySlots();
             auto element = Pop_non_send();
             CHECK_AND_CONTINUE(element->id_ != -1);
             do_pass = false;
@@ -38,6 +38,7 @@ public:
     void FlushTranscodeAccessTimes(const TranscodeAccessType type, TranscodeType transcodeType);
     void FlushTranscodeFailed(const TranscodeErrorType type, TranscodeType transcodeType);
     void FlushTranscodeCostTime(const int32_t costTime, TranscodeType transcodeType);
+    void FlushTranscodeCacheAccess(const TranscodeCacheAccessType type, TranscodeType transcodeType);
     void FlushCinematicVideoInfo(CinematicVideoInfo& newCinematicVideoInfo);
     void FlushAgingLcdCount(PhotoLcdStatistics stats);
     void FlushAgingLcdContinue();
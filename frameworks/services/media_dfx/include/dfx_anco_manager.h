@@ -42,6 +42,7 @@ public:
     void ReportAncoCheckInfo(const AncoCheckInfo& reportData);
     void ReportAncoOperationChangeInfo(const AncoOperationChangeInfo& reportData);
     void NotifyOperationChange(const int32_t objType, const int32_t optType);
+    void NotifyFileChangeBurst(int32_t msgCount, int32_t appliedCount, int64_t latencyMs);
     void ReportFileManagerFirstLoad();
 
 private:
@@ -61,7 +62,7 @@ private:
     Utils::Timer timer_{ "AncoDfxTimer" };
     uint32_t timerId_{ 0 };
     AncoOperationChangeInfo ancoOptChangeInfo_{
-        0, 0, 0, 0, 0, 0, 0 };
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
     std::mutex ancoOptChangeInfoMutex_;
     int32_t NOTIFY_FILE_TYPE = 0;
     int32_t NOTIFY_DIR_TYPE = 1;
@@ -173,6 +173,9 @@ const std::string TRANSCODE_TIMES = "transcode_times";
 const std::string TRANSCODE_FAILED_TIMES = "transcode_failed_times";
 const std::string INNER_FAILED_TIMES = "inner_failed_times";
 const std::string CODEC_FAILED_TIMES = "codec_failed_times";
+const std::string TRANSCODE_CACHE_HIT_TIMES = "transcode_cache_hit_times";
+const std::string TRANSCODE_COALESCED_TIMES = "transcode_coalesced_times";
+const std::string TRANSCODE_EVICTED_TIMES = "transcode_evicted_times";
 const std::string APP_PACKAGE_CONFIG = "app_package_config";
 
 const std::string LCD_AGING_TOTAL_TIME = "lcd_aging_total_time";
@@ -305,6 +308,12 @@ enum TranscodeErrorType {
     CODEC_FAILED,
 };
 
+enum TranscodeCacheAccessType {
+    CACHE_HIT = 0,
+    CACHE_COALESCED,
+    CACHE_EVICTED,
+};
+
 enum NetConnStatusType {
     NO_NETWORK = 0,
     WIFI_CONNECTED,
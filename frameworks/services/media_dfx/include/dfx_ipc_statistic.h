@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIA_DFX_IPC_STATISTIC_H
+#define OHOS_MEDIA_DFX_IPC_STATISTIC_H
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+struct IpcCodeStatistic {
+    uint32_t code = 0;
+    uint64_t count = 0;
+    uint64_t rejectCount = 0;
+    uint64_t totalCostUs = 0;
+    uint64_t maxCostUs = 0;
+    uint64_t p50CostUs = 0;
+    uint64_t p99CostUs = 0;
+    uint64_t totalPayloadBytes = 0;
+    uint64_t p99PayloadBytes = 0;
+};
+
+/**
+ * @brief Latency and payload histogram of one IPC code. Buckets are powers of two, so recording is a few relaxed
+ * atomic adds and percentiles are reported as the upper bound of their bucket.
+ */
+class DfxIpcHistogram {
+public:
+    static constexpr size_t BUCKET_NUM = 20;
+
+    EXPORT explicit DfxIpcHistogram(uint32_t code);
+    EXPORT void Record(uint64_t costUs, uint64_t payloadBytes);
+    EXPORT void RecordReject();
+    EXPORT IpcCodeStatistic Snapshot(bool isReset);
+
+private:
+    using Buckets = std::array<std::atomic<uint64_t>, BUCKET_NUM>;
+    static size_t GetBucketIndex(uint64_t value);
+    static uint64_t GetPercentile(const std::array<uint64_t, BUCKET_NUM> &counts, uint64_t total, uint32_t percent);
+    static std::array<uint64_t, BUCKET_NUM> LoadBuckets(Buckets &buckets, bool isReset);
+    static uint64_t LoadValue(std::atomic<uint64_t> &value, bool isReset);
+
+    uint32_t code_;
+    Buckets costBuckets_ {};
+    Buckets payloadBuckets_ {};
+    std::atomic<uint64_t> rejectCount_ {0};
+    std::atomic<uint64_t> totalCostUs_ {0};
+    std::atomic<uint64_t> maxCostUs_ {0};
+    std::atomic<uint64_t> totalPayloadBytes_ {0};
+};
+
+class DfxIpcStatistic {
+public:
+    EXPORT static DfxIpcStatistic &GetInstance();
+    // the histogram is created on first use and kept for the lifetime of the process
+    EXPORT std::shared_ptr<DfxIpcHistogram> GetHistogram(uint32_t code);
+    // codes that were called since the last reset, the most expensive first
+    EXPORT std::vector<IpcCodeStatistic> Snapshot(bool isReset);
+
+private:
+    std::mutex mutex_;
+    std::map<uint32_t, std::shared_ptr<DfxIpcHistogram>> histograms_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIA_DFX_IPC_STATISTIC_H
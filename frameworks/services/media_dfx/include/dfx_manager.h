@@ -100,6 +100,7 @@ public:
     EXPORT void HandleTranscodeAccessTime(const TranscodeAccessType type, TranscodeType transcodeType);
     EXPORT void HandleTranscodeFailed(const TranscodeErrorType type, TranscodeType transcodeType);
     EXPORT void HandleTranscodeCostTime(const int32_t costTime, TranscodeType transcodeType);
+    EXPORT void HandleTranscodeCacheAccess(const TranscodeCacheAccessType type, TranscodeType transcodeType);
     void HandleAccurateRefreshTimeOut(const AccurateRefreshDfxDataPoint& reportData);
     void HandleCinematicVideoAccessTimes(bool isByUri, bool isHighQualityRequest, const std::string &fileId = "");
     void HandleCinematicVideoAddStartTime(const CinematicWaitType waitType, const std::string &videoId);
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIA_DFX_QUERY_STATISTIC_H
+#define OHOS_MEDIA_DFX_QUERY_STATISTIC_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+struct QueryShapeStatistic {
+    // queries whose sql was served from the shape cache
+    uint64_t hitCount = 0;
+    // queries whose sql was built and added to the shape cache
+    uint64_t missCount = 0;
+    // queries that could not be normalised and took the predicates path
+    uint64_t bypassCount = 0;
+    uint64_t evictCount = 0;
+    // literals moved out of where clauses into bind args
+    uint64_t literalCount = 0;
+    // time spent in the sql builder on misses, the predicates path pays it on every query
+    uint64_t buildCostUs = 0;
+    // end to end time of GetQuerySql, including normalising the where clause and building the shape key
+    uint64_t hitCostUs = 0;
+    uint64_t missCostUs = 0;
+    // time spent normalising where clauses that then took the predicates path
+    uint64_t bypassCostUs = 0;
+};
+
+class DfxQueryStatistic {
+public:
+    EXPORT static DfxQueryStatistic &GetInstance();
+    EXPORT void AddHit(uint64_t literalCount, uint64_t costUs);
+    EXPORT void AddMiss(uint64_t literalCount, uint64_t buildCostUs, uint64_t costUs);
+    EXPORT void AddBypass(uint64_t costUs);
+    EXPORT void AddEvict();
+    EXPORT QueryShapeStatistic Snapshot(bool isReset);
+    // build time the predicates path would have paid minus the time GetQuerySql took, negative if the cache costs
+    EXPORT static int64_t GetNetSavedCostUs(const QueryShapeStatistic &statistic);
+
+private:
+    std::atomic<uint64_t> hitCount_ {0};
+    std::atomic<uint64_t> missCount_ {0};
+    std::atomic<uint64_t> bypassCount_ {0};
+    std::atomic<uint64_t> evictCount_ {0};
+    std::atomic<uint64_t> literalCount_ {0};
+    std::atomic<uint64_t> buildCostUs_ {0};
+    std::atomic<uint64_t> hitCostUs_ {0};
+    std::atomic<uint64_t> missCostUs_ {0};
+    std::atomic<uint64_t> bypassCostUs_ {0};
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIA_DFX_QUERY_STATISTIC_H
@@ -161,6 +161,11 @@ struct AncoOperationChangeInfo {
     int32_t albumOptUpdateCount;
     int32_t albumOptDeleteCount;
     int32_t totalOptCount;
+    int32_t burstCount;
+    int32_t burstMsgCount;
+    int32_t burstAppliedCount;
+    int64_t burstTotalLatency;
+    int64_t burstMaxLatency;
 };
 
 enum LoadType : int32_t {
@@ -239,6 +244,8 @@ public:
     void ReportReadLcd(const int32_t southDeviceType);
     void ReportAgingLcdInfo();
     void ReportVisitLcd(const int32_t southDeviceType);
+    void ReportIpcStatistic();
+    void ReportQueryShapeStatistic();
 };
 } // namespace Media
 } // namespace OHOS
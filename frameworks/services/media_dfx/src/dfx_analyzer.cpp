@@ -21,6 +21,7 @@
 #include "media_log.h"
 #include "preferences.h"
 #include "preferences_helper.h"
+#include "preferences_write_back.h"
 #include "media_column.h"
 #include "dfx_const.h"
 #include "permission_utils.h"
@@ -57,7 +58,7 @@ void DfxAnalyzer::FlushThumbnail(std::unordered_map<std::string, ThumbnailErrorI
         string value = to_string(entry.second.time);
         prefs->PutString(key, value);
     }
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("flush %{public}zu itmes", thumbnailErrorMap.size());
 }
 
@@ -84,7 +85,7 @@ void DfxAnalyzer::FlushCommonBehavior(std::unordered_map<string, CommonBehavior>
         prefs->PutInt(bundleName, times + oldValue);
         behaviors += "{" + bundleName + ": " + to_string(times) + "}";
     }
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     if (!behaviors.empty()) {
         MEDIA_INFO_LOG("common behavior for fuse getattr: %{public}s", behaviors.c_str());
     }
@@ -108,7 +109,7 @@ void DfxAnalyzer::FlushDeleteBehavior(std::unordered_map<string, int32_t> &delet
         int32_t oldValue = prefs->GetInt(bundleName, 0);
         prefs->PutInt(bundleName + SPLIT_CHAR + to_string(type), times + oldValue);
     }
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushInvalidMap(std::unordered_map<string, string> &invalidMap, int32_t type)
@@ -126,7 +127,7 @@ void DfxAnalyzer::FlushInvalidMap(std::unordered_map<string, string> &invalidMap
         string operation = entry.second;
         prefs->PutString(typeStr + SPLIT_CHAR + bundleName, operation);
     }
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushAdaptationToMovingPhoto(AdaptationToMovingPhotoInfo& newAdaptationInfo)
@@ -155,7 +156,7 @@ void DfxAnalyzer::FlushAdaptationToMovingPhoto(AdaptationToMovingPhotoInfo& newA
     prefs->PutInt(MOVING_PHOTO_KEY_ADAPTED_NUM, allAdaptedApps.size());
     prefs->PutString(MOVING_PHOTO_KEY_ADAPTED_PACKAGE, DfxUtils::JoinStrings(allAdaptedApps, ';'));
 
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("flush adaptation to moving photo, unadapted num: %{private}zu, adapted num: %{private}zu",
         allUnadaptedApps.size(), allAdaptedApps.size());
 }
@@ -240,7 +241,7 @@ void DfxAnalyzer::FlushTranscodeAccessTimes(const TranscodeAccessType type, Tran
     int32_t accessTimes = prefs->GetInt(accessKey, 0);
     prefs->PutInt(TRANSCODE_ACCESS_TIMES, useTimes + 1);
     prefs->PutInt(accessKey, accessTimes + 1);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushTranscodeFailed(const TranscodeErrorType type, TranscodeType transcodeType)
@@ -271,7 +272,7 @@ void DfxAnalyzer::FlushTranscodeFailed(const TranscodeErrorType type, TranscodeT
     int32_t failedTimes = prefs->GetInt(typeKey, 0);
     prefs->PutInt(TRANSCODE_FAILED_TIMES, failedAllTimes + 1);
     prefs->PutInt(typeKey, failedTimes + 1);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushTranscodeCostTime(const int32_t costTime, TranscodeType transcodeType)
@@ -292,7 +293,39 @@ void DfxAnalyzer::FlushTranscodeCostTime(const int32_t costTime, TranscodeType t
     alreadyCostTime = alreadyCostTime + costTime;
     prefs->PutInt(TRANSCODE_AVG_TIME, alreadyCostTime);
     prefs->PutInt(TRANSCODE_TIMES, transcodeTime + 1);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
+}
+
+void DfxAnalyzer::FlushTranscodeCacheAccess(const TranscodeCacheAccessType type, TranscodeType transcodeType)
+{
+    int32_t errCode;
+    string XML;
+    bool success = GetTransCodeXML(transcodeType, XML);
+    CHECK_AND_RETURN_LOG(success, "GetTranscodeXML failed");
+    shared_ptr<NativePreferences::Preferences> prefs =
+        NativePreferences::PreferencesHelper::GetPreferences(XML, errCode);
+    if (!prefs) {
+        MEDIA_ERR_LOG("get preferences error: %{public}d", errCode);
+        return;
+    }
+    const char* typeKey = nullptr;
+    switch (type) {
+        case CACHE_HIT:
+            typeKey = TRANSCODE_CACHE_HIT_TIMES.c_str();
+            break;
+        case CACHE_COALESCED:
+            typeKey = TRANSCODE_COALESCED_TIMES.c_str();
+            break;
+        case CACHE_EVICTED:
+            typeKey = TRANSCODE_EVICTED_TIMES.c_str();
+            break;
+        default:
+            MEDIA_ERR_LOG("get TranscodeCacheAccessType error: %{public}d", type);
+            return;
+    }
+    int32_t times = prefs->GetInt(typeKey, 0);
+    prefs->PutInt(typeKey, times + 1);
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushCinematicVideoInfo(CinematicVideoInfo& newCinematicVideoInfo)
@@ -342,7 +375,7 @@ void DfxAnalyzer::FlushCinematicVideoInfo(CinematicVideoInfo& newCinematicVideoI
     prefs->PutInt(CINEMATIC_VIDEO_KEY_MULTISTAGE_SUCCESS_TIMES, multistageSuccessTime);
     prefs->PutInt(CINEMATIC_VIDEO_KEY_MULTISTAGE_FAILED_TIMES, multistageFailedTime);
 
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushAgingLcdCount(PhotoLcdStatistics stats)
@@ -357,7 +390,7 @@ void DfxAnalyzer::FlushAgingLcdCount(PhotoLcdStatistics stats)
     prefs->PutInt(FAVORITE_LCD_NUM, stats.favoriteCount);
     prefs->PutInt(ALBUM_COVER_NUM, stats.albumCoverCount);
     prefs->PutInt(SMART_NUM, stats.smartCount);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushAgingLcdContinue()
@@ -368,7 +401,7 @@ void DfxAnalyzer::FlushAgingLcdContinue()
     CHECK_AND_RETURN_LOG(prefs, "get preferences error: %{public}d", errCode);
     int32_t LcdContinueTimes = prefs->GetInt(AGING_CONTINUE_NUM.c_str(), 0);
     prefs->PutInt(AGING_CONTINUE_NUM, LcdContinueTimes + 1);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushAgingLcdFinish(int64_t hasAgingLcdNumber, int32_t totalSize,
@@ -383,7 +416,7 @@ void DfxAnalyzer::FlushAgingLcdFinish(int64_t hasAgingLcdNumber, int32_t totalSi
     prefs->PutInt(FLASH_FREE_SIZE, freeSize);
     prefs->PutInt(FLASH_FREE_SIZE_OLD, freeSizeOld);
     prefs->PutInt(LCD_AGING_TOTAL_TIME.c_str(), totalTime);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 void DfxAnalyzer::FlushReadLcdTimes(bool isSuccess, NetConnStatusType netStatus)
 {
@@ -431,7 +464,7 @@ void DfxAnalyzer::FlushReadLcdTimes(bool isSuccess, NetConnStatusType netStatus)
     }
     prefs->PutInt(successKey, readLcdTimes + 1);
     prefs->PutInt(typeKey, netLcdTimes + 1);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushThumbnailQuality(const int32_t southDeviceType)
@@ -459,7 +492,7 @@ void DfxAnalyzer::FlushThumbnailQuality(const int32_t southDeviceType)
 
     int32_t lowQualityCounts = prefs->GetInt(typeKey, 0);
     prefs->PutInt(typeKey, lowQualityCounts + 1);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxAnalyzer::FlushVisitLcd()
@@ -476,7 +509,7 @@ void DfxAnalyzer::FlushVisitLcd()
     } else {
         prefs->PutInt(NON_SYSTEM_APP_VISIT_NUM, nonsystemAppVisitTimes + 1);
     }
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
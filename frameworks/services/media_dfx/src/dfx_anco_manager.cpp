@@ -16,6 +16,8 @@
 
 #include "dfx_anco_manager.h"
 
+#include <algorithm>
+
 #include "dfx_reporter.h"
 #include "dfx_utils.h"
 #include "media_file_utils.h"
@@ -114,6 +116,16 @@ void AncoDfxManager::NotifyOperationChange(const int32_t objType, const int32_t
     ancoOptChangeInfo_.totalOptCount += 1;
 }
 
+void AncoDfxManager::NotifyFileChangeBurst(int32_t msgCount, int32_t appliedCount, int64_t latencyMs)
+{
+    std::unique_lock<std::mutex> lock(ancoOptChangeInfoMutex_);
+    ancoOptChangeInfo_.burstCount += 1;
+    ancoOptChangeInfo_.burstMsgCount += msgCount;
+    ancoOptChangeInfo_.burstAppliedCount += appliedCount;
+    ancoOptChangeInfo_.burstTotalLatency += latencyMs;
+    ancoOptChangeInfo_.burstMaxLatency = std::max(ancoOptChangeInfo_.burstMaxLatency, latencyMs);
+}
+
 void AncoDfxManager::InnerReportAncoCountFormatInfo(uint64_t loadStartTime, uint64_t loadEndTime, bool firstLoad,
     LoadType loadType)
 {
@@ -210,6 +222,11 @@ void AncoDfxManager::InnerReportAndResetOptChangeInfo()
     ancoOptChangeInfo_.albumOptUpdateCount = 0;
     ancoOptChangeInfo_.albumOptDeleteCount = 0;
     ancoOptChangeInfo_.totalOptCount = 0;
+    ancoOptChangeInfo_.burstCount = 0;
+    ancoOptChangeInfo_.burstMsgCount = 0;
+    ancoOptChangeInfo_.burstAppliedCount = 0;
+    ancoOptChangeInfo_.burstTotalLatency = 0;
+    ancoOptChangeInfo_.burstMaxLatency = 0;
 }
 
 void AncoDfxManager::RegisterFormatCountTimer()
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "DfxIpcStatistic"
+
+#include "dfx_ipc_statistic.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Media {
+// bucket 0 holds values up to 2^MIN_BUCKET_SHIFT, the last bucket holds everything above the previous one
+constexpr uint32_t MIN_BUCKET_SHIFT = 6;
+constexpr uint32_t PERCENT_P50 = 50;
+constexpr uint32_t PERCENT_P99 = 99;
+constexpr uint32_t PERCENT_MAX = 100;
+
+DfxIpcHistogram::DfxIpcHistogram(uint32_t code) : code_(code) {}
+
+size_t DfxIpcHistogram::GetBucketIndex(uint64_t value)
+{
+    size_t index = 0;
+    uint64_t bound = 1ULL << MIN_BUCKET_SHIFT;
+    while (value > bound && index < BUCKET_NUM - 1) {
+        bound <<= 1;
+        index++;
+    }
+    return index;
+}
+
+void DfxIpcHistogram::Record(uint64_t costUs, uint64_t payloadBytes)
+{
+    costBuckets_[GetBucketIndex(costUs)].fetch_add(1, std::memory_order_relaxed);
+    payloadBuckets_[GetBucketIndex(payloadBytes)].fetch_add(1, std::memory_order_relaxed);
+    totalCostUs_.fetch_add(costUs, std::memory_order_relaxed);
+    totalPayloadBytes_.fetch_add(payloadBytes, std::memory_order_relaxed);
+    uint64_t maxCostUs = maxCostUs_.load(std::memory_order_relaxed);
+    while (costUs > maxCostUs &&
+        !maxCostUs_.compare_exchange_weak(maxCostUs, costUs, std::memory_order_relaxed)) {
+    }
+}
+
+void DfxIpcHistogram::RecordReject()
+{
+    rejectCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t DfxIpcHistogram::LoadValue(std::atomic<uint64_t> &value, bool isReset)
+{
+    return isReset ? value.exchange(0, std::memory_order_relaxed) : value.load(std::memory_order_relaxed);
+}
+
+std::array<uint64_t, DfxIpcHistogram::BUCKET_NUM> DfxIpcHistogram::LoadBuckets(Buckets &buckets, bool isReset)
+{
+    std::array<uint64_t, BUCKET_NUM> counts {};
+    for (size_t i = 0; i < BUCKET_NUM; i++) {
+        counts[i] = LoadValue(buckets[i], isReset);
+    }
+    return counts;
+}
+
+uint64_t DfxIpcHistogram::GetPercentile(const std::array<uint64_t, BUCKET_NUM> &counts, uint64_t total,
+    uint32_t percent)
+{
+    if (total == 0) {
+        return 0;
+    }
+    // rank of the percentile, rounded up so that p99 of a single call is that call
+    uint64_t rank = (total * percent + PERCENT_MAX - 1) / PERCENT_MAX;
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < BUCKET_NUM; i++) {
+        accumulated += counts[i];
+        if (accumulated >= rank) {
+            return 1ULL << (MIN_BUCKET_SHIFT + i);
+        }
+    }
+    return 1ULL << (MIN_BUCKET_SHIFT + BUCKET_NUM - 1);
+}
+
+IpcCodeStatistic DfxIpcHistogram::Snapshot(bool isReset)
+{
+    // a call recorded concurrently may land in either snapshot, the counters stay consistent over time
+    std::array<uint64_t, BUCKET_NUM> costCounts = LoadBuckets(costBuckets_, isReset);
+    std::array<uint64_t, BUCKET_NUM> payloadCounts = LoadBuckets(payloadBuckets_, isReset);
+    IpcCodeStatistic statistic;
+    statistic.code = code_;
+    for (uint64_t count : costCounts) {
+        statistic.count += count;
+    }
+    uint64_t payloadCount = 0;
+    for (uint64_t count : payloadCounts) {
+        payloadCount += count;
+    }
+    statistic.rejectCount = LoadValue(rejectCount_, isReset);
+    statistic.totalCostUs = LoadValue(totalCostUs_, isReset);
+    statistic.maxCostUs = LoadValue(maxCostUs_, isReset);
+    statistic.totalPayloadBytes = LoadValue(totalPayloadBytes_, isReset);
+    statistic.p50CostUs = std::min(GetPercentile(costCounts, statistic.count, PERCENT_P50), statistic.maxCostUs);
+    statistic.p99CostUs = std::min(GetPercentile(costCounts, statistic.count, PERCENT_P99), statistic.maxCostUs);
+    statistic.p99PayloadBytes = GetPercentile(payloadCounts, payloadCount, PERCENT_P99);
+    return statistic;
+}
+
+DfxIpcStatistic &DfxIpcStatistic::GetInstance()
+{
+    static DfxIpcStatistic instance;
+    return instance;
+}
+
+std::shared_ptr<DfxIpcHistogram> DfxIpcStatistic::GetHistogram(uint32_t code)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &histogram = histograms_[code];
+    if (histogram == nullptr) {
+        histogram = std::make_shared<DfxIpcHistogram>(code);
+    }
+    return histogram;
+}
+
+std::vector<IpcCodeStatistic> DfxIpcStatistic::Snapshot(bool isReset)
+{
+    std::vector<std::shared_ptr<DfxIpcHistogram>> histograms;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        histograms.reserve(histograms_.size());
+        for (const auto &[code, histogram] : histograms_) {
+            histograms.push_back(histogram);
+        }
+    }
+    std::vector<IpcCodeStatistic> statistics;
+    for (const auto &histogram : histograms) {
+        IpcCodeStatistic statistic = histogram->Snapshot(isReset);
+        if (statistic.count > 0 || statistic.rejectCount > 0) {
+            statistics.push_back(statistic);
+        }
+    }
+    std::sort(statistics.begin(), statistics.end(), [](const IpcCodeStatistic &a, const IpcCodeStatistic &b) {
+        return a.totalCostUs > b.totalCostUs;
+    });
+    return statistics;
+}
+} // namespace Media
+} // namespace OHOS
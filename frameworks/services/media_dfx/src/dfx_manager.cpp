@@ -762,6 +762,8 @@ int64_t DfxManager::HandleOneDayReport()
     dfxReporter_->ReportReadLcd(static_cast<int32_t>(SouthDeviceType::SOUTH_DEVICE_CLOUD));
     dfxReporter_->ReportReadLcd(static_cast<int32_t>(SouthDeviceType::SOUTH_DEVICE_HDC));
     dfxReporter_->ReportVisitLcd(static_cast<int32_t>(SouthDeviceType::SOUTH_DEVICE_VISIT));
+    dfxReporter_->ReportIpcStatistic();
+    dfxReporter_->ReportQueryShapeStatistic();
     return MediaFileUtils::UTCTimeSeconds();
 }
 
@@ -1385,6 +1387,14 @@ void DfxManager::HandleTranscodeCostTime(const int32_t costTime, TranscodeType t
     dfxAnalyzer_->FlushTranscodeCostTime(costTime, transcodeType);
 }
 
+void DfxManager::HandleTranscodeCacheAccess(const TranscodeCacheAccessType type, TranscodeType transcodeType)
+{
+    MEDIA_DEBUG_LOG("HandleTranscodeCacheAccess type: %{public}d", type);
+    CHECK_AND_RETURN_LOG(isInitSuccess_, "DfxManager not init");
+    CHECK_AND_RETURN_LOG(dfxAnalyzer_, "dfxAnalyzer_ is nullptr");
+    dfxAnalyzer_->FlushTranscodeCacheAccess(type, transcodeType);
+}
+
 void DfxManager::HandleUpgradeFault(const UpgradeExceptionInfo& reportData)
 {
     dfxReporter_->ReportUpgradeFault(reportData);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "DfxQueryStatistic"
+
+#include "dfx_query_statistic.h"
+
+#include "media_log.h"
+
+namespace OHOS {
+namespace Media {
+static uint64_t LoadValue(std::atomic<uint64_t> &value, bool isReset)
+{
+    return isReset ? value.exchange(0, std::memory_order_relaxed) : value.load(std::memory_order_relaxed);
+}
+
+DfxQueryStatistic &DfxQueryStatistic::GetInstance()
+{
+    static DfxQueryStatistic instance;
+    return instance;
+}
+
+void DfxQueryStatistic::AddHit(uint64_t literalCount, uint64_t costUs)
+{
+    hitCount_.fetch_add(1, std::memory_order_relaxed);
+    literalCount_.fetch_add(literalCount, std::memory_order_relaxed);
+    hitCostUs_.fetch_add(costUs, std::memory_order_relaxed);
+}
+
+void DfxQueryStatistic::AddMiss(uint64_t literalCount, uint64_t buildCostUs, uint64_t costUs)
+{
+    missCount_.fetch_add(1, std::memory_order_relaxed);
+    literalCount_.fetch_add(literalCount, std::memory_order_relaxed);
+    buildCostUs_.fetch_add(buildCostUs, std::memory_order_relaxed);
+    missCostUs_.fetch_add(costUs, std::memory_order_relaxed);
+}
+
+void DfxQueryStatistic::AddBypass(uint64_t costUs)
+{
+    bypassCount_.fetch_add(1, std::memory_order_relaxed);
+    bypassCostUs_.fetch_add(costUs, std::memory_order_relaxed);
+}
+
+void DfxQueryStatistic::AddEvict()
+{
+    evictCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+QueryShapeStatistic DfxQueryStatistic::Snapshot(bool isReset)
+{
+    QueryShapeStatistic statistic;
+    statistic.hitCount = LoadValue(hitCount_, isReset);
+    statistic.missCount = LoadValue(missCount_, isReset);
+    statistic.bypassCount = LoadValue(bypassCount_, isReset);
+    statistic.evictCount = LoadValue(evictCount_, isReset);
+    statistic.literalCount = LoadValue(literalCount_, isReset);
+    statistic.buildCostUs = LoadValue(buildCostUs_, isReset);
+    statistic.hitCostUs = LoadValue(hitCostUs_, isReset);
+    statistic.missCostUs = LoadValue(missCostUs_, isReset);
+    statistic.bypassCostUs = LoadValue(bypassCostUs_, isReset);
+    return statistic;
+}
+
+int64_t DfxQueryStatistic::GetNetSavedCostUs(const QueryShapeStatistic &statistic)
+{
+    CHECK_AND_RETURN_RET(statistic.missCount > 0, 0);
+    // without the cache every normalised query builds its sql, estimated from the builder time of a miss
+    uint64_t avgBuildCostUs = statistic.buildCostUs / statistic.missCount;
+    int64_t uncachedCostUs = static_cast<int64_t>(avgBuildCostUs * (statistic.hitCount + statistic.missCount));
+    int64_t cachedCostUs = static_cast<int64_t>(statistic.hitCostUs + statistic.missCostUs + statistic.bypassCostUs);
+    return uncachedCostUs - cachedCostUs;
+}
+} // namespace Media
+} // namespace OHOS
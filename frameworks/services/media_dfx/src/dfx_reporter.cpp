@@ -21,12 +21,15 @@
 #include "dfx_const.h"
 #include "dfx_utils.h"
 #include "dfx_database_utils.h"
+#include "dfx_ipc_statistic.h"
+#include "dfx_query_statistic.h"
 #include "medialibrary_errno.h"
 #include "media_file_utils.h"
 #include "media_log.h"
 #include "hisysevent.h"
 #include "preferences.h"
 #include "preferences_helper.h"
+#include "preferences_write_back.h"
 #include "medialibrary_data_manager_utils.h"
 #include "medialibrary_bundle_manager.h"
 #include "medialibrary_inotify.h"
@@ -37,6 +40,8 @@ namespace OHOS {
 namespace Media {
 static constexpr char MEDIA_LIBRARY[] = "MEDIALIBRARY";
 constexpr uint64_t MB_SIZE = 1024 * 1024;
+constexpr size_t IPC_STATISTIC_REPORT_NUM = 20;
+constexpr int32_t PERCENTAGE = 100;
 
 DfxReporter::DfxReporter()
 {
@@ -139,7 +144,7 @@ void DfxReporter::ReportThumbnailError()
         }
     }
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 void DfxReporter::ReportCommonBehavior()
@@ -166,7 +171,7 @@ void DfxReporter::ReportCommonBehavior()
         }
     }
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 void DfxReporter::ReportDeleteStatistic()
@@ -202,7 +207,7 @@ void DfxReporter::ReportDeleteStatistic()
         }
     }
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 void DfxReporter::ReportInvalidBehavior()
@@ -238,7 +243,7 @@ void DfxReporter::ReportInvalidBehavior()
         }
     }
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 void DfxReporter::ReportDeleteBehavior(string bundleName, int32_t type, std::string path)
@@ -410,7 +415,7 @@ void DfxReporter::ReportAdaptationToMovingPhoto()
     int32_t adaptedAppNum = prefs->GetInt(MOVING_PHOTO_KEY_ADAPTED_NUM);
 
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 
     int ret = HiSysEventWrite(
         MEDIA_LIBRARY,
@@ -466,7 +471,7 @@ void DfxReporter::ReportCinematicVideo()
     }
 
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 void DfxReporter::ReportStartResult(int32_t scene, int32_t error, int32_t start)
@@ -889,7 +894,7 @@ void DfxReporter::ReportMediaLibCompatConfig()
             to_string(pair.second.futureField);
         prefs->PutString(pair.first, dbValueStr);
     }
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 static void ReportAlibDuplicate(TranscodeType transcodeType)
@@ -915,6 +920,15 @@ static void ReportAlibDuplicate(TranscodeType transcodeType)
     int32_t transcodeFailedTimes = prefs->GetInt(TRANSCODE_FAILED_TIMES, 0);
     int32_t innerFailedTimes = prefs->GetInt(INNER_FAILED_TIMES, 0);
     int32_t codecFailedTimes = prefs->GetInt(CODEC_FAILED_TIMES, 0);
+    int32_t cacheHitTimes = prefs->GetInt(TRANSCODE_CACHE_HIT_TIMES, 0);
+    int32_t coalescedTimes = prefs->GetInt(TRANSCODE_COALESCED_TIMES, 0);
+    int32_t evictedTimes = prefs->GetInt(TRANSCODE_EVICTED_TIMES, 0);
+    // percentage of the create requests served without transcoding
+    int32_t hitRate = 0;
+    int32_t requestTimes = cacheHitTimes + coalescedTimes + transcodeTimes;
+    if (requestTimes != 0) {
+        hitRate = (cacheHitTimes + coalescedTimes) * PERCENTAGE / requestTimes;
+    }
     int ret = HiSysEventWrite(
         MEDIA_LIBRARY,
         "MEDIALIB_HEIF_ACCESS_STAT",
@@ -927,13 +941,17 @@ static void ReportAlibDuplicate(TranscodeType transcodeType)
         "TRANSCODE_FAILED_TIMES", transcodeFailedTimes,
         "INNER_FAILED_TIMES", innerFailedTimes,
         "CODEC_FAILED_TIMES", codecFailedTimes,
+        "CACHE_HIT_TIMES", cacheHitTimes,
+        "COALESCED_TIMES", coalescedTimes,
+        "EVICTED_TIMES", evictedTimes,
+        "CACHE_HIT_RATE", hitRate,
         "TRANSCODE_TYPE", static_cast<int32_t>(transcodeType));
     if (ret != 0) {
         MEDIA_ERR_LOG("Report alib heif duplicate error:%{public}d", ret);
     }
 
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 void DfxReporter::ReportAlibHeifDuplicate()
@@ -980,6 +998,7 @@ int32_t DfxReporter::ReportAncoCheckInfo(const AncoCheckInfo& reportData)
  
 int32_t DfxReporter::ReportAncoOperationChangeInfo(const AncoOperationChangeInfo& reportData)
 {
+    int64_t burstAvgLatency = reportData.burstCount > 0 ? reportData.burstTotalLatency / reportData.burstCount : 0;
     int ret = HiSysEventWrite(
         MEDIA_LIBRARY,
         "MEDIALIB_ANCO_OPRN_CHANGE_INFO",
@@ -990,7 +1009,12 @@ int32_t DfxReporter::ReportAncoOperationChangeInfo(const AncoOperationChangeInfo
         "ALBUM_OPT_ADD_COUNT", reportData.albumOptAddCount,
         "ALBUM_OPT_UPDATE_COUNT", reportData.albumOptUpdateCount,
         "ALBUM_OPT_DELETE_COUNT", reportData.albumOptDeleteCount,
-        "TOTAL_OPT_COUNT", reportData.totalOptCount);
+        "TOTAL_OPT_COUNT", reportData.totalOptCount,
+        "BURST_COUNT", reportData.burstCount,
+        "BURST_MSG_COUNT", reportData.burstMsgCount,
+        "BURST_APPLIED_COUNT", reportData.burstAppliedCount,
+        "BURST_AVG_LATENCY", burstAvgLatency,
+        "BURST_MAX_LATENCY", reportData.burstMaxLatency);
     if (ret != 0) {
         MEDIA_ERR_LOG("Report AncoOperationChangeInfo error: %{public}d", ret);
     }
@@ -1115,7 +1139,7 @@ void DfxReporter::ReportAgingLcdInfo()
         MEDIA_ERR_LOG("Report aging lcd info error:%{public}d", ret);
     }
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
 }
 
 static void GetReadLcdPrefs(shared_ptr<NativePreferences::Preferences> prefs, std::string typeKey,
@@ -1183,7 +1207,7 @@ void DfxReporter::ReportReadLcd(const int32_t southDeviceType)
             return;
     }
     GetReadLcdPrefs(prefs, typeKey, southDeviceType);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void DfxReporter::ReportVisitLcd(const int32_t southDeviceType)
@@ -1221,7 +1245,82 @@ void DfxReporter::ReportVisitLcd(const int32_t southDeviceType)
         MEDIA_ERR_LOG("Report visit lcd error:%{public}d", ret);
     }
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
+}
+
+void DfxReporter::ReportIpcStatistic()
+{
+    vector<IpcCodeStatistic> statistics = DfxIpcStatistic::GetInstance().Snapshot(true);
+    if (statistics.empty()) {
+        return;
+    }
+    if (statistics.size() > IPC_STATISTIC_REPORT_NUM) {
+        statistics.resize(IPC_STATISTIC_REPORT_NUM);
+    }
+    string codes;
+    string counts;
+    string rejectCounts;
+    string totalCosts;
+    string p50Costs;
+    string p99Costs;
+    string maxCosts;
+    string p99Payloads;
+    for (const auto &statistic : statistics) {
+        string separator = codes.empty() ? "" : ",";
+        codes += separator + to_string(statistic.code);
+        counts += separator + to_string(statistic.count);
+        rejectCounts += separator + to_string(statistic.rejectCount);
+        totalCosts += separator + to_string(statistic.totalCostUs);
+        p50Costs += separator + to_string(statistic.p50CostUs);
+        p99Costs += separator + to_string(statistic.p99CostUs);
+        maxCosts += separator + to_string(statistic.maxCostUs);
+        p99Payloads += separator + to_string(statistic.p99PayloadBytes);
+    }
+    int ret = HiSysEventWrite(
+        MEDIA_LIBRARY,
+        "MEDIALIB_IPC_STATISTIC",
+        HiviewDFX::HiSysEvent::EventType::STATISTIC,
+        "DATE", DfxUtils::GetCurrentDate(),
+        "CODES", codes,
+        "COUNTS", counts,
+        "REJECT_COUNTS", rejectCounts,
+        "TOTAL_COSTS", totalCosts,
+        "P50_COSTS", p50Costs,
+        "P99_COSTS", p99Costs,
+        "MAX_COSTS", maxCosts,
+        "P99_PAYLOADS", p99Payloads);
+    if (ret != 0) {
+        MEDIA_ERR_LOG("Report ipc statistic error:%{public}d", ret);
+    }
+}
+
+void DfxReporter::ReportQueryShapeStatistic()
+{
+    QueryShapeStatistic statistic = DfxQueryStatistic::GetInstance().Snapshot(true);
+    if (statistic.hitCount == 0 && statistic.missCount == 0 && statistic.bypassCount == 0) {
+        return;
+    }
+    uint64_t avgBuildCostUs = statistic.missCount == 0 ? 0 : statistic.buildCostUs / statistic.missCount;
+    uint64_t avgHitCostUs = statistic.hitCount == 0 ? 0 : statistic.hitCostUs / statistic.hitCount;
+    uint64_t avgMissCostUs = statistic.missCount == 0 ? 0 : statistic.missCostUs / statistic.missCount;
+    int ret = HiSysEventWrite(
+        MEDIA_LIBRARY,
+        "MEDIALIB_QUERY_SHAPE_STATISTIC",
+        HiviewDFX::HiSysEvent::EventType::STATISTIC,
+        "DATE", DfxUtils::GetCurrentDate(),
+        "HIT_COUNT", statistic.hitCount,
+        "MISS_COUNT", statistic.missCount,
+        "BYPASS_COUNT", statistic.bypassCount,
+        "EVICT_COUNT", statistic.evictCount,
+        "LITERAL_COUNT", statistic.literalCount,
+        "AVG_BUILD_COST", avgBuildCostUs,
+        "AVG_HIT_COST", avgHitCostUs,
+        "AVG_MISS_COST", avgMissCostUs,
+        "BYPASS_COST", statistic.bypassCostUs,
+        "NET_SAVED_COST", DfxQueryStatistic::GetNetSavedCostUs(statistic));
+    if (ret != 0) {
+        MEDIA_ERR_LOG("Report query shape statistic error:%{public}d", ret);
+    }
 }
 } // namespace Media
 } // namespace OHOS
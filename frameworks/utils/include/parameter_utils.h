@@ -38,6 +38,8 @@ public:
 
     static int32_t CheckPublicCreateAsset(const CreateAssetReqBody &reqBody);
     static int32_t CheckSystemCreateAsset(const CreateAssetReqBody &reqBody);
+    static int32_t CheckBatchCreateAssets(const BatchCreateAssetsReqBody &reqBody);
+    static int32_t CheckBatchCommitAssets(const std::vector<int32_t> &fileIds);
     static int32_t CheckPublicCreateAssetForApp(const CreateAssetForAppReqBody &reqBody);
     static int32_t CheckSystemCreateAssetForApp(const CreateAssetForAppReqBody &reqBody);
     static int32_t CheckCreateAssetForAppWithAlbum(const CreateAssetForAppReqBody &reqBody);
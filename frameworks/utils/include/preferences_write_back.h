@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIALIBRARY_PREFERENCES_WRITE_BACK_H
+#define OHOS_MEDIALIBRARY_PREFERENCES_WRITE_BACK_H
+
+#include <cstdint>
+#include <memory>
+
+#include "preferences.h"
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+/**
+ * @brief Coalesces the flushes of preferences files. Values written by Put stay readable from the in-memory
+ * preferences at once, the file itself is written by a single flush once the delay since its first pending write
+ * has passed, or earlier on a barrier, a critical write or Stop. The delayed flush runs as an ffrt task that keeps
+ * the shared state alive, so destroying an instance never waits for it; owners call Stop from their shutdown path.
+ */
+class PreferencesWriteBack {
+public:
+    EXPORT static PreferencesWriteBack &GetInstance();
+    EXPORT explicit PreferencesWriteBack(int64_t delayMs);
+
+    // replaces FlushSync after Put, a critical write is on disk before returning
+    EXPORT void MarkDirty(const std::shared_ptr<NativePreferences::Preferences> &prefs, bool isCritical = false);
+    // flushes every pending file before returning
+    EXPORT void FlushAll();
+    // flushes every pending file and cancels the delayed flush until the next write
+    EXPORT void Stop();
+    EXPORT size_t GetPendingCount();
+
+private:
+    struct State;
+    static void ScheduleFlushLocked(const std::shared_ptr<State> &state, int64_t delayMs);
+    static void OnFlushTimer(const std::shared_ptr<State> &state, uint64_t generation);
+    static void FlushPending(const std::shared_ptr<State> &state, bool isForce);
+
+    std::shared_ptr<State> state_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIALIBRARY_PREFERENCES_WRITE_BACK_H
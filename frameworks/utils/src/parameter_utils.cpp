@@ -35,6 +35,7 @@ static const int32_t FORMID_MAX_LEN = 19;
 static const int32_t EDIT_DATA_MAX_LENGTH = 5 * 1024 * 1024;
 constexpr size_t MAX_TRASH_PHOTOS_SIZE = 300;
 constexpr size_t MAX_DELETE_PHOTOS_COMPLETED_SIZE = 500;
+constexpr size_t MAX_BATCH_CREATE_ASSETS_SIZE = 500;
 constexpr int32_t USER_COMMENT_MAX_LEN = 420;
 const std::unordered_set<int32_t> SUPPORTED_ORIENTATION{0, 90, 180, 270};
 const int32_t MAX_PHOTO_ID_LEN = 32;
@@ -182,6 +183,29 @@ int32_t ParameterUtils::CheckSystemCreateAsset(const CreateAssetReqBody &reqBody
     return E_OK;
 }
 
+int32_t ParameterUtils::CheckBatchCreateAssets(const BatchCreateAssetsReqBody &reqBody)
+{
+    CHECK_AND_RETURN_RET_LOG(!reqBody.assets.empty(), -EINVAL, "assets is empty");
+    CHECK_AND_RETURN_RET_LOG(reqBody.assets.size() <= MAX_BATCH_CREATE_ASSETS_SIZE, -EINVAL,
+        "Invalid assets size: %{public}zu", reqBody.assets.size());
+    for (const auto &asset : reqBody.assets) {
+        int32_t errCode = CheckPublicCreateAsset(asset);
+        CHECK_AND_RETURN_RET(errCode == E_OK, errCode);
+    }
+    return E_OK;
+}
+
+int32_t ParameterUtils::CheckBatchCommitAssets(const std::vector<int32_t> &fileIds)
+{
+    CHECK_AND_RETURN_RET_LOG(!fileIds.empty(), -EINVAL, "fileIds is empty");
+    CHECK_AND_RETURN_RET_LOG(fileIds.size() <= MAX_BATCH_CREATE_ASSETS_SIZE, -EINVAL,
+        "Invalid fileIds size: %{public}zu", fileIds.size());
+    for (int32_t fileId : fileIds) {
+        CHECK_AND_RETURN_RET_LOG(fileId > 0, -EINVAL, "Invalid fileId: %{public}d", fileId);
+    }
+    return E_OK;
+}
+
 int32_t ParameterUtils::CheckPublicCreateAssetForApp(const CreateAssetForAppReqBody &reqBody)
 {
     CHECK_AND_RETURN_RET_LOG(reqBody.displayName.empty(), -EINVAL, "Invalid displayName");
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "PreferencesWriteBack"
+
+#include "preferences_write_back.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "ffrt_inner.h"
+#include "media_log.h"
+
+namespace OHOS {
+namespace Media {
+// writes to the same file within this delay share one flush
+static constexpr int64_t WRITE_BACK_DELAY_MS = 3000;
+static constexpr uint64_t USEC_PER_MSEC = 1000;
+
+struct PreferencesWriteBack::State {
+    explicit State(int64_t delayMs) : delayMs(delayMs) {}
+
+    int64_t delayMs;
+    std::mutex mutex;
+    bool isScheduled = false;
+    // a delayed flush only acts for the generation it was scheduled in, Stop starts a new one
+    uint64_t generation = 0;
+    // pending files keyed by their preferences object, with the steady time of the first pending write in ms
+    std::map<NativePreferences::Preferences *,
+        std::pair<std::shared_ptr<NativePreferences::Preferences>, int64_t>> pending;
+    // serialises flushes so that a barrier returns only after a flush running on the ffrt task completes
+    std::mutex flushMutex;
+};
+
+static int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+PreferencesWriteBack &PreferencesWriteBack::GetInstance()
+{
+    static PreferencesWriteBack instance(WRITE_BACK_DELAY_MS);
+    return instance;
+}
+
+PreferencesWriteBack::PreferencesWriteBack(int64_t delayMs) : state_(std::make_shared<State>(delayMs)) {}
+
+void PreferencesWriteBack::MarkDirty(const std::shared_ptr<NativePreferences::Preferences> &prefs, bool isCritical)
+{
+    CHECK_AND_RETURN_LOG(prefs != nullptr, "prefs is nullptr");
+    if (!isCritical) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        // an already pending file keeps the time of its first write, so a steady stream of writes still flushes
+        state_->pending.emplace(prefs.get(), std::make_pair(prefs, GetSteadyTimeMs()));
+        CHECK_AND_EXECUTE(state_->isScheduled, ScheduleFlushLocked(state_, state_->delayMs));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->pending.erase(prefs.get());
+    }
+    std::lock_guard<std::mutex> flushLock(state_->flushMutex);
+    int32_t ret = prefs->FlushSync();
+    CHECK_AND_PRINT_LOG(ret == NativePreferences::E_OK, "Flush critical preferences failed, ret: %{public}d", ret);
+}
+
+void PreferencesWriteBack::FlushAll()
+{
+    FlushPending(state_, true);
+}
+
+void PreferencesWriteBack::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->generation++;
+        state_->isScheduled = false;
+    }
+    FlushPending(state_, true);
+}
+
+size_t PreferencesWriteBack::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->pending.size();
+}
+
+void PreferencesWriteBack::ScheduleFlushLocked(const std::shared_ptr<State> &state, int64_t delayMs)
+{
+    state->isScheduled = true;
+    uint64_t generation = state->generation;
+    ffrt::submit([state, generation]() { OnFlushTimer(state, generation); }, {}, {},
+        ffrt::task_attr().name("PrefsWriteBack").delay(static_cast<uint64_t>(std::max<int64_t>(delayMs, 0)) *
+        USEC_PER_MSEC));
+}
+
+void PreferencesWriteBack::OnFlushTimer(const std::shared_ptr<State> &state, uint64_t generation)
+{
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        CHECK_AND_RETURN(state->generation == generation);
+    }
+    FlushPending(state, false);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    CHECK_AND_RETURN(state->generation == generation);
+    state->isScheduled = false;
+    CHECK_AND_RETURN(!state->pending.empty());
+    int64_t firstWriteTime = std::numeric_limits<int64_t>::max();
+    for (const auto &[key, value] : state->pending) {
+        firstWriteTime = std::min(firstWriteTime, value.second);
+    }
+    ScheduleFlushLocked(state, firstWriteTime + state->delayMs - GetSteadyTimeMs());
+}
+
+void PreferencesWriteBack::FlushPending(const std::shared_ptr<State> &state, bool isForce)
+{
+    std::lock_guard<std::mutex> flushLock(state->flushMutex);
+    std::vector<std::shared_ptr<NativePreferences::Preferences>> files;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        int64_t now = GetSteadyTimeMs();
+        for (auto it = state->pending.begin(); it != state->pending.end();) {
+            if (isForce || it->second.second + state->delayMs <= now) {
+                files.push_back(it->second.first);
+                it = state->pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    // a write arriving during the flush marks its file pending again and is flushed in the next round
+    for (const auto &prefs : files) {
+        int32_t ret = prefs->FlushSync();
+        CHECK_AND_PRINT_LOG(ret == NativePreferences::E_OK, "Flush preferences failed, ret: %{public}d", ret);
+    }
+}
+} // namespace Media
+} // namespace OHOS
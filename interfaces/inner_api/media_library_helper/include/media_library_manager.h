@@ -183,6 +183,26 @@ public:
     EXPORT int32_t GetBatchAstcs(
         const std::vector<std::string> &uriBatch, std::vector<std::vector<uint8_t>> &astcBatch);
 
+    /**
+     * @brief Report the visible window of the month or year grid, astc pages ahead of it are read in the background
+     *
+     * @param size thumbnail size of the grid, month or year
+     * @param start offset of the first visible item
+     * @param count number of visible items
+     * @param direction 1 towards larger offsets, -1 towards smaller offsets, 0 inferred from the previous window
+     * @param speed scroll speed in items per second, 0 inferred from the previous window
+     */
+    EXPORT void ReportAstcScrollState(const Size &size, int32_t start, int32_t count, int32_t direction = 0,
+        int32_t speed = 0);
+
+    /**
+     * @brief Shrink or drop the astc read-ahead cache on memory pressure, the cache is also trimmed on
+     * system memory level and background notifications
+     *
+     * @param memoryLevel 0 normal, 1 moderate, 2 critical
+     */
+    EXPORT void TrimAstcCache(int32_t memoryLevel);
+
     /**
      * @brief Obtain pixelmap of astc
      *
@@ -492,6 +512,7 @@ private:
     static unique_ptr<PixelMap> GetPixelMapWithoutDecode(UniqueFd &uniqueFd, const Size& size);
     static unique_ptr<PixelMap> DecodeAstc(UniqueFd &uniqueFd);
     shared_ptr<DataShare::DataShareHelper> GetDataShareHelper();
+    void RegisterAstcPrefetchInvalidator();
 
     static shared_ptr<DataShare::DataShareHelper> sDataShareHelper_;
     static sptr<IRemoteObject> token_;
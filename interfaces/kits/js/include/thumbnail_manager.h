@@ -17,17 +17,18 @@
 #define INTERFACES_KITS_JS_MEDIALIBRARY_INCLUDE_THUMBNAIL_MANAGER_H
 
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
 #include "image_type.h"
 #include "napi/native_api.h"
 #include "nocopyable.h"
 #include "safe_map.h"
-#include "safe_queue.h"
 #include "pixel_map.h"
 #include "unique_fd.h"
 #include "userfile_manager_types.h"
@@ -54,6 +55,7 @@ struct RequestPhotoParams {
     std::string path;
     Size size;
     RequestPhotoType type;
+    int64_t dateModified = 0;
 };
 
 class ThumbnailCallback {
@@ -97,6 +99,11 @@ public:
         return requestSize_;
     }
 
+    int64_t GetDateModified() const
+    {
+        return dateModified_;
+    }
+
     PixelMapPtr GetPixelMap()
     {
         return std::move(pixelMap);
@@ -144,6 +151,7 @@ private:
     std::string uri_;
     std::string path_;
     Size requestSize_;
+    int64_t dateModified_ = 0;
     ThumbnailStatus status_ = ThumbnailStatus::THUMB_INITIAL;
     std::mutex mutex_;
     std::string uuid_;
@@ -153,6 +161,62 @@ private:
     PixelMapPtr pixelMap;
 };
 
+// Pending requests of one priority. A cancelled request is taken out at once, and when the queue is full the oldest
+// request is handed back to the caller to be failed instead of waiting behind newer ones.
+class ThumbnailRequestQueue {
+public:
+    explicit ThumbnailRequestQueue(size_t maxDepth) : maxDepth_(maxDepth) {}
+    RequestSharedPtr Push(const RequestSharedPtr &request);
+    bool Pop(RequestSharedPtr &request);
+    bool Erase(const std::string &requestId);
+    bool Empty();
+
+private:
+    std::mutex mutex_;
+    std::deque<RequestSharedPtr> requests_;
+    size_t maxDepth_;
+};
+
+// Recently decoded thumbnails, bounded by pixel bytes. An entry is keyed by uri, size and the modification time of
+// the asset, callers always get a copy since the js side may edit its pixel map in place.
+class ThumbnailPixelMapCache {
+public:
+    ThumbnailPixelMapCache(size_t maxBytes, size_t maxCount) : maxBytes_(maxBytes), maxCount_(maxCount) {}
+    static std::string GetKey(const std::string &uri, const Size &size, int64_t dateModified);
+    PixelMapPtr Get(const std::string &key);
+    void Put(const std::string &key, const std::string &fileId, PixelMap &pixelMap);
+    // an empty file id drops every entry
+    void Invalidate(const std::string &fileId);
+
+private:
+    struct CacheEntry {
+        std::string key;
+        std::string fileId;
+        std::shared_ptr<PixelMap> pixelMap;
+        size_t bytes = 0;
+    };
+    using EntryList = std::list<CacheEntry>;
+    void EraseEntry(EntryList::iterator it);
+
+    std::mutex mutex_;
+    // most recently used entry at the front
+    EntryList entries_;
+    std::unordered_map<std::string, EntryList::iterator> entryMap_;
+    size_t totalBytes_ = 0;
+    size_t maxBytes_;
+    size_t maxCount_;
+};
+
+class ThumbnailCacheObserver : public DataShare::DataShareObserver {
+public:
+    explicit ThumbnailCacheObserver(ThumbnailPixelMapCache &cache) : cache_(cache) {}
+    ~ThumbnailCacheObserver() = default;
+    void OnChange(const ChangeInfo &changeInfo) override;
+
+private:
+    ThumbnailPixelMapCache &cache_;
+};
+
 class MMapFdPtr {
 public:
     explicit MMapFdPtr(int32_t fd, bool isNeedRelease);
@@ -168,6 +232,9 @@ private:
 };
 
 constexpr int THREAD_NUM = 5;
+constexpr size_t MAX_QUEUE_DEPTH = 256;
+constexpr size_t PIXEL_MAP_CACHE_BYTES = 32 * 1024 * 1024;
+constexpr size_t PIXEL_MAP_CACHE_COUNT = 256;
 class ThumbnailManager : NoCopyable {
 public:
     virtual ~ThumbnailManager();
@@ -193,10 +260,15 @@ private:
     void AddFastPhotoRequest(const RequestSharedPtr &request);
     void NotifyImage(const RequestSharedPtr &request);
     bool RequestFastImage(const RequestSharedPtr &request);
+    void FailDroppedRequest(const RequestSharedPtr &request);
+    PixelMapPtr GetCachedPixelMap(const RequestSharedPtr &request, const Size &size);
+    void CachePixelMap(const RequestSharedPtr &request, const Size &size, PixelMap &pixelMap);
 
     SafeMap<std::string, RequestSharedPtr> thumbRequest_;
-    SafeQueue<RequestSharedPtr> fastQueue_;
-    SafeQueue<RequestSharedPtr> qualityQueue_;
+    ThumbnailRequestQueue fastQueue_ { MAX_QUEUE_DEPTH };
+    ThumbnailRequestQueue qualityQueue_ { MAX_QUEUE_DEPTH };
+    ThumbnailPixelMapCache pixelMapCache_ { PIXEL_MAP_CACHE_BYTES, PIXEL_MAP_CACHE_COUNT };
+    std::shared_ptr<ThumbnailCacheObserver> cacheObserver_;
 
     std::mutex queueLock_;
     std::condition_variable queueCv_;
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIALIBRARY_BACKGROUND_CLOUD_FILE_DOWNLOAD_SCHEDULER_H
+#define OHOS_MEDIALIBRARY_BACKGROUND_CLOUD_FILE_DOWNLOAD_SCHEDULER_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+
+struct CloudDownloadCandidate {
+    std::string uri;
+    int32_t fileId = 0;
+    int64_t dateTaken = 0;
+    int64_t size = 0;
+    bool isFavorite = false;
+    int32_t visitCount = 0;
+    // failed attempts, persisted per uri by the processor
+    int64_t downloadCnt = 0;
+    double value = 0.0;
+};
+
+enum class CloudDownloadResult : int32_t {
+    SUCCESS = 0,
+    NETWORK_UNAVAILABLE,
+    STORAGE_FULL,
+    STOPPED,
+    FAILED,
+    // StartFileCache refused the batch, the files are not blamed but the batch did not download anything
+    START_FAILED,
+};
+
+// position of the candidate scan, the newest and the oldest photo already read from the database
+struct CloudDownloadCursor {
+    bool isStarted = false;
+    bool isExhausted = false;
+    int64_t headDateTaken = 0;
+    int64_t tailDateTaken = 0;
+    int32_t tailFileId = 0;
+    int64_t scannedNum = 0;
+};
+
+/**
+ * @brief Picks the cloud files downloaded in each background cycle. Candidates read page by page through a cursor
+ * wait in a queue ordered by predicted viewing value. The number of files of a batch follows the observed results,
+ * growing while batches finish early and halving on network failures or batches outliving the cycle, and the bytes
+ * of a batch are bounded by the measured throughput and the storage headroom.
+ */
+class BackgroundCloudFileDownloadScheduler {
+public:
+    EXPORT explicit BackgroundCloudFileDownloadScheduler(int64_t intervalMs);
+
+    EXPORT static double PredictViewingValue(const CloudDownloadCandidate &candidate, int64_t nowMs);
+    EXPORT void AddCandidates(std::vector<CloudDownloadCandidate> candidates, int64_t nowMs);
+    EXPORT size_t GetPendingCount();
+    // picks the next batch, empty while the previous batch is still running or the storage is short
+    EXPORT std::vector<CloudDownloadCandidate> StartBatch(double freeRatio, int64_t cycleNum, int64_t nowMs);
+    EXPORT void OnFileFinished(const std::string &uri, CloudDownloadResult result, int64_t nowMs);
+    EXPORT bool IsBatchRunning();
+    // the next StartBatch gives up a timed out batch, its download has to be stopped first
+    EXPORT bool IsBatchTimedOut(int64_t nowMs);
+    EXPORT int32_t GetBatchLimit();
+    // bytes per second, 0 until a batch has finished successfully
+    EXPORT int64_t GetThroughput();
+    EXPORT CloudDownloadCursor GetCursor();
+    EXPORT void SetCursor(const CloudDownloadCursor &cursor);
+    EXPORT void Reset();
+
+private:
+    void FinishBatch(int64_t nowMs, bool isTimeout);
+    bool IsBatchTimedOutLocked(int64_t nowMs);
+    void Requeue(CloudDownloadCandidate candidate, CloudDownloadResult result);
+    int64_t GetByteBudget(double freeRatio);
+
+    int64_t intervalMs_;
+    std::mutex mutex_;
+    std::deque<CloudDownloadCandidate> pending_;
+    CloudDownloadCursor cursor_;
+
+    // files of the running batch keyed by uri
+    std::unordered_map<std::string, CloudDownloadCandidate> running_;
+    int64_t batchStartMs_ = 0;
+    bool isBatchOverrun_ = false;
+    int32_t batchSuccessNum_ = 0;
+    int32_t batchFailedNum_ = 0;
+    int64_t batchSuccessBytes_ = 0;
+    bool isNetworkFailed_ = false;
+    bool isStorageFull_ = false;
+
+    int32_t batchLimit_;
+    double throughput_ = 0.0;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIALIBRARY_BACKGROUND_CLOUD_FILE_DOWNLOAD_SCHEDULER_H
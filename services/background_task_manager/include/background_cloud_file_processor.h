@@ -18,6 +18,7 @@
 
 #include "background_cloud_file_processor_common.h"
 #include "background_cloud_file_download_callback.h"
+#include "background_cloud_file_download_scheduler.h"
 
 namespace OHOS {
 namespace Media {
@@ -96,7 +97,9 @@ private:
     static void CheckAndUpdateDownloadCnt(std::string path, int64_t cnt);
     static void GetDownloadNum(int64_t &downloadNum);
     static void DownloadLatestFinished();
-    static void ParseDownloadFiles(std::shared_ptr<NativeRdb::ResultSet> &resultSet, DownloadFiles &downloadFiles);
+    static void ReadDownloadCandidates(std::shared_ptr<NativeRdb::ResultSet> &resultSet, int64_t currentMilliSecond);
+    static void ParseDownloadFiles(std::shared_ptr<NativeRdb::ResultSet> &resultSet, DownloadFiles &downloadFiles,
+        double freeRatio);
     static void removeFinishedResult(const std::vector<std::string>& downloadingPaths);
     static int32_t AddDownloadTask(const DownloadFiles &downloadFiles);
     static void DownloadCloudFilesExecutor(AsyncTaskData *data);
@@ -132,6 +135,7 @@ private:
     static std::mutex repairMimeTypeMutex_;
     static std::unordered_map<std::string, DownloadStatus> downloadResult_;
     static int64_t downloadId_;
+    static BackgroundCloudFileDownloadScheduler scheduler_;
 };
 } // namespace Media
 } // namespace OHOS
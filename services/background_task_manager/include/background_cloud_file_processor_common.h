@@ -39,6 +39,10 @@ constexpr int32_t DOWNLOAD_INTERVAL = 1 * 60 * 1000;  // 1 minute
 constexpr int32_t DOWNLOAD_DURATION = 10 * 1000; // 10 seconds
 constexpr int32_t DOWNLOAD_FAIL_MAX_TIMES = 5; // 5 times
 
+// The task can be performed only when the ratio of available storage capacity reaches this value
+constexpr double DEVICE_STORAGE_FREE_RATIO_HIGH = 0.15;
+constexpr double DEVICE_STORAGE_FREE_RATIO_LOW = 0.05;
+
 typedef struct {
     bool isCloud;
     bool isVideo;
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "BackgroundCloudFileDownloadScheduler"
+
+#include "background_cloud_file_download_scheduler.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+#include "background_cloud_file_processor_common.h"
+#include "media_log.h"
+
+namespace OHOS {
+namespace Media {
+static constexpr int32_t MIN_BATCH_NUM = 1;
+// the number of uris a single StartFileCache request is given at most
+static constexpr int32_t MAX_BATCH_NUM = 30;
+// a batch still running after this many cycles is given up and its files retried
+static constexpr int64_t BATCH_TIMEOUT_CYCLES = 3;
+// a batch is sized to take this share of the cycle at the measured throughput
+static constexpr double TARGET_UTILIZATION = 0.5;
+static constexpr double THROUGHPUT_WEIGHT = 0.3;
+static constexpr int64_t MSEC_PER_SEC = 1000;
+
+static constexpr double MSEC_PER_DAY = 24.0 * 60 * 60 * 1000;
+static constexpr double RECENCY_HALF_LIFE_DAYS = 7.0;
+static constexpr double FAVORITE_VALUE = 1.0;
+static constexpr double VISIT_VALUE_WEIGHT = 0.25;
+
+BackgroundCloudFileDownloadScheduler::BackgroundCloudFileDownloadScheduler(int64_t intervalMs)
+    : intervalMs_(std::max<int64_t>(intervalMs, 1)), batchLimit_(MIN_BATCH_NUM) {}
+
+double BackgroundCloudFileDownloadScheduler::PredictViewingValue(const CloudDownloadCandidate &candidate,
+    int64_t nowMs)
+{
+    // recent photos are viewed most, favorites and photos opened before are likely to be viewed again
+    double ageDays = std::max(0.0, static_cast<double>(nowMs - candidate.dateTaken) / MSEC_PER_DAY);
+    double value = std::exp2(-ageDays / RECENCY_HALF_LIFE_DAYS);
+    value += candidate.isFavorite ? FAVORITE_VALUE : 0.0;
+    value += VISIT_VALUE_WEIGHT * std::log2(1.0 + static_cast<double>(std::max(candidate.visitCount, 0)));
+    return value;
+}
+
+void BackgroundCloudFileDownloadScheduler::AddCandidates(std::vector<CloudDownloadCandidate> candidates,
+    int64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &candidate : candidates) {
+        bool isQueued = running_.count(candidate.uri) > 0 || std::any_of(pending_.begin(), pending_.end(),
+            [&candidate](const CloudDownloadCandidate &item) { return item.uri == candidate.uri; });
+        CHECK_AND_CONTINUE(!isQueued);
+        candidate.value = PredictViewingValue(candidate, nowMs);
+        pending_.push_back(std::move(candidate));
+    }
+    std::stable_sort(pending_.begin(), pending_.end(),
+        [](const CloudDownloadCandidate &lhs, const CloudDownloadCandidate &rhs) { return lhs.value > rhs.value; });
+}
+
+size_t BackgroundCloudFileDownloadScheduler::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+int64_t BackgroundCloudFileDownloadScheduler::GetByteBudget(double freeRatio)
+{
+    CHECK_AND_RETURN_RET(throughput_ > 0.0, 0);
+    double budget = throughput_ * static_cast<double>(intervalMs_) / MSEC_PER_SEC * TARGET_UTILIZATION;
+    if (freeRatio < DEVICE_STORAGE_FREE_RATIO_HIGH) {
+        budget *= (freeRatio - DEVICE_STORAGE_FREE_RATIO_LOW) /
+            (DEVICE_STORAGE_FREE_RATIO_HIGH - DEVICE_STORAGE_FREE_RATIO_LOW);
+    }
+    return std::max<int64_t>(static_cast<int64_t>(budget), 1);
+}
+
+std::vector<CloudDownloadCandidate> BackgroundCloudFileDownloadScheduler::StartBatch(double freeRatio,
+    int64_t cycleNum, int64_t nowMs)
+{
+    std::vector<CloudDownloadCandidate> batch;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_.empty()) {
+        if (!IsBatchTimedOutLocked(nowMs)) {
+            // the link is slower than the batch assumed, the next batch is smaller
+            if (!isBatchOverrun_) {
+                isBatchOverrun_ = true;
+                batchLimit_ = std::max(MIN_BATCH_NUM, batchLimit_ / 2);
+                MEDIA_INFO_LOG("Batch outlives the cycle, running: %{public}zu, limit: %{public}d",
+                    running_.size(), batchLimit_);
+            }
+            return batch;
+        }
+        FinishBatch(nowMs, true);
+    }
+    CHECK_AND_RETURN_RET_LOG(freeRatio >= DEVICE_STORAGE_FREE_RATIO_LOW, batch,
+        "freeRatio is %{public}.2f, no batch started", freeRatio);
+
+    // compensates the cycles missed while the kernel hibernates
+    int64_t limit = std::min<int64_t>(static_cast<int64_t>(batchLimit_) * std::max<int64_t>(cycleNum, 1),
+        MAX_BATCH_NUM);
+    if (freeRatio < DEVICE_STORAGE_FREE_RATIO_HIGH) {
+        double headroom = (freeRatio - DEVICE_STORAGE_FREE_RATIO_LOW) /
+            (DEVICE_STORAGE_FREE_RATIO_HIGH - DEVICE_STORAGE_FREE_RATIO_LOW);
+        limit = std::max<int64_t>(static_cast<int64_t>(static_cast<double>(limit) * headroom), MIN_BATCH_NUM);
+    }
+    int64_t budget = GetByteBudget(freeRatio);
+    int64_t batchBytes = 0;
+    while (!pending_.empty() && static_cast<int64_t>(batch.size()) < limit) {
+        const auto &candidate = pending_.front();
+        bool isOverBudget = budget > 0 && !batch.empty() && batchBytes + candidate.size > budget;
+        CHECK_AND_BREAK(!isOverBudget);
+        batchBytes += candidate.size;
+        batch.push_back(candidate);
+        pending_.pop_front();
+    }
+    CHECK_AND_RETURN_RET(!batch.empty(), batch);
+
+    for (const auto &candidate : batch) {
+        running_.emplace(candidate.uri, candidate);
+    }
+    batchStartMs_ = nowMs;
+    isBatchOverrun_ = false;
+    batchSuccessNum_ = 0;
+    batchFailedNum_ = 0;
+    batchSuccessBytes_ = 0;
+    isNetworkFailed_ = false;
+    isStorageFull_ = false;
+    MEDIA_DEBUG_LOG("Start batch, num: %{public}zu, bytes: %{public}" PRId64 ", limit: %{public}" PRId64
+        ", budget: %{public}" PRId64, batch.size(), batchBytes, limit, budget);
+    return batch;
+}
+
+bool BackgroundCloudFileDownloadScheduler::IsBatchTimedOutLocked(int64_t nowMs)
+{
+    return !running_.empty() && nowMs - batchStartMs_ >= BATCH_TIMEOUT_CYCLES * intervalMs_;
+}
+
+bool BackgroundCloudFileDownloadScheduler::IsBatchTimedOut(int64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return IsBatchTimedOutLocked(nowMs);
+}
+
+void BackgroundCloudFileDownloadScheduler::Requeue(CloudDownloadCandidate candidate, CloudDownloadResult result)
+{
+    // network and storage failures are not the file's fault and are not counted
+    if (result == CloudDownloadResult::FAILED) {
+        candidate.downloadCnt++;
+    }
+    CHECK_AND_RETURN(candidate.downloadCnt < DOWNLOAD_FAIL_MAX_TIMES);
+    pending_.push_front(std::move(candidate));
+}
+
+void BackgroundCloudFileDownloadScheduler::OnFileFinished(const std::string &uri, CloudDownloadResult result,
+    int64_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = running_.find(uri);
+    CHECK_AND_RETURN(it != running_.end());
+    CloudDownloadCandidate candidate = std::move(it->second);
+    running_.erase(it);
+    switch (result) {
+        case CloudDownloadResult::SUCCESS:
+            batchSuccessNum_++;
+            batchSuccessBytes_ += candidate.size;
+            break;
+        case CloudDownloadResult::NETWORK_UNAVAILABLE:
+            isNetworkFailed_ = true;
+            batchFailedNum_++;
+            Requeue(std::move(candidate), result);
+            break;
+        case CloudDownloadResult::STORAGE_FULL:
+            isStorageFull_ = true;
+            batchFailedNum_++;
+            Requeue(std::move(candidate), result);
+            break;
+        case CloudDownloadResult::STOPPED:
+            Requeue(std::move(candidate), result);
+            break;
+        default:
+            batchFailedNum_++;
+            Requeue(std::move(candidate), result);
+            break;
+    }
+    CHECK_AND_EXECUTE(!running_.empty(), FinishBatch(nowMs, false));
+}
+
+void BackgroundCloudFileDownloadScheduler::FinishBatch(int64_t nowMs, bool isTimeout)
+{
+    for (auto &[uri, candidate] : running_) {
+        batchFailedNum_++;
+        Requeue(std::move(candidate), CloudDownloadResult::FAILED);
+    }
+    running_.clear();
+
+    int64_t elapsedMs = std::max<int64_t>(nowMs - batchStartMs_, 1);
+    if (batchSuccessBytes_ > 0) {
+        double sample = static_cast<double>(batchSuccessBytes_) * MSEC_PER_SEC / static_cast<double>(elapsedMs);
+        throughput_ = throughput_ > 0.0 ? (1.0 - THROUGHPUT_WEIGHT) * throughput_ + THROUGHPUT_WEIGHT * sample :
+            sample;
+    }
+    if (isStorageFull_) {
+        batchLimit_ = MIN_BATCH_NUM;
+    } else if (isNetworkFailed_ || isTimeout) {
+        batchLimit_ = std::max(MIN_BATCH_NUM, batchLimit_ / 2);
+    } else if (batchSuccessNum_ > 0 && batchFailedNum_ == 0 && !isBatchOverrun_) {
+        // a batch done within half the cycle leaves the link idle, so the next one doubles
+        batchLimit_ = elapsedMs * 2 <= intervalMs_ ? std::min(batchLimit_ * 2, MAX_BATCH_NUM) :
+            std::min(batchLimit_ + 1, MAX_BATCH_NUM);
+    }
+    MEDIA_INFO_LOG("Batch finished, success: %{public}d, failed: %{public}d, cost: %{public}" PRId64
+        "ms, timeout: %{public}d, limit: %{public}d, throughput: %{public}" PRId64 "B/s", batchSuccessNum_,
+        batchFailedNum_, elapsedMs, isTimeout, batchLimit_, static_cast<int64_t>(throughput_));
+}
+
+bool BackgroundCloudFileDownloadScheduler::IsBatchRunning()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !running_.empty();
+}
+
+int32_t BackgroundCloudFileDownloadScheduler::GetBatchLimit()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batchLimit_;
+}
+
+int64_t BackgroundCloudFileDownloadScheduler::GetThroughput()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int64_t>(throughput_);
+}
+
+CloudDownloadCursor BackgroundCloudFileDownloadScheduler::GetCursor()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cursor_;
+}
+
+void BackgroundCloudFileDownloadScheduler::SetCursor(const CloudDownloadCursor &cursor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    cursor_ = cursor;
+}
+
+void BackgroundCloudFileDownloadScheduler::Reset()
+{
+    // the learned batch limit and throughput describe the link and are kept
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    running_.clear();
+    cursor_ = CloudDownloadCursor();
+}
+} // namespace Media
+} // namespace OHOS
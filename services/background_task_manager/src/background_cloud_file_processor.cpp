@@ -17,6 +17,7 @@
 
 #include "background_cloud_file_processor.h"
 
+#include <algorithm>
 #include <sys/statvfs.h>
 
 #include "abs_rdb_predicates.h"
@@ -40,6 +41,7 @@
 #include "values_bucket.h"
 #include "preferences.h"
 #include "preferences_helper.h"
+#include "preferences_write_back.h"
 #include "cloud_sync_utils.h"
 #include "power_efficiency_manager.h"
 #include "result_set_reader.h"
@@ -58,10 +60,6 @@ static constexpr int32_t MAX_RETRY_COUNT = 2;
 static constexpr int32_t MIMETYPE_REPAIR_INTERVAL = 20000;
 static constexpr int32_t CACHE_PHOTO_NUM = 100;
 
-// The task can be performed only when the ratio of available storage capacity reaches this value
-static constexpr double DEVICE_STORAGE_FREE_RATIO_HIGH = 0.15;
-static constexpr double DEVICE_STORAGE_FREE_RATIO_LOW = 0.05;
-
 static constexpr int64_t ONEDAY_TO_SEC = 60 * 60 * 24;
 #ifdef MEDIALIBRARY_SECURE_ALBUM_ENABLE
     static constexpr int64_t DOWNLOAD_NUM_FREE_RATIO_HIGH = 100;
@@ -74,6 +72,9 @@ static constexpr int64_t DOWNLOAD_DAY_FREE_RATIO_HIGH = 30;
 static constexpr int64_t DOWNLOAD_DAY_FREE_RATIO_LOW = 7;
 
 static const int64_t DOWNLOAD_ID_DEFAULT = -1;
+// rows read from the candidate cursor at once, the next page is read once fewer candidates than a full batch wait
+static constexpr int32_t CANDIDATE_PAGE_SIZE = 100;
+static constexpr size_t CANDIDATE_REFILL_NUM = 30;
 
 int32_t BackgroundCloudFileProcessor::processInterval_ = PROCESS_INTERVAL;  // 5 minute
 int32_t BackgroundCloudFileProcessor::downloadInterval_ = DOWNLOAD_INTERVAL;  // 1 minute
@@ -93,6 +94,7 @@ std::mutex BackgroundCloudFileProcessor::repairMimeTypeMutex_;
 std::unordered_map<std::string, BackgroundCloudFileProcessor::DownloadStatus>
     BackgroundCloudFileProcessor::downloadResult_;
 int64_t BackgroundCloudFileProcessor::downloadId_ = DOWNLOAD_ID_DEFAULT;
+BackgroundCloudFileDownloadScheduler BackgroundCloudFileProcessor::scheduler_(DOWNLOAD_INTERVAL);
 
 const std::string BACKGROUND_CLOUD_FILE_CONFIG = "/data/storage/el2/base/preferences/background_cloud_file_config.xml";
 const std::string DOWNLOAD_CNT_CONFIG = "/data/storage/el2/base/preferences/download_count_config.xml";
@@ -114,7 +116,7 @@ void BackgroundCloudFileProcessor::SetDownloadLatestFinished(bool downloadLatest
     CHECK_AND_RETURN_LOG(prefs, "get preferences error: %{public}d", errCode);
 
     prefs->PutBool(DOWNLOAD_LATEST_FINISHED, downloadLatestFinished);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("set preferences %{public}d", downloadLatestFinished);
 }
 
@@ -137,7 +139,7 @@ void BackgroundCloudFileProcessor::SetLastDownloadMilliSecond(int64_t lastDownlo
     CHECK_AND_RETURN_LOG(prefs, "get preferences error: %{public}d", errCode);
 
     prefs->PutLong(LAST_DOWNLOAD_MILLISECOND, lastDownloadMilliSecond);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 int64_t BackgroundCloudFileProcessor::GetLastDownloadMilliSecond()
@@ -158,7 +160,7 @@ void BackgroundCloudFileProcessor::ClearDownloadCnt()
         NativePreferences::PreferencesHelper::GetPreferences(DOWNLOAD_CNT_CONFIG, errCode);
     CHECK_AND_RETURN_LOG(prefs, "get preferences error: %{public}d", errCode);
     prefs->Clear();
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 void BackgroundCloudFileProcessor::UpdateDownloadCnt(std::string uri, int64_t cnt)
@@ -168,7 +170,7 @@ void BackgroundCloudFileProcessor::UpdateDownloadCnt(std::string uri, int64_t cn
         NativePreferences::PreferencesHelper::GetPreferences(DOWNLOAD_CNT_CONFIG, errCode);
     CHECK_AND_RETURN_LOG(prefs, "get preferences error: %{public}d", errCode);
     prefs->PutLong(uri, cnt);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
 }
 
 int64_t BackgroundCloudFileProcessor::GetDownloadCnt(std::string uri)
@@ -190,15 +192,19 @@ void BackgroundCloudFileProcessor::DownloadCloudFiles()
     double freeRatio = 0.0;
     CHECK_AND_RETURN_LOG(GetStorageFreeRatio(freeRatio),
         "GetStorageFreeRatio failed, stop downloading cloud files");
-    auto resultSet = QueryCloudFiles(freeRatio);
-    CHECK_AND_RETURN_LOG(resultSet != nullptr, "Failed to query cloud files!");
+    // the candidates stay queued across cycles, the database is read again only once the queue runs low
+    std::shared_ptr<NativeRdb::ResultSet> resultSet = nullptr;
+    if (scheduler_.GetPendingCount() < CANDIDATE_REFILL_NUM) {
+        resultSet = QueryCloudFiles(freeRatio);
+        CHECK_AND_RETURN_LOG(resultSet != nullptr, "Failed to query cloud files!");
+    }
 
     DownloadFiles downloadFiles;
-    ParseDownloadFiles(resultSet, downloadFiles);
-    CHECK_AND_RETURN_LOG(!downloadFiles.uris.empty(), "No cloud files need to be downloaded");
+    ParseDownloadFiles(resultSet, downloadFiles, freeRatio);
     if (resultSet != nullptr) {
         resultSet->Close();
     }
+    CHECK_AND_RETURN_LOG(!downloadFiles.uris.empty(), "No cloud files need to be downloaded");
     int32_t ret = AddDownloadTask(downloadFiles);
     CHECK_AND_PRINT_LOG(ret == E_OK, "Failed to add download task! err: %{public}d", ret);
 }
@@ -316,7 +322,7 @@ void BackgroundCloudFileProcessor::HandleRepairMimeType(const int32_t &lastRecor
             this_thread::sleep_for(chrono::milliseconds(MIMETYPE_REPAIR_INTERVAL));
         }
         prefs->PutInt(LAST_LOCAL_MIMETYPE_REPAIR, repairRecord);
-        prefs->FlushSync();
+        PreferencesWriteBack::GetInstance().MarkDirty(prefs);
         MEDIA_INFO_LOG("repair mimetype to %{public}d", repairRecord);
         CHECK_AND_EXECUTE(terminate, photosPoVec = GetRepairMimeTypeData(repairRecord));
     } while (!terminate && !photosPoVec.empty());
@@ -382,16 +388,30 @@ std::shared_ptr<NativeRdb::ResultSet> BackgroundCloudFileProcessor::QueryCloudFi
 
     auto currentMilliSecond = MediaFileUtils::UTCTimeMilliSeconds();
 
+    // the next page after the photos already read, plus the photos taken since the scan started
+    CloudDownloadCursor cursor = scheduler_.GetCursor();
+    string cursorCondition;
+    if (cursor.isStarted) {
+        cursorCondition = " AND (" + MediaColumn::MEDIA_DATE_TAKEN + " > " + std::to_string(cursor.headDateTaken);
+        if (cursor.scannedNum < downloadNum) {
+            cursorCondition += " OR " + MediaColumn::MEDIA_DATE_TAKEN + " < " + std::to_string(cursor.tailDateTaken) +
+                " OR (" + MediaColumn::MEDIA_DATE_TAKEN + " = " + std::to_string(cursor.tailDateTaken) + " AND " +
+                PhotoColumn::MEDIA_ID + " < " + std::to_string(cursor.tailFileId) + ")";
+        }
+        cursorCondition += ")";
+    }
     string sql = "SELECT " + PhotoColumn::MEDIA_FILE_PATH + ", " + PhotoColumn::PHOTO_POSITION + ", " +
-        PhotoColumn::MEDIA_ID + ", " + PhotoColumn::MEDIA_NAME +
+        PhotoColumn::MEDIA_ID + ", " + PhotoColumn::MEDIA_NAME + ", " + MediaColumn::MEDIA_DATE_TAKEN + ", " +
+        MediaColumn::MEDIA_SIZE + ", " + MediaColumn::MEDIA_IS_FAV + ", " + PhotoColumn::PHOTO_VISIT_COUNT +
         " FROM " + PhotoColumn::PHOTOS_TABLE + " WHERE " +
         PhotoColumn::PHOTO_CLEAN_FLAG + " = " + std::to_string(static_cast<int32_t>(CleanType::TYPE_NOT_CLEAN)) +
         " AND " + PhotoColumn::MEDIA_FILE_PATH + " IS NOT NULL AND " + PhotoColumn::MEDIA_FILE_PATH + " != '' AND " +
         MediaColumn::MEDIA_SIZE + " > 0 AND " + PhotoColumn::MEDIA_TYPE + " = " + std::to_string(MEDIA_TYPE_IMAGE) +
         " AND " + MediaColumn::MEDIA_DATE_TAKEN + " > " + std::to_string(currentMilliSecond - downloadMilliSecond) +
-        " ORDER BY " + MediaColumn::MEDIA_DATE_TAKEN + " DESC, " + PhotoColumn::MEDIA_ID + " DESC LIMIT " +
-        std::to_string(downloadNum);
-    MEDIA_DEBUG_LOG("ParseDownloadFiles SQL limit downloadNum: %{public}" PRId64, downloadNum);
+        cursorCondition + " ORDER BY " + MediaColumn::MEDIA_DATE_TAKEN + " DESC, " + PhotoColumn::MEDIA_ID +
+        " DESC LIMIT " + std::to_string(CANDIDATE_PAGE_SIZE);
+    MEDIA_DEBUG_LOG("QueryCloudFiles downloadNum: %{public}" PRId64 ", scannedNum: %{public}" PRId64,
+        downloadNum, cursor.scannedNum);
     return uniStore->QuerySql(sql);
 }
 
@@ -434,6 +454,7 @@ void BackgroundCloudFileProcessor::DownloadLatestFinished()
 {
     SetDownloadLatestFinished(true);
     ClearDownloadCnt();
+    scheduler_.Reset();
 
     unique_lock<mutex> downloadLock(downloadResultMutex_);
     downloadResult_.clear();
@@ -450,51 +471,92 @@ void BackgroundCloudFileProcessor::DownloadLatestFinished()
     }
 }
 
-void BackgroundCloudFileProcessor::ParseDownloadFiles(std::shared_ptr<NativeRdb::ResultSet> &resultSet,
-    DownloadFiles &downloadFiles)
+void BackgroundCloudFileProcessor::ReadDownloadCandidates(std::shared_ptr<NativeRdb::ResultSet> &resultSet,
+    int64_t currentMilliSecond)
 {
-    int64_t downloadNum;
-    GetDownloadNum(downloadNum);
-    auto currentMilliSecond = MediaFileUtils::UTCTimeMilliSeconds();
-    SetLastDownloadMilliSecond(currentMilliSecond);
-
-    bool downloadLatestFinished = true;
-    downloadFiles.uris.clear();
+    CloudDownloadCursor cursor = scheduler_.GetCursor();
+    int64_t lastHeadDateTaken = cursor.headDateTaken;
+    int32_t rowCount = 0;
+    std::vector<CloudDownloadCandidate> candidates;
     while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        rowCount++;
+        int32_t fileId = get<int32_t>(ResultSetUtils::GetValFromColumn(PhotoColumn::MEDIA_ID, resultSet, TYPE_INT32));
+        int64_t dateTaken =
+            get<int64_t>(ResultSetUtils::GetValFromColumn(MediaColumn::MEDIA_DATE_TAKEN, resultSet, TYPE_INT64));
+        // rows come newest first, the photos taken since the last page come before the rest of the scan
+        if (!cursor.isStarted || dateTaken > lastHeadDateTaken) {
+            cursor.headDateTaken = std::max(cursor.headDateTaken, dateTaken);
+        }
+        if (!cursor.isStarted || dateTaken <= lastHeadDateTaken) {
+            cursor.tailDateTaken = dateTaken;
+            cursor.tailFileId = fileId;
+        }
+        cursor.isStarted = true;
+
         std::string path =
             get<std::string>(ResultSetUtils::GetValFromColumn(PhotoColumn::MEDIA_FILE_PATH, resultSet, TYPE_STRING));
         if (path.empty()) {
             MEDIA_WARN_LOG("Failed to get cloud file path!");
             continue;
         }
-
         int32_t position =
             get<int32_t>(ResultSetUtils::GetValFromColumn(PhotoColumn::PHOTO_POSITION, resultSet, TYPE_INT32));
         if (position != static_cast<int32_t>(PhotoPositionType::CLOUD)) {
             continue;
         }
-        int32_t fileId = get<int32_t>(ResultSetUtils::GetValFromColumn(PhotoColumn::MEDIA_ID, resultSet, TYPE_INT32));
-        MEDIA_DEBUG_LOG("ParseDownloadFiles fileId: %{public}d", fileId);
         std::string displayName =
             get<std::string>(ResultSetUtils::GetValFromColumn(PhotoColumn::MEDIA_NAME, resultSet, TYPE_STRING));
         if (displayName.empty()) {
             MEDIA_WARN_LOG("Failed to get cloud file displayName!");
             continue;
         }
-        std::string uri = "";
-        uri = MediaFileUri::GetPhotoUri(to_string(fileId), path, displayName);
-
-        int64_t cnt = GetDownloadCnt(uri);
-        if (cnt < DOWNLOAD_FAIL_MAX_TIMES) {
-            downloadLatestFinished = false;
-            downloadFiles.uris.push_back(uri);
-            downloadFiles.mediaType = MEDIA_TYPE_IMAGE;
-            CheckAndUpdateDownloadCnt(uri, cnt);
-            if ((int64_t)downloadFiles.uris.size() >= downloadNum) {
-                break;
-            }
+        CloudDownloadCandidate candidate;
+        candidate.uri = MediaFileUri::GetPhotoUri(to_string(fileId), path, displayName);
+        candidate.downloadCnt = GetDownloadCnt(candidate.uri);
+        if (candidate.downloadCnt >= DOWNLOAD_FAIL_MAX_TIMES) {
+            continue;
         }
+        candidate.fileId = fileId;
+        candidate.dateTaken = dateTaken;
+        candidate.size = GetInt64Val(MediaColumn::MEDIA_SIZE, resultSet);
+        candidate.isFavorite = GetInt32Val(MediaColumn::MEDIA_IS_FAV, resultSet) != 0;
+        candidate.visitCount = GetInt32Val(PhotoColumn::PHOTO_VISIT_COUNT, resultSet);
+        candidates.push_back(std::move(candidate));
     }
+    cursor.scannedNum += rowCount;
+    cursor.isExhausted = rowCount < CANDIDATE_PAGE_SIZE;
+    scheduler_.SetCursor(cursor);
+    MEDIA_DEBUG_LOG("ReadDownloadCandidates rows: %{public}d, candidates: %{public}zu", rowCount, candidates.size());
+    scheduler_.AddCandidates(std::move(candidates), currentMilliSecond);
+}
+
+void BackgroundCloudFileProcessor::ParseDownloadFiles(std::shared_ptr<NativeRdb::ResultSet> &resultSet,
+    DownloadFiles &downloadFiles, double freeRatio)
+{
+    int64_t downloadNum;
+    GetDownloadNum(downloadNum);
+    auto currentMilliSecond = MediaFileUtils::UTCTimeMilliSeconds();
+    SetLastDownloadMilliSecond(currentMilliSecond);
+
+    if (resultSet != nullptr) {
+        ReadDownloadCandidates(resultSet, currentMilliSecond);
+    }
+    downloadFiles.uris.clear();
+    if (scheduler_.IsBatchTimedOut(currentMilliSecond)) {
+        // the files of the given up batch are requeued, they must not be requested while still in flight
+        StopDownloadFiles();
+        lock_guard<mutex> downloadLock(downloadResultMutex_);
+        downloadId_ = DOWNLOAD_ID_DEFAULT;
+    }
+    // downloadNum counts the cycles since the last download, the scheduler sizes the batch from it
+    std::vector<CloudDownloadCandidate> batch = scheduler_.StartBatch(freeRatio, downloadNum, currentMilliSecond);
+    for (const auto &candidate : batch) {
+        downloadFiles.uris.push_back(candidate.uri);
+        downloadFiles.mediaType = MEDIA_TYPE_IMAGE;
+        CheckAndUpdateDownloadCnt(candidate.uri, candidate.downloadCnt);
+    }
+    bool downloadLatestFinished = batch.empty() && !scheduler_.IsBatchRunning() &&
+        scheduler_.GetPendingCount() == 0 && scheduler_.GetCursor().isExhausted;
     if (downloadLatestFinished) {
         DownloadLatestFinished();
     }
@@ -552,6 +614,11 @@ void BackgroundCloudFileProcessor::DownloadCloudFilesExecutor(AsyncTaskData *dat
         MEDIA_ERR_LOG("failed to StartFileCache, ret: %{public}d, downloadId_: %{public}s.",
             ret, to_string(downloadId_).c_str());
         downloadId_ = DOWNLOAD_ID_DEFAULT;
+        // the files are queued again for the next cycle without counting a failed attempt
+        for (const auto &uri : downloadFiles.uris) {
+            scheduler_.OnFileFinished(uri, CloudDownloadResult::START_FAILED,
+                MediaFileUtils::UTCTimeMilliSeconds());
+        }
         return;
     }
 
@@ -589,6 +656,7 @@ void BackgroundCloudFileProcessor::HandleSuccessCallback(const DownloadProgressO
     downloadResult_[progress.path] = DownloadStatus::SUCCESS;
     // 已成功下载的图片，不可再次下载
     UpdateDownloadCnt(progress.path, DOWNLOAD_FAIL_MAX_TIMES);
+    scheduler_.OnFileFinished(progress.path, CloudDownloadResult::SUCCESS, MediaFileUtils::UTCTimeMilliSeconds());
     MEDIA_INFO_LOG("download success, uri: %{public}s.", MediaFileUtils::DesensitizePath(progress.path).c_str());
 }
 
@@ -603,13 +671,16 @@ void BackgroundCloudFileProcessor::HandleFailedCallback(const DownloadProgressOb
 
     MEDIA_ERR_LOG("download failed, error type: %{public}d, uri: %{public}s.", progress.downloadErrorType,
         MediaFileUtils::DesensitizePath(progress.path).c_str());
+    CloudDownloadResult result = CloudDownloadResult::FAILED;
     switch (progress.downloadErrorType) {
         case static_cast<int32_t>(DownloadProgressObj::DownloadErrorType::NETWORK_UNAVAILABLE): {
             downloadResult_[progress.path] = DownloadStatus::NETWORK_UNAVAILABLE;
+            result = CloudDownloadResult::NETWORK_UNAVAILABLE;
             break;
         }
         case static_cast<int32_t>(DownloadProgressObj::DownloadErrorType::LOCAL_STORAGE_FULL): {
             downloadResult_[progress.path] = DownloadStatus::STORAGE_FULL;
+            result = CloudDownloadResult::STORAGE_FULL;
             break;
         }
         default: {
@@ -618,6 +689,7 @@ void BackgroundCloudFileProcessor::HandleFailedCallback(const DownloadProgressOb
             break;
         }
     }
+    scheduler_.OnFileFinished(progress.path, result, MediaFileUtils::UTCTimeMilliSeconds());
 }
 
 void BackgroundCloudFileProcessor::HandleStoppedCallback(const DownloadProgressObj& progress)
@@ -631,6 +703,7 @@ void BackgroundCloudFileProcessor::HandleStoppedCallback(const DownloadProgressO
 
     downloadResult_[progress.path] = DownloadStatus::STOPPED;
     UpdateDownloadCnt(progress.path, 0);
+    scheduler_.OnFileFinished(progress.path, CloudDownloadResult::STOPPED, MediaFileUtils::UTCTimeMilliSeconds());
     MEDIA_ERR_LOG("download stopped, uri: %{public}s.", MediaFileUtils::DesensitizePath(progress.path).c_str());
 }
 
@@ -341,7 +341,7 @@ static bool GetRealHeightAndWidthFromPath(const CheckPhotoInfo &photoInfo, int32
     data->SetFileMediaType(photoInfo.mediaType);
     data->SetPhotoSubType(photoInfo.subtype);
     data->SetMovingPhotoEffectMode(photoInfo.movingPhotoEffectMode);
-    int32_t ret = MetadataExtractor::Extract(data);
+    int32_t ret = MetadataExtractor::ExtractBasicMetadata(data);
     CHECK_AND_RETURN_RET_LOG(ret == NativeRdb::E_OK, false, "Failed to get height and width.");
     width = data->GetFileWidth();
     height = data->GetFileHeight();
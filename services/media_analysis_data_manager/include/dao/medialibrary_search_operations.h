@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "abs_shared_result_set.h"
 #include "medialibrary_command.h"
@@ -34,6 +35,8 @@ public:
     static std::shared_ptr<NativeRdb::ResultSet> QueryOperation(MediaLibraryCommand &cmd,
         const std::vector<std::string> &columns);
     static std::shared_ptr<NativeRdb::ResultSet> QueryIndexConstructProgress();
+    // per file contribution to the progress counters, all counted files if fileIds is empty
+    static std::shared_ptr<NativeRdb::ResultSet> QueryIndexProgressFileStates(const std::vector<int32_t> &fileIds);
 };
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIALIBRARY_SEARCH_INDEX_PROGRESS_COUNTER_H
+#define OHOS_MEDIALIBRARY_SEARCH_INDEX_PROGRESS_COUNTER_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "medialibrary_command.h"
+#include "values_bucket.h"
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+struct IndexProgressCounts {
+    int64_t photoCompleteNum = 0;
+    int64_t photoTotalNum = 0;
+    int64_t videoCompleteNum = 0;
+    int64_t videoTotalNum = 0;
+};
+
+/**
+ * @brief Keeps the search index construct progress as counters. Every counted file keeps its contribution, so the
+ * files changed by a search or vision status write are re-evaluated by file id and the counters adjusted. Writes
+ * whose files are unknown mark the counters dirty, and a full query reconciles them on the next read.
+ */
+class SearchIndexProgressCounter {
+public:
+    EXPORT static SearchIndexProgressCounter &GetInstance();
+
+    EXPORT int32_t GetCounts(IndexProgressCounts &counts);
+    // re-evaluates the given files after a write to the search or vision status columns
+    EXPORT void UpdateFiles(const std::vector<int32_t> &fileIds);
+    // re-evaluates the files inserted into the search or vision total table
+    EXPORT void UpdateFiles(const std::string &table, const std::vector<NativeRdb::ValuesBucket> &values);
+    // collects the files an update or delete on the search or vision total table is about to change
+    EXPORT std::vector<int32_t> QueryChangingFileIds(MediaLibraryCommand &cmd);
+    EXPORT void MarkDirty();
+    EXPORT void Reset();
+
+private:
+    SearchIndexProgressCounter() = default;
+    ~SearchIndexProgressCounter() = default;
+
+    static bool IsIndexStatusTable(const std::string &table);
+    int32_t Reconcile();
+    int32_t QueryFileStates(const std::vector<int32_t> &fileIds, std::vector<std::pair<int32_t, uint8_t>> &states);
+    void ApplyFileState(int32_t fileId, uint8_t state);
+
+    std::mutex mutex_;
+    // contribution of each file, indexed by file id
+    std::vector<uint8_t> fileStates_;
+    IndexProgressCounts counts_;
+    bool isValid_ = false;
+    bool isDirty_ = false;
+    bool isReconciling_ = false;
+    int64_t lastReconcileTime_ = 0;
+    // files changed while a reconcile is running, applied again on top of its result
+    std::vector<int32_t> pendingFileIds_;
+    // keeps the query and the apply of concurrent updates in the same order
+    std::mutex updateMutex_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIALIBRARY_SEARCH_INDEX_PROGRESS_COUNTER_H
@@ -48,6 +48,9 @@ const std::string PHOTO_COMPLETE_NUM = "finishedImageCount";
 const std::string PHOTO_TOTAL_NUM = "totalImageCount";
 const std::string VIDEO_COMPLETE_NUM = "finishedVideoCount";
 const std::string VIDEO_TOTAL_NUM = "totalVideoCount";
+// Per file columns of the index construction progress counters
+const std::string INDEX_PROGRESS_TOTAL_TYPE = "index_total_type";
+const std::string INDEX_PROGRESS_COMPLETE = "index_complete";
 
 // field status enum
 enum TblSearchPhotoStatus {
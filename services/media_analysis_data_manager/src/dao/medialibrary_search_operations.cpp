@@ -22,6 +22,7 @@
 #include "medialibrary_errno.h"
 #include "medialibrary_unistore_manager.h"
 #include "search_column.h"
+#include "search_index_progress_counter.h"
 #include "vision_total_column.h"
 
 using namespace std;
@@ -49,11 +50,18 @@ const std::string selectAnalysisCompletedVideo = "COUNT(case when " + notTrashed
     " then 1 end) as " + VIDEO_COMPLETE_NUM + ",";
 const std::string mediaVideoTotal = "COUNT(case when " + notTrashedAndHiddenCondition + MediaColumn::MEDIA_TYPE +
     " = 2 then 1 end) as " + VIDEO_TOTAL_NUM;
+const std::string indexProgressJoin = " FROM " + PhotoColumn::PHOTOS_TABLE + " Inner JOIN " + SEARCH_TOTAL_TABLE +
+    " ON " + PhotoColumn::PHOTOS_TABLE + "." + MediaColumn::MEDIA_ID + "=" + SEARCH_TOTAL_TABLE + "." +
+    TBL_SEARCH_FILE_ID + " Inner JOIN " + VISION_TOTAL_TABLE + " ON " + SEARCH_TOTAL_TABLE + "." +
+    TBL_SEARCH_FILE_ID + "=" + VISION_TOTAL_TABLE + "." + MediaColumn::MEDIA_ID;
 const std::string mediaPhotosQuery = selectAnalysisCompletedPhoto + mediaPhotoTotal + selectAnalysisCompletedVideo +
-    mediaVideoTotal + " FROM " + PhotoColumn::PHOTOS_TABLE + " Inner JOIN " + SEARCH_TOTAL_TABLE + " ON " +
-    PhotoColumn::PHOTOS_TABLE + "." + MediaColumn::MEDIA_ID + "=" + SEARCH_TOTAL_TABLE + "." + TBL_SEARCH_FILE_ID +
-    " Inner JOIN " + VISION_TOTAL_TABLE + " ON " + SEARCH_TOTAL_TABLE + "." + TBL_SEARCH_FILE_ID + "=" +
-    VISION_TOTAL_TABLE + "." + MediaColumn::MEDIA_ID;
+    mediaVideoTotal + indexProgressJoin;
+// 每个文件对进度计数的贡献：计入的类型（1 图片，2 视频，0 不计入）及是否已完成
+const std::string indexProgressFileStateQuery = "SELECT " + PhotoColumn::PHOTOS_TABLE + "." + MediaColumn::MEDIA_ID +
+    " AS " + MediaColumn::MEDIA_ID + ", CASE WHEN " + notTrashedAndHiddenCondition + MediaColumn::MEDIA_TYPE +
+    " IN (1, 2) THEN " + MediaColumn::MEDIA_TYPE + " ELSE 0 END AS " + INDEX_PROGRESS_TOTAL_TYPE + ", CASE WHEN " +
+    TBL_SEARCH_PHOTO_STATUS + " > 1 AND " + analysisCompleteCondition + " THEN 1 ELSE 0 END AS " +
+    INDEX_PROGRESS_COMPLETE + indexProgressJoin;
 
 int32_t MediaLibrarySearchOperations::InsertOperation(MediaLibraryCommand &cmd)
 {
@@ -67,6 +75,7 @@ int32_t MediaLibrarySearchOperations::InsertOperation(MediaLibraryCommand &cmd)
         MEDIA_ERR_LOG("Insert into db failed, errCode = %{public}d", errCode);
         return E_HAS_DB_ERROR;
     }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(cmd.GetTableName(), { cmd.GetValueBucket() });
     return static_cast<int32_t>(outRowId);
 }
 
@@ -76,12 +85,14 @@ int32_t MediaLibrarySearchOperations::UpdateOperation(MediaLibraryCommand &cmd)
     if (rdbStore == nullptr) {
         return E_HAS_DB_ERROR;
     }
+    std::vector<int32_t> fileIds = SearchIndexProgressCounter::GetInstance().QueryChangingFileIds(cmd);
     int32_t updateRows = -1;
     int32_t errCode = rdbStore->Update(cmd, updateRows);
     if (errCode != NativeRdb::E_OK || updateRows < 0) {
         MEDIA_ERR_LOG("Update db failed, errCode = %{public}d", errCode);
         return E_HAS_DB_ERROR;
     }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(fileIds);
     return static_cast<int32_t>(updateRows);
 }
 
@@ -91,12 +102,14 @@ int32_t MediaLibrarySearchOperations::DeleteOperation(MediaLibraryCommand &cmd)
     if (rdbStore == nullptr) {
         return E_HAS_DB_ERROR;
     }
+    std::vector<int32_t> fileIds = SearchIndexProgressCounter::GetInstance().QueryChangingFileIds(cmd);
     int32_t deleteRows = -1;
     int32_t errCode = rdbStore->Delete(cmd, deleteRows);
     if (errCode != NativeRdb::E_OK || deleteRows < 0) {
         MEDIA_ERR_LOG("Delete db failed, errCode = %{public}d", errCode);
         return E_HAS_DB_ERROR;
     }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(fileIds);
     return static_cast<int32_t>(deleteRows);
 }
 
@@ -118,7 +131,35 @@ shared_ptr<ResultSet> MediaLibrarySearchOperations::QueryIndexConstructProgress(
         return nullptr;
     }
 
-    return rdbStore->QuerySql(mediaPhotosQuery);
+    IndexProgressCounts counts;
+    if (SearchIndexProgressCounter::GetInstance().GetCounts(counts) != E_OK) {
+        MEDIA_WARN_LOG("Index progress counters unavailable, query the full progress");
+        return rdbStore->QuerySql(mediaPhotosQuery);
+    }
+    const std::string countsQuery = "SELECT ? AS " + PHOTO_COMPLETE_NUM + ", ? AS " + PHOTO_TOTAL_NUM + ", ? AS " +
+        VIDEO_COMPLETE_NUM + ", ? AS " + VIDEO_TOTAL_NUM;
+    return rdbStore->QuerySql(countsQuery, { ValueObject(counts.photoCompleteNum),
+        ValueObject(counts.photoTotalNum), ValueObject(counts.videoCompleteNum), ValueObject(counts.videoTotalNum) });
+}
+
+shared_ptr<ResultSet> MediaLibrarySearchOperations::QueryIndexProgressFileStates(const std::vector<int32_t> &fileIds)
+{
+    auto rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
+    if (rdbStore == nullptr) {
+        MEDIA_ERR_LOG("rdbStore is nullptr!");
+        return nullptr;
+    }
+    if (fileIds.empty()) {
+        return rdbStore->QuerySql(indexProgressFileStateQuery);
+    }
+    std::string placeholders;
+    std::vector<ValueObject> bindArgs;
+    for (const auto &fileId : fileIds) {
+        placeholders += placeholders.empty() ? "?" : ", ?";
+        bindArgs.emplace_back(fileId);
+    }
+    return rdbStore->QuerySql(indexProgressFileStateQuery + " WHERE " + PhotoColumn::PHOTOS_TABLE + "." +
+        MediaColumn::MEDIA_ID + " IN (" + placeholders + ")", bindArgs);
 }
 }
 }
@@ -29,6 +29,7 @@
 #include "medialibrary_rdb_transaction.h"
 #include "medialibrary_rdbstore.h"
 #include "rdb_utils.h"
+#include "search_index_progress_counter.h"
 #include "vision_aesthetics_score_column.h"
 #include "vision_column.h"
 #include "vision_total_column.h"
@@ -58,6 +59,7 @@ int32_t MediaLibraryVisionOperations::InsertOperation(MediaLibraryCommand &cmd)
         MEDIA_ERR_LOG("Insert into db failed, errCode = %{public}d", errCode);
         return E_HAS_DB_ERROR;
     }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(cmd.GetTableName(), { cmd.GetValueBucket() });
     return static_cast<int32_t>(outRowId);
 }
 
@@ -67,12 +69,14 @@ int32_t MediaLibraryVisionOperations::UpdateOperation(MediaLibraryCommand &cmd)
     if (rdbStore == nullptr) {
         return E_HAS_DB_ERROR;
     }
+    std::vector<int32_t> fileIds = SearchIndexProgressCounter::GetInstance().QueryChangingFileIds(cmd);
     int32_t updateRows = -1;
     int32_t errCode = rdbStore->Update(cmd, updateRows);
     if (errCode != NativeRdb::E_OK || updateRows < 0) {
         MEDIA_ERR_LOG("Update db failed, errCode = %{public}d", errCode);
         return E_HAS_DB_ERROR;
     }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(fileIds);
     return static_cast<int32_t>(updateRows);
 }
 
@@ -82,12 +86,14 @@ int32_t MediaLibraryVisionOperations::DeleteOperation(MediaLibraryCommand &cmd)
     if (rdbStore == nullptr) {
         return E_HAS_DB_ERROR;
     }
+    std::vector<int32_t> fileIds = SearchIndexProgressCounter::GetInstance().QueryChangingFileIds(cmd);
     int32_t deleteRows = -1;
     int32_t errCode = rdbStore->Delete(cmd, deleteRows);
     if (errCode != NativeRdb::E_OK || deleteRows < 0) {
         MEDIA_ERR_LOG("Delete db failed, errCode = %{public}d", errCode);
         return E_HAS_DB_ERROR;
     }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(fileIds);
     return static_cast<int32_t>(deleteRows);
 }
 
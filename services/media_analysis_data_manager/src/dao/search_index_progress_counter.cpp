@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "SearchIndexProgressCounter"
+
+#include "search_index_progress_counter.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <unordered_map>
+
+#include "media_column.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+#include "medialibrary_search_operations.h"
+#include "medialibrary_unistore_manager.h"
+#include "result_set_utils.h"
+#include "search_column.h"
+#include "vision_column.h"
+
+using namespace OHOS::NativeRdb;
+
+namespace OHOS {
+namespace Media {
+// a full reconcile corrects drift from writes that bypass the counters
+static constexpr int64_t RECONCILE_INTERVAL_MS = 10 * 60 * 1000;
+// minimum interval between the reconciles triggered by writes whose files are unknown
+static constexpr int64_t DIRTY_RECONCILE_INTERVAL_MS = 5 * 1000;
+// a write touching more files than this is left to the reconcile
+static constexpr size_t MAX_INCREMENTAL_FILE_NUM = 500;
+
+static constexpr uint8_t STATE_PHOTO = 0x1;
+static constexpr uint8_t STATE_VIDEO = 0x2;
+static constexpr uint8_t STATE_COMPLETE = 0x4;
+static constexpr int32_t MEDIA_TYPE_PHOTO = 1;
+static constexpr int32_t MEDIA_TYPE_VIDEO = 2;
+
+static int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void AddState(IndexProgressCounts &counts, uint8_t state, int64_t sign)
+{
+    bool isComplete = (state & STATE_COMPLETE) != 0;
+    if ((state & STATE_PHOTO) != 0) {
+        counts.photoTotalNum += sign;
+        counts.photoCompleteNum += isComplete ? sign : 0;
+    } else if ((state & STATE_VIDEO) != 0) {
+        counts.videoTotalNum += sign;
+        counts.videoCompleteNum += isComplete ? sign : 0;
+    }
+}
+
+SearchIndexProgressCounter &SearchIndexProgressCounter::GetInstance()
+{
+    static SearchIndexProgressCounter instance;
+    return instance;
+}
+
+int32_t SearchIndexProgressCounter::GetCounts(IndexProgressCounts &counts)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t elapsed = GetSteadyTimeMs() - lastReconcileTime_;
+        bool needReconcile = !isValid_ || elapsed >= RECONCILE_INTERVAL_MS ||
+            (isDirty_ && elapsed >= DIRTY_RECONCILE_INTERVAL_MS);
+        if (!needReconcile) {
+            counts = counts_;
+            return E_OK;
+        }
+    }
+    int32_t ret = Reconcile();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // a failed reconcile keeps serving the last counters
+    CHECK_AND_RETURN_RET_LOG(isValid_, ret == E_OK ? E_ERR : ret, "Index progress counters not ready");
+    counts = counts_;
+    return E_OK;
+}
+
+int32_t SearchIndexProgressCounter::Reconcile()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CHECK_AND_RETURN_RET(!isReconciling_, E_OK);
+        isReconciling_ = true;
+        isDirty_ = false;
+        pendingFileIds_.clear();
+    }
+    int64_t startTime = GetSteadyTimeMs();
+    std::vector<std::pair<int32_t, uint8_t>> states;
+    int32_t ret = QueryFileStates({}, states);
+
+    std::vector<int32_t> pendingFileIds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isReconciling_ = false;
+        if (ret != E_OK) {
+            isDirty_ = true;
+            return ret;
+        }
+        std::vector<uint8_t> fileStates;
+        IndexProgressCounts counts;
+        for (const auto &[fileId, state] : states) {
+            if (static_cast<size_t>(fileId) >= fileStates.size()) {
+                fileStates.resize(static_cast<size_t>(fileId) + 1, 0);
+            }
+            fileStates[fileId] = state;
+            AddState(counts, state, 1);
+        }
+        if (isValid_ && (counts.photoTotalNum != counts_.photoTotalNum ||
+            counts.photoCompleteNum != counts_.photoCompleteNum || counts.videoTotalNum != counts_.videoTotalNum ||
+            counts.videoCompleteNum != counts_.videoCompleteNum)) {
+            MEDIA_INFO_LOG("Reconcile index progress, photo: %{public}" PRId64 "/%{public}" PRId64 " -> %{public}"
+                PRId64 "/%{public}" PRId64 ", video: %{public}" PRId64 "/%{public}" PRId64 " -> %{public}" PRId64
+                "/%{public}" PRId64, counts_.photoCompleteNum, counts_.photoTotalNum, counts.photoCompleteNum,
+                counts.photoTotalNum, counts_.videoCompleteNum, counts_.videoTotalNum, counts.videoCompleteNum,
+                counts.videoTotalNum);
+        }
+        fileStates_.swap(fileStates);
+        counts_ = counts;
+        isValid_ = true;
+        lastReconcileTime_ = GetSteadyTimeMs();
+        pendingFileIds.swap(pendingFileIds_);
+    }
+    MEDIA_INFO_LOG("Reconcile index progress done, file num: %{public}zu, cost: %{public}" PRId64 "ms",
+        states.size(), GetSteadyTimeMs() - startTime);
+    UpdateFiles(pendingFileIds);
+    return E_OK;
+}
+
+int32_t SearchIndexProgressCounter::QueryFileStates(const std::vector<int32_t> &fileIds,
+    std::vector<std::pair<int32_t, uint8_t>> &states)
+{
+    auto resultSet = MediaLibrarySearchOperations::QueryIndexProgressFileStates(fileIds);
+    CHECK_AND_RETURN_RET_LOG(resultSet != nullptr, E_HAS_DB_ERROR, "Query index progress file states failed");
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int32_t fileId = GetInt32Val(MediaColumn::MEDIA_ID, resultSet);
+        int32_t type = GetInt32Val(INDEX_PROGRESS_TOTAL_TYPE, resultSet);
+        CHECK_AND_CONTINUE(fileId >= 0 && (type == MEDIA_TYPE_PHOTO || type == MEDIA_TYPE_VIDEO));
+        uint8_t state = type == MEDIA_TYPE_PHOTO ? STATE_PHOTO : STATE_VIDEO;
+        state |= GetInt32Val(INDEX_PROGRESS_COMPLETE, resultSet) != 0 ? STATE_COMPLETE : 0;
+        states.emplace_back(fileId, state);
+    }
+    resultSet->Close();
+    return E_OK;
+}
+
+void SearchIndexProgressCounter::ApplyFileState(int32_t fileId, uint8_t state)
+{
+    CHECK_AND_RETURN(fileId >= 0);
+    if (static_cast<size_t>(fileId) >= fileStates_.size()) {
+        CHECK_AND_RETURN(state != 0);
+        fileStates_.resize(static_cast<size_t>(fileId) + 1, 0);
+    }
+    AddState(counts_, fileStates_[fileId], -1);
+    AddState(counts_, state, 1);
+    fileStates_[fileId] = state;
+}
+
+void SearchIndexProgressCounter::UpdateFiles(const std::vector<int32_t> &fileIds)
+{
+    CHECK_AND_RETURN(!fileIds.empty());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CHECK_AND_RETURN(isValid_ || isReconciling_);
+        if (isReconciling_) {
+            pendingFileIds_.insert(pendingFileIds_.end(), fileIds.begin(), fileIds.end());
+            return;
+        }
+    }
+    if (fileIds.size() > MAX_INCREMENTAL_FILE_NUM) {
+        MarkDirty();
+        return;
+    }
+
+    std::lock_guard<std::mutex> updateLock(updateMutex_);
+    std::vector<std::pair<int32_t, uint8_t>> states;
+    if (QueryFileStates(fileIds, states) != E_OK) {
+        MarkDirty();
+        return;
+    }
+    std::unordered_map<int32_t, uint8_t> stateMap(states.begin(), states.end());
+    std::lock_guard<std::mutex> lock(mutex_);
+    // a reconcile started after the query replaces the states, apply the files again on its result
+    if (isReconciling_) {
+        pendingFileIds_.insert(pendingFileIds_.end(), fileIds.begin(), fileIds.end());
+        return;
+    }
+    for (const auto &fileId : fileIds) {
+        auto it = stateMap.find(fileId);
+        ApplyFileState(fileId, it == stateMap.end() ? 0 : it->second);
+    }
+}
+
+bool SearchIndexProgressCounter::IsIndexStatusTable(const std::string &table)
+{
+    return table == SEARCH_TOTAL_TABLE || table == VISION_TOTAL_TABLE;
+}
+
+void SearchIndexProgressCounter::UpdateFiles(const std::string &table, const std::vector<ValuesBucket> &values)
+{
+    CHECK_AND_RETURN(IsIndexStatusTable(table));
+    std::vector<int32_t> fileIds;
+    fileIds.reserve(values.size());
+    for (const auto &value : values) {
+        ValueObject valueObject;
+        int32_t fileId = -1;
+        if (!value.GetObject(MediaColumn::MEDIA_ID, valueObject) || valueObject.GetInt(fileId) != NativeRdb::E_OK) {
+            MarkDirty();
+            return;
+        }
+        fileIds.push_back(fileId);
+    }
+    UpdateFiles(fileIds);
+}
+
+std::vector<int32_t> SearchIndexProgressCounter::QueryChangingFileIds(MediaLibraryCommand &cmd)
+{
+    std::vector<int32_t> fileIds;
+    CHECK_AND_RETURN_RET(IsIndexStatusTable(cmd.GetTableName()) && cmd.GetAbsRdbPredicates() != nullptr, fileIds);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CHECK_AND_RETURN_RET(isValid_ || isReconciling_, fileIds);
+    }
+    auto rdbStore = MediaLibraryUnistoreManager::GetInstance().GetRdbStore();
+    CHECK_AND_RETURN_RET_LOG(rdbStore != nullptr, fileIds, "rdbStore is nullptr");
+    AbsRdbPredicates predicates = *cmd.GetAbsRdbPredicates();
+    predicates.Limit(static_cast<int32_t>(MAX_INCREMENTAL_FILE_NUM) + 1);
+    auto resultSet = rdbStore->QueryByStep(predicates, { MediaColumn::MEDIA_ID });
+    if (resultSet == nullptr) {
+        MEDIA_ERR_LOG("Query changing file ids failed");
+        MarkDirty();
+        return fileIds;
+    }
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        fileIds.push_back(GetInt32Val(MediaColumn::MEDIA_ID, resultSet));
+    }
+    resultSet->Close();
+    if (fileIds.size() > MAX_INCREMENTAL_FILE_NUM) {
+        MarkDirty();
+        fileIds.clear();
+    }
+    return fileIds;
+}
+
+void SearchIndexProgressCounter::MarkDirty()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isDirty_ = true;
+}
+
+void SearchIndexProgressCounter::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    fileStates_.clear();
+    counts_ = IndexProgressCounts();
+    isValid_ = false;
+    isDirty_ = false;
+    pendingFileIds_.clear();
+}
+} // namespace Media
+} // namespace OHOS
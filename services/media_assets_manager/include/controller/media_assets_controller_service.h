@@ -171,6 +171,8 @@ public:
     EXPORT int32_t GetDeepOptimizeSpace(MessageParcel &data, MessageParcel &reply);
     EXPORT int32_t BatchUpdateMetaDataModified(MessageParcel &data, MessageParcel &reply);
     EXPORT int32_t SetPhotoCritical(MessageParcel &data, MessageParcel &reply);
+    EXPORT int32_t BatchCreateAssets(MessageParcel &data, MessageParcel &reply);
+    EXPORT int32_t BatchCommitAssets(MessageParcel &data, MessageParcel &reply);
 
 public:
     virtual ~MediaAssetsControllerService() = default;
@@ -179,6 +181,9 @@ public:
         uint32_t code, MessageParcel &data, MessageParcel &reply, OHOS::Media::IPC::IPCContext &context) override;
     int32_t GetPermissionPolicy(
         uint32_t code, std::vector<std::vector<PermissionType>> &permissionPolicy, bool &isBypass) override;
+    // reads the permission policy tables, GetPermissionPolicy serves the copy cached in the dispatch table
+    static int32_t LookupPermissionPolicy(
+        uint32_t code, std::vector<std::vector<PermissionType>> &permissionPolicy, bool &isBypass);
 
 private:
     Common::MediaAssetsDeleteService mediaAssetsDeleteService_;
@@ -45,6 +45,14 @@ public:
         std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, int32_t fileId);
     int32_t ResetFileManagerPositionToCloudOnly(
         std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, int32_t fileId);
+    // Multi-row variants for the batch delete pipeline. They do not notify, the caller notifies once the
+    // transaction bound to photoRefresh has committed.
+    int32_t ClearCloudInfo(std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh,
+        const std::vector<int32_t> &fileIds);
+    int32_t ResetPositionToCloudOnly(
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, const std::vector<int32_t> &fileIds);
+    int32_t ResetFileManagerPositionToCloudOnly(
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, const std::vector<int32_t> &fileIds);
     int32_t MergeCloudInfoIntoTargetPhoto(const PhotosPo &sourcePhotoInfo, const PhotosPo &targetPhotoInfo,
         std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh);
     int32_t DeletePhotoInfo(std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, const int32_t fileId);
@@ -88,8 +96,12 @@ private:
             const PhotosPo &sourcePhotoInfo, const PhotosPo &targetPhotoInfo, NativeRdb::ValuesBucket &values);
     int32_t HandleSouthDeviceType(const PhotosPo &sourcePhotoInfo, const PhotosPo &targetPhotoInfo,
         NativeRdb::ValuesBucket &values);
+    int32_t UpdateAssetsByFileIds(std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh,
+        const NativeRdb::ValuesBucket &values, const std::vector<int32_t> &fileIds, const std::string &tag);
 
 private:
+    // keep every IN (...) list well below the sqlite host parameter limit
+    const size_t MAX_UPDATE_IDS_PER_STATEMENT = 500;
     const std::string SOURCE_PATH_PERFIX = "/storage/emulated/0";
     const std::string SQL_PHOTO_ALBUM_QUERY_BY_LPATH =
         "SELECT * FROM PhotoAlbum WHERE LOWER(lpath) = LOWER(?) LIMIT 1;";
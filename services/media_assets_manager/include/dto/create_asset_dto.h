@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "create_asset_vo.h"
 
@@ -47,5 +48,15 @@ public:
     CreateAssetDto(const CreateAssetsWithAlbumReqBody &reqBody);
     CreateAssetRespBody GetRespBody();
 };
+
+class BatchCreateAssetsDto {
+public:
+    std::vector<CreateAssetDto> assets;
+    std::vector<int32_t> fds;
+
+public:
+    BatchCreateAssetsDto(const BatchCreateAssetsReqBody &reqBody);
+    BatchCreateAssetsRespBody GetRespBody();
+};
 }  // namespace OHOS::Media
 #endif  // OHOS_MEDIA_ASSETS_MANAGER_CREATE_ASSET_DTO_H
\ No newline at end of file
@@ -94,6 +94,7 @@
 #include "file_management_utils.h"
 
 namespace OHOS::Media {
+struct TmpCompatibleDupResult;
 #define EXPORT __attribute__ ((visibility ("default")))
 class MediaAssetsService {
 public:
@@ -138,6 +139,8 @@ public:
     int32_t CreateAssetForApp(CreateAssetDto &dto);
     int32_t CreateAssetForAppWithAlbum(CreateAssetDto &dto);
     int32_t CreateAssetWithAlbum(CreateAssetDto &dto);
+    int32_t BatchCreateAssets(BatchCreateAssetsDto &dto);
+    int32_t BatchCommitAssets(const std::vector<int32_t> &fileIds);
     int32_t UpdateExistedTasksTitle(int32_t fileId);
     int32_t SetAssetTitle(int32_t fileId, const std::string &title);
     int32_t SetAssetPending(int32_t fileId, int32_t pending);
@@ -245,6 +248,7 @@ int32_t ScanMoveAssets(const std::vector<std::string> &allAssetPath,
 
  private:
     int32_t SubmitMetadataChanged(const int32_t fileId);
+    void DoCreateTmpCompatibleDup(int32_t fileId, const std::string &path, TmpCompatibleDupResult &result);
     MediaAssetsRdbOperations rdbOperation_;
     std::mutex progressMutex_;
 };
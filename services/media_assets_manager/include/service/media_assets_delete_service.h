@@ -16,6 +16,7 @@
 #ifndef OHOS_MEDIA_MEDIA_ASSETS_DELETE_SERVICE_H
 #define OHOS_MEDIA_MEDIA_ASSETS_DELETE_SERVICE_H
 
+#include <functional>
 #include <vector>
 #include <mutex>
 
@@ -31,6 +32,28 @@ struct StoreThumbnailAndEditSizeConfig {
     EditAndAttachmentUpdateType targetUpdateType = EditAndAttachmentUpdateType::EDIT_AND_ATTACHMENT_SIZE;
 };
 
+enum class TrashAssetKind : int32_t {
+    MEDIA = 0,
+    LAKE,
+    FILE_MANAGER,
+};
+
+// One LOCAL_AND_CLOUD asset handled by the batch delete pipeline.
+struct TrashAssetPlan {
+    PhotosPo photoInfo;
+    PhotosPo targetPhotoInfo;
+    TrashAssetKind kind = TrashAssetKind::MEDIA;
+    bool isTargetBuilt = false;  // targetPhotoInfo is built, its file path is allocated
+    bool isFileReady = false;    // files of the target are in place, ready to insert
+    bool isCreated = false;      // target record inserted
+};
+
+struct TrashClassifyResult {
+    std::vector<std::string> directFileUris;  // move to trash as they are
+    std::vector<PhotosPo> chainAssets;        // burst groups, handled one by one by the responsibility-chain
+    std::vector<TrashAssetPlan> plans;        // handled by the batch pipeline
+};
+
 class EXPORT MediaAssetsDeleteService {
 public: // constructors
     MediaAssetsDeleteService() = default;
@@ -130,8 +153,28 @@ private:
     int32_t ResetUniqueId(PhotosPo &photoInfo);
     int32_t ResetTransCode(PhotosPo &photoInfo);
     int32_t ResetStoragePath(PhotosPo &photoInfo);
+    int32_t ClassifyAssetsForTrash(
+        const std::vector<PhotosPo> &photosList, bool isLocalDelete, TrashClassifyResult &result);
+    TrashAssetKind GetTrashAssetKind(const PhotosPo &photoInfo);
+    void RunTrashPlanTasks(std::vector<TrashAssetPlan> &plans, const std::function<void(TrashAssetPlan &)> &task);
+    void PrepareLocalTrashPlans(std::vector<TrashAssetPlan> &plans);
+    void PrepareCloudTrashPlans(std::vector<TrashAssetPlan> &plans);
+    int32_t BatchCreateDentryFiles(const std::vector<PhotosPo> &photoInfos);
+    int32_t CreateTrashedAssetsInTransaction(std::vector<TrashAssetPlan> &plans,
+        const std::function<int32_t(std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &)> &updateSources,
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh);
+    int32_t ApplyLocalTrashPlans(
+        std::vector<TrashAssetPlan> &plans, std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh);
+    int32_t ApplyCloudTrashPlans(
+        std::vector<TrashAssetPlan> &plans, std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh);
+    void RevertLocalTrashPlans(std::vector<TrashAssetPlan> &plans);
+    void FinishLocalTrashPlans(std::vector<TrashAssetPlan> &plans, std::vector<std::string> &targetFileIds);
+    void FinishCloudTrashPlans(std::vector<TrashAssetPlan> &plans, std::vector<std::string> &targetFileIds);
+    void NotifyAssetsUpdated(const std::vector<int32_t> &fileIds);
 
 private:
+    // number of workers moving files or copying thumbnails for one batch
+    const size_t TRASH_FILE_TASK_WORKERS = 4;
     MediaAssetsDao mediaAssetsDao_;
     std::mutex deleteAssetsMutex_;
     using DeleteFuncHandle = int32_t (MediaAssetsDeleteService::*)(
@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "i_media_parcelable.h"
 
@@ -89,5 +90,34 @@ public:  // functions of Parcelable.
 };
 
 using CreateAssetsWithAlbumRespBody = CreateAssetRespBody;
+
+class BatchCreateAssetsReqBody : public IPC::IMediaParcelable {
+public:
+    std::vector<CreateAssetReqBody> assets;
+
+public:  // functions of Parcelable.
+    bool Unmarshalling(MessageParcel &parcel) override;
+    bool Marshalling(MessageParcel &parcel) const override;
+};
+
+class BatchCreateAssetsRespBody : public IPC::IMediaParcelable {
+public:
+    std::vector<CreateAssetRespBody> assets;
+    // write fds in the order of assets, closed once written to the parcel
+    std::vector<int32_t> fds;
+
+public:  // functions of Parcelable.
+    bool Unmarshalling(MessageParcel &parcel) override;
+    bool Marshalling(MessageParcel &parcel) const override;
+};
+
+class BatchCommitAssetsReqBody : public IPC::IMediaParcelable {
+public:
+    std::vector<int32_t> fileIds;
+
+public:  // functions of Parcelable.
+    bool Unmarshalling(MessageParcel &parcel) override;
+    bool Marshalling(MessageParcel &parcel) const override;
+};
 } // namespace OHOS::Media
 #endif // OHOS_MEDIA_ASSETS_MANAGER_CREATE_ASSET_VO_H
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 #define MLOG_TAG "MediaAssetsControllerService"
 
+#include <array>
+#include <chrono>
 #include <functional>
 
 #include "media_assets_controller_service.h"
@@ -130,6 +132,7 @@
 #include "query_deep_optimizable_space_vo.h"
 #include "lcd_aging_service.h"
 #include "media_empty_obj_vo.h"
+#include "dfx_ipc_statistic.h"
 
 namespace OHOS::Media {
 using namespace std;
@@ -758,25 +761,164 @@ const std::map<uint32_t, RequestHandle> HANDLERS = {
         static_cast<uint32_t>(MediaLibraryBusinessCode::SET_PHOTO_CRITICAL),
         &MediaAssetsControllerService::SetPhotoCritical
     },
+    {
+        static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_BATCH_CREATE_ASSETS),
+        &MediaAssetsControllerService::BatchCreateAssets
+    },
+    {
+        static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_BATCH_COMMIT_ASSETS),
+        &MediaAssetsControllerService::BatchCommitAssets
+    },
+};
+
+// business codes are grouped in ranges of 10000 and numbered densely from the start of each range
+static constexpr uint32_t BUSINESS_CODE_RANGE_SIZE = 10000;
+static constexpr uint32_t BUSINESS_CODE_RANGE_NUM =
+    static_cast<uint32_t>(MediaLibraryBusinessCode::CAMERA_BUSINESS_CODE_END) / BUSINESS_CODE_RANGE_SIZE + 1;
+// the binder buffer of one transaction is 1MB, a request above its limit is rejected before it is decoded
+static constexpr size_t DEFAULT_MAX_REQUEST_BYTES = 1024 * 1024;
+static constexpr size_t EMPTY_BODY_MAX_REQUEST_BYTES = 4 * 1024;
+static constexpr size_t SINGLE_ASSET_MAX_REQUEST_BYTES = 64 * 1024;
+
+const std::map<uint32_t, size_t> MAX_REQUEST_BYTES = {
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::PAUSE_DOWNLOAD_CLOUDMEDIA), EMPTY_BODY_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::CANCEL_DOWNLOAD_CLOUDMEDIA), EMPTY_BODY_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::INNER_GET_ASSET_COMPRESS_VERSION), EMPTY_BODY_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::STOP_DEEP_OPTIMIZE_SPACE), EMPTY_BODY_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::CLONE_IS_ACTIVE_LCD_AGING), EMPTY_BODY_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::ASSET_CHANGE_SET_FAVORITE), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::ASSET_CHANGE_SET_HIDDEN), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::ASSET_CHANGE_SET_LOCATION), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::ASSET_CHANGE_SET_TITLE), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::ASSET_CHANGE_SET_USER_COMMENT), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_PUBLIC_SET_TITLE), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_SET_PENDING), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_SET_FAVORITE), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::SET_EFFECT_MODE), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::SET_ORIENTATION), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::SET_CAMERA_SHOT_KEY), SINGLE_ASSET_MAX_REQUEST_BYTES},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::DISCARD_CAMERA_PHOTO), SINGLE_ASSET_MAX_REQUEST_BYTES},
+};
+
+struct RequestDispatchEntry {
+    RequestHandle handle = nullptr;
+    SpecialRequestHandle specialHandle = nullptr;
+    int32_t permissionRet = E_FAIL;
+    bool isDbBypass = false;
+    std::vector<std::vector<PermissionType>> permissionPolicy;
+    size_t maxRequestBytes = DEFAULT_MAX_REQUEST_BYTES;
+    std::shared_ptr<DfxIpcHistogram> histogram;
+};
+
+// built once from HANDLERS, SPECIAL_HANDLERS and the permission policy, so that a call costs two array indexes
+class RequestDispatchTable {
+public:
+    static const RequestDispatchTable &GetInstance()
+    {
+        static const RequestDispatchTable table;
+        return table;
+    }
+
+    const RequestDispatchEntry *Find(uint32_t code) const
+    {
+        uint32_t range = code / BUSINESS_CODE_RANGE_SIZE;
+        uint32_t offset = code % BUSINESS_CODE_RANGE_SIZE;
+        if (range >= BUSINESS_CODE_RANGE_NUM || offset >= index_[range].size() || index_[range][offset] < 0) {
+            return nullptr;
+        }
+        return &entries_[index_[range][offset]];
+    }
+
+private:
+    RequestDispatchTable()
+    {
+        entries_.reserve(HANDLERS.size() + SPECIAL_HANDLERS.size());
+        for (const auto &[code, handle] : HANDLERS) {
+            RequestDispatchEntry *entry = AddEntry(code);
+            if (entry != nullptr) {
+                entry->handle = handle;
+            }
+        }
+        for (const auto &[code, specialHandle] : SPECIAL_HANDLERS) {
+            RequestDispatchEntry *entry = AddEntry(code);
+            if (entry != nullptr) {
+                entry->specialHandle = specialHandle;
+            }
+        }
+    }
+
+    RequestDispatchEntry *AddEntry(uint32_t code)
+    {
+        uint32_t range = code / BUSINESS_CODE_RANGE_SIZE;
+        uint32_t offset = code % BUSINESS_CODE_RANGE_SIZE;
+        CHECK_AND_RETURN_RET_LOG(range < BUSINESS_CODE_RANGE_NUM, nullptr, "invalid code: %{public}u", code);
+        std::vector<int32_t> &rangeIndex = index_[range];
+        if (offset >= rangeIndex.size()) {
+            rangeIndex.resize(offset + 1, -1);
+        }
+        if (rangeIndex[offset] >= 0) {
+            return &entries_[rangeIndex[offset]];
+        }
+        RequestDispatchEntry entry;
+        entry.permissionRet = MediaAssetsControllerService::LookupPermissionPolicy(
+            code, entry.permissionPolicy, entry.isDbBypass);
+        auto maxBytesIt = MAX_REQUEST_BYTES.find(code);
+        if (maxBytesIt != MAX_REQUEST_BYTES.end()) {
+            entry.maxRequestBytes = maxBytesIt->second;
+        }
+        entry.histogram = DfxIpcStatistic::GetInstance().GetHistogram(code);
+        rangeIndex[offset] = static_cast<int32_t>(entries_.size());
+        entries_.push_back(std::move(entry));
+        return &entries_.back();
+    }
+
+    std::vector<RequestDispatchEntry> entries_;
+    std::array<std::vector<int32_t>, BUSINESS_CODE_RANGE_NUM> index_;
 };
 
 bool MediaAssetsControllerService::Accept(uint32_t code)
 {
-    return HANDLERS.find(code) != HANDLERS.end() || SPECIAL_HANDLERS.find(code) != SPECIAL_HANDLERS.end();
+    return RequestDispatchTable::GetInstance().Find(code) != nullptr;
+}
+
+int32_t MediaAssetsControllerService::GetPermissionPolicy(
+    uint32_t code, std::vector<std::vector<PermissionType>> &permissionPolicy, bool &isBypass)
+{
+    const RequestDispatchEntry *entry = RequestDispatchTable::GetInstance().Find(code);
+    if (entry == nullptr) {
+        return LookupPermissionPolicy(code, permissionPolicy, isBypass);
+    }
+    if (entry->isDbBypass) {
+        isBypass = true;
+    }
+    if (entry->permissionRet == E_SUCCESS) {
+        permissionPolicy = entry->permissionPolicy;
+    }
+    return entry->permissionRet;
 }
 
 int32_t MediaAssetsControllerService::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, OHOS::Media::IPC::IPCContext &context)
 {
-    auto handlersIt = HANDLERS.find(code);
-    if (handlersIt != HANDLERS.end()) {
-        return (this->*(handlersIt->second))(data, reply);
+    const RequestDispatchEntry *entry = RequestDispatchTable::GetInstance().Find(code);
+    if (entry == nullptr) {
+        return IPC::UserDefineIPC().WriteResponseBody(reply, E_IPC_SEVICE_NOT_FOUND);
     }
-    auto specialHandlersIt = SPECIAL_HANDLERS.find(code);
-    if (specialHandlersIt != SPECIAL_HANDLERS.end()) {
-        return (this->*(specialHandlersIt->second))(data, reply, context);
+    size_t requestBytes = data.GetReadableBytes();
+    if (requestBytes > entry->maxRequestBytes) {
+        MEDIA_ERR_LOG("request of code %{public}u is too large: %{public}zu", code, requestBytes);
+        entry->histogram->RecordReject();
+        return IPC::UserDefineIPC().WriteResponseBody(reply, E_IPC_INVAL_ARG);
     }
-    return IPC::UserDefineIPC().WriteResponseBody(reply, E_IPC_SEVICE_NOT_FOUND);
+    size_t replyStart = reply.GetDataSize();
+    auto startTime = std::chrono::steady_clock::now();
+    int32_t ret = entry->handle != nullptr ? (this->*(entry->handle))(data, reply) :
+        (this->*(entry->specialHandle))(data, reply, context);
+    int64_t costUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+    size_t replyBytes = reply.GetDataSize() > replyStart ? reply.GetDataSize() - replyStart : 0;
+    entry->histogram->Record(static_cast<uint64_t>(costUs), requestBytes + replyBytes);
+    return ret;
 }
 
 int32_t MediaAssetsControllerService::RemoveFormInfo(MessageParcel &data, MessageParcel &reply)
@@ -1660,6 +1802,52 @@ int32_t MediaAssetsControllerService::PublicCreateAsset(MessageParcel &data, Mes
     return IPC::UserDefineIPC().WriteResponseBody(reply, dto.GetRespBody(), ret);
 }
 
+int32_t MediaAssetsControllerService::BatchCreateAssets(MessageParcel &data, MessageParcel &reply)
+{
+    BatchCreateAssetsReqBody reqBody;
+    BatchCreateAssetsRespBody respBody;
+    uint32_t operationCode = static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_BATCH_CREATE_ASSETS);
+    int64_t timeout = DfxTimer::GetOperationCodeTimeout(operationCode);
+    DfxTimer dfxTimer(operationCode, timeout, true);
+    int32_t ret = IPC::UserDefineIPC().ReadRequestBody(data, reqBody);
+    if (ret != E_OK) {
+        MEDIA_ERR_LOG("BatchCreateAssets Read Request Error");
+        return IPC::UserDefineIPC().WriteResponseBody(reply, respBody, ret);
+    }
+
+    ret = ParameterUtils::CheckBatchCreateAssets(reqBody);
+    if (ret != E_OK) {
+        MEDIA_ERR_LOG("CheckBatchCreateAssets ret:%{public}d", ret);
+        return IPC::UserDefineIPC().WriteResponseBody(reply, respBody, ret);
+    }
+
+    BatchCreateAssetsDto dto(reqBody);
+    ret = MediaAssetsService::GetInstance().BatchCreateAssets(dto);
+    return IPC::UserDefineIPC().WriteResponseBody(reply, dto.GetRespBody(), ret);
+}
+
+int32_t MediaAssetsControllerService::BatchCommitAssets(MessageParcel &data, MessageParcel &reply)
+{
+    uint32_t operationCode = static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_BATCH_COMMIT_ASSETS);
+    int64_t timeout = DfxTimer::GetOperationCodeTimeout(operationCode);
+    DfxTimer dfxTimer(operationCode, timeout, true);
+    BatchCommitAssetsReqBody reqBody;
+    int32_t ret = IPC::UserDefineIPC().ReadRequestBody(data, reqBody);
+    if (ret != E_OK) {
+        MEDIA_ERR_LOG("BatchCommitAssets Read Request Error");
+        return IPC::UserDefineIPC().WriteResponseBody(reply, ret);
+    }
+
+    ret = ParameterUtils::CheckBatchCommitAssets(reqBody.fileIds);
+    if (ret != E_OK) {
+        MEDIA_ERR_LOG("CheckBatchCommitAssets ret:%{public}d", ret);
+        return IPC::UserDefineIPC().WriteResponseBody(reply, ret);
+    }
+
+    ret = MediaAssetsService::GetInstance().BatchCommitAssets(reqBody.fileIds);
+    return IPC::UserDefineIPC().WriteResponseBody(reply, ret);
+}
+
 int32_t MediaAssetsControllerService::SystemCreateAsset(MessageParcel &data, MessageParcel &reply)
 {
     uint32_t operationCode = static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_CREATE_ASSET);
@@ -236,6 +236,8 @@ static std::unordered_map<uint32_t, std::vector<std::vector<PermissionType>>> me
         {{SYSTEMINNERAPI_PERM, WRITE_PERM}}},
     {static_cast<uint32_t>(MediaLibraryBusinessCode::SET_PHOTO_CRITICAL),
         {{SYSTEMINNERAPI_PERM, WRITE_PERM}}},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_BATCH_CREATE_ASSETS), {{SYSTEMAPI_PERM, WRITE_PERM}}},
+    {static_cast<uint32_t>(MediaLibraryBusinessCode::PAH_SYSTEM_BATCH_COMMIT_ASSETS), {{SYSTEMAPI_PERM, WRITE_PERM}}},
 };
 
 static std::unordered_set<uint32_t> mediaAssetsPermissionDbBypass = {
@@ -243,7 +245,7 @@ static std::unordered_set<uint32_t> mediaAssetsPermissionDbBypass = {
     static_cast<uint32_t>(MediaLibraryBusinessCode::GET_BURST_ASSETS),
 };
 
-int32_t MediaAssetsControllerService::GetPermissionPolicy(
+int32_t MediaAssetsControllerService::LookupPermissionPolicy(
     uint32_t code, std::vector<std::vector<PermissionType>> &permissionPolicy, bool &isBypass)
 {
     if (mediaAssetsPermissionDbBypass.find(code) != mediaAssetsPermissionDbBypass.end()) {
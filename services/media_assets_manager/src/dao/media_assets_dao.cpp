@@ -130,6 +130,65 @@ int32_t MediaAssetsDao::ResetFileManagerPositionToCloudOnly(
     return E_OK;
 }
 
+int32_t MediaAssetsDao::UpdateAssetsByFileIds(std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh,
+    const NativeRdb::ValuesBucket &values, const std::vector<int32_t> &fileIds, const std::string &tag)
+{
+    CHECK_AND_RETURN_RET_LOG(photoRefresh != nullptr, E_RDB_STORE_NULL, "%{public}s Failed to get photoRefresh.",
+        tag.c_str());
+    CHECK_AND_RETURN_RET(!fileIds.empty(), E_OK);
+    int32_t totalChangedRows = 0;
+    for (size_t offset = 0; offset < fileIds.size(); offset += MAX_UPDATE_IDS_PER_STATEMENT) {
+        size_t end = std::min(fileIds.size(), offset + MAX_UPDATE_IDS_PER_STATEMENT);
+        std::vector<std::string> ids;
+        ids.reserve(end - offset);
+        for (size_t index = offset; index < end; index++) {
+            CHECK_AND_RETURN_RET_LOG(fileIds[index] > 0, E_INVALID_VALUES, "%{public}s invalid fileId: %{public}d",
+                tag.c_str(), fileIds[index]);
+            ids.emplace_back(std::to_string(fileIds[index]));
+        }
+        NativeRdb::AbsRdbPredicates predicates = NativeRdb::AbsRdbPredicates(PhotoColumn::PHOTOS_TABLE);
+        predicates.In(PhotoColumn::MEDIA_ID, ids);
+        int32_t changedRows = -1;
+        int32_t ret = photoRefresh->Update(changedRows, values, predicates);
+        CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "Failed to %{public}s, ret: %{public}d", tag.c_str(), ret);
+        totalChangedRows += changedRows;
+    }
+    MEDIA_INFO_LOG("%{public}s Update fileIds: %{public}zu, ChangedRows: %{public}d",
+        tag.c_str(), fileIds.size(), totalChangedRows);
+    return E_OK;
+}
+
+int32_t MediaAssetsDao::ClearCloudInfo(
+    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, const std::vector<int32_t> &fileIds)
+{
+    NativeRdb::ValuesBucket values;
+    values.PutNull(PhotoColumn::PHOTO_CLOUD_ID);
+    values.PutInt(PhotoColumn::PHOTO_DIRTY, static_cast<int32_t>(DirtyType::TYPE_NEW));
+    values.PutInt(PhotoColumn::PHOTO_POSITION, static_cast<int32_t>(PhotoPositionType::LOCAL));
+    values.PutInt(PhotoColumn::PHOTO_SOUTH_DEVICE_TYPE, static_cast<int32_t>(SouthDeviceType::SOUTH_DEVICE_NULL));
+    values.PutLong(PhotoColumn::PHOTO_CLOUD_VERSION, 0);
+    return this->UpdateAssetsByFileIds(photoRefresh, values, fileIds, "ClearCloudInfo");
+}
+
+int32_t MediaAssetsDao::ResetPositionToCloudOnly(
+    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, const std::vector<int32_t> &fileIds)
+{
+    NativeRdb::ValuesBucket values;
+    values.PutInt(PhotoColumn::PHOTO_POSITION, static_cast<int32_t>(PhotoPositionType::CLOUD));
+    values.PutInt(PhotoColumn::PHOTO_FILE_SOURCE_TYPE, static_cast<int32_t>(FileSourceType::MEDIA));
+    values.PutInt(PhotoColumn::LOCAL_ASSET_SIZE, 0);    // position = 2时, local_asset_size = 0
+    return this->UpdateAssetsByFileIds(photoRefresh, values, fileIds, "ResetPositionToCloudOnly");
+}
+
+int32_t MediaAssetsDao::ResetFileManagerPositionToCloudOnly(
+    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh, const std::vector<int32_t> &fileIds)
+{
+    NativeRdb::ValuesBucket values;
+    values.PutInt(PhotoColumn::PHOTO_POSITION, static_cast<int32_t>(PhotoPositionType::CLOUD));
+    values.PutInt(PhotoColumn::LOCAL_ASSET_SIZE, 0);    // position = 2时, local_asset_size = 0
+    return this->UpdateAssetsByFileIds(photoRefresh, values, fileIds, "ResetFileManagerPositionToCloudOnly");
+}
+
 int32_t MediaAssetsDao::QueryAlbumByAlbumId(const int32_t albumId, std::optional<PhotoAlbumPo> &albumInfo)
 {
     CHECK_AND_RETURN_RET_LOG(albumId > 0, E_INVALID_VALUES, "Invalid albumId, albumId: %{public}d", albumId);
@@ -62,4 +62,22 @@ CreateAssetRespBody CreateAssetDto::GetRespBody()
     respBody.outUri = this->outUri;
     return respBody;
 }
+
+BatchCreateAssetsDto::BatchCreateAssetsDto(const BatchCreateAssetsReqBody &reqBody)
+{
+    this->assets.reserve(reqBody.assets.size());
+    for (const auto &asset : reqBody.assets) {
+        this->assets.emplace_back(asset);
+    }
+}
+
+BatchCreateAssetsRespBody BatchCreateAssetsDto::GetRespBody()
+{
+    BatchCreateAssetsRespBody respBody;
+    for (auto &asset : this->assets) {
+        respBody.assets.push_back(asset.GetRespBody());
+    }
+    respBody.fds = this->fds;
+    return respBody;
+}
 }  // namespace OHOS::Media
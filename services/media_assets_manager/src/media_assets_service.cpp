@@ -28,6 +28,7 @@
 #include "media_visit_count_manager.h"
 #include "result_set_utils.h"
 #include "dfx_manager.h"
+#include "burst_persist_stage.h"
 #include "multistages_camera_capture_manager.h"
 #include "multistages_capture_dfx_request_policy.h"
 #include "multistages_capture_request_task_manager.h"
@@ -37,6 +38,8 @@
 #endif
 #include "medialibrary_photo_operations.h"
 #include "medialibrary_album_fusion_utils.h"
+#include "medialibrary_transcode_data_aging_operation.h"
+#include "tmp_compatible_dup_cache.h"
 #include "medialibrary_album_operations.h"
 #include "rdb_utils.h"
 #include "medialibrary_data_manager.h"
@@ -511,6 +514,11 @@ static bool DoCameraPipeline(const SaveCameraPhotoDto &dto, int32_t& errCode)
         return false;
     }
 
+    if (BurstPersistStage::IsBurstFrame(pipeline, dto)) {
+        // 连拍帧成组提交, 提交后再结束一阶段并清理 pipeline
+        errCode = BurstPersistStage::GetInstance().Accept(pipeline, dto);
+        return true;
+    }
     errCode = pipeline->SaveCameraPhoto(dto);
     // 尝试清理数据
     pipeline->SaveCameraPhotoFinished();
@@ -930,6 +938,43 @@ int32_t MediaAssetsService::CreateAsset(CreateAssetDto& dto)
     return E_OK;
 }
 
+int32_t MediaAssetsService::BatchCreateAssets(BatchCreateAssetsDto &dto)
+{
+    std::vector<std::unique_ptr<MediaLibraryCommand>> cmds;
+    cmds.reserve(dto.assets.size());
+    for (const auto &asset : dto.assets) {
+        NativeRdb::ValuesBucket assetInfo;
+        assetInfo.PutString(CONST_ASSET_EXTENTION, asset.extension);
+        assetInfo.PutInt(MediaColumn::MEDIA_TYPE, asset.mediaType);
+        assetInfo.PutInt(PhotoColumn::PHOTO_SUBTYPE, asset.photoSubtype);
+        if (!asset.title.empty()) {
+            assetInfo.PutString(MediaColumn::MEDIA_TITLE, asset.title);
+        }
+        auto cmd = std::make_unique<MediaLibraryCommand>(OperationObject::FILESYSTEM_PHOTO, OperationType::CREATE,
+            MediaLibraryApi::API_10);
+        cmd->SetValueBucket(assetInfo);
+        cmd->SetDeviceName(GetLocalDeviceName());
+        cmd->SetBundleName(GetClientBundleName());
+        cmds.push_back(std::move(cmd));
+    }
+
+    std::vector<BatchCreatedAsset> createdAssets;
+    int32_t ret = MediaLibraryPhotoOperations::BatchCreate(cmds, createdAssets);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "MediaLibraryPhotoOperations::BatchCreate failed");
+    dto.fds.clear();
+    for (size_t i = 0; i < createdAssets.size() && i < dto.assets.size(); i++) {
+        dto.assets[i].fileId = createdAssets[i].fileId;
+        dto.assets[i].outUri = createdAssets[i].uri;
+        dto.fds.push_back(createdAssets[i].fd);
+    }
+    return E_OK;
+}
+
+int32_t MediaAssetsService::BatchCommitAssets(const std::vector<int32_t> &fileIds)
+{
+    return MediaLibraryPhotoOperations::BatchCommit(fileIds, GetClientBundleName());
+}
+
 int32_t MediaAssetsService::CreateAssetForApp(CreateAssetDto& dto)
 {
     NativeRdb::ValuesBucket assetInfo;
@@ -1206,6 +1251,29 @@ bool MediaAssetsService::CheckMimeType(const int32_t fileId)
     return true;
 }
 
+void MediaAssetsService::DoCreateTmpCompatibleDup(int32_t fileId, const std::string &path,
+    TmpCompatibleDupResult &result)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto dfxManager = DfxManager::GetInstance();
+    CHECK_AND_RETURN_LOG(dfxManager != nullptr, "DfxManager::GetInstance() returned nullptr");
+    result.ret = MediaLibraryAlbumFusionUtils::CreateTmpCompatibleDup(fileId, path, result.size, result.dupExist,
+        result.transcodeType);
+    if (result.ret == E_OK && result.dupExist == 0) {
+        result.ret = this->rdbOperation_.UpdateTmpCompatibleDup(fileId, result.size);
+        if (result.ret == E_OK) {
+            auto endTime = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<uint16_t, std::milli> duration =
+                std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+            MEDIA_INFO_LOG("CreateTmpCompatibleDup duration:%{public}d ms", duration.count());
+            dfxManager->HandleTranscodeCostTime(duration.count(), result.transcodeType);
+        } else {
+            MEDIA_ERR_LOG("CreateTmpCompatibleDup dfx updata database failed");
+            dfxManager->HandleTranscodeFailed(INNER_FAILED, result.transcodeType);
+        }
+    }
+}
+
 int32_t MediaAssetsService::CreateTmpCompatibleDup(const CreateTmpCompatibleDupDto &createTmpCompatibleDupDto)
 {
     MEDIA_DEBUG_LOG("CreateTmpCompatibleDup: %{public}s", createTmpCompatibleDupDto.ToString().c_str());
@@ -1215,27 +1283,23 @@ int32_t MediaAssetsService::CreateTmpCompatibleDup(const CreateTmpCompatibleDupD
         "Invalid parameters for CreateTmpCompatibleDup, fileId: %{public}d, path: %{public}s",
         fileId, path.c_str());
 
-    auto startTime = std::chrono::high_resolution_clock::now();
-    size_t size = 0;
-    int32_t dupExist = 0;
-    TranscodeType transcodeType = TranscodeType::DEFAULT;
     auto dfxManager = DfxManager::GetInstance();
     CHECK_AND_RETURN_RET_LOG(dfxManager != nullptr, E_INVALID_VALUES, "DfxManager::GetInstance() returned nullptr");
-    auto err = MediaLibraryAlbumFusionUtils::CreateTmpCompatibleDup(fileId, path, size, dupExist, transcodeType);
-    if (err == E_OK && dupExist == 0) {
-        err = this->rdbOperation_.UpdateTmpCompatibleDup(fileId, size);
-        if (err == E_OK) {
-            auto endTime = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<uint16_t, std::milli> duration =
-                std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-            MEDIA_INFO_LOG("CreateTmpCompatibleDup duration:%{public}d ms", duration.count());
-            dfxManager->HandleTranscodeCostTime(duration.count(), transcodeType);
-        } else {
-            MEDIA_ERR_LOG("CreateTmpCompatibleDup dfx updata database failed");
-            dfxManager->HandleTranscodeFailed(INNER_FAILED, transcodeType);
-        }
+    MediaLibraryTranscodeDataAgingOperation::LoadTmpCompatibleDupCache();
+    auto &cache = TmpCompatibleDupCache::GetInstance();
+    // the database is updated inside the shared creation, so a coalesced request sees the duplicate recorded
+    TmpCompatibleDupResult result = cache.Create(fileId, [this, fileId, &path](TmpCompatibleDupResult &result) {
+        result.ret = E_INVALID_VALUES;
+        DoCreateTmpCompatibleDup(fileId, path, result);
+    });
+    CHECK_AND_RETURN_RET(result.ret == E_OK && result.dupExist > 0, result.ret);
+    if (result.isCoalesced) {
+        dfxManager->HandleTranscodeCacheAccess(CACHE_COALESCED, result.transcodeType);
+        return E_OK;
     }
-    return err;
+    cache.Touch(fileId);
+    dfxManager->HandleTranscodeCacheAccess(CACHE_HIT, result.transcodeType);
+    return E_OK;
 }
 
 int32_t MediaAssetsService::RevertToOriginal(const RevertToOriginalDto& revertToOriginalDto)
@@ -17,7 +17,9 @@
 
 #include "media_assets_delete_service.h"
 
+#include <atomic>
 #include <uuid/uuid.h>
+#include "ffrt_inner.h"
 #include "media_log.h"
 #include "medialibrary_type_const.h"
 #include "medialibrary_db_const.h"
@@ -30,6 +32,7 @@
 #include "lake_file_operations.h"
 #include "dfx_utils.h"
 #include "medialibrary_notify.h"
+#include "medialibrary_rdb_transaction.h"
 #include "medialibrary_photo_operations.h"
 #include "thumbnail_service.h"
 #include "medialibrary_transcode_data_aging_operation.h"
@@ -69,43 +72,38 @@ int32_t MediaAssetsDeleteService::DeleteLocalAssets(const std::vector<std::strin
 int32_t MediaAssetsDeleteService::BatchCopyAndMoveLocalAssetToTrash(
     const std::vector<PhotosPo> &photosList, std::vector<std::string> &targetFileIds)
 {
-    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> photoRefresh =
-        std::make_shared<AccurateRefresh::AssetAccurateRefresh>();
-    CHECK_AND_RETURN_RET_LOG(
-        photoRefresh != nullptr, E_RDB_STORE_NULL, "BatchCopyAndMoveLocalAssetToTrash Failed to get photoRefresh.");
-    int32_t ret = E_OK;
-    bool isValid = false;
-    std::optional<PhotosPo> targetPhotoInfoOp;
-    bool isCoverAsset = false;
-    for (const PhotosPo &photoInfo : photosList) {
-        // Only process cover asset.
-        isCoverAsset = photoInfo.burstCoverLevel.value_or(1) == 1;
-        CHECK_AND_CONTINUE_INFO_LOG(isCoverAsset,
-            "Skip member asset. fileId: %{public}d, position: %{public}d, cloudId: %{public}s, burstKey: %{public}s",
-            photoInfo.fileId.value_or(-1),
-            photoInfo.position.value_or(-1),
-            photoInfo.cloudId.value_or("").c_str(),
-            photoInfo.burstKey.value_or("").c_str());
-        // Fdirty asset should move to trash directly.
-        isValid = photoInfo.dirty.value_or(0) != static_cast<int32_t>(DirtyType::TYPE_FDIRTY);
-        CHECK_AND_EXECUTE(isValid, targetFileIds.emplace_back(photoInfo.BuildFileUri()));
-        CHECK_AND_CONTINUE_INFO_LOG(isValid,
-            "Delete directly. fileId: %{public}d, position: %{public}d, cloudId: %{public}s",
-            photoInfo.fileId.value_or(-1),
-            photoInfo.position.value_or(-1),
-            photoInfo.cloudId.value_or("").c_str());
-        targetPhotoInfoOp.reset();
-        // Only handle the LOCAL_AND_CLOUD assets.
-        ret = this->DeleteLocalAssetSingle(photoInfo, targetPhotoInfoOp, photoRefresh);
-        isValid = ret == E_OK && targetPhotoInfoOp.has_value();
-        CHECK_AND_EXECUTE(!isValid, targetFileIds.emplace_back(targetPhotoInfoOp.value().BuildFileUri()));
-        // Handle the LOCAL assets, ignore the CLOUD assets.
-        isValid = photoInfo.position.value_or(1) == static_cast<int32_t>(PhotoPositionType::LOCAL);
-        CHECK_AND_EXECUTE(!isValid, targetFileIds.emplace_back(photoInfo.BuildFileUri()));
+    TrashClassifyResult classifyResult;
+    this->ClassifyAssetsForTrash(photosList, true, classifyResult);
+    targetFileIds.insert(
+        targetFileIds.end(), classifyResult.directFileUris.begin(), classifyResult.directFileUris.end());
+    // Burst groups keep the responsibility-chain, the whole group follows its cover asset.
+    if (!classifyResult.chainAssets.empty()) {
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> photoRefresh =
+            std::make_shared<AccurateRefresh::AssetAccurateRefresh>();
+        std::optional<PhotosPo> targetPhotoInfoOp;
+        for (const PhotosPo &photoInfo : classifyResult.chainAssets) {
+            targetPhotoInfoOp.reset();
+            int32_t ret = this->DeleteLocalAssetSingle(photoInfo, targetPhotoInfoOp, photoRefresh);
+            bool isValid = ret == E_OK && targetPhotoInfoOp.has_value();
+            CHECK_AND_EXECUTE(!isValid, targetFileIds.emplace_back(targetPhotoInfoOp.value().BuildFileUri()));
+        }
+        photoRefresh->RefreshAlbumNoDateModified(static_cast<NotifyAlbumType>(
+            NotifyAlbumType::SYS_ALBUM | NotifyAlbumType::USER_ALBUM | NotifyAlbumType::SOURCE_ALBUM));
+        photoRefresh->Notify();
     }
+    CHECK_AND_RETURN_RET(!classifyResult.plans.empty(), E_OK);
+    std::vector<TrashAssetPlan> &plans = classifyResult.plans;
+    this->PrepareLocalTrashPlans(plans);
+    std::shared_ptr<TransactionOperations> trans = std::make_shared<TransactionOperations>(__func__);
+    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> photoRefresh =
+        std::make_shared<AccurateRefresh::AssetAccurateRefresh>(trans);
+    int32_t ret = this->ApplyLocalTrashPlans(plans, photoRefresh);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "ApplyLocalTrashPlans fail, ret: %{public}d, plans: %{public}zu",
+        ret, plans.size());
     photoRefresh->RefreshAlbumNoDateModified(static_cast<NotifyAlbumType>(
         NotifyAlbumType::SYS_ALBUM | NotifyAlbumType::USER_ALBUM | NotifyAlbumType::SOURCE_ALBUM));
     photoRefresh->Notify();
+    this->FinishLocalTrashPlans(plans, targetFileIds);
     return E_OK;
 }
 
@@ -271,43 +269,38 @@ int32_t MediaAssetsDeleteService::DeleteCloudAssets(const std::vector<std::strin
 int32_t MediaAssetsDeleteService::BatchCopyAndMoveCloudAssetToTrash(
     const std::vector<PhotosPo> &photosList, std::vector<std::string> &targetFileIds)
 {
-    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> photoRefresh =
-        std::make_shared<AccurateRefresh::AssetAccurateRefresh>();
-    CHECK_AND_RETURN_RET_LOG(
-        photoRefresh != nullptr, E_RDB_STORE_NULL, "BatchCopyAndMoveCloudAssetToTrash Failed to get photoRefresh.");
-    int32_t ret = E_OK;
-    bool isValid = false;
-    std::optional<PhotosPo> targetPhotoInfoOp;
-    bool isCoverAsset = false;
-    for (const PhotosPo &photoInfo : photosList) {
-        // Only process cover asset.
-        isCoverAsset = photoInfo.burstCoverLevel.value_or(1) == 1;
-        CHECK_AND_CONTINUE_INFO_LOG(isCoverAsset,
-            "Skip member asset. fileId: %{public}d, position: %{public}d, cloudId: %{public}s, burstKey: %{public}s",
-            photoInfo.fileId.value_or(-1),
-            photoInfo.position.value_or(-1),
-            photoInfo.cloudId.value_or("").c_str(),
-            photoInfo.burstKey.value_or("").c_str());
-        // Fdirty asset should move to trash directly.
-        isValid = photoInfo.dirty.value_or(0) != static_cast<int32_t>(DirtyType::TYPE_FDIRTY);
-        CHECK_AND_EXECUTE(isValid, targetFileIds.emplace_back(photoInfo.BuildFileUri()));
-        CHECK_AND_CONTINUE_INFO_LOG(isValid,
-            "Delete directly. fileId: %{public}d, position: %{public}d, cloudId: %{public}s",
-            photoInfo.fileId.value_or(-1),
-            photoInfo.position.value_or(-1),
-            photoInfo.cloudId.value_or("").c_str());
-        targetPhotoInfoOp.reset();
-        // Only handle the LOCAL_AND_CLOUD assets.
-        ret = this->DeleteCloudAssetSingle(photoInfo, targetPhotoInfoOp, photoRefresh);
-        isValid = ret == E_OK && targetPhotoInfoOp.has_value();
-        CHECK_AND_EXECUTE(!isValid, targetFileIds.emplace_back(targetPhotoInfoOp.value().BuildFileUri()));
-        // Handle the CLOUD assets, ignore the LOCAL assets.
-        isValid = photoInfo.position.value_or(1) == static_cast<int32_t>(PhotoPositionType::CLOUD);
-        CHECK_AND_EXECUTE(!isValid, targetFileIds.emplace_back(photoInfo.BuildFileUri()));
+    TrashClassifyResult classifyResult;
+    this->ClassifyAssetsForTrash(photosList, false, classifyResult);
+    targetFileIds.insert(
+        targetFileIds.end(), classifyResult.directFileUris.begin(), classifyResult.directFileUris.end());
+    // Burst groups keep the responsibility-chain, the whole group follows its cover asset.
+    if (!classifyResult.chainAssets.empty()) {
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> photoRefresh =
+            std::make_shared<AccurateRefresh::AssetAccurateRefresh>();
+        std::optional<PhotosPo> targetPhotoInfoOp;
+        for (const PhotosPo &photoInfo : classifyResult.chainAssets) {
+            targetPhotoInfoOp.reset();
+            int32_t ret = this->DeleteCloudAssetSingle(photoInfo, targetPhotoInfoOp, photoRefresh);
+            bool isValid = ret == E_OK && targetPhotoInfoOp.has_value();
+            CHECK_AND_EXECUTE(!isValid, targetFileIds.emplace_back(targetPhotoInfoOp.value().BuildFileUri()));
+        }
+        photoRefresh->RefreshAlbumNoDateModified(static_cast<NotifyAlbumType>(
+            NotifyAlbumType::SYS_ALBUM | NotifyAlbumType::USER_ALBUM | NotifyAlbumType::SOURCE_ALBUM));
+        photoRefresh->Notify();
     }
+    CHECK_AND_RETURN_RET(!classifyResult.plans.empty(), E_OK);
+    std::vector<TrashAssetPlan> &plans = classifyResult.plans;
+    this->PrepareCloudTrashPlans(plans);
+    std::shared_ptr<TransactionOperations> trans = std::make_shared<TransactionOperations>(__func__);
+    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> photoRefresh =
+        std::make_shared<AccurateRefresh::AssetAccurateRefresh>(trans);
+    int32_t ret = this->ApplyCloudTrashPlans(plans, photoRefresh);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "ApplyCloudTrashPlans fail, ret: %{public}d, plans: %{public}zu",
+        ret, plans.size());
     photoRefresh->RefreshAlbumNoDateModified(static_cast<NotifyAlbumType>(
         NotifyAlbumType::SYS_ALBUM | NotifyAlbumType::USER_ALBUM | NotifyAlbumType::SOURCE_ALBUM));
     photoRefresh->Notify();
+    this->FinishCloudTrashPlans(plans, targetFileIds);
     return E_OK;
 }
 
@@ -1108,4 +1101,322 @@ int32_t MediaAssetsDeleteService::ResetStoragePath(PhotosPo &photoInfo)
     photoInfo.storagePath.reset();
     return E_OK;
 }
+
+/**
+ * Split the assets of one delete request:
+ * 1. member assets of a burst group are skipped, they follow their cover asset;
+ * 2. file-modified assets, and assets which only keep the copy being deleted, move to trash directly;
+ * 3. LOCAL_AND_CLOUD burst covers keep the responsibility-chain;
+ * 4. other LOCAL_AND_CLOUD assets, not in trash yet, are handled by the batch pipeline.
+ */
+int32_t MediaAssetsDeleteService::ClassifyAssetsForTrash(
+    const std::vector<PhotosPo> &photosList, bool isLocalDelete, TrashClassifyResult &result)
+{
+    // Delete LOCAL keeps the CLOUD assets, delete CLOUD keeps the LOCAL assets.
+    const int32_t directPosition =
+        static_cast<int32_t>(isLocalDelete ? PhotoPositionType::LOCAL : PhotoPositionType::CLOUD);
+    bool isValid = false;
+    for (const PhotosPo &photoInfo : photosList) {
+        // Only process cover asset.
+        isValid = photoInfo.burstCoverLevel.value_or(1) == 1;
+        CHECK_AND_CONTINUE_INFO_LOG(isValid,
+            "Skip member asset. fileId: %{public}d, position: %{public}d, cloudId: %{public}s, burstKey: %{public}s",
+            photoInfo.fileId.value_or(-1),
+            photoInfo.position.value_or(-1),
+            photoInfo.cloudId.value_or("").c_str(),
+            photoInfo.burstKey.value_or("").c_str());
+        // Fdirty asset should move to trash directly.
+        isValid = photoInfo.dirty.value_or(0) != static_cast<int32_t>(DirtyType::TYPE_FDIRTY);
+        CHECK_AND_EXECUTE(isValid, result.directFileUris.emplace_back(photoInfo.BuildFileUri()));
+        CHECK_AND_CONTINUE_INFO_LOG(isValid,
+            "Delete directly. fileId: %{public}d, position: %{public}d, cloudId: %{public}s",
+            photoInfo.fileId.value_or(-1),
+            photoInfo.position.value_or(-1),
+            photoInfo.cloudId.value_or("").c_str());
+        const int32_t position = photoInfo.position.value_or(1);
+        if (position != static_cast<int32_t>(PhotoPositionType::LOCAL_AND_CLOUD)) {
+            CHECK_AND_EXECUTE(position != directPosition, result.directFileUris.emplace_back(photoInfo.BuildFileUri()));
+            continue;
+        }
+        // Same as the responsibility-chain, the trashed LOCAL_AND_CLOUD assets are left as they are.
+        CHECK_AND_CONTINUE(photoInfo.dateTrashed.value_or(0) == 0);
+        if (!photoInfo.burstKey.value_or("").empty()) {
+            result.chainAssets.emplace_back(photoInfo);
+            continue;
+        }
+        TrashAssetPlan plan;
+        plan.photoInfo = photoInfo;
+        plan.kind = this->GetTrashAssetKind(photoInfo);
+        result.plans.emplace_back(std::move(plan));
+    }
+    MEDIA_INFO_LOG("ClassifyAssetsForTrash completed, isLocalDelete: %{public}d, photosList: %{public}zu, "
+                   "direct: %{public}zu, chain: %{public}zu, plans: %{public}zu",
+        isLocalDelete,
+        photosList.size(),
+        result.directFileUris.size(),
+        result.chainAssets.size(),
+        result.plans.size());
+    return E_OK;
+}
+
+TrashAssetKind MediaAssetsDeleteService::GetTrashAssetKind(const PhotosPo &photoInfo)
+{
+    // Same order as the responsibility-chain: Media, Lake, FileManager.
+    if (photoInfo.ShouldHandleAsMediaFile()) {
+        return TrashAssetKind::MEDIA;
+    }
+    if (photoInfo.ShouldHandleAsFileManager()) {
+        return TrashAssetKind::FILE_MANAGER;
+    }
+    return TrashAssetKind::LAKE;
+}
+
+void MediaAssetsDeleteService::RunTrashPlanTasks(
+    std::vector<TrashAssetPlan> &plans, const std::function<void(TrashAssetPlan &)> &task)
+{
+    // Each plan touches its own files only, workers pick the next plan until all are done.
+    std::atomic<size_t> nextIndex {0};
+    auto worker = [&plans, &task, &nextIndex]() {
+        for (size_t index = nextIndex++; index < plans.size(); index = nextIndex++) {
+            task(plans[index]);
+        }
+    };
+    size_t workerCount = std::min(TRASH_FILE_TASK_WORKERS, plans.size());
+    for (size_t i = 1; i < workerCount; i++) {
+        ffrt::submit(worker, {}, {}, ffrt::task_attr().qos(static_cast<int32_t>(ffrt::qos_utility)));
+    }
+    worker();  // The calling thread works as well.
+    CHECK_AND_EXECUTE(workerCount <= 1, ffrt::wait());
+}
+
+void MediaAssetsDeleteService::PrepareLocalTrashPlans(std::vector<TrashAssetPlan> &plans)
+{
+    // The target path is allocated in its own transaction, build the targets one by one.
+    for (TrashAssetPlan &plan : plans) {
+        int32_t ret = this->CreateLocalTrashedPhotosPo(plan.photoInfo, plan.targetPhotoInfo);
+        plan.isTargetBuilt = ret == E_OK;
+        CHECK_AND_PRINT_LOG(plan.isTargetBuilt, "CreateLocalTrashedPhotosPo fail, ret: %{public}d, fileId: %{public}d",
+            ret, plan.photoInfo.fileId.value_or(-1));
+    }
+    this->RunTrashPlanTasks(plans, [this](TrashAssetPlan &plan) {
+        CHECK_AND_RETURN(plan.isTargetBuilt);
+        int32_t ret = E_OK;
+        if (plan.kind == TrashAssetKind::LAKE) {
+            // identify Media HO Lake asset, and move the original file from lake.
+            ret = this->MoveAssetFileOutOfLake(plan.photoInfo);
+            CHECK_AND_RETURN_LOG(ret == E_OK, "MoveAssetFileOutOfLake fail, ret: %{public}d", ret);
+        }
+        ret = this->MoveLocalAssetFile(plan.photoInfo, plan.targetPhotoInfo);
+        CHECK_AND_RETURN_LOG(ret == E_OK, "MoveLocalAssetFile fail, ret: %{public}d", ret);
+        bool isClearStoragePath = plan.kind == TrashAssetKind::FILE_MANAGER &&
+            plan.targetPhotoInfo.fileSourceType == FileSourceType::MEDIA &&
+            plan.targetPhotoInfo.storagePath.value_or("") != "";
+        CHECK_AND_EXECUTE(!isClearStoragePath, plan.targetPhotoInfo.storagePath = "");
+        plan.isFileReady = true;
+    });
+}
+
+void MediaAssetsDeleteService::PrepareCloudTrashPlans(std::vector<TrashAssetPlan> &plans)
+{
+    // The target path is allocated in its own transaction, build the targets one by one.
+    for (TrashAssetPlan &plan : plans) {
+        int32_t ret = this->CreateCloudTrashedPhotosPo(plan.photoInfo, plan.targetPhotoInfo);
+        plan.isTargetBuilt = ret == E_OK;
+        CHECK_AND_PRINT_LOG(plan.isTargetBuilt, "CreateCloudTrashedPhotosPo fail, ret: %{public}d, fileId: %{public}d",
+            ret, plan.photoInfo.fileId.value_or(-1));
+    }
+    this->RunTrashPlanTasks(plans, [this](TrashAssetPlan &plan) {
+        CHECK_AND_RETURN(plan.isTargetBuilt);
+        int32_t ret = this->CreateCloudAssetThumbnail(plan.photoInfo, plan.targetPhotoInfo);
+        CHECK_AND_RETURN_LOG(ret == E_OK, "CreateCloudAssetThumbnail fail, ret: %{public}d", ret);
+        plan.isFileReady = true;
+    });
+}
+
+int32_t MediaAssetsDeleteService::BatchCreateDentryFiles(const std::vector<PhotosPo> &photoInfos)
+{
+    CHECK_AND_RETURN_RET(!photoInfos.empty(), E_OK);
+    std::vector<FileManagement::CloudSync::DentryFileInfo> dentryInfoList;
+    dentryInfoList.reserve(photoInfos.size());
+    for (const PhotosPo &photoInfo : photoInfos) {
+        FileManagement::CloudSync::DentryFileInfo dentryInfo;
+        this->GetDentryFileInfo(photoInfo, dentryInfo);
+        dentryInfoList.emplace_back(dentryInfo);
+    }
+    std::vector<std::string> failCloudIdList;
+    int32_t ret = FileManagement::CloudSync::CloudSyncManager::GetInstance().BatchDentryFileInsert(dentryInfoList,
+                                                                                                   failCloudIdList);
+    MEDIA_INFO_LOG("BatchDentryFileInsert completed, ret: %{public}d, size: %{public}zu, failSize: %{public}zu.",
+        ret,
+        dentryInfoList.size(),
+        failCloudIdList.size());
+    return ret;
+}
+
+/**
+ * Update the source assets and insert the ready targets in one transaction.
+ * A target failed to insert is skipped as before, only a failed source update rolls back the batch.
+ */
+int32_t MediaAssetsDeleteService::CreateTrashedAssetsInTransaction(std::vector<TrashAssetPlan> &plans,
+    const std::function<int32_t(std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &)> &updateSources,
+    std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh)
+{
+    CHECK_AND_RETURN_RET_LOG(photoRefresh != nullptr, E_RDB_STORE_NULL, "Failed to get photoRefresh.");
+    std::shared_ptr<TransactionOperations> trans = photoRefresh->GetTransaction();
+    CHECK_AND_RETURN_RET_LOG(trans != nullptr, E_RDB_STORE_NULL, "Failed to get transaction.");
+    int32_t createdCount = 0;
+    std::function<int(void)> func = [&]()->int {
+        createdCount = 0;
+        int32_t ret = updateSources(photoRefresh);
+        CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "Update source assets fail, ret: %{public}d", ret);
+        for (TrashAssetPlan &plan : plans) {
+            plan.isCreated = false;
+            CHECK_AND_CONTINUE(plan.isFileReady);
+            ret = this->CreateNewAssetInfoAndReturnFileId(plan.targetPhotoInfo, photoRefresh);
+            CHECK_AND_CONTINUE_ERR_LOG(ret == E_OK, "CreateNewAssetInfoAndReturnFileId fail, "
+                "ret: %{public}d, sourceFileId: %{public}d", ret, plan.photoInfo.fileId.value_or(-1));
+            plan.isCreated = true;
+            createdCount++;
+        }
+        return E_OK;
+    };
+    int32_t ret = trans->RetryTrans(func);
+    if (ret != E_OK) {
+        std::for_each(plans.begin(), plans.end(), [](TrashAssetPlan &plan) { plan.isCreated = false; });
+    }
+    MEDIA_INFO_LOG("CreateTrashedAssetsInTransaction completed, ret: %{public}d, plans: %{public}zu, "
+                   "created: %{public}d",
+        ret,
+        plans.size(),
+        createdCount);
+    return ret;
+}
+
+int32_t MediaAssetsDeleteService::ApplyLocalTrashPlans(
+    std::vector<TrashAssetPlan> &plans, std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh)
+{
+    std::vector<PhotosPo> dentryPhotoInfos;
+    std::vector<int32_t> cloudOnlyFileIds;
+    std::vector<int32_t> fileManagerFileIds;
+    for (const TrashAssetPlan &plan : plans) {
+        const int32_t fileId = plan.photoInfo.fileId.value_or(-1);
+        if (plan.kind == TrashAssetKind::MEDIA) {
+            // The source always turns into CLOUD only with a dentry file, whether the LOCAL copy is created or not.
+            dentryPhotoInfos.emplace_back(plan.photoInfo);
+            cloudOnlyFileIds.emplace_back(fileId);
+        } else if (plan.kind == TrashAssetKind::LAKE) {
+            cloudOnlyFileIds.emplace_back(fileId);
+        } else if (plan.isTargetBuilt) {
+            // 原图更新为纯云资产，删除本地文件路径
+            fileManagerFileIds.emplace_back(fileId);
+        }
+    }
+    this->BatchCreateDentryFiles(dentryPhotoInfos);
+    auto updateSources = [this, &cloudOnlyFileIds, &fileManagerFileIds](
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &refresh) -> int32_t {
+        // Reset the storage position of the LOCAL_AND_CLOUD asset record to CLOUD asset record (cloud only).
+        int32_t ret = this->mediaAssetsDao_.ResetPositionToCloudOnly(refresh, cloudOnlyFileIds);
+        CHECK_AND_RETURN_RET(ret == E_OK, ret);
+        return this->mediaAssetsDao_.ResetFileManagerPositionToCloudOnly(refresh, fileManagerFileIds);
+    };
+    int32_t ret = this->CreateTrashedAssetsInTransaction(plans, updateSources, photoRefresh);
+    // The sources are still LOCAL_AND_CLOUD after a rollback, their files must go back to where the records point.
+    CHECK_AND_EXECUTE(ret == E_OK, this->RevertLocalTrashPlans(plans));
+    return ret;
+}
+
+void MediaAssetsDeleteService::RevertLocalTrashPlans(std::vector<TrashAssetPlan> &plans)
+{
+    this->RunTrashPlanTasks(plans, [this](TrashAssetPlan &plan) {
+        CHECK_AND_RETURN(plan.isFileReady);
+        int32_t ret = this->MoveLocalAssetFile(plan.targetPhotoInfo, plan.photoInfo);
+        CHECK_AND_RETURN_LOG(ret == E_OK, "Revert MoveLocalAssetFile fail, ret: %{public}d, fileId: %{public}d",
+            ret, plan.photoInfo.fileId.value_or(-1));
+        plan.isFileReady = false;
+        CHECK_AND_RETURN(plan.kind == TrashAssetKind::LAKE);
+        // Move the original file back into the lake, reverse of MoveAssetFileOutOfLake.
+        const std::string mediaPath = plan.photoInfo.data.value_or("");
+        ret = LakeFileOperations::MoveLakeFile(mediaPath, plan.photoInfo.storagePath.value_or(""));
+        CHECK_AND_PRINT_LOG(ret == E_OK, "Revert MoveLakeFile fail, ret: %{public}d, fileId: %{public}d",
+            ret, plan.photoInfo.fileId.value_or(-1));
+    });
+    MEDIA_INFO_LOG("RevertLocalTrashPlans completed, plans: %{public}zu", plans.size());
+}
+
+int32_t MediaAssetsDeleteService::ApplyCloudTrashPlans(
+    std::vector<TrashAssetPlan> &plans, std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &photoRefresh)
+{
+    std::vector<PhotosPo> dentryPhotoInfos;
+    std::vector<int32_t> localOnlyFileIds;
+    for (TrashAssetPlan &plan : plans) {
+        CHECK_AND_CONTINUE(plan.isFileReady);
+        localOnlyFileIds.emplace_back(plan.photoInfo.fileId.value_or(-1));
+        // In this case, Only Media file need to create dentry file. (No need for Lake file).
+        CHECK_AND_CONTINUE(plan.kind != TrashAssetKind::LAKE);
+        dentryPhotoInfos.emplace_back(plan.targetPhotoInfo);
+        // The CLOUD copy is inserted as cloud only directly, position = 2时, local_asset_size = 0
+        plan.targetPhotoInfo.localAssetSize = 0;
+    }
+    this->BatchCreateDentryFiles(dentryPhotoInfos);
+    auto updateSources = [this, &localOnlyFileIds](
+        std::shared_ptr<AccurateRefresh::AssetAccurateRefresh> &refresh) -> int32_t {
+        // Must Clean the cloud info of original asset firstly, to avoid duplicate cloud info in the database.
+        return this->mediaAssetsDao_.ClearCloudInfo(refresh, localOnlyFileIds);
+    };
+    return this->CreateTrashedAssetsInTransaction(plans, updateSources, photoRefresh);
+}
+
+void MediaAssetsDeleteService::FinishLocalTrashPlans(
+    std::vector<TrashAssetPlan> &plans, std::vector<std::string> &targetFileIds)
+{
+    this->RunTrashPlanTasks(plans, [this](TrashAssetPlan &plan) {
+        CHECK_AND_RETURN(plan.isCreated);
+        this->MoveOrGenerateLocalThumbnail(plan.photoInfo, plan.targetPhotoInfo);
+    });
+    std::vector<int32_t> updatedFileIds;
+    for (const TrashAssetPlan &plan : plans) {
+        const PhotosPo &photoInfo = plan.photoInfo;
+        bool isSourceUpdated = plan.kind != TrashAssetKind::FILE_MANAGER || plan.isTargetBuilt;
+        CHECK_AND_EXECUTE(!isSourceUpdated, updatedFileIds.emplace_back(photoInfo.fileId.value_or(0)));
+        // clean transcode info
+        bool isCleanTransCode = plan.kind == TrashAssetKind::MEDIA &&
+            photoInfo.attributes.find(PhotoColumn::PHOTO_EXIST_COMPATIBLE_DUPLICATE) != photoInfo.attributes.end();
+        CHECK_AND_EXECUTE(!isCleanTransCode, MediaLibraryTranscodeDataAgingOperation::DeleteTransCodeInfo(
+            photoInfo.data.value_or(""), to_string(photoInfo.fileId.value_or(-1)), __func__));
+        // FileManager assets report the sizes only when the LOCAL copy is created, as the chain did.
+        CHECK_AND_CONTINUE(plan.kind != TrashAssetKind::FILE_MANAGER || plan.isCreated);
+        this->StoreThumbnailAndEditSize(photoInfo, EditAndAttachmentUpdateType::EDIT_ONLY);
+        CHECK_AND_CONTINUE(plan.isCreated);
+        this->StoreThumbnailAndEditSize(plan.targetPhotoInfo);
+        targetFileIds.emplace_back(plan.targetPhotoInfo.BuildFileUri());
+    }
+    this->NotifyAssetsUpdated(updatedFileIds);
+}
+
+void MediaAssetsDeleteService::FinishCloudTrashPlans(
+    std::vector<TrashAssetPlan> &plans, std::vector<std::string> &targetFileIds)
+{
+    std::vector<int32_t> updatedFileIds;
+    for (const TrashAssetPlan &plan : plans) {
+        CHECK_AND_CONTINUE(plan.isFileReady);
+        updatedFileIds.emplace_back(plan.photoInfo.fileId.value_or(0));
+        CHECK_AND_CONTINUE(plan.isCreated);
+        CHECK_AND_EXECUTE(plan.kind == TrashAssetKind::LAKE,
+            updatedFileIds.emplace_back(plan.targetPhotoInfo.fileId.value_or(0)));
+        this->StoreThumbnailAndEditSize(plan.photoInfo);
+        this->StoreThumbnailAndEditSize(plan.targetPhotoInfo, EditAndAttachmentUpdateType::EDIT_ONLY);
+        targetFileIds.emplace_back(plan.targetPhotoInfo.BuildFileUri());
+    }
+    this->NotifyAssetsUpdated(updatedFileIds);
+}
+
+void MediaAssetsDeleteService::NotifyAssetsUpdated(const std::vector<int32_t> &fileIds)
+{
+    CHECK_AND_RETURN(!fileIds.empty());
+    auto watch = MediaLibraryNotify::GetInstance();
+    CHECK_AND_RETURN_LOG(watch != nullptr, "watch is nullptr");
+    for (int32_t fileId : fileIds) {
+        watch->Notify(PhotoColumn::PHOTO_URI_PREFIX + to_string(fileId), NotifyType::NOTIFY_UPDATE);
+    }
+}
 }  // namespace OHOS::Media::Common
\ No newline at end of file
@@ -22,11 +22,11 @@ namespace OHOS::Media {
 
 bool BatchUpdateMetaDataModifiedReqBody::Unmarshalling(MessageParcel &parcel)
 {
-    return IPC::ITypeMediaUtil::Unmarshalling<std::string>(this->fileIds, parcel);
+    return IPC::ITypeMediaUtil::UnmarshalStrVec(this->fileIds, parcel);
 }
 
 bool BatchUpdateMetaDataModifiedReqBody::Marshalling(MessageParcel &parcel) const
 {
-    return IPC::ITypeMediaUtil::Marshalling<std::string>(this->fileIds, parcel);
+    return IPC::ITypeMediaUtil::MarshalStrVec(this->fileIds, parcel);
 }
 } // namespace OHOS::Media
\ No newline at end of file
@@ -15,6 +15,9 @@
 
 #include "create_asset_vo.h"
 
+#include <unistd.h>
+
+#include "media_itypes_utils.h"
 #include "media_log.h"
 
 namespace OHOS::Media {
@@ -148,4 +151,55 @@ bool CreateAssetsWithAlbumReqBody::Marshalling(MessageParcel &parcel) const
     CHECK_AND_RETURN_RET(status, status);
     return parcel.WriteBool(this->isRealTimeThumb);
 }
+bool BatchCreateAssetsReqBody::Unmarshalling(MessageParcel &parcel)
+{
+    return IPC::ITypeMediaUtil::UnmarshallingParcelable<CreateAssetReqBody>(this->assets, parcel);
+}
+
+bool BatchCreateAssetsReqBody::Marshalling(MessageParcel &parcel) const
+{
+    return IPC::ITypeMediaUtil::MarshallingParcelable<CreateAssetReqBody>(this->assets, parcel);
+}
+
+bool BatchCreateAssetsRespBody::Unmarshalling(MessageParcel &parcel)
+{
+    bool status = IPC::ITypeMediaUtil::UnmarshallingParcelable<CreateAssetRespBody>(this->assets, parcel);
+    CHECK_AND_RETURN_RET(status, status);
+    this->fds.clear();
+    for (size_t i = 0; i < this->assets.size(); i++) {
+        int32_t fd = parcel.ReadFileDescriptor();
+        if (fd < 0) {
+            MEDIA_ERR_LOG("Unmarshalling fd is invalid, index: %{public}zu", i);
+            for (int32_t readFd : this->fds) {
+                close(readFd);
+            }
+            this->fds.clear();
+            return false;
+        }
+        this->fds.push_back(fd);
+    }
+    return true;
+}
+
+bool BatchCreateAssetsRespBody::Marshalling(MessageParcel &parcel) const
+{
+    bool status = this->assets.size() == this->fds.size() &&
+        IPC::ITypeMediaUtil::MarshallingParcelable<CreateAssetRespBody>(this->assets, parcel);
+    // the fds are owned by the reply from here on and closed even if writing fails
+    for (int32_t fd : this->fds) {
+        status = status && parcel.WriteFileDescriptor(fd);
+        close(fd);
+    }
+    return status;
+}
+
+bool BatchCommitAssetsReqBody::Unmarshalling(MessageParcel &parcel)
+{
+    return IPC::ITypeMediaUtil::Unmarshalling<int32_t>(this->fileIds, parcel);
+}
+
+bool BatchCommitAssetsReqBody::Marshalling(MessageParcel &parcel) const
+{
+    return IPC::ITypeMediaUtil::Marshalling<int32_t>(this->fileIds, parcel);
+}
 } // namespace OHOS::Media
\ No newline at end of file
@@ -34,7 +34,7 @@ bool ModifyAssetsReqBody::Unmarshalling(MessageParcel &parcel)
     CHECK_AND_RETURN_RET(status, status);
     status = parcel.ReadString(this->userComment);
     CHECK_AND_RETURN_RET(status, status);
-    return IPC::ITypeMediaUtil::Unmarshalling<int32_t>(this->fileIds, parcel);
+    return IPC::ITypeMediaUtil::UnmarshalInt32Vec(this->fileIds, parcel);
 }
 
 bool ModifyAssetsReqBody::Marshalling(MessageParcel &parcel) const
@@ -51,6 +51,6 @@ bool ModifyAssetsReqBody::Marshalling(MessageParcel &parcel) const
     CHECK_AND_RETURN_RET(status, status);
     status = parcel.WriteString(this->userComment);
     CHECK_AND_RETURN_RET(status, status);
-    return IPC::ITypeMediaUtil::Marshalling<int32_t>(this->fileIds, parcel);
+    return IPC::ITypeMediaUtil::MarshalInt32Vec(this->fileIds, parcel);
 }
 } // namespace OHOS::Media
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIA_BURST_PERSIST_STAGE_H
+#define OHOS_MEDIA_BURST_PERSIST_STAGE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#include "camera_asset_pipeline.h"
+#include "save_camera_photo_dto.h"
+#include "values_bucket.h"
+
+namespace OHOS::Media {
+/**
+ * 连拍一阶段落盘: 连拍帧的文件在调用线程落盘后即返回, 数据库更新在后台按连拍组合并。
+ * 一组连拍在每个文件系统上只刷一次盘, 刷盘完成后整组数据在同一事务内提交, 提交前连拍帧保持 is_temp, 对外不可见。
+ */
+class BurstPersistStage {
+public:
+    EXPORT static BurstPersistStage& GetInstance();
+    EXPORT static bool IsBurstFrame(const std::shared_ptr<CameraAssetPipeline> &pipeline,
+        const SaveCameraPhotoDto &dto);
+
+    // 接管连拍帧的一阶段落盘, 以及 pipeline 的一阶段结束与清理; 返回值与 SaveCameraPhoto 一致
+    EXPORT int32_t Accept(const std::shared_ptr<CameraAssetPipeline> &pipeline, const SaveCameraPhotoDto &dto);
+    // 立即提交所有等待中的连拍帧
+    EXPORT void Flush();
+    EXPORT size_t GetPendingCount();
+    // 已提交的连拍组(事务)个数
+    EXPORT uint64_t GetCommitCount();
+
+private:
+    struct BurstFrame {
+        std::shared_ptr<CameraAssetPipeline> pipeline;
+        NativeRdb::ValuesBucket values;
+        CameraAssetInfo modifyAssetInfo;
+        bool isModified{false};
+        int64_t acceptMs{0};
+    };
+
+    BurstPersistStage() {}
+    ~BurstPersistStage() {}
+    BurstPersistStage(const BurstPersistStage&) = delete;
+    BurstPersistStage& operator=(const BurstPersistStage&) = delete;
+
+    void Run();
+    bool IsGroupClosedLocked(int64_t nowMs);
+    std::vector<BurstFrame> TakeGroupLocked(size_t maxFrames);
+    void CommitGroup(std::vector<BurstFrame> &group);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable acceptCv_;
+    std::deque<BurstFrame> pending_;
+    int64_t lastAcceptMs_{0};
+    bool isRunning_{false};
+
+    // 连拍组按顺序逐组提交
+    std::mutex commitMutex_;
+    uint64_t commitCount_{0};
+};
+} // namespace OHOS::Media
+#endif // OHOS_MEDIA_BURST_PERSIST_STAGE_H
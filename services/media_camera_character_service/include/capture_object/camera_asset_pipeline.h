@@ -32,6 +32,8 @@
 #include "scan_camera_file_dto.h"
 
 namespace OHOS::Media {
+class BurstPersistStage;
+
 class EXPORT CameraAssetPipeline {
 public:
     EXPORT CameraAssetPipeline() {}
@@ -107,6 +109,11 @@ private:
     int32_t DoAccurateRefresh(const SaveCameraPhotoDto &dto, AccurateRefresh::AssetAccurateRefresh &assetRefresh,
         NativeRdb::ValuesBucket &values, NativeRdb::RdbPredicates &predicates);
 
+    // 连拍一阶段流程: 文件先落盘, 数据由 BurstPersistStage 成组提交
+    int32_t PrepareBurstSave(const SaveCameraPhotoDto &dto, NativeRdb::ValuesBucket &values,
+        CameraAssetInfo &modifyAssetInfo, bool &isModified);
+    void FinishBurstSave(bool isSaved, const CameraAssetInfo &modifyAssetInfo, bool isModified);
+
     // 二阶段落盘
     void ProcessMultistagesPhoto(const std::shared_ptr<FileAsset> &fileAsset);
     // 二阶段失败
@@ -115,6 +122,8 @@ private:
     void HandleRecoverableErrImage(const CameraAssetInfo& assetInfo);
 
 private:
+    friend class BurstPersistStage;
+
     std::mutex dbMutex_;
     // 不允许添加其他 info 数据
     CameraAssetInfo assetInfo_;
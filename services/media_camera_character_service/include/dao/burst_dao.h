@@ -19,7 +19,17 @@
 #include <string>
 #include <vector>
 
+#include "asset_accurate_refresh.h"
+#include "values_bucket.h"
+
 namespace OHOS::Media {
+struct BurstMemberValues {
+    int32_t fileId{0};
+    NativeRdb::ValuesBucket values;
+    // 输出: 该连拍帧是否已更新
+    bool isSaved{false};
+};
+
 class BurstDao {
 public:
     /**
@@ -27,6 +37,15 @@ public:
      * @param fileIds 输入的fileId列表（引用传递，会被扩展）
      */
     static void CompleteBurstFileIds(std::vector<std::string> &fileIds, std::vector<std::string> &uris);
+
+    /**
+     * @brief 在同一事务内更新一组连拍帧的一阶段落盘数据
+     * @param members 连拍帧及其更新数据, 记录不存在的帧不更新, isSaved 为 false
+     * @param assetRefresh 持有事务的刷新对象
+     * @return 事务提交成功返回 E_OK, 否则整组回滚
+     */
+    static int32_t SaveBurstMembers(std::vector<BurstMemberValues> &members,
+        AccurateRefresh::AssetAccurateRefresh &assetRefresh);
 };
 }  // namespace OHOS::Media
 #endif  // SERVICES_CAMERA_SERVICE_INCLUDE_BURST_DAO_H
\ No newline at end of file
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "BurstPersistStage"
+
+#include "burst_persist_stage.h"
+
+#include <fcntl.h>
+#include <map>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+
+#include "burst_dao.h"
+#include "media_file_utils.h"
+#include "media_log.h"
+#include "media_time_utils.h"
+#include "medialibrary_errno.h"
+#include "medialibrary_rdb_transaction.h"
+#include "medialibrary_tracer.h"
+#include "multistages_camera_capture_manager.h"
+#include "refresh_business_name.h"
+#include "unique_fd.h"
+
+namespace OHOS::Media {
+using namespace std;
+
+// 连拍帧间隔远小于该时长, 超过该时长没有新帧即认为连拍组结束
+static constexpr int64_t BURST_GROUP_QUIET_MS = 100;
+// 组内首帧最多等待的时长, 避免长时间连拍推迟缩略图
+static constexpr int64_t BURST_GROUP_MAX_DELAY_MS = 500;
+static constexpr size_t BURST_GROUP_MAX_FRAMES = 30;
+// 接管后按一行更新成功返回, 与 SaveCameraPhoto 的返回值一致
+static constexpr int32_t BURST_ACCEPTED_ROWS = 1;
+
+BurstPersistStage& BurstPersistStage::GetInstance()
+{
+    // 后台线程可能在进程退出时仍在运行, 单例不析构
+    static BurstPersistStage *instance = new BurstPersistStage();
+    return *instance;
+}
+
+bool BurstPersistStage::IsBurstFrame(const std::shared_ptr<CameraAssetPipeline> &pipeline,
+    const SaveCameraPhotoDto &dto)
+{
+    // 三方应用保存的照片需要立即取消二阶段, 不参与合并
+    CHECK_AND_RETURN_RET(pipeline != nullptr && !dto.discardHighQualityPhoto, false);
+    return pipeline->GetAssetInfo().GetSubtype() == static_cast<int32_t>(PhotoSubType::BURST);
+}
+
+int32_t BurstPersistStage::Accept(const std::shared_ptr<CameraAssetPipeline> &pipeline, const SaveCameraPhotoDto &dto)
+{
+    CHECK_AND_RETURN_RET_LOG(pipeline != nullptr, E_ERR, "pipeline is nullptr.");
+    MediaLibraryTracer tracer;
+    tracer.Start("BurstPersistStage::Accept");
+
+    BurstFrame frame;
+    frame.pipeline = pipeline;
+    int32_t ret = pipeline->PrepareBurstSave(dto, frame.values, frame.modifyAssetInfo, frame.isModified);
+    if (ret != E_OK) {
+        pipeline->SaveCameraPhotoFinished();
+        MultistagesCameraCaptureManager::GetInstance().DeletePipelineWithFileId(dto.fileId, false);
+        return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    frame.acceptMs = MediaTimeUtils::UTCTimeMilliSeconds();
+    lastAcceptMs_ = frame.acceptMs;
+    pending_.push_back(std::move(frame));
+    if (!isRunning_) {
+        isRunning_ = true;
+        std::thread([this]() { Run(); }).detach();
+    }
+    acceptCv_.notify_one();
+    MEDIA_INFO_LOG("Accept burst frame, fileId: %{public}d, pending: %{public}zu.", dto.fileId, pending_.size());
+    return BURST_ACCEPTED_ROWS;
+}
+
+void BurstPersistStage::Flush()
+{
+    std::lock_guard<std::mutex> commitLock(commitMutex_);
+    std::vector<BurstFrame> group;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        group = TakeGroupLocked(pending_.size());
+    }
+    CommitGroup(group);
+}
+
+size_t BurstPersistStage::GetPendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+uint64_t BurstPersistStage::GetCommitCount()
+{
+    std::lock_guard<std::mutex> commitLock(commitMutex_);
+    return commitCount_;
+}
+
+void BurstPersistStage::Run()
+{
+    std::string name("BurstPersist");
+    pthread_setname_np(pthread_self(), name.c_str());
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!pending_.empty() && !IsGroupClosedLocked(MediaTimeUtils::UTCTimeMilliSeconds())) {
+                acceptCv_.wait_for(lock, std::chrono::milliseconds(BURST_GROUP_QUIET_MS));
+            }
+            if (pending_.empty()) {
+                isRunning_ = false;
+                return;
+            }
+        }
+        // 取帧与提交都在 commitMutex_ 内, Flush 返回时已取走的帧必然已提交
+        std::lock_guard<std::mutex> commitLock(commitMutex_);
+        std::vector<BurstFrame> group;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            group = TakeGroupLocked(BURST_GROUP_MAX_FRAMES);
+        }
+        CommitGroup(group);
+    }
+}
+
+bool BurstPersistStage::IsGroupClosedLocked(int64_t nowMs)
+{
+    CHECK_AND_RETURN_RET(!pending_.empty(), false);
+    return pending_.size() >= BURST_GROUP_MAX_FRAMES || nowMs - lastAcceptMs_ >= BURST_GROUP_QUIET_MS ||
+        nowMs - pending_.front().acceptMs >= BURST_GROUP_MAX_DELAY_MS;
+}
+
+std::vector<BurstPersistStage::BurstFrame> BurstPersistStage::TakeGroupLocked(size_t maxFrames)
+{
+    std::vector<BurstFrame> group;
+    while (!pending_.empty() && group.size() < maxFrames) {
+        group.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+    }
+    return group;
+}
+
+// 每个文件系统只 syncfs 一次; syncfs 失败时退回到逐个文件 fdatasync, 仍失败的帧不提交
+static std::vector<bool> SyncGroupFiles(const std::vector<std::string> &paths)
+{
+    MediaLibraryTracer tracer;
+    tracer.Start("BurstPersistStage::SyncGroupFiles");
+    std::vector<bool> isDurable(paths.size(), false);
+    std::map<dev_t, bool> syncedDevices;
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::string dirPath = MediaFileUtils::GetParentPath(paths[i]);
+        UniqueFd dirFd(open(dirPath.c_str(), O_RDONLY | O_DIRECTORY));
+        struct stat statInfo {};
+        bool isValid = dirFd.Get() >= 0 && fstat(dirFd.Get(), &statInfo) == 0;
+        CHECK_AND_CONTINUE_ERR_LOG(isValid, "open burst frame dir fail, errno: %{public}d, path: %{public}s",
+            errno, MediaFileUtils::DesensitizePath(paths[i]).c_str());
+        auto iter = syncedDevices.find(statInfo.st_dev);
+        if (iter == syncedDevices.end()) {
+            bool isSynced = syncfs(dirFd.Get()) == 0;
+            CHECK_AND_PRINT_LOG(isSynced, "syncfs fail, errno: %{public}d", errno);
+            iter = syncedDevices.emplace(statInfo.st_dev, isSynced).first;
+        }
+        if (iter->second) {
+            isDurable[i] = true;
+            continue;
+        }
+        UniqueFd fd(open(paths[i].c_str(), O_RDONLY));
+        isDurable[i] = fd.Get() >= 0 && fdatasync(fd.Get()) == 0;
+        CHECK_AND_PRINT_LOG(isDurable[i], "fdatasync burst frame fail, errno: %{public}d, path: %{public}s",
+            errno, MediaFileUtils::DesensitizePath(paths[i]).c_str());
+    }
+    return isDurable;
+}
+
+void BurstPersistStage::CommitGroup(std::vector<BurstFrame> &group)
+{
+    CHECK_AND_RETURN(!group.empty());
+    MediaLibraryTracer tracer;
+    tracer.Start("BurstPersistStage::CommitGroup");
+
+    // 1.整组刷盘
+    std::vector<std::string> paths;
+    for (const auto &frame : group) {
+        paths.push_back(frame.modifyAssetInfo.GetPath());
+    }
+    std::vector<bool> isDurable = SyncGroupFiles(paths);
+    std::vector<BurstMemberValues> members;
+    std::vector<size_t> memberIndexes;
+    for (size_t i = 0; i < group.size(); i++) {
+        CHECK_AND_CONTINUE(isDurable[i]);
+        members.push_back({ group[i].modifyAssetInfo.GetFileId(), group[i].values });
+        memberIndexes.push_back(i);
+    }
+
+    // 2.整组同一事务提交, 提交期间与各帧的二阶段查询互斥
+    std::shared_ptr<TransactionOperations> trans = std::make_shared<TransactionOperations>(__func__);
+    AccurateRefresh::AssetAccurateRefresh assetRefresh(AccurateRefresh::SAVE_CAMERA_PHOTO_BUSSINESS_NAME, trans);
+    int32_t ret = E_OK;
+    {
+        std::vector<std::unique_lock<std::mutex>> dbLocks;
+        std::unordered_set<CameraAssetPipeline *> lockedPipelines;
+        for (auto &frame : group) {
+            CHECK_AND_CONTINUE(lockedPipelines.insert(frame.pipeline.get()).second);
+            dbLocks.emplace_back(frame.pipeline->dbMutex_);
+        }
+        ret = BurstDao::SaveBurstMembers(members, assetRefresh);
+    }
+    std::vector<bool> isSaved(group.size(), false);
+    size_t savedCount = 0;
+    for (size_t i = 0; i < members.size() && ret == E_OK; i++) {
+        isSaved[memberIndexes[i]] = members[i].isSaved;
+        savedCount += members[i].isSaved ? 1 : 0;
+    }
+    if (savedCount > 0) {
+        assetRefresh.RefreshAlbum(static_cast<NotifyAlbumType>(SYS_ALBUM | USER_ALBUM | SOURCE_ALBUM));
+        assetRefresh.Notify();
+    }
+    commitCount_++;
+    MEDIA_INFO_LOG("CommitGroup end, ret: %{public}d, frames: %{public}zu, saved: %{public}zu.",
+        ret, group.size(), savedCount);
+
+    // 3.逐帧结束一阶段
+    for (size_t i = 0; i < group.size(); i++) {
+        auto &pipeline = group[i].pipeline;
+        pipeline->FinishBurstSave(isSaved[i], group[i].modifyAssetInfo, group[i].isModified);
+        pipeline->SaveCameraPhotoFinished();
+        MultistagesCameraCaptureManager::GetInstance().DeletePipelineWithFileId(
+            group[i].modifyAssetInfo.GetFileId(), false);
+    }
+}
+} // namespace OHOS::Media
@@ -395,6 +395,54 @@ int32_t CameraAssetPipeline::HandleSaveCameraPhoto(const SaveCameraPhotoDto &dto
     return ret;
 }
 
+int32_t CameraAssetPipeline::PrepareBurstSave(const SaveCameraPhotoDto &dto, ValuesBucket &values,
+    CameraAssetInfo &modifyAssetInfo, bool &isModified)
+{
+    CHECK_AND_RETURN_RET_LOG(IsValid(), E_ERR, "pipeline is invalid.");
+    MediaLibraryTracer tracer;
+    tracer.Start("CameraAssetPipeline::PrepareBurstSave");
+    MultiStagesCaptureDfxCaptureTimes::GetInstance().AddCaptureTimes(CaptureMessageType::SAVE_ASSET);
+    MultiStagesCaptureDfxSaveCameraPhoto::GetInstance().AddSaveTime(assetInfo_.GetPhotoId(), AddSaveTimeStat::START);
+
+    // 1.确定水印状态 + 文件落盘, 刷盘由所在连拍组统一执行
+    RecheckEffectStatus();
+    SaveImageForStageInternal(dto);
+
+    // 2.待提交的数据, 与 UpdateIsTempAndDirty 的连拍分支一致
+    values.Put(PhotoColumn::PHOTO_IS_TEMP, false);
+    UpdateValuesForCommon(dto, values);
+    modifyAssetInfo = assetInfo_;
+    isModified = UpdateExtValuesForStageInternal(dto, values, modifyAssetInfo);
+    values.Put(PhotoColumn::PHOTO_DIRTY, static_cast<int32_t>(DirtyType::TYPE_NEW));
+    MEDIA_INFO_LOG("PrepareBurstSave end, assetInfo: %{public}s.", assetInfo_.ToString().c_str());
+    return E_OK;
+}
+
+void CameraAssetPipeline::FinishBurstSave(bool isSaved, const CameraAssetInfo &modifyAssetInfo, bool isModified)
+{
+    MediaLibraryTracer tracer;
+    tracer.Start("CameraAssetPipeline::FinishBurstSave");
+    if (!isSaved) {
+        MultiStagesCaptureDfxSaveCameraPhoto::GetInstance().RemoveTime(assetInfo_.GetPhotoId());
+        MultiStagesCaptureDfxCaptureFault::Report(assetInfo_.GetPhotoId(), assetInfo_.GetSubtype(),
+            CaptureFaultType::UPDATE_DB_TIMEOUT, "SaveBurstMembers failed");
+        MEDIA_ERR_LOG("FinishBurstSave failed, assetInfo: %{public}s.", assetInfo_.ToString().c_str());
+        return;
+    }
+    if (isModified) {
+        assetInfo_ = modifyAssetInfo;
+    }
+
+    // 与 HandleSaveCameraPhoto 的后续流程一致
+    CheckSaveImageForYuv();
+    ScanFileForStageInternal();
+
+    MultiStagesCaptureDfxCaptureTimes::GetInstance().AddCaptureTimes(CaptureMessageType::CAPTURE_IMAGE_TIMES_SUCCESS);
+    MultiStagesCaptureDfxSaveCameraPhoto::GetInstance().AddSaveTime(assetInfo_.GetPhotoId(), AddSaveTimeStat::END);
+    MultiStagesCaptureDfxSaveCameraPhoto::GetInstance().Report(assetInfo_.GetPhotoId(), false, assetInfo_.GetSubtype());
+    MEDIA_INFO_LOG("FinishBurstSave success, assetInfo: %{public}s.", assetInfo_.ToString().c_str());
+}
+
 void CameraAssetPipeline::RecheckEffectStatus()
 {
     auto effectStatus = assetInfo_.GetTakeEffectStatus();
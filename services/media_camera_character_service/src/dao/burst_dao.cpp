@@ -17,6 +17,8 @@
 
 #include "burst_dao.h"
 
+#include <algorithm>
+
 #include "media_file_uri.h"
 #include "media_file_utils.h"
 #include "media_log.h"
@@ -27,6 +29,10 @@
 #include "medialibrary_unistore_manager.h"
 #include "result_set_utils.h"
 #include "cloud_media_common.h"
+#include "medialibrary_rdb_transaction.h"
+#include "medialibrary_tracer.h"
+#include "medialibrary_type_const.h"
+#include "rdb_predicates.h"
 
 namespace OHOS::Media {
 /**
@@ -94,4 +100,39 @@ void BurstDao::CompleteBurstFileIds(std::vector<std::string> &fileIds, std::vect
     }
     resultSet->Close();
 }
-}  // namespace OHOS::Media
\ No newline at end of file
+
+int32_t BurstDao::SaveBurstMembers(std::vector<BurstMemberValues> &members,
+    AccurateRefresh::AssetAccurateRefresh &assetRefresh)
+{
+    CHECK_AND_RETURN_RET_LOG(!members.empty(), E_OK, "SaveBurstMembers members is empty");
+    MediaLibraryTracer tracer;
+    tracer.Start("BurstDao::SaveBurstMembers");
+    std::shared_ptr<TransactionOperations> trans = assetRefresh.GetTransaction();
+    CHECK_AND_RETURN_RET_LOG(trans != nullptr, E_RDB_STORE_NULL, "Failed to get transaction.");
+
+    std::function<int(void)> func = [&]()->int {
+        for (auto &member : members) {
+            member.isSaved = false;
+            NativeRdb::RdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
+            predicates.EqualTo(MediaColumn::MEDIA_ID, std::to_string(member.fileId));
+            predicates.EqualTo(PhotoColumn::PHOTO_QUALITY,
+                std::to_string(static_cast<int32_t>(MultiStagesPhotoQuality::FULL)));
+            predicates.EqualTo(PhotoColumn::PHOTO_SUBTYPE, std::to_string(static_cast<int32_t>(PhotoSubType::BURST)));
+            // 每次重试都需要使用未经扩展的数据
+            NativeRdb::ValuesBucket values = member.values;
+            int32_t updateRows = assetRefresh.UpdateWithDateTime(values, predicates);
+            CHECK_AND_RETURN_RET_LOG(updateRows >= 0, E_ERR, "update burst member fail, fileId: %{public}d",
+                member.fileId);
+            CHECK_AND_PRINT_LOG(updateRows > 0, "burst member not found, fileId: %{public}d", member.fileId);
+            member.isSaved = updateRows > 0;
+        }
+        return E_OK;
+    };
+    int32_t ret = trans->RetryTrans(func);
+    if (ret != E_OK) {
+        std::for_each(members.begin(), members.end(), [](BurstMemberValues &member) { member.isSaved = false; });
+    }
+    MEDIA_INFO_LOG("SaveBurstMembers completed, ret: %{public}d, members: %{public}zu", ret, members.size());
+    return ret;
+}
+}  // namespace OHOS::Media
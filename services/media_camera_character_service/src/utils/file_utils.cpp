@@ -77,6 +77,22 @@ int FileUtils::DeleteFileIfExist(const string &fileName)
     return DeleteFile(fileName);
 }
 
+static int32_t WriteAll(int32_t fd, const void *output, size_t writeSize)
+{
+    const uint8_t *data = static_cast<const uint8_t *>(output);
+    size_t written = 0;
+    while (written < writeSize) {
+        ssize_t ret = write(fd, data + written, writeSize - written);
+        if (ret < 0) {
+            CHECK_AND_CONTINUE(errno != EINTR);
+            return E_ERR;
+        }
+        CHECK_AND_RETURN_RET(ret != 0, E_ERR);
+        written += static_cast<size_t>(ret);
+    }
+    return E_OK;
+}
+
 int32_t FileUtils::SaveImage(const string &filePath, void *output, size_t writeSize)
 {
     const mode_t fileMode = 0644;
@@ -90,7 +106,7 @@ int32_t FileUtils::SaveImage(const string &filePath, void *output, size_t writeS
     }
     MEDIA_DEBUG_LOG("filePath: %{private}s, fd: %{public}d", filePath.c_str(), fd);
 
-    int ret = write(fd, output, writeSize);
+    int ret = WriteAll(fd, output, writeSize);
     close(fd);
     if (ret < 0) {
         MEDIA_ERR_LOG("write fail, ret: %{public}d, errno: %{public}d", ret, errno);
@@ -16,14 +16,19 @@
 #ifndef FRAMEWORKS_SERVICES_MEDIA_CLOUD_ENHANCEMENT_INCLUDE_ENHANCEMENT_THREAD_MANAGER_H
 #define FRAMEWORKS_SERVICES_MEDIA_CLOUD_ENHANCEMENT_INCLUDE_ENHANCEMENT_THREAD_MANAGER_H
 
-#include <queue>
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace OHOS {
 namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
 struct CloudEnhancementThreadTask {
     std::string taskId;
     int32_t statusCode;
@@ -38,24 +43,52 @@ struct CloudEnhancementThreadTask {
         isSuccessed(isSuccessed), videoAddr(videoAddr), videoBytes(videoBytes) {}
 };
 
+/**
+ * Saves the enhancement results on a small pool of detached workers. Results of the same photo_id run one at a
+ * time in arrival order, photos the user is looking at (manual tasks or prioritized ones) are served first.
+ * Idle workers exit after WAIT_TIME seconds, producers only start workers and never wait for one.
+ */
 class EnhancementThreadManager {
 public:
-    EnhancementThreadManager();
-    ~EnhancementThreadManager();
-    void StartConsumerThread();
-    void OnProducerCallback(CloudEnhancementThreadTask& task);
+    using TaskExecutor = std::function<void(CloudEnhancementThreadTask &)>;
+
+    EXPORT EnhancementThreadManager();
+    EXPORT ~EnhancementThreadManager();
+    EXPORT void StartConsumerThread();
+    EXPORT void OnProducerCallback(CloudEnhancementThreadTask& task);
+    // the photo is shown to the user, save its result ahead of the background ones
+    EXPORT void PrioritizeTask(const std::string &taskId);
+    // replaces the save step, used by a local stand-in of the enhancement service for load testing
+    EXPORT void SetTaskExecutor(TaskExecutor executor);
+    EXPORT size_t GetWorkerCount();
 
 private:
+    struct PhotoTasks {
+        std::deque<CloudEnhancementThreadTask> tasks;
+        bool isRunning {false};
+        bool isHighPriority {false};
+    };
+
     std::atomic<bool> stop;
-    std::atomic<bool> isThreadAlive;
     std::mutex queueMutex_;
     std::condition_variable condVar_;
-    std::mutex releaseMutex_;
     std::condition_variable releaseVar_;
-    std::queue<CloudEnhancementThreadTask> taskQueue_;
-    std::thread consumerThread_;
+    // key: photo_id, a photo is in one of the ready queues only while it has tasks and none of them is running
+    std::unordered_map<std::string, PhotoTasks> photoTasks_;
+    std::deque<std::string> highReadyIds_;
+    std::deque<std::string> lowReadyIds_;
+    std::unordered_set<std::string> prioritizedIds_;
+    size_t workerCount_ {0};
+    size_t idleWorkerCount_ {0};
+    TaskExecutor executor_;
 
+    bool TryAddWorkerLocked();
+    void PushReadyLocked(const std::string &photoId, const PhotoTasks &photoTasks);
+    void PromoteLocked(const std::string &photoId, PhotoTasks &photoTasks);
+    bool PopReadyTaskLocked(std::string &photoId, CloudEnhancementThreadTask &task, TaskExecutor &executor);
+    void FinishTaskLocked(const std::string &photoId);
     void DealWithTasks();
+    void ExecTask(CloudEnhancementThreadTask& task, const TaskExecutor &executor);
     void ExecSuccessedTask(CloudEnhancementThreadTask& task);
     void ExecFailedTask(CloudEnhancementThreadTask& task);
     void ExecExtraWork();
@@ -1101,6 +1101,8 @@ int32_t EnhancementManager::HandlePrioritizeOperation(MediaLibraryCommand &cmd)
             photoId.c_str());
         return E_ERR;
     }
+    // the user is looking at this photo, save its result ahead of the background ones
+    threadManager_->PrioritizeTask(photoId);
     CHECK_AND_RETURN_RET_LOG(LoadService(), E_ERR, "load enhancement service error");
     MediaEnhanceBundleHandle* mediaEnhanceBundle = enhancementService_->CreateBundle();
     if (mediaEnhanceBundle == nullptr) {
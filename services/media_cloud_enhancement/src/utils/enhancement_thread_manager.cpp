@@ -17,7 +17,10 @@
 
 #include "enhancement_thread_manager.h"
 
+#include <algorithm>
+
 #include "enhancement_service_callback.h"
+#include "enhancement_task_manager.h"
 #include "media_log.h"
 
 using namespace std;
@@ -25,85 +28,193 @@ using namespace std;
 namespace OHOS {
 namespace Media {
 static constexpr int32_t WAIT_TIME = 30;
-static constexpr int32_t WAIT_RELEASE = 50;
+static constexpr size_t MAX_WORKER_NUM = 4;
+// prioritize hints of photos whose result never comes back are dropped beyond this
+static constexpr size_t MAX_PRIORITIZED_NUM = 64;
 
 EnhancementThreadManager::EnhancementThreadManager()
 {
     stop = false;
-#ifdef ABILITY_CLOUD_ENHANCEMENT_SUPPORT
-    isThreadAlive = true;
-    consumerThread_ = thread(&EnhancementThreadManager::DealWithTasks, this);
-#endif
 }
 
 EnhancementThreadManager::~EnhancementThreadManager()
 {
     stop = true;
     condVar_.notify_all();
-#ifdef ABILITY_CLOUD_ENHANCEMENT_SUPPORT
-    if (consumerThread_.joinable()) {
-        consumerThread_.join();
-    }
-#endif
+    // workers are detached, wait until they drained the queue and left
+    unique_lock<mutex> lock(queueMutex_);
+    releaseVar_.wait(lock, [this]() { return workerCount_ == 0; });
 }
 
 void EnhancementThreadManager::StartConsumerThread()
 {
-    if (!isThreadAlive) {
-        isThreadAlive = true;
-#ifdef ABILITY_CLOUD_ENHANCEMENT_SUPPORT
-        if (consumerThread_.joinable()) {
-            consumerThread_.join();
-        }
-        consumerThread_ = thread(&EnhancementThreadManager::DealWithTasks, this);
-#endif
+    bool needWorker = false;
+    {
+        lock_guard<mutex> lock(queueMutex_);
+        needWorker = workerCount_ == 0 && TryAddWorkerLocked();
+    }
+    if (needWorker) {
+        thread(&EnhancementThreadManager::DealWithTasks, this).detach();
+    }
+}
+
+bool EnhancementThreadManager::TryAddWorkerLocked()
+{
+    if (stop || workerCount_ >= MAX_WORKER_NUM) {
+        return false;
+    }
+    // a new worker counts as idle until it picks a task
+    workerCount_++;
+    idleWorkerCount_++;
+    return true;
+}
+
+void EnhancementThreadManager::PushReadyLocked(const string &photoId, const PhotoTasks &photoTasks)
+{
+    if (photoTasks.isHighPriority) {
+        highReadyIds_.push_back(photoId);
+    } else {
+        lowReadyIds_.push_back(photoId);
+    }
+}
+
+void EnhancementThreadManager::PromoteLocked(const string &photoId, PhotoTasks &photoTasks)
+{
+    if (photoTasks.isHighPriority) {
+        return;
+    }
+    photoTasks.isHighPriority = true;
+    if (photoTasks.isRunning || photoTasks.tasks.empty()) {
+        return;
+    }
+    auto it = find(lowReadyIds_.begin(), lowReadyIds_.end(), photoId);
+    if (it != lowReadyIds_.end()) {
+        lowReadyIds_.erase(it);
+        highReadyIds_.push_back(photoId);
     }
 }
 
 void EnhancementThreadManager::OnProducerCallback(CloudEnhancementThreadTask& task)
 {
+    // query before taking queueMutex_, the task manager has its own lock
+    bool isManualTask = EnhancementTaskManager::QueryTaskTypeByPhotoId(task.taskId) == TYPE_MANUAL_ENHANCEMENT;
+    bool needWorker = false;
     {
         lock_guard<mutex> lock(queueMutex_);
-        taskQueue_.push(task);
-        StartConsumerThread();
+        PhotoTasks &photoTasks = photoTasks_[task.taskId];
+        bool isIdle = !photoTasks.isRunning && photoTasks.tasks.empty();
+        photoTasks.tasks.push_back(task);
+        if (isManualTask || prioritizedIds_.count(task.taskId) > 0) {
+            PromoteLocked(task.taskId, photoTasks);
+        }
+        if (isIdle) {
+            PushReadyLocked(task.taskId, photoTasks);
+        }
+        needWorker = highReadyIds_.size() + lowReadyIds_.size() > idleWorkerCount_ && TryAddWorkerLocked();
     }
     condVar_.notify_one();
+    if (needWorker) {
+        thread(&EnhancementThreadManager::DealWithTasks, this).detach();
+    }
+}
+
+void EnhancementThreadManager::PrioritizeTask(const string &taskId)
+{
+    CHECK_AND_RETURN(!taskId.empty());
+    lock_guard<mutex> lock(queueMutex_);
+    auto it = photoTasks_.find(taskId);
+    if (it != photoTasks_.end()) {
+        PromoteLocked(taskId, it->second);
+        return;
+    }
+    if (prioritizedIds_.size() >= MAX_PRIORITIZED_NUM) {
+        prioritizedIds_.clear();
+    }
+    prioritizedIds_.insert(taskId);
+}
+
+void EnhancementThreadManager::SetTaskExecutor(TaskExecutor executor)
+{
+    lock_guard<mutex> lock(queueMutex_);
+    executor_ = executor;
+}
+
+size_t EnhancementThreadManager::GetWorkerCount()
+{
+    lock_guard<mutex> lock(queueMutex_);
+    return workerCount_;
+}
+
+bool EnhancementThreadManager::PopReadyTaskLocked(string &photoId, CloudEnhancementThreadTask &task,
+    TaskExecutor &executor)
+{
+    deque<string> &readyIds = highReadyIds_.empty() ? lowReadyIds_ : highReadyIds_;
+    if (readyIds.empty()) {
+        return false;
+    }
+    photoId = readyIds.front();
+    readyIds.pop_front();
+    PhotoTasks &photoTasks = photoTasks_[photoId];
+    task = photoTasks.tasks.front();
+    photoTasks.tasks.pop_front();
+    photoTasks.isRunning = true;
+    executor = executor_;
+    return true;
+}
+
+void EnhancementThreadManager::FinishTaskLocked(const string &photoId)
+{
+    auto it = photoTasks_.find(photoId);
+    if (it == photoTasks_.end()) {
+        return;
+    }
+    it->second.isRunning = false;
+    if (!it->second.tasks.empty()) {
+        // the next result of the same photo is only ready once this one is saved
+        PushReadyLocked(photoId, it->second);
+        return;
+    }
+    photoTasks_.erase(it);
+    prioritizedIds_.erase(photoId);
 }
 
 void EnhancementThreadManager::DealWithTasks()
 {
-    MEDIA_INFO_LOG("cloud enhancement consumer thread start");
-    bool loopCondition = true;
-    while (loopCondition) {
-        bool needExtraWork = false;
+    MEDIA_INFO_LOG("cloud enhancement worker start");
+    unique_lock<mutex> lock(queueMutex_);
+    while (true) {
+        condVar_.wait_for(lock, chrono::seconds(WAIT_TIME), [this]() {
+            return !highReadyIds_.empty() || !lowReadyIds_.empty() || stop;
+        });
+        string photoId;
         CloudEnhancementThreadTask task("", 0, nullptr, 0, false, nullptr, 0);
-        {
-            unique_lock<mutex> lock(queueMutex_);
-            if (condVar_.wait_for(lock, chrono::seconds(WAIT_TIME), [this]() {
-                return !taskQueue_.empty() || stop;
-            })) {
-                if (stop && taskQueue_.empty()) {
-                    loopCondition = false;
-                    break;
-                }
-                task = taskQueue_.front();
-                taskQueue_.pop();
-
-                if (taskQueue_.empty()) {
-                    needExtraWork = true;
-                }
-            } else {
-                loopCondition = false;
-                break;
-            }
+        TaskExecutor executor;
+        // idle for WAIT_TIME seconds, or stopped with nothing left to save
+        if (!PopReadyTaskLocked(photoId, task, executor)) {
+            break;
         }
-        if (task.taskId.empty()) {
-            continue;
+        idleWorkerCount_--;
+        lock.unlock();
+        if (!task.taskId.empty()) {
+            ExecTask(task, executor);
         }
-        task.isSuccessed ? ExecSuccessedTask(task) : ExecFailedTask(task);
+        lock.lock();
+        FinishTaskLocked(photoId);
+        idleWorkerCount_++;
+    }
+    idleWorkerCount_--;
+    workerCount_--;
+    MEDIA_INFO_LOG("cloud enhancement worker exit, workers left: %{public}zu", workerCount_);
+    releaseVar_.notify_all();
+}
+
+void EnhancementThreadManager::ExecTask(CloudEnhancementThreadTask& task, const TaskExecutor &executor)
+{
+    if (executor) {
+        executor(task);
+        return;
     }
-    MEDIA_INFO_LOG("cloud enhancement thread task queue is empty for %{public}d seconds", WAIT_TIME);
-    isThreadAlive = false;
+    task.isSuccessed ? ExecSuccessedTask(task) : ExecFailedTask(task);
 }
 
 void EnhancementThreadManager::ExecSuccessedTask(CloudEnhancementThreadTask& task)
@@ -20,6 +20,7 @@
 #include <thread>
 
 #include "asset_accurate_refresh.h"
+#include "ffrt.h"
 #include "medialibrary_custom_restore_notify.h"
 #include "medialibrary_rdbstore.h"
 #include "medialibrary_rdb_transaction.h"
@@ -72,6 +73,7 @@ const std::string LOCAL_ROOT_MEDIA_DIR = "/storage/media/local/files/";
 const std::string CUSTOM_RESTORE_DIR = LOCAL_ROOT_MEDIA_DIR + CUSTOM_RESTORE_VALUES;
 const int MAX_RESTORE_FILE_NUM = 200;
 const int MAX_RESTORE_THREAD_NUM = 2;
+const int MAX_RESTORE_INFLIGHT_BATCH_NUM = MAX_RESTORE_THREAD_NUM * 2;
 const int RESTORE_URI_TYPE_PHOTO = 1;
 const int RESTORE_URI_TYPE_EMPTY = 2;
 const int RESTORE_URI_TYPE_ALBUM = 3;
@@ -110,6 +112,10 @@ private:
         const vector<string> &files, int32_t index, int32_t &firstRestoreIndex);
     void HandleBatchCustomRestore(const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo,
         int32_t notifyType, const vector<string> &subFiles);
+    void SubmitBatchCustomRestore(const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo,
+        int32_t notifyType, vector<string> &&subFiles);
+    void WaitBatchSlot(int32_t maxInFlightNum);
+    void ReleaseBatchSlot();
     int32_t HandleTlvRestore(const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo,
         const vector<string> &filePathVector, bool isFirst, UniqueNumber &uniqueNumber);
     void RestoreTlvRollback(const std::string &assetPath);
@@ -141,6 +147,12 @@ private:
     int32_t HandleTlvSingleRestore(const std::unordered_map<TlvTag, std::string> &editFileMap,
         const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo, bool isFirst,
         UniqueNumber &uniqueNumber);
+    int32_t HandleTlvSingleRestore(const std::unordered_map<TlvTag, std::string> &editFileMap,
+        const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo, bool isFirst,
+        UniqueNumber &uniqueNumber, AccurateRefresh::AssetAccurateRefresh &assetRefresh,
+        vector<RestoreFileInfo> &restoredFiles);
+    void NotifyTlvRestoreFiles(AccurateRefresh::AssetAccurateRefresh &assetRefresh,
+        const vector<RestoreFileInfo> &restoredFiles);
     static int32_t UpdateTlvEditDataSize(const std::string &assetPath);
 
     static std::string GetUniqueTempDir(const std::string &tlvPath);
@@ -179,6 +191,9 @@ private:
     std::atomic<int32_t> failNum_{0};
     std::atomic<int32_t> sameNum_{0};
     std::unordered_set<std::string> photoCache_;
+    ffrt::mutex batchMutex_;
+    ffrt::condition_variable batchCv_;
+    int32_t inFlightBatchNum_ = 0;
 
     //AsyncWorker thread members
     std::mutex queueMutex_;
@@ -369,6 +369,7 @@ void PhotoCustomRestoreOperation::DoCustomRestore(RestoreTaskInfo &restoreTaskIn
     int32_t total = static_cast<int32_t>(files.size());
     MEDIA_INFO_LOG("DoCustomRestore files count: %{public}d", total);
     int32_t lastIndex = total - 1;
+    vector<string> batchFiles;
     for (int32_t index = 0; index < total; index++) {
         if (IsCancelTask(restoreTaskInfo)) {
             break;
@@ -381,26 +382,12 @@ void PhotoCustomRestoreOperation::DoCustomRestore(RestoreTaskInfo &restoreTaskIn
             }
             continue;
         }
-        // Remainder and multiple of MAX_RESTORE_FILE_NUM
-        int32_t remainder = (index + 1) % MAX_RESTORE_FILE_NUM;
-        int32_t multiples = (index + 1) / MAX_RESTORE_FILE_NUM;
-        if (remainder == 0 || index == lastIndex) {
-            int32_t fileNum = remainder == 0 && multiples > 0 ? MAX_RESTORE_FILE_NUM : remainder;
-            int32_t beginOffset = index - fileNum + 1;
-            if (beginOffset <= firstRestoreIndex) {
-                // not contain first restore file
-                beginOffset = firstRestoreIndex + 1;
-                fileNum = index - beginOffset + 1;
-            }
+        // batches end on multiples of MAX_RESTORE_FILE_NUM and never contain the first restore file
+        batchFiles.push_back(files[index]);
+        if ((index + 1) % MAX_RESTORE_FILE_NUM == 0 || index == lastIndex) {
             int32_t notifyType = index == lastIndex ? NOTIFY_LAST : NOTIFY_PROGRESS;
-            vector<string> subFiles(files.begin() + beginOffset, files.begin() + index + 1);
-            ffrt::submit(
-                [this, &timeInfoMap, &restoreTaskInfo, notifyType, subFiles = std::move(subFiles)]() {
-                    HandleBatchCustomRestore(timeInfoMap, restoreTaskInfo, notifyType, std::move(subFiles));
-                },
-                {},
-                {},
-                ffrt::task_attr().qos(static_cast<int32_t>(ffrt::qos_utility)));
+            SubmitBatchCustomRestore(timeInfoMap, restoreTaskInfo, notifyType, std::move(batchFiles));
+            batchFiles = vector<string>();
         }
     }
     ffrt::wait();
@@ -409,6 +396,36 @@ void PhotoCustomRestoreOperation::DoCustomRestore(RestoreTaskInfo &restoreTaskIn
     ReleaseCustomRestoreTask(restoreTaskInfo);
 }
 
+void PhotoCustomRestoreOperation::WaitBatchSlot(int32_t maxInFlightNum)
+{
+    std::unique_lock<ffrt::mutex> lock(batchMutex_);
+    batchCv_.wait(lock, [this, maxInFlightNum]() { return inFlightBatchNum_ < maxInFlightNum; });
+    inFlightBatchNum_++;
+}
+
+void PhotoCustomRestoreOperation::ReleaseBatchSlot()
+{
+    std::lock_guard<ffrt::mutex> lock(batchMutex_);
+    inFlightBatchNum_--;
+    batchCv_.notify_all();
+}
+
+void PhotoCustomRestoreOperation::SubmitBatchCustomRestore(const unordered_map<string, TimeInfo> &timeInfoMap,
+    RestoreTaskInfo &restoreTaskInfo, int32_t notifyType, vector<string> &&subFiles)
+{
+    // the listing is only walked as fast as the batches are restored, the last batch waits for all the others so
+    // that its NOTIFY_LAST carries the final counts
+    WaitBatchSlot(notifyType == NOTIFY_LAST ? 1 : MAX_RESTORE_INFLIGHT_BATCH_NUM);
+    ffrt::submit(
+        [this, &timeInfoMap, &restoreTaskInfo, notifyType, subFiles = std::move(subFiles)]() {
+            HandleBatchCustomRestore(timeInfoMap, restoreTaskInfo, notifyType, subFiles);
+            ReleaseBatchSlot();
+        },
+        {},
+        {},
+        ffrt::task_attr().qos(static_cast<int32_t>(ffrt::qos_utility)));
+}
+
 void PhotoCustomRestoreOperation::PhotoCustomRestoreOperation::ReleaseCustomRestoreTask(
     RestoreTaskInfo &restoreTaskInfo)
 {
@@ -657,6 +674,9 @@ int32_t PhotoCustomRestoreOperation::HandleTlvRestore(const unordered_map<string
     std::unordered_map<TlvTag, std::string> decodeTlvPathMap;
     vector<string> fallbackFiles;
     UniqueNumber tempUniqueNumber;
+    // album refresh, notify and shooting mode albums are handled once for the whole batch
+    AccurateRefresh::AssetAccurateRefresh assetRefresh(AccurateRefresh::CUSTOM_RESTORE_BUSSINESS_NAME);
+    vector<RestoreFileInfo> restoredFiles;
     for (const auto &tlvPath : filePathVector) {
         CHECK_AND_CONTINUE_ERR_LOG(MediaFileUtils::IsFileExists(tlvPath), "tlvPath is not exist: %{public}s",
             DfxUtils::GetSafePath(tlvPath).c_str());
@@ -675,13 +695,18 @@ int32_t PhotoCustomRestoreOperation::HandleTlvRestore(const unordered_map<string
         CHECK_AND_PRINT_LOG(MediaFileUtils::DeleteFile(tlvPath), "delete tlv file failed, path: %{public}s",
             DfxUtils::GetSafePath(tlvPath).c_str());
         tempUniqueNumber.clear();
-        ret = HandleTlvSingleRestore(decodeTlvPathMap, timeInfoMap, restoreTaskInfo, isFirst, tempUniqueNumber);
+        // the first file also updates the target album, keep it on the standalone path
+        ret = isFirst ?
+            HandleTlvSingleRestore(decodeTlvPathMap, timeInfoMap, restoreTaskInfo, isFirst, tempUniqueNumber) :
+            HandleTlvSingleRestore(decodeTlvPathMap, timeInfoMap, restoreTaskInfo, isFirst, tempUniqueNumber,
+            assetRefresh, restoredFiles);
         uniqueNumber = uniqueNumber + tempUniqueNumber;
         CHECK_AND_PRINT_LOG(DeleteDirectoryIfExists(decodeTlvDir), "delete decode tlv dir failed.");
         CHECK_AND_PRINT_LOG(ret == E_FILE_EXIST || ret == E_OK, "HandleTlvSingleRestore failed, ret: %{public}d", ret);
         CHECK_AND_EXECUTE(ret != E_FILE_EXIST, sameFileNum++);
         CHECK_AND_EXECUTE(ret != E_OK, totalSuccess++);
     }
+    NotifyTlvRestoreFiles(assetRefresh, restoredFiles);
     int32_t totalFileNum = static_cast<int32_t>(filePathVector.size());
     successNum_.fetch_add(totalSuccess);
     failNum_.fetch_add(totalFileNum - totalSuccess - sameFileNum);
@@ -743,6 +768,24 @@ int32_t PhotoCustomRestoreOperation::UpdateTlvEditDataSize(const std::string &as
 int32_t PhotoCustomRestoreOperation::HandleTlvSingleRestore(const std::unordered_map<TlvTag, std::string> &editFileMap,
     const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo, bool isFirst,
     UniqueNumber &uniqueNumber)
+{
+    AccurateRefresh::AssetAccurateRefresh assetRefresh(AccurateRefresh::CUSTOM_RESTORE_BUSSINESS_NAME);
+    vector<RestoreFileInfo> insertRestoreFiles;
+    int32_t ret = HandleTlvSingleRestore(editFileMap, timeInfoMap, restoreTaskInfo, isFirst, uniqueNumber,
+        assetRefresh, insertRestoreFiles);
+    CHECK_AND_RETURN_RET(ret == E_OK, ret);
+    NotifyTlvRestoreFiles(assetRefresh, insertRestoreFiles);
+    if (isFirst && !insertRestoreFiles.empty()) {
+        ret = UpdatePhotoAlbum(restoreTaskInfo, insertRestoreFiles[0]);
+        CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "UpdatePhotoAlbum failed.");
+    }
+    return E_OK;
+}
+
+int32_t PhotoCustomRestoreOperation::HandleTlvSingleRestore(const std::unordered_map<TlvTag, std::string> &editFileMap,
+    const unordered_map<string, TimeInfo> &timeInfoMap, RestoreTaskInfo &restoreTaskInfo, bool isFirst,
+    UniqueNumber &uniqueNumber, AccurateRefresh::AssetAccurateRefresh &assetRefresh,
+    vector<RestoreFileInfo> &restoredFiles)
 {
     MEDIA_INFO_LOG("HandleTlvSingleRestore begin.");
 
@@ -774,19 +817,21 @@ int32_t PhotoCustomRestoreOperation::HandleTlvSingleRestore(const std::unordered
     }
     ret = UpdateTlvEditDataSize(assetPath);
     CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "UpdateTlvEditDataSize failed");
-    AccurateRefresh::AssetAccurateRefresh assetRefresh(AccurateRefresh::CUSTOM_RESTORE_BUSSINESS_NAME);
     ret = BatchUpdateTimePending(insertRestoreFiles, assetRefresh);
     CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "BatchUpdateTimePending failed. ret: %{public}d", ret);
     MediaShareDirtyDataCleaner::SetSharingState(false);
     MediaShareDirtyDataCleaner::UpdateCleanFlag(false);
+    restoredFiles.insert(restoredFiles.end(), insertRestoreFiles.begin(), insertRestoreFiles.end());
+    return E_OK;
+}
+
+void PhotoCustomRestoreOperation::NotifyTlvRestoreFiles(AccurateRefresh::AssetAccurateRefresh &assetRefresh,
+    const vector<RestoreFileInfo> &restoredFiles)
+{
+    CHECK_AND_RETURN(!restoredFiles.empty());
     assetRefresh.RefreshAlbum();
     assetRefresh.Notify();
-    UpdateAndNotifyShootingModeAlbumIfNeeded(insertRestoreFiles);
-    if (isFirst && !insertRestoreFiles.empty()) {
-        ret = UpdatePhotoAlbum(restoreTaskInfo, insertRestoreFiles[0]);
-        CHECK_AND_RETURN_RET_LOG(ret == E_OK, ret, "UpdatePhotoAlbum failed.");
-    }
-    return E_OK;
+    UpdateAndNotifyShootingModeAlbumIfNeeded(restoredFiles);
 }
 
 void PhotoCustomRestoreOperation::RestoreTlvRollback(const std::string &assetPath)
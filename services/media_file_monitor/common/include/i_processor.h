@@ -31,6 +31,11 @@ public:
     {
         return false;
     }
+    // a batchable processor applies the infos of one directory through Process(notifyInfos) at once
+    virtual bool IsBatchable() const
+    {
+        return false;
+    }
 };
 }
 }
@@ -16,6 +16,11 @@
 #define MLOG_TAG "FileChangeProcessor"
 #include "media_file_change_processor.h"
 
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+#include <unordered_map>
+
 #include "dfx_anco_manager.h"
 #include "dfx_utils.h"
 #ifdef MEDIALIBRARY_LAKE_SUPPORT
@@ -33,6 +38,15 @@ namespace OHOS::Media {
 #define IN_LAKE_MOUNT_OUTLAKE_PATH_PREFIEX "/storage/media/local/files/Docs/HO_DATA_EXT_MISC/"
 #define FILE_MANAGER_DOCS_PATH_PREFIEX "/storage/media/local/files/Docs/"
 
+// 收到变更信号后等待的窗口，使同一突发内的消息一起取出合并
+static constexpr int32_t COALESCE_WINDOW_MS = 100;
+
+static int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 std::shared_ptr<MediaFileChangeProcessor> MediaFileChangeProcessor::GetInstance()
 {
     static auto instance = MediaFileChangeProcessor::Create();
@@ -57,6 +71,8 @@ void MediaFileChangeProcessor::SetFileMonitorProxy(
 
 int32_t MediaFileChangeProcessor::OnFileChanged()
 {
+    int64_t expected = 0;
+    firstSignalTimeMs_.compare_exchange_strong(expected, GetSteadyTimeMs());
     auto callback = [self = shared_from_this()]() {
         self->ProcessFileChanged();
     };
@@ -74,13 +90,19 @@ void MediaFileChangeProcessor::ProcessFileChanged()
 {
     CHECK_AND_RETURN_LOG(fileMonitorProxy_ != nullptr, "not set file monitor proxy");
 
+    int64_t startTime = GetSteadyTimeMs();
+    int64_t signalTime = firstSignalTimeMs_.exchange(0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(COALESCE_WINDOW_MS));
+
     int32_t count = 0;
+    size_t eventCount = 0;
+    size_t appliedCount = 0;
     while (true) {
         std::vector<FileMonitorService::FileMsgModel> msgs;
         auto ret = fileMonitorProxy_->SearchMonitorData(msgs);
-        CHECK_AND_RETURN_LOG(ret == E_OK, "SearchMonitorData failed, ret: %{public}d", ret);
+        CHECK_AND_BREAK_ERR_LOG(ret == E_OK, "SearchMonitorData failed, ret: %{public}d", ret);
 
-        CHECK_AND_RETURN_INFO_LOG(!msgs.empty(), "No file change messages found.");
+        CHECK_AND_BREAK_INFO_LOG(!msgs.empty(), "No file change messages found.");
 
         MEDIA_INFO_LOG("index: %{public}d, msg num: %{public}zu", ++count, msgs.size());
 
@@ -90,12 +112,128 @@ void MediaFileChangeProcessor::ProcessFileChanged()
         for (const auto& fileInfo: msgs) {
             ids.push_back(fileInfo.id);
             if (shouldProcessMsg_) {
-                ProcessSingleFileChange(fileInfo);
                 UpdateDfxData(fileInfo);
             }
         }
+        if (shouldProcessMsg_) {
+            eventCount += msgs.size();
+            appliedCount += ApplyFileChanges(msgs);
+        }
         UpdateMonitorRequests(ids);
     }
+
+    CHECK_AND_RETURN(eventCount > 0);
+    // 从首个变更信号到本次突发全部入库的时延
+    int64_t latencyMs = GetSteadyTimeMs() - (signalTime > 0 ? signalTime : startTime);
+    MEDIA_INFO_LOG("file change burst done, msg num: %{public}zu, applied num: %{public}zu, latency: %{public}"
+        PRId64 "ms", eventCount, appliedCount, latencyMs);
+    AncoDfxManager::GetInstance().NotifyFileChangeBurst(static_cast<int32_t>(eventCount),
+        static_cast<int32_t>(appliedCount), latencyMs);
+}
+
+size_t MediaFileChangeProcessor::ApplyFileChanges(const std::vector<FileMonitorService::FileMsgModel> &msgs)
+{
+    size_t appliedCount = 0;
+    for (const auto &segment : CoalesceFileChanges(msgs)) {
+        appliedCount += ApplySegment(segment);
+    }
+    return appliedCount;
+}
+
+bool MediaFileChangeProcessor::IsBarrierFileChange(const FileMonitorService::FileMsgModel &fileInfo) const
+{
+    if (!fileInfo.isFile) {
+        return true;
+    }
+    // 重命名/移动同时涉及新旧两个路径，不参与按路径合并
+    return fileInfo.opType == static_cast<int32_t>(FileNotifyOperationType::MOD) &&
+        !fileInfo.oldFileUri.empty() && fileInfo.oldFileUri != fileInfo.fileUri;
+}
+
+bool MediaFileChangeProcessor::MergeFileChange(FileMonitorService::FileMsgModel &pending,
+    const FileMonitorService::FileMsgModel &fileInfo)
+{
+    auto pendingOpType = static_cast<FileNotifyOperationType>(pending.opType);
+    auto opType = static_cast<FileNotifyOperationType>(fileInfo.opType);
+    // 删除后重新创建、修改后又新增的序列保持原有先后顺序
+    CHECK_AND_RETURN_RET(pendingOpType != FileNotifyOperationType::DEL || opType == FileNotifyOperationType::DEL,
+        false);
+    CHECK_AND_RETURN_RET(pendingOpType != FileNotifyOperationType::MOD || opType != FileNotifyOperationType::ADD,
+        false);
+
+    // ADD+MOD 合并为 ADD，MOD+MOD 合并为 MOD，ADD/MOD+DEL 合并为 DEL
+    auto mergedOpType = opType == FileNotifyOperationType::MOD ? pendingOpType : opType;
+    bool isContentChange = pending.isContentChange || fileInfo.isContentChange;
+    pending = fileInfo;
+    pending.opType = static_cast<int32_t>(mergedOpType);
+    pending.isContentChange = isContentChange;
+    return true;
+}
+
+std::vector<MediaFileChangeProcessor::FileChangeSegment> MediaFileChangeProcessor::CoalesceFileChanges(
+    const std::vector<FileMonitorService::FileMsgModel> &msgs)
+{
+    std::vector<FileChangeSegment> segments;
+    FileChangeSegment current;
+    std::unordered_map<std::string, size_t> pathIndexes;
+    auto closeSegment = [&segments, &current, &pathIndexes]() {
+        if (!current.fileInfos.empty()) {
+            segments.push_back(std::move(current));
+            current = FileChangeSegment();
+        }
+        pathIndexes.clear();
+    };
+
+    for (const auto &fileInfo : msgs) {
+        // 非媒体文件、未知操作和不在 Docs 下的消息不会产生处理，直接跳过
+        if (fileInfo.isFile && (!fileInfo.isMediaData || !IsInDocsPath(fileInfo.fileUri) ||
+            fileInfo.opType < static_cast<int32_t>(FileNotifyOperationType::ADD) ||
+            fileInfo.opType > static_cast<int32_t>(FileNotifyOperationType::DEL))) {
+            MEDIA_DEBUG_LOG("not care, id:%{public}u, type: %{public}d, path: %{private}s",
+                fileInfo.id, fileInfo.opType, DfxUtils::GetSafePath(fileInfo.fileUri).c_str());
+            continue;
+        }
+        if (IsBarrierFileChange(fileInfo)) {
+            closeSegment();
+            segments.push_back({ true, { fileInfo } });
+            continue;
+        }
+        auto it = pathIndexes.find(fileInfo.fileUri);
+        if (it != pathIndexes.end()) {
+            if (MergeFileChange(current.fileInfos[it->second], fileInfo)) {
+                continue;
+            }
+            closeSegment();
+        }
+        pathIndexes[fileInfo.fileUri] = current.fileInfos.size();
+        current.fileInfos.push_back(fileInfo);
+    }
+    closeSegment();
+    return segments;
+}
+
+size_t MediaFileChangeProcessor::ApplySegment(const FileChangeSegment &segment)
+{
+    if (segment.isBarrier) {
+        for (const auto &fileInfo : segment.fileInfos) {
+            ProcessSingleFileChange(fileInfo);
+        }
+        return segment.fileInfos.size();
+    }
+
+    std::vector<MediaNotifyInfo> notifyInfos;
+    notifyInfos.reserve(segment.fileInfos.size());
+    for (const auto &fileInfo : segment.fileInfos) {
+        if (fileInfo.opType == static_cast<int32_t>(FileNotifyOperationType::MOD) && !PrepareModify(fileInfo)) {
+            continue;
+        }
+        notifyInfos.push_back(BuildLakeNotifyInfo(fileInfo));
+        MEDIA_INFO_LOG("receive file changed, id:%{public}u, type: %{public}d, path: %{private}s",
+            fileInfo.id, fileInfo.opType, DfxUtils::GetSafePath(fileInfo.fileUri).c_str());
+    }
+    CHECK_AND_RETURN_RET(!notifyInfos.empty(), 0);
+    MediaFileNotifyProcessor::GetInstance()->ProcessNotifications(notifyInfos);
+    return notifyInfos.size();
 }
 
 void MediaFileChangeProcessor::ProcessSingleFileChange(const FileMonitorService::FileMsgModel &fileInfo)
@@ -149,17 +287,23 @@ void MediaFileChangeProcessor::HandleModify(const FileMonitorService::FileMsgMod
             fileInfo.id, fileInfo.opType, DfxUtils::GetSafePath(fileInfo.fileUri).c_str());
         return;
     }
+    CHECK_AND_RETURN(PrepareModify(fileInfo));
+
+    auto notifyInfo = BuildLakeNotifyInfo(fileInfo);
+    MediaFileNotifyProcessor::GetInstance()->ProcessNotification(notifyInfo);
+}
+
+bool MediaFileChangeProcessor::PrepareModify(const FileMonitorService::FileMsgModel &fileInfo)
+{
 #ifdef MEDIALIBRARY_LAKE_SUPPORT
     std::string fileUri = fileInfo.fileUri;
     CHECK_AND_PRINT_LOG(LakeFileOperations::UpdateMediaAssetEditData(fileUri) == E_OK,
         "UpdateMediaAssetEditData failed");
 #endif
-    CHECK_AND_RETURN_LOG(fileInfo.isContentChange || IsInDocsPath(fileInfo.oldFileUri),
+    CHECK_AND_RETURN_RET_LOG(fileInfo.isContentChange || IsInDocsPath(fileInfo.oldFileUri), false,
         "Invalid MOD message, id:%{public}u, oldPath: %{private}s, path: %{private}s", fileInfo.id,
         DfxUtils::GetSafePath(fileInfo.oldFileUri).c_str(), DfxUtils::GetSafePath(fileInfo.fileUri).c_str());
-
-    auto notifyInfo = BuildLakeNotifyInfo(fileInfo);
-    MediaFileNotifyProcessor::GetInstance()->ProcessNotification(notifyInfo);
+    return true;
 }
 
 std::optional<MediaFileChangeProcessor::PathPrefixMapping> MediaFileChangeProcessor::GetPathPrefixMapping(
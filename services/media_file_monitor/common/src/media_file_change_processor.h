@@ -16,8 +16,10 @@
 #ifndef MEDIA_FILE_CHANGE_PROCESSOR_H
 #define MEDIA_FILE_CHANGE_PROCESSOR_H
 
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "media_thread_pool.h"
 #include "media_enable_shared_create.h"
@@ -44,6 +46,7 @@ protected:
         FileNotifyObjectType objType, FileNotifyOperationType opType);
     void HandleModify(const FileMonitorService::FileMsgModel &fileInfo,
         FileNotifyObjectType objType, FileNotifyOperationType opType);
+    bool PrepareModify(const FileMonitorService::FileMsgModel &fileInfo);
 
     struct PathPrefixMapping {
         std::string logicPrefix;
@@ -55,10 +58,24 @@ protected:
     MediaNotifyInfo BuildLakeNotifyInfo(const FileMonitorService::FileMsgModel &fileInfo);
     void UpdateMonitorRequests(const std::vector<int32_t> &ids);
 
+    // 一段内每个路径只保留一条合并后的消息；目录和重命名消息单独成段，按序作为屏障处理
+    struct FileChangeSegment {
+        bool isBarrier = false;
+        std::vector<FileMonitorService::FileMsgModel> fileInfos;
+    };
+    std::vector<FileChangeSegment> CoalesceFileChanges(const std::vector<FileMonitorService::FileMsgModel> &msgs);
+    static bool MergeFileChange(FileMonitorService::FileMsgModel &pending,
+        const FileMonitorService::FileMsgModel &fileInfo);
+    bool IsBarrierFileChange(const FileMonitorService::FileMsgModel &fileInfo) const;
+    size_t ApplyFileChanges(const std::vector<FileMonitorService::FileMsgModel> &msgs);
+    size_t ApplySegment(const FileChangeSegment &segment);
+
 private:
     std::shared_ptr<MediaFileMonitorProxyWrapper> fileMonitorProxy_;
     ThreadPool threadPool_;
     std::atomic<bool> shouldProcessMsg_{true};
+    // steady time in ms of the first change signal not yet served, 0 if none
+    std::atomic<int64_t> firstSignalTimeMs_{0};
 };
 
 }
@@ -36,6 +36,8 @@
 #include "media_move_file_manager_dir_processor.h"
 #endif
 
+#include <unordered_map>
+
 #include "media_log.h"
 #include "medialibrary_errno.h"
 
@@ -162,15 +164,9 @@ std::vector<MediaNotifyInfo> SplitNotifyInfo(const MediaNotifyInfo &notifyInfo)
     return infos;
 }
 
-int32_t MediaFileNotifyProcessor::ProcessNotification(const MediaNotifyInfo &notifyInfo)
+// 填充 pathType
+static void FillPathType(MediaNotifyInfo &info)
 {
-    MEDIA_INFO_LOG("NOTIFY, objType: %{public}d, operType: %{public}d, path: %{public}s, oldPath: %{public}s",
-        static_cast<int32_t>(notifyInfo.objType), static_cast<int32_t>(notifyInfo.optType),
-        MediaFileUtils::DesensitizePath(notifyInfo.afterPath).c_str(),
-        MediaFileUtils::DesensitizePath(notifyInfo.beforePath).c_str());
-
-    // 填充 pathType
-    MediaNotifyInfo info = notifyInfo;
     if (!info.afterPath.empty()) {
         if (info.afterPath.find(LAKE_SCAN_DIR) == 0) {
             info.pathType = FileNotifyPathType::LAKE;
@@ -178,6 +174,17 @@ int32_t MediaFileNotifyProcessor::ProcessNotification(const MediaNotifyInfo &not
             info.pathType = FileNotifyPathType::FILE_MANAGER;
         }
     }
+}
+
+int32_t MediaFileNotifyProcessor::ProcessNotification(const MediaNotifyInfo &notifyInfo)
+{
+    MEDIA_INFO_LOG("NOTIFY, objType: %{public}d, operType: %{public}d, path: %{public}s, oldPath: %{public}s",
+        static_cast<int32_t>(notifyInfo.objType), static_cast<int32_t>(notifyInfo.optType),
+        MediaFileUtils::DesensitizePath(notifyInfo.afterPath).c_str(),
+        MediaFileUtils::DesensitizePath(notifyInfo.beforePath).c_str());
+
+    MediaNotifyInfo info = notifyInfo;
+    FillPathType(info);
 
     ProcessorKey key{ info.objType, info.optType, info.pathType };
     std::unique_ptr<IProcessor> processor = MediaProcessorRegistry::GetInstance().CreateProcessor(key);
@@ -191,4 +198,47 @@ int32_t MediaFileNotifyProcessor::ProcessNotification(const MediaNotifyInfo &not
     return 0;
 }
 
+int32_t MediaFileNotifyProcessor::ProcessNotifications(const std::vector<MediaNotifyInfo> &notifyInfos)
+{
+    struct NotifyGroup {
+        ProcessorKey key;
+        std::vector<MediaNotifyInfo> infos;
+    };
+    // 按处理器和父目录分组，保持各组首次出现的顺序
+    std::vector<NotifyGroup> groups;
+    std::unordered_map<std::string, size_t> groupIndexes;
+    for (const auto &notifyInfo : notifyInfos) {
+        MediaNotifyInfo info = notifyInfo;
+        FillPathType(info);
+        ProcessorKey key{ info.objType, info.optType, info.pathType };
+        std::string groupKey = std::to_string(static_cast<int32_t>(info.objType)) + "|" +
+            std::to_string(static_cast<int32_t>(info.optType)) + "|" +
+            std::to_string(static_cast<int32_t>(info.pathType)) + "|" + MediaFileUtils::GetParentPath(info.afterPath);
+        auto it = groupIndexes.find(groupKey);
+        if (it == groupIndexes.end()) {
+            groupIndexes.emplace(groupKey, groups.size());
+            groups.push_back({ key, { std::move(info) } });
+        } else {
+            groups[it->second].infos.push_back(std::move(info));
+        }
+    }
+
+    int32_t ret = E_OK;
+    for (const auto &group : groups) {
+        std::unique_ptr<IProcessor> processor = MediaProcessorRegistry::GetInstance().CreateProcessor(group.key);
+        if (processor == nullptr || !processor->IsBatchable() || group.infos.size() == 1) {
+            for (const auto &info : group.infos) {
+                ret = ProcessNotification(info) == E_OK ? ret : E_ERR;
+            }
+            continue;
+        }
+        MEDIA_INFO_LOG("NOTIFY BATCH, objType: %{public}d, operType: %{public}d, num: %{public}zu, dir: %{public}s",
+            static_cast<int32_t>(std::get<0>(group.key)), static_cast<int32_t>(std::get<1>(group.key)),
+            group.infos.size(),
+            MediaFileUtils::DesensitizePath(MediaFileUtils::GetParentPath(group.infos.front().afterPath)).c_str());
+        processor->Process(group.infos);
+    }
+    return ret;
+}
+
 }
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "media_enable_shared_create.h"
 #include "media_file_notify_info.h"
@@ -36,6 +37,8 @@ public:
         return 0;
     }
     int32_t ProcessNotification(const MediaNotifyInfo &notifyInfo);
+    // groups the infos by processor and parent directory, a batchable processor applies each group at once
+    int32_t ProcessNotifications(const std::vector<MediaNotifyInfo> &notifyInfos);
 
 protected:
     std::shared_ptr<MediaLibraryRdbStore> rdbStore_;
@@ -34,6 +34,25 @@ public:
         FileManagerScanner scanner;
         scanner.Run(input);
     }
+
+    void Process(const std::vector<MediaNotifyInfo> &notifyInfos) override
+    {
+        std::vector<MediaNotifyInfo> input;
+        input.reserve(notifyInfos.size());
+        for (const auto &notifyInfo : notifyInfos) {
+            CHECK_AND_CONTINUE_ERR_LOG(notifyInfo.afterPath != "", "Invalid path in MediaScanFileManagerFileProcessor.");
+            input.push_back(notifyInfo);
+        }
+        CHECK_AND_RETURN(!input.empty());
+        MEDIA_INFO_LOG("Process in MediaScanFileManagerFileProcessor, file num: %{public}zu", input.size());
+        FileManagerScanner scanner;
+        scanner.Run(input);
+    }
+
+    bool IsBatchable() const override
+    {
+        return true;
+    }
 };
 }
 }
@@ -14,6 +14,8 @@
  */
 #include "media_move_file_manager_dir_processor.h"
 
+#include <algorithm>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +36,7 @@
 #include "media_log.h"
 #include "medialibrary_errno.h"
 #include "medialibrary_notify.h"
+#include "medialibrary_rdb_transaction.h"
 #include "medialibrary_rdb_utils.h"
 #include "photo_album_column.h"
 #include "rdb_predicates.h"
@@ -46,6 +49,10 @@ using namespace OHOS::Media::AccurateRefresh;
 
 constexpr int32_t INVALID_ID = -1;
 constexpr int32_t INVALID_COUNT = 0;
+// 单条资产改写语句覆盖的相册数，限制绑定参数个数
+constexpr size_t MOVE_DIR_ALBUM_BATCH_SIZE = 200;
+// 相册与资产变更数超过该值时旧通知合并为集合通知
+constexpr size_t MOVE_DIR_NOTIFY_MERGE_THRESHOLD = 100;
 
 // 存量核查任务状态
 constexpr int32_t TASK_STATUS_COMPLETE = 3;
@@ -100,7 +107,7 @@ bool QueryAlbumDetailByLPath(const shared_ptr<MediaLibraryRdbStore> &rdbStore,
            ->Or()
            ->Like(PhotoAlbumColumns::ALBUM_LPATH, lPath + "/%");
     predicates.EndWrap();
-    predicates.EqualTo(PhotoAlbumColumns::ALBUM_TYPE, "2048");
+    predicates.EqualTo(PhotoAlbumColumns::ALBUM_TYPE, to_string(PhotoAlbumType::SOURCE));
 
     auto resultSet = rdbStore->QueryByStep(predicates, {
         PhotoAlbumColumns::ALBUM_ID,
@@ -140,35 +147,6 @@ bool QueryAlbumDetailByLPath(const shared_ptr<MediaLibraryRdbStore> &rdbStore,
     return true;
 }
 
-bool MarkAssetsTimePending(const std::vector<int32_t> &albumIds, int64_t timePendingValue)
-{
-    CHECK_AND_RETURN_RET_LOG(!albumIds.empty(), false, "albumIds is empty");
-
-    AssetAccurateRefresh assetRefresh;
-    ValuesBucket values;
-    values.PutLong(MediaColumn::MEDIA_TIME_PENDING, timePendingValue);
-
-    RdbPredicates predicates(PhotoColumn::PHOTOS_TABLE);
-    std::vector<std::string> albumIdStrings;
-    albumIdStrings.reserve(albumIds.size());
-    for (int32_t id : albumIds) {
-        albumIdStrings.push_back(to_string(id));
-    }
-    predicates.In(PhotoColumn::PHOTO_OWNER_ALBUM_ID, albumIdStrings);
-    predicates.EqualTo(PhotoColumn::PHOTO_FILE_SOURCE_TYPE,
-        to_string(static_cast<int32_t>(FileSourceType::FILE_MANAGER)));
-
-    int32_t changedRows = 0;
-    CHECK_AND_RETURN_RET_LOG(
-        assetRefresh.Update(changedRows, values, predicates) == E_OK, false,
-        "MarkAssetsTimePending Update failed, timePending: %{public}" PRId64, timePendingValue);
-
-    assetRefresh.RefreshAlbum();
-    assetRefresh.Notify();
-    MEDIA_INFO_LOG("Marked %{public}d assets time_pending=%{public}" PRId64, changedRows, timePendingValue);
-    return true;
-}
-
 std::string ComputeNewLPath(const std::string &oldLPath, const std::string &detailLPath, const std::string &newLPath)
 {
     // Top-level renamed album: lpath fully replaced
@@ -194,12 +172,14 @@ std::string ComputeNewAlbumName(const std::string &oldLPath, const std::string &
     return detailName;
 }
 
-bool CreateAlbumsByLPathReplace(MoveDirData &moveDirData)
+// New albums are inserted with one statement, the ids are read back by lpath inside the same transaction
+bool CreateAlbumsByLPathReplace(MoveDirData &moveDirData, AlbumAccurateRefresh &albumRefresh,
+    const std::shared_ptr<TransactionOperations> &trans)
 {
     CHECK_AND_RETURN_RET_LOG(!moveDirData.albumDetails.empty(), false, "albumDetails is empty");
 
-    AlbumAccurateRefresh albumRefresh;
-
+    std::vector<ValuesBucket> valuesList;
+    std::unordered_map<std::string, int32_t> newLPathMap; // newLPath -> oldAlbumId
     for (const auto &detail : moveDirData.albumDetails) {
         std::string newLPathForThisAlbum =
             ComputeNewLPath(moveDirData.oldLPath, detail.albumLPath, moveDirData.newLPath);
@@ -215,35 +195,53 @@ bool CreateAlbumsByLPathReplace(MoveDirData &moveDirData)
         values.PutInt(PhotoAlbumColumns::ALBUM_TYPE, detail.albumType);
         values.PutInt(PhotoAlbumColumns::ALBUM_SUBTYPE, detail.albumSubtype);
         values.PutString(PhotoAlbumColumns::ALBUM_LPATH, newLPathForThisAlbum);
-
-        int64_t newRowId = 0;
-        int32_t ret = albumRefresh.Insert(newRowId, PhotoAlbumColumns::TABLE, values);
-        CHECK_AND_RETURN_RET_LOG(ret == E_OK && newRowId > 0, false,
-            "Insert album failed, ret: %{public}d, newRowId: %{public}" PRId64, ret, newRowId);
-
-        moveDirData.albumIdMap[detail.albumId] = static_cast<int32_t>(newRowId);
-        moveDirData.newAlbumIdStrings.push_back(to_string(static_cast<int32_t>(newRowId)));
-        MEDIA_INFO_LOG("New album created, oldId: %{public}d -> newId: %{public}d, "
-            "lpath: %{public}s -> %{public}s, name: %{public}s -> %{public}s",
-            detail.albumId, static_cast<int32_t>(newRowId),
-            DfxUtils::GetSafePath(detail.albumLPath).c_str(),
-            DfxUtils::GetSafePath(newLPathForThisAlbum).c_str(),
-            detail.albumName.c_str(), nameForNewAlbum.c_str());
+        valuesList.push_back(std::move(values));
+        newLPathMap[newLPathForThisAlbum] = detail.albumId;
     }
-    CHECK_AND_RETURN_RET_LOG(!moveDirData.albumIdMap.empty(), false, "albumIdMap is empty after creation");
-    CHECK_AND_RETURN_RET_LOG(albumRefresh.NotifyAddAlbums(moveDirData.newAlbumIdStrings) == E_OK, false,
-        "AlbumAccurateRefresh NotifyAddAlbums failed");
-    
-    // 立即发送新相册新增的旧通知
-    MediaFileMonitorRdbUtils::NotifyAlbums(moveDirData.newAlbumIdStrings,
-        AlbumNotifyType::COMMON_ALBUM, NotifyType::NOTIFY_ADD);
-    MEDIA_INFO_LOG("New albums created and notified, count: %{public}zu", moveDirData.newAlbumIdStrings.size());
-    
+    CHECK_AND_RETURN_RET_LOG(!valuesList.empty(), false, "No album to create");
+
+    int64_t insertedRows = 0;
+    int32_t rdbError = 0;
+    int32_t ret = albumRefresh.BatchInsert(insertedRows, PhotoAlbumColumns::TABLE, valuesList, rdbError);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK && insertedRows == static_cast<int64_t>(valuesList.size()), false,
+        "BatchInsert albums failed, ret: %{public}d, rdbError: %{public}d, inserted: %{public}" PRId64
+        ", expected: %{public}zu", ret, rdbError, insertedRows, valuesList.size());
+
+    // An album left at the new lpath by an earlier move is older, the latest id of each lpath is the new album
+    std::string sql = "SELECT MAX(" + PhotoAlbumColumns::ALBUM_ID + ") AS " + PhotoAlbumColumns::ALBUM_ID + ", " +
+        PhotoAlbumColumns::ALBUM_LPATH + " FROM " + PhotoAlbumColumns::TABLE + " WHERE " +
+        PhotoAlbumColumns::ALBUM_TYPE + " = ? AND (" + PhotoAlbumColumns::ALBUM_LPATH + " = ? OR " +
+        PhotoAlbumColumns::ALBUM_LPATH + " LIKE ?) GROUP BY " + PhotoAlbumColumns::ALBUM_LPATH;
+    auto resultSet = trans->QueryByStep(sql, { ValueObject(static_cast<int32_t>(PhotoAlbumType::SOURCE)),
+        ValueObject(moveDirData.newLPath), ValueObject(moveDirData.newLPath + "/%") });
+    CHECK_AND_RETURN_RET_LOG(resultSet != nullptr, false, "Query new albums failed");
+    while (resultSet->GoToNextRow() == E_OK) {
+        int32_t newAlbumId = INVALID_ID;
+        std::string newLPath;
+        int index = -1;
+        if (resultSet->GetColumnIndex(PhotoAlbumColumns::ALBUM_ID, index) == E_OK) {
+            resultSet->GetInt(index, newAlbumId);
+        }
+        if (resultSet->GetColumnIndex(PhotoAlbumColumns::ALBUM_LPATH, index) == E_OK) {
+            resultSet->GetString(index, newLPath);
+        }
+        auto it = newLPathMap.find(newLPath);
+        CHECK_AND_CONTINUE(it != newLPathMap.end() && newAlbumId > 0);
+        moveDirData.albumIdMap[it->second] = newAlbumId;
+        moveDirData.newAlbumIdStrings.push_back(to_string(newAlbumId));
+    }
+    resultSet->Close();
+    CHECK_AND_RETURN_RET_LOG(moveDirData.albumIdMap.size() == newLPathMap.size(), false,
+        "New album ids mismatch, found: %{public}zu, expected: %{public}zu",
+        moveDirData.albumIdMap.size(), newLPathMap.size());
+    MEDIA_INFO_LOG("New albums created, count: %{public}zu, lpath: %{public}s -> %{public}s",
+        moveDirData.albumIdMap.size(), DfxUtils::GetSafePath(moveDirData.oldLPath).c_str(),
+        DfxUtils::GetSafePath(moveDirData.newLPath).c_str());
     return true;
 }
 
 // Delete old albums after new albums are created
-bool DeleteAlbumsByIds(const std::vector<int32_t> &albumIds)
+bool DeleteAlbumsByIds(const std::vector<int32_t> &albumIds, AlbumAccurateRefresh &albumRefresh)
 {
     CHECK_AND_RETURN_RET_LOG(!albumIds.empty(), false, "albumIds is empty");
 
@@ -256,71 +254,59 @@ bool DeleteAlbumsByIds(const std::vector<int32_t> &albumIds)
     RdbPredicates predicates(PhotoAlbumColumns::TABLE);
     predicates.In(PhotoAlbumColumns::ALBUM_ID, albumIdStrings);
 
-    AlbumAccurateRefresh albumRefresh;
     int32_t deletedRows = 0;
     int32_t ret = albumRefresh.LogicalDeleteReplaceByUpdate(predicates, deletedRows);
     CHECK_AND_RETURN_RET_LOG(ret == E_OK, false,
         "DeleteAlbumsByIds failed, ret: %{public}d, deletedRows: %{public}d", ret, deletedRows);
-
-    albumRefresh.Notify();
-
-    // 立即发送旧相册删除的旧通知
-    MediaFileMonitorRdbUtils::NotifyAlbums(albumIdStrings,
-        AlbumNotifyType::COMMON_ALBUM, NotifyType::NOTIFY_REMOVE);
-    MEDIA_INFO_LOG("Deleted %{public}d old albums and notified", deletedRows);
-    
+    MEDIA_INFO_LOG("Deleted %{public}d old albums", deletedRows);
     return true;
 }
 
-bool RefreshAssetsForDirMove(const unordered_map<int32_t, int32_t> &albumIdMap,
-    const std::vector<LakeMonitorQueryResultData> &dataList,
+// Owner album and storage path prefix of the assets of many albums are rewritten by each statement
+bool RefreshAssetsForDirMove(const unordered_map<int32_t, int32_t> &albumIdMap, AssetAccurateRefresh &assetRefresh,
     const std::string &oldPathPrefix, const std::string &newPathPrefix)
 {
     CHECK_AND_RETURN_RET_LOG(!albumIdMap.empty(), false, "albumIdMap is empty");
 
-    AssetAccurateRefresh assetRefresh;
+    std::string oldPrefix = oldPathPrefix + "/";
+    std::string newPrefix = newPathPrefix + "/";
+    std::vector<std::pair<int32_t, int32_t>> albumPairs(albumIdMap.begin(), albumIdMap.end());
+    for (size_t start = 0; start < albumPairs.size(); start += MOVE_DIR_ALBUM_BATCH_SIZE) {
+        size_t end = std::min(start + MOVE_DIR_ALBUM_BATCH_SIZE, albumPairs.size());
+        std::string caseClause;
+        std::string inClause;
+        std::vector<ValueObject> bindArgs;
+        for (size_t i = start; i < end; i++) {
+            caseClause += " WHEN ? THEN ?";
+            bindArgs.push_back(ValueObject(albumPairs[i].first));
+            bindArgs.push_back(ValueObject(albumPairs[i].second));
+        }
+        // SUBSTR counts characters, so the prefix length is taken by LENGTH rather than the byte size
+        bindArgs.push_back(ValueObject(oldPrefix));
+        bindArgs.push_back(ValueObject(oldPrefix));
+        bindArgs.push_back(ValueObject(newPrefix));
+        bindArgs.push_back(ValueObject(oldPrefix));
+        for (size_t i = start; i < end; i++) {
+            inClause += (i == start) ? "?" : ", ?";
+            bindArgs.push_back(ValueObject(albumPairs[i].first));
+        }
+        bindArgs.push_back(ValueObject(static_cast<int32_t>(FileSourceType::FILE_MANAGER)));
 
-    for (const auto &[oldAlbumId, newAlbumId] : albumIdMap) {
         std::string sql = "UPDATE " + PhotoColumn::PHOTOS_TABLE + " SET "
-            + PhotoColumn::PHOTO_OWNER_ALBUM_ID + " = ?, "
-            + PhotoColumn::PHOTO_STORAGE_PATH + " = REPLACE("
-                + PhotoColumn::PHOTO_STORAGE_PATH + ", ?, ?), "
+            + PhotoColumn::PHOTO_OWNER_ALBUM_ID + " = CASE " + PhotoColumn::PHOTO_OWNER_ALBUM_ID
+                + caseClause + " END, "
+            + PhotoColumn::PHOTO_STORAGE_PATH + " = CASE WHEN SUBSTR(" + PhotoColumn::PHOTO_STORAGE_PATH
+                + ", 1, LENGTH(?)) = ? THEN ? || SUBSTR(" + PhotoColumn::PHOTO_STORAGE_PATH
+                + ", LENGTH(?) + 1) ELSE "
+                + PhotoColumn::PHOTO_STORAGE_PATH + " END, "
             + MediaColumn::MEDIA_TIME_PENDING + " = 0 "
-            + "WHERE " + PhotoColumn::PHOTO_OWNER_ALBUM_ID + " = ? AND "
+            + "WHERE " + PhotoColumn::PHOTO_OWNER_ALBUM_ID + " IN (" + inClause + ") AND "
             + PhotoColumn::PHOTO_FILE_SOURCE_TYPE + " = ?";
-
-        std::vector<ValueObject> bindArgs;
-        bindArgs.push_back(ValueObject(static_cast<int32_t>(newAlbumId)));
-        bindArgs.push_back(ValueObject(oldPathPrefix));
-        bindArgs.push_back(ValueObject(newPathPrefix));
-        bindArgs.push_back(ValueObject(static_cast<int32_t>(oldAlbumId)));
-        bindArgs.push_back(ValueObject(to_string(static_cast<int32_t>(FileSourceType::FILE_MANAGER))));
-
-        CHECK_AND_RETURN_RET_LOG(
-            assetRefresh.ExecuteSql(sql, bindArgs, RDB_OPERATION_UPDATE) == E_OK, false,
-            "RefreshAssetsForDirMove ExecuteSql failed, oldId:%{public}d->newId:%{public}d",
-            oldAlbumId, newAlbumId);
-    }
-
-    assetRefresh.RefreshAlbum();
-    assetRefresh.Notify();
-
-    // 立即发送相册内容更新通知
-    auto watch = MediaLibraryNotify::GetInstance();
-    CHECK_AND_RETURN_RET_LOG(watch != nullptr, false, "Can not get MediaLibraryNotify Instance");
-    for (const auto &[oldAlbumId, newAlbumId] : albumIdMap) {
-        watch->Notify(MediaFileUtils::GetUriByExtrConditions(
-            PhotoAlbumColumns::ALBUM_URI_PREFIX, to_string(newAlbumId)), NotifyType::NOTIFY_ALBUM_ADD_ASSET);
-    }
-    
-    // 立即发送资产更新通知（路径和所属相册变化）
-    for (const auto &data : dataList) {
-        NotifyAssetChange(data.fileId, NotifyType::NOTIFY_UPDATE);
+        CHECK_AND_RETURN_RET_LOG(assetRefresh.ExecuteSql(sql, bindArgs, RDB_OPERATION_UPDATE) == E_OK, false,
+            "RefreshAssetsForDirMove ExecuteSql failed, albums: [%{public}zu, %{public}zu)", start, end);
     }
-    
-    MEDIA_INFO_LOG("RefreshAssetsForDirMove completed and notified, %{public}zu mappings, "
-        "oldPrefix: %{public}s -> newPrefix: %{public}s",
-        albumIdMap.size(),
+    MEDIA_INFO_LOG("RefreshAssetsForDirMove completed, %{public}zu mappings, "
+        "oldPrefix: %{public}s -> newPrefix: %{public}s", albumIdMap.size(),
         DfxUtils::GetSafePath(oldPathPrefix).c_str(), DfxUtils::GetSafePath(newPathPrefix).c_str());
     return true;
 }
@@ -350,19 +336,61 @@ bool QueryMoveDirData(const shared_ptr<MediaLibraryRdbStore> &rdbStore, MoveDirD
     return true;
 }
 
-bool SwapAlbums(MoveDirData &moveDirData)
+// 新增相册、删除旧相册、改写资产在同一事务内完成，中间状态对外不可见
+bool SwapAlbumsAndAssets(MoveDirData &moveDirData, AlbumAccurateRefresh &addAlbumRefresh,
+    AlbumAccurateRefresh &deleteAlbumRefresh, AssetAccurateRefresh &assetRefresh,
+    const std::shared_ptr<TransactionOperations> &trans)
 {
-    CHECK_AND_RETURN_RET_LOG(
-        CreateAlbumsByLPathReplace(moveDirData),
-        false, "CreateAlbumsByLPathReplace failed");
-
-    CHECK_AND_RETURN_RET_LOG(DeleteAlbumsByIds(moveDirData.oldAlbumIds),
-        false, "DeleteAlbumsByIds failed");
+    std::function<int(void)> func = [&]()->int {
+        moveDirData.albumIdMap.clear();
+        moveDirData.newAlbumIdStrings.clear();
+        CHECK_AND_RETURN_RET_LOG(CreateAlbumsByLPathReplace(moveDirData, addAlbumRefresh, trans),
+            E_HAS_DB_ERROR, "CreateAlbumsByLPathReplace failed");
+        CHECK_AND_RETURN_RET_LOG(DeleteAlbumsByIds(moveDirData.oldAlbumIds, deleteAlbumRefresh),
+            E_HAS_DB_ERROR, "DeleteAlbumsByIds failed");
+        CHECK_AND_RETURN_RET_LOG(RefreshAssetsForDirMove(moveDirData.albumIdMap, assetRefresh,
+            moveDirData.oldPath, moveDirData.newPath), E_HAS_DB_ERROR, "RefreshAssetsForDirMove failed");
+        return E_OK;
+    };
+    int32_t ret = trans->RetryTrans(func);
+    CHECK_AND_RETURN_RET_LOG(ret == E_OK, false, "Move dir transaction failed, ret: %{public}d", ret);
     return true;
 }
 
-void NotifyMoveDirResult(const MoveDirData &moveDirData)
+void NotifyMoveDirResult(const MoveDirData &moveDirData, AlbumAccurateRefresh &addAlbumRefresh,
+    AlbumAccurateRefresh &deleteAlbumRefresh, AssetAccurateRefresh &assetRefresh)
 {
+    CHECK_AND_PRINT_LOG(addAlbumRefresh.NotifyAddAlbums(moveDirData.newAlbumIdStrings) == E_OK,
+        "AlbumAccurateRefresh NotifyAddAlbums failed");
+    deleteAlbumRefresh.Notify();
+    assetRefresh.RefreshAlbum();
+    assetRefresh.Notify();
+
+    // 旧通知：变更较多时合并为相册和资产集合各一条
+    auto watch = MediaLibraryNotify::GetInstance();
+    CHECK_AND_RETURN_LOG(watch != nullptr, "Can not get MediaLibraryNotify Instance");
+    if (moveDirData.albumIdMap.size() + moveDirData.dataList.size() > MOVE_DIR_NOTIFY_MERGE_THRESHOLD) {
+        watch->Notify(PhotoAlbumColumns::DEFAULT_PHOTO_ALBUM_URI, NotifyType::NOTIFY_UPDATE);
+        watch->Notify(PhotoColumn::DEFAULT_PHOTO_URI, NotifyType::NOTIFY_UPDATE);
+    } else {
+        MediaFileMonitorRdbUtils::NotifyAlbums(moveDirData.newAlbumIdStrings,
+            AlbumNotifyType::COMMON_ALBUM, NotifyType::NOTIFY_ADD);
+        std::vector<std::string> oldAlbumIdStrings;
+        oldAlbumIdStrings.reserve(moveDirData.oldAlbumIds.size());
+        for (int32_t id : moveDirData.oldAlbumIds) {
+            oldAlbumIdStrings.push_back(to_string(id));
+        }
+        MediaFileMonitorRdbUtils::NotifyAlbums(oldAlbumIdStrings,
+            AlbumNotifyType::COMMON_ALBUM, NotifyType::NOTIFY_REMOVE);
+        for (const auto &[oldAlbumId, newAlbumId] : moveDirData.albumIdMap) {
+            watch->Notify(MediaFileUtils::GetUriByExtrConditions(
+                PhotoAlbumColumns::ALBUM_URI_PREFIX, to_string(newAlbumId)), NotifyType::NOTIFY_ALBUM_ADD_ASSET);
+        }
+        for (const auto &data : moveDirData.dataList) {
+            NotifyAssetChange(data.fileId, NotifyType::NOTIFY_UPDATE);
+        }
+    }
+
     // 智慧相册通知（资产所属智慧相册内容可能变化）
     if (!moveDirData.analysisAlbumIds.empty()) {
         std::vector<std::string> albumIdsVec(moveDirData.analysisAlbumIds.begin(), moveDirData.analysisAlbumIds.end());
@@ -421,18 +449,16 @@ bool MoveFileManagerDir(const std::string &oldPath, const std::string &newPath,
     // 查询文件夹变化前后数据库相册和资产信息
     CHECK_AND_RETURN_RET_LOG(QueryMoveDirData(rdbStore, moveDirData), false,
         "Query file_manager albums and assets failed");
-    // 变更前设置所有相关资产time_pending=-1不可见
-    CHECK_AND_RETURN_RET_LOG(MarkAssetsTimePending(moveDirData.oldAlbumIds, -1), false,
-        "Mark assets time_pending failed");
-    // 新增、删除相册
-    CHECK_AND_RETURN_RET_LOG(SwapAlbums(moveDirData), false, "Swap albums failed");
-    // 刷新数据库资产（owner_album_id, storage_path, time_pending）
-    CHECK_AND_RETURN_RET_LOG(RefreshAssetsForDirMove(moveDirData.albumIdMap, moveDirData.dataList,
-        moveDirData.oldPath, moveDirData.newPath),
-        false, "Refresh file_manager assets failed");
-    
-    // 智慧相册通知
-    NotifyMoveDirResult(moveDirData);
+    // 新增、删除相册并刷新资产（owner_album_id, storage_path, time_pending）
+    std::shared_ptr<TransactionOperations> trans = std::make_shared<TransactionOperations>(__func__);
+    AlbumAccurateRefresh addAlbumRefresh(trans);
+    AlbumAccurateRefresh deleteAlbumRefresh(trans);
+    AssetAccurateRefresh assetRefresh(trans);
+    CHECK_AND_RETURN_RET_LOG(SwapAlbumsAndAssets(moveDirData, addAlbumRefresh, deleteAlbumRefresh, assetRefresh,
+        trans), false, "Swap albums and assets failed");
+    NotifyMoveDirResult(moveDirData, addAlbumRefresh, deleteAlbumRefresh, assetRefresh);
+    MEDIA_INFO_LOG("Move dir done, albums: %{public}zu, assets: %{public}zu",
+        moveDirData.albumIdMap.size(), moveDirData.dataList.size());
 
     HandleRenameCompensation(oldPath, newPath, rdbStore);
 
@@ -38,6 +38,27 @@ public:
         scanner.Run(input);
 #endif
     }
+
+    void Process(const std::vector<MediaNotifyInfo> &notifyInfos) override
+    {
+        std::vector<MediaNotifyInfo> input;
+        input.reserve(notifyInfos.size());
+        for (const auto &notifyInfo : notifyInfos) {
+            CHECK_AND_CONTINUE_ERR_LOG(notifyInfo.afterPath != "", "Invalid path in MediaScanLakeFileProcessor.");
+            input.push_back(notifyInfo);
+        }
+        CHECK_AND_RETURN(!input.empty());
+        MEDIA_INFO_LOG("Process in MediaScanLakeFileProcessor, file num: %{public}zu", input.size());
+#ifdef MEDIALIBRARY_LAKE_SUPPORT
+        LakeFileScanner scanner;
+        scanner.Run(input);
+#endif
+    }
+
+    bool IsBatchable() const override
+    {
+        return true;
+    }
 };
 }
 }
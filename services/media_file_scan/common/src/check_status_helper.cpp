@@ -20,6 +20,7 @@
 
 #include "media_file_utils.h"
 #include "media_log.h"
+#include "preferences_write_back.h"
 
 namespace OHOS::Media {
 const std::string KEY_LAST_FILE_ID = "last_file_id";
@@ -38,7 +39,7 @@ void CheckStatusHelper::SetInt32ValueByKey(const std::string &key, int32_t value
     auto prefs = GetPreferences();
     CHECK_AND_RETURN_LOG(prefs != nullptr, "GetPreferences failed");
     prefs->PutInt(key, value);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("%{public}s: %{public}d", key.c_str(), value);
 }
 
@@ -54,7 +55,7 @@ void CheckStatusHelper::SetInt64ValueByKey(const std::string &key, int64_t value
     auto prefs = GetPreferences();
     CHECK_AND_RETURN_LOG(prefs != nullptr, "GetPreferences failed");
     prefs->PutLong(key, value);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("%{public}s: %{public}" PRId64, key.c_str(), value);
 }
 
@@ -80,7 +81,7 @@ void CheckStatusHelper::SetValuesByCurrentProgress(const ConsistencyCheck::Scena
     CHECK_AND_RETURN_LOG(prefs != nullptr, "GetPreferences failed");
     prefs->PutInt(KEY_LAST_FILE_ID, progress.lastFileId);
     prefs->PutInt(KEY_LAST_ALBUM_ID, progress.lastAlbumId);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("Set %{public}s", progress.ToString().c_str());
 }
 
@@ -91,7 +92,7 @@ void CheckStatusHelper::SetValuesByFinishedProgress(const ConsistencyCheck::Scen
     prefs->PutInt(KEY_LAST_FILE_ID, progress.lastFileId);
     prefs->PutInt(KEY_LAST_ALBUM_ID, progress.lastAlbumId);
     prefs->PutLong(KEY_LAST_CHECK_TIME_IN_MS, progress.lastCheckTimeInMs);
-    prefs->FlushSync();
+    PreferencesWriteBack::GetInstance().MarkDirty(prefs);
     MEDIA_INFO_LOG("Set %{public}s", progress.ToString().c_str());
 }
 
@@ -829,6 +829,7 @@ static int32_t OpenFile(const string &filePath, const string &fileId, const stri
         CHECK_AND_EXECUTE(dfxManager != nullptr, close(ret));
         CHECK_AND_RETURN_RET_LOG(dfxManager != nullptr, E_INNER_FAIL, "DfxManager::GetInstance() returned nullptr");
         dfxManager->HandleTranscodeAccessTime(ACCESS_LIBC, transcodeType);
+        MediaLibraryTranscodeDataAgingOperation::TouchTmpCompatibleDup(fileId);
     }
     return ret;
 }
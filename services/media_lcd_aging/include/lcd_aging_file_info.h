@@ -31,6 +31,8 @@ struct LcdAgingFileInfo {
     int64_t thumbnailReady {-1};
     int64_t dateModified {-1};
     int32_t lcdFileSize {0};
+    int64_t lcdVisitTime {0};
+    int32_t lcdVisitCount {0};
     bool needFixLcdFileSize {false};
     bool hasExThumbnail {false};
 };
@@ -94,6 +94,7 @@ private:
     int32_t InsertDentryFileWithRetry(const std::vector<FileManagement::CloudSync::DentryFileInfo> &dentryFileInfos,
         std::vector<std::string> &failCloudIds);
     int32_t CheckLcdAgingTargetReached(int32_t &excessSize);
+    int32_t CheckFreeBytesTarget();
 
     void StartCallbackTimer();
     void StopCallbackTimer();
@@ -112,7 +113,12 @@ private:
     std::queue<DeleteLcdFilesTask> deleteLcdFilesTaskQueue_;
     std::mutex deleteLcdFilesTaskMutex_;
     std::condition_variable deleteLcdFilesTaskCv_;
+    std::condition_variable deleteLcdFilesSpaceCv_;
     std::atomic<bool> isDeleteLcdFilesWorkerRunning_ {false};
+    // 空间紧张时需要释放的字节数及截止时间, 为0表示按LCD数量老化
+    int64_t freeBytesTarget_ {0};
+    int64_t agingDeadline_ {0};
+    std::atomic<int64_t> freedLcdBytes_ {0};
     int64_t freeSizeOld_{0};
     int64_t startTime_{0};
 
@@ -33,6 +33,11 @@ public:
     EXPORT static std::vector<DentryFileInfo> ConvertAgingFileToDentryFile(
         const std::vector<LcdAgingFileInfo> &agingFileInfos);
     EXPORT static bool HasExThumbnail(const LcdAgingFileInfo &agingFileInfo);
+    // 老化收益: 文件越大、越久未访问、访问次数越少, 收益越高
+    EXPORT static double GetAgingPriority(const LcdAgingFileInfo &agingFileInfo, const int64_t currentTime);
+    EXPORT static void SortByAgingPriority(std::vector<LcdAgingFileInfo> &agingFileInfos);
+    // 剩余空间低于阈值时需要释放的字节数, 空间充足时返回0
+    EXPORT static int64_t GetFreeBytesTarget(const int64_t totalSize, const int64_t freeSize);
 };
 }  // namespace OHOS::Media
 #endif  // OHOS_MEDIA_LCD_AGING_UTILS_H
\ No newline at end of file
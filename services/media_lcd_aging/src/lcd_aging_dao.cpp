@@ -48,7 +48,8 @@ const std::string SQL_GET_TOTAL_NUMBER_OF_LCD = "\
         ((position = 2 OR position = 3) AND (thumb_status & 1) = 0)) AND \
         clean_flag = 0;";
 const std::string SQL_QUERY_AGING_INFO_COLUMN =
-    " file_id, data, cloud_id, media_type, orientation, exif_rotate, thumbnail_ready, date_modified, lcd_file_size ";
+    " file_id, data, cloud_id, media_type, orientation, exif_rotate, thumbnail_ready, date_modified, lcd_file_size, "
+    " real_lcd_visit_time, lcd_visit_count ";
 
 // 查询可以老化的图片: 纯云图、非收藏，需要排除以下图片: 最近拍摄的图片(LatestPhotos)、人像/合影相册封面、时刻封面
 // 收藏的时刻、智慧分析标注的图片、其他原因不可老化的图片
@@ -110,15 +111,19 @@ const std::string SQL_AGING_WHERE_CONDITION = "\
     AND P.real_lcd_visit_time < ? \
     AND P.date_taken < ? ";
 
-// 查询回收站可老化图片
+// 排序不依赖索引: 公共条件本身就需要扫描Photos, 带LIMIT的ORDER BY只维护LIMIT条记录的堆;
+// real_lcd_visit_time在每次浏览LCD时更新, 为其建索引会给浏览路径增加写开销
+// 查询回收站可老化图片, 按LCD访问时间升序, 优先取最久未访问的图片
 const std::string SQL_QUERY_AGING_LCD_DATA_TRASHED = SQL_QUERY_NOT_AGING_DATA +
     " SELECT " + SQL_QUERY_AGING_INFO_COLUMN +
-    " FROM Photos P WHERE " + SQL_AGING_WHERE_CONDITION + " AND P.date_trashed > 0 LIMIT ?;";
+    " FROM Photos P WHERE " + SQL_AGING_WHERE_CONDITION + " AND P.date_trashed > 0" +
+    " ORDER BY P.real_lcd_visit_time ASC LIMIT ?;";
 
-// 查询非回收站可老化图片
+// 查询非回收站可老化图片, 按LCD访问时间升序, 优先取最久未访问的图片
 const std::string SQL_QUERY_AGING_LCD_DATA_NOT_TRASHED = SQL_QUERY_NOT_AGING_DATA +
     " SELECT " + SQL_QUERY_AGING_INFO_COLUMN +
-    " FROM Photos P WHERE " + SQL_AGING_WHERE_CONDITION + " AND P.date_trashed = 0 LIMIT ?;";
+    " FROM Photos P WHERE " + SQL_AGING_WHERE_CONDITION + " AND P.date_trashed = 0" +
+    " ORDER BY P.real_lcd_visit_time ASC LIMIT ?;";
 
 // 统计可老化图片总数
 const std::string SQL_COUNT_AGING_LCD_DATA = SQL_QUERY_NOT_AGING_DATA +
@@ -183,6 +188,8 @@ void LcdAgingDao::ReadLcdAgingInfoFromResultSet(const std::shared_ptr<NativeRdb:
     constexpr int32_t INDEX_THUMBNAIL_READY = 6;
     constexpr int32_t INDEX_DATE_MODIFIED = 7;
     constexpr int32_t INDEX_LCD_FILE_SIZE = 8;
+    constexpr int32_t INDEX_LCD_VISIT_TIME = 9;
+    constexpr int32_t INDEX_LCD_VISIT_COUNT = 10;
 
     CHECK_AND_RETURN_LOG(resultSet != nullptr, "resultSet is nullptr");
     resultSet->GetInt(INDEX_FILE_ID, lcdAgingInfo.fileId);
@@ -194,6 +201,8 @@ void LcdAgingDao::ReadLcdAgingInfoFromResultSet(const std::shared_ptr<NativeRdb:
     resultSet->GetLong(INDEX_THUMBNAIL_READY, lcdAgingInfo.thumbnailReady);
     resultSet->GetLong(INDEX_DATE_MODIFIED, lcdAgingInfo.dateModified);
     resultSet->GetInt(INDEX_LCD_FILE_SIZE, lcdAgingInfo.lcdFileSize);
+    resultSet->GetLong(INDEX_LCD_VISIT_TIME, lcdAgingInfo.lcdVisitTime);
+    resultSet->GetInt(INDEX_LCD_VISIT_COUNT, lcdAgingInfo.lcdVisitCount);
 }
 
 int32_t LcdAgingDao::QueryAgingLcdDataInternal(const int32_t size, const std::vector<std::string> &notAgingFileIds,
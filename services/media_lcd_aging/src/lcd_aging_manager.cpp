@@ -17,6 +17,8 @@
 #include "lcd_aging_manager.h"
 
 #include <dlfcn.h>
+#include <thread>
+#include <unordered_set>
 #include <sys/stat.h>
 
 #include "cloud_sync_manager.h"
@@ -41,6 +43,7 @@
 #include "thumbnail_source_loading.h"
 #include "medialibrary_unistore_manager.h"
 #include "dfx_manager.h"
+#include "ffrt_inner.h"
 
 namespace OHOS::Media {
 const std::string LCD_AGING_XML = "/data/storage/el2/base/preferences/lcd_aging.xml";
@@ -52,6 +55,8 @@ constexpr int32_t CYCLE_NUMBER = 100;
 constexpr int32_t E_FINISH = 1;
 constexpr int32_t E_AGING_STOP = 2;
 constexpr int32_t E_AGING_INTERRUPT = 3;
+constexpr int32_t E_AGING_TARGET_REACHED = 4;
+constexpr int32_t E_AGING_TIMEOUT = 5;
 constexpr uint32_t MAX_PROGRESS = 100;
 // 老化执行中的进度上限, 100%进度仅在老化任务完成后上报
 constexpr uint32_t MAX_RUNNING_PROGRESS = 99;
@@ -62,6 +67,12 @@ const std::string CLOUDSYNC_SWITCH_STATUS_KEY = "persist.kernel.cloudsync.switch
 constexpr int32_t DIVISOR = 1024 * 1024;
 
 constexpr uint32_t DELETE_LCD_FILES_WAIT_SECONDS = 2;
+// 删除队列上限, 队列满时老化主流程等待, 保证已释放空间的统计不会落后太多
+constexpr size_t MAX_PENDING_DELETE_TASKS = 4;
+constexpr size_t DELETE_LCD_FILES_TASK_NUM = 4;
+constexpr size_t PARALLEL_DELETE_MIN_SIZE = 64;
+// 空间紧张时单次老化的最长时间
+constexpr int64_t PRESSURE_AGING_MAX_SECONDS = 300;
 
 LcdAgingManager& LcdAgingManager::GetInstance()
 {
@@ -85,6 +96,12 @@ int32_t LcdAgingManager::ReadyAgingLcd()
     this->totalAgingLcdNumber_ = 0;
     this->lastAgingProgress_ = 0;
     this->notAgingFileIds_.clear();
+    this->freedLcdBytes_ = 0;
+    this->freeBytesTarget_ = LcdAgingUtils::GetFreeBytesTarget(MediaFileUtils::GetTotalSize(),
+        MediaFileUtils::GetFreeSize());
+    this->agingDeadline_ = this->freeBytesTarget_ > 0 ? this->startTime_ + PRESSURE_AGING_MAX_SECONDS : 0;
+    MEDIA_INFO_LOG("freeBytesTarget: %{public}" PRId64 ", agingDeadline: %{public}" PRId64,
+        this->freeBytesTarget_, this->agingDeadline_);
     dfxManager->HandleAgingLcdContinue();
     return E_OK;
 }
@@ -150,7 +167,8 @@ int32_t LcdAgingManager::ExecuteAgingLoop(const std::atomic<bool> &shouldStop)
         ret = ExecuteSingleBatch(excessSize, hasTrashedData, shouldStop);
         CHECK_AND_PRINT_LOG(ret == E_OK, "failed to BatchAgingLcdFile, ret: %{public}d", ret);
 
-        bool shouldBreak = (ret == E_NO_QUERY_DATA || ret == E_AGING_STOP || ret == E_AGING_INTERRUPT);
+        bool shouldBreak = (ret == E_NO_QUERY_DATA || ret == E_AGING_STOP || ret == E_AGING_INTERRUPT ||
+            ret == E_AGING_TARGET_REACHED || ret == E_AGING_TIMEOUT);
         CHECK_AND_BREAK_INFO_LOG(!shouldBreak, "break aging lcd task, ret: %{public}d", ret);
 
         MEDIA_INFO_LOG("batch aging lcdFile, hasAgingLcdNumber: %{public}" PRId64 ", totalAgingLcdNumber: %{public}"
@@ -191,6 +209,7 @@ int32_t LcdAgingManager::BatchAgingLcdFileTrashed(const int32_t size, const std:
     int32_t ret = this->lcdAgingDao_.QueryAgingLcdDataTrashed(size, this->notAgingFileIds_, lcdAgingFileInfoList);
     CHECK_AND_RETURN_RET_LOG(ret == E_OK, E_ERR, "Failed to QueryAgingLcdDataTrashed, ret: %{public}d", ret);
     CHECK_AND_RETURN_RET_LOG(!lcdAgingFileInfoList.empty(), E_NO_QUERY_DATA, "no aging lcd data (trashed)");
+    LcdAgingUtils::SortByAgingPriority(lcdAgingFileInfoList);
     ret = this->DoBatchAgingLcdFile(lcdAgingFileInfoList, shouldStop);
     CHECK_AND_PRINT_LOG(ret == E_OK, "Failed to DoBatchAgingLcdFile, ret: %{public}d", ret);
     return ret;
@@ -204,6 +223,7 @@ int32_t LcdAgingManager::BatchAgingLcdFileNotTrashed(const int32_t size, const s
     int32_t ret = this->lcdAgingDao_.QueryAgingLcdDataNotTrashed(size, this->notAgingFileIds_, lcdAgingFileInfoList);
     CHECK_AND_RETURN_RET_LOG(ret == E_OK, E_ERR, "Failed to QueryAgingLcdDataNotTrashed, ret: %{public}d", ret);
     CHECK_AND_RETURN_RET_LOG(!lcdAgingFileInfoList.empty(), E_NO_QUERY_DATA, "no aging lcd data (not trashed)");
+    LcdAgingUtils::SortByAgingPriority(lcdAgingFileInfoList);
     ret = this->DoBatchAgingLcdFile(lcdAgingFileInfoList, shouldStop);
     CHECK_AND_PRINT_LOG(ret == E_OK, "Failed to DoBatchAgingLcdFile, ret: %{public}d", ret);
     return ret;
@@ -222,6 +242,8 @@ int32_t LcdAgingManager::DoBatchAgingLcdFile(const std::vector<LcdAgingFileInfo>
     for (size_t offset = 0; offset < totalSize; offset += BATCH_AGING_SIZE) {
         ret = CheckLcdAgingStatus(shouldStop);
         CHECK_AND_RETURN_RET(ret == E_OK, ret);
+        ret = CheckFreeBytesTarget();
+        CHECK_AND_RETURN_RET(ret == E_OK, ret);
 
         size_t batchSize = std::min(BATCH_AGING_SIZE, totalSize - offset);
 
@@ -361,7 +383,8 @@ int32_t LcdAgingManager::GetNeedAgingLcdSize(int64_t &taskSize)
 
 int32_t LcdAgingManager::FinishAgingTask()
 {
-    MEDIA_INFO_LOG("start FinishAgingTask, notAgingFileIds_ size: %{public}zu", this->notAgingFileIds_.size());
+    MEDIA_INFO_LOG("start FinishAgingTask, notAgingFileIds_ size: %{public}zu, freedLcdBytes: %{public}" PRId64,
+        this->notAgingFileIds_.size(), this->freedLcdBytes_.load());
     auto dfxManager = DfxManager::GetInstance();
     // 打点上报
     int32_t totalSize = MediaFileUtils::GetTotalSize() / DIVISOR;
@@ -377,6 +400,8 @@ int32_t LcdAgingManager::FinishAgingTask()
     this->lastAgingProgress_ = 0;
     this->freeSizeOld_ = 0;
     this->notAgingFileIds_.clear();
+    this->freeBytesTarget_ = 0;
+    this->agingDeadline_ = 0;
     MEDIA_INFO_LOG("end FinishAgingTask");
     return E_FINISH;
 }
@@ -431,7 +456,11 @@ void LcdAgingManager::AsyncDeleteLcdFiles(const std::vector<LcdAgingFileInfo> &l
 {
     bool needStartWorker = false;
     {
-        std::lock_guard<std::mutex> lock(deleteLcdFilesTaskMutex_);
+        std::unique_lock<std::mutex> lock(deleteLcdFilesTaskMutex_);
+        // 队列非空时删除线程一定在运行, 等待其取走任务
+        deleteLcdFilesSpaceCv_.wait(lock, [this]() {
+            return deleteLcdFilesTaskQueue_.size() < MAX_PENDING_DELETE_TASKS;
+        });
         deleteLcdFilesTaskQueue_.push({lcdAgingFileInfoList, failFileIds});
         if (!isDeleteLcdFilesWorkerRunning_) {
             isDeleteLcdFilesWorkerRunning_ = true;
@@ -464,6 +493,7 @@ void LcdAgingManager::ProcessDeleteLcdFilesTasks()
             task = std::move(deleteLcdFilesTaskQueue_.front());
             deleteLcdFilesTaskQueue_.pop();
         }
+        deleteLcdFilesSpaceCv_.notify_all();
         ExecuteDeleteLcdFiles(task);
     }
     MEDIA_INFO_LOG("End ProcessDeleteLcdFilesTasks thread");
@@ -473,20 +503,40 @@ void LcdAgingManager::ExecuteDeleteLcdFiles(const DeleteLcdFilesTask &task)
 {
     MediaLibraryTracer tracer;
     tracer.Start("AsyncDeleteLocalLcdFiles");
+    std::unordered_set<std::string> failFileIds(task.failFileIds.begin(), task.failFileIds.end());
+    std::vector<const LcdAgingFileInfo *> deleteFileInfos;
     std::vector<std::pair<std::string, std::string>> thumbnailSizeUpdateList;
     for (const auto &agingFileInfo : task.agingFileInfos) {
-        bool isValid = std::find(task.failFileIds.begin(), task.failFileIds.end(),
-            std::to_string(agingFileInfo.fileId)) == task.failFileIds.end();
-        CHECK_AND_CONTINUE(isValid);
-
-        CHECK_AND_EXECUTE(!agingFileInfo.hasExThumbnail,
-            DeleteLocalFile(agingFileInfo.localLcdExPath));
-        DeleteLocalFile(agingFileInfo.localLcdPath);
-        thumbnailSizeUpdateList.emplace_back(std::to_string(agingFileInfo.fileId), agingFileInfo.path);
+        std::string fileId = std::to_string(agingFileInfo.fileId);
+        CHECK_AND_CONTINUE(failFileIds.count(fileId) == 0);
+        deleteFileInfos.emplace_back(&agingFileInfo);
+        thumbnailSizeUpdateList.emplace_back(std::move(fileId), agingFileInfo.path);
+    }
+
+    std::atomic<size_t> cursor {0};
+    auto deleteFiles = [this, &deleteFileInfos, &cursor]() {
+        for (size_t i = cursor++; i < deleteFileInfos.size(); i = cursor++) {
+            const LcdAgingFileInfo &agingFileInfo = *deleteFileInfos[i];
+            CHECK_AND_EXECUTE(!agingFileInfo.hasExThumbnail,
+                DeleteLocalFile(agingFileInfo.localLcdExPath));
+            CHECK_AND_CONTINUE(DeleteLocalFile(agingFileInfo.localLcdPath) == E_OK);
+            this->freedLcdBytes_ += agingFileInfo.lcdFileSize;
+        }
+    };
+    // unlink 主要耗时在文件系统元数据更新, 文件较多时分给ffrt任务并行删除, 当前线程也参与
+    bool isParallel = deleteFileInfos.size() >= PARALLEL_DELETE_MIN_SIZE;
+    if (isParallel) {
+        for (size_t i = 1; i < DELETE_LCD_FILES_TASK_NUM; ++i) {
+            ffrt::submit(deleteFiles, {}, {}, ffrt::task_attr().qos(static_cast<int32_t>(ffrt::qos_utility)));
+        }
     }
+    deleteFiles();
+    CHECK_AND_EXECUTE(!isParallel, ffrt::wait());
+
     CHECK_AND_EXECUTE(thumbnailSizeUpdateList.empty(),
         MediaLibraryPhotoOperations::BatchStoreThumbnailSize(thumbnailSizeUpdateList));
-    MEDIA_INFO_LOG("AsyncDeleteLocalLcdFiles completed, count: %{public}zu", task.agingFileInfos.size());
+    MEDIA_INFO_LOG("AsyncDeleteLocalLcdFiles completed, count: %{public}zu, freedLcdBytes: %{public}" PRId64,
+        task.agingFileInfos.size(), this->freedLcdBytes_.load());
 }
 
 int32_t LcdAgingManager::StartDeepOptimizeSpace(const sptr<IRemoteObject> &clientRemote,
@@ -569,13 +619,15 @@ void LcdAgingManager::HandleAfterAgingProgress(const int32_t errorCode)
 {
     switch (errorCode) {
         case E_NO_QUERY_DATA:
-            // 没有可以老化的LCD，上报100%进度
+        case E_AGING_TARGET_REACHED:
+            // 没有可以老化的LCD或已释放足够空间，上报100%进度
             LcdAgingWorker::GetInstance().NotifyProgress(DeepOptimizeSpaceState::COMPLETED, MAX_PROGRESS);
             break;
         case E_AGING_STOP:
             LcdAgingWorker::GetInstance().NotifyProgress(DeepOptimizeSpaceState::STOPPED, this->lastAgingProgress_);
             break;
         case E_AGING_INTERRUPT:
+        case E_AGING_TIMEOUT:
             LcdAgingWorker::GetInstance().NotifyProgress(DeepOptimizeSpaceState::INTERRUPTED, this->lastAgingProgress_);
             break;
         default:
@@ -668,6 +720,19 @@ int32_t LcdAgingManager::CheckLcdAgingTargetReached(int32_t &excessSize)
     return E_OK;
 }
 
+int32_t LcdAgingManager::CheckFreeBytesTarget()
+{
+    CHECK_AND_RETURN_RET(this->freeBytesTarget_ > 0, E_OK);
+    int64_t freedLcdBytes = this->freedLcdBytes_.load();
+    CHECK_AND_RETURN_RET_INFO_LOG(freedLcdBytes < this->freeBytesTarget_, E_AGING_TARGET_REACHED,
+        "free bytes target reached, freed: %{public}" PRId64 ", target: %{public}" PRId64,
+        freedLcdBytes, this->freeBytesTarget_);
+    CHECK_AND_RETURN_RET_WARN_LOG(MediaFileUtils::UTCTimeSeconds() < this->agingDeadline_, E_AGING_TIMEOUT,
+        "aging deadline exceeded, freed: %{public}" PRId64 ", target: %{public}" PRId64,
+        freedLcdBytes, this->freeBytesTarget_);
+    return E_OK;
+}
+
 void LcdAgingManager::StartCallbackTimer()
 {
     if (callbackTimerId_ != 0) {
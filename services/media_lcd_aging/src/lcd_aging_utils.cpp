@@ -16,7 +16,9 @@
 
 #include "lcd_aging_utils.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
 #include <map>
 
 #include "exif_rotate_utils.h"
@@ -34,6 +36,12 @@ const std::string DENTRY_INFO_LCD_EX = "THM_EX/LCD";
 const std::string DENTRY_INFO_LCD = "LCD";
 const std::string FILE_NAME_LCD = "LCD.jpg";
 const int64_t THUMB_DENTRY_SIZE = 2 * 1024 * 1024;
+constexpr int64_t ONE_DAY_MS = 24LL * 60 * 60 * 1000;
+// 未知大小的LCD按平均大小估算, 避免排到最后
+constexpr int32_t DEFAULT_LCD_FILE_SIZE = 200 * 1024;
+// 剩余空间低于总空间的该比例时视为空间紧张
+constexpr int64_t LOW_SPACE_PERCENT = 10;
+constexpr int64_t PERCENT_BASE = 100;
 
 int64_t LcdAgingUtils::GetMaxThresholdOfLcd()
 {
@@ -68,4 +76,41 @@ bool LcdAgingUtils::HasExThumbnail(const LcdAgingFileInfo &agingFileInfo)
     return (agingFileInfo.mediaType == MediaType::MEDIA_TYPE_IMAGE) &&
         (agingFileInfo.orientation != 0 || agingFileInfo.exifRotate > static_cast<int32_t>(ExifRotateType::TOP_LEFT));
 }
-}  // namespace OHOS::Media
\ No newline at end of file
+
+double LcdAgingUtils::GetAgingPriority(const LcdAgingFileInfo &agingFileInfo, const int64_t currentTime)
+{
+    int32_t fileSize = agingFileInfo.lcdFileSize > 0 ? agingFileInfo.lcdFileSize : DEFAULT_LCD_FILE_SIZE;
+    int64_t idleTime = std::max<int64_t>(currentTime - agingFileInfo.lcdVisitTime, 0);
+    double idleDays = static_cast<double>(idleTime) / ONE_DAY_MS;
+    int32_t visitCount = std::max(agingFileInfo.lcdVisitCount, 0);
+    // 闲置时间取对数, 避免极久未访问的小文件压过大文件
+    return static_cast<double>(fileSize) * (1.0 + std::log2(1.0 + idleDays)) / (1.0 + visitCount);
+}
+
+void LcdAgingUtils::SortByAgingPriority(std::vector<LcdAgingFileInfo> &agingFileInfos)
+{
+    CHECK_AND_RETURN(agingFileInfos.size() > 1);
+    int64_t currentTime = MediaFileUtils::UTCTimeMilliSeconds();
+    std::vector<std::pair<double, size_t>> priorities;
+    priorities.reserve(agingFileInfos.size());
+    for (size_t i = 0; i < agingFileInfos.size(); ++i) {
+        priorities.emplace_back(GetAgingPriority(agingFileInfos[i], currentTime), i);
+    }
+    std::stable_sort(priorities.begin(), priorities.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+
+    std::vector<LcdAgingFileInfo> sortedInfos;
+    sortedInfos.reserve(agingFileInfos.size());
+    for (const auto &priority : priorities) {
+        sortedInfos.emplace_back(std::move(agingFileInfos[priority.second]));
+    }
+    agingFileInfos = std::move(sortedInfos);
+}
+
+int64_t LcdAgingUtils::GetFreeBytesTarget(const int64_t totalSize, const int64_t freeSize)
+{
+    CHECK_AND_RETURN_RET(totalSize > 0 && freeSize >= 0, 0);
+    int64_t lowSpaceSize = totalSize / PERCENT_BASE * LOW_SPACE_PERCENT;
+    return freeSize < lowSpaceSize ? lowSpaceSize - freeSize : 0;
+}
+}  // namespace OHOS::Media
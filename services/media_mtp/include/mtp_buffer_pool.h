@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORKS_SERVICES_MEDIA_MTP_INCLUDE_MTP_BUFFER_POOL_H_
+#define FRAMEWORKS_SERVICES_MEDIA_MTP_INCLUDE_MTP_BUFFER_POOL_H_
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+
+// Recycles the byte vectors used to assemble and receive MTP containers, so that a long
+// GetObjectPropList/GetObjectHandles session does not hit the allocator for every packet.
+class MtpBufferPool {
+public:
+    EXPORT static MtpBufferPool &GetInstance();
+    // returns an empty buffer whose capacity is at least minCapacity
+    EXPORT std::vector<uint8_t> Acquire(size_t minCapacity);
+    // hands a buffer back, oversized buffers and buffers beyond the pool limit are freed
+    EXPORT void Release(std::vector<uint8_t> &&buffer);
+    EXPORT size_t GetIdleCount();
+    EXPORT void Clear();
+
+    static constexpr size_t MAX_IDLE_BUFFERS = 8;
+    static constexpr size_t MAX_POOLED_CAPACITY = 256 * 1024;
+
+private:
+    MtpBufferPool() = default;
+    ~MtpBufferPool() = default;
+
+    std::mutex mutex_;
+    std::vector<std::vector<uint8_t>> idleBuffers_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif  // FRAMEWORKS_SERVICES_MEDIA_MTP_INCLUDE_MTP_BUFFER_POOL_H_
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FRAMEWORKS_SERVICES_MEDIA_MTP_INCLUDE_MTP_FILE_IO_UTILS_H_
+#define FRAMEWORKS_SERVICES_MEDIA_MTP_INCLUDE_MTP_FILE_IO_UTILS_H_
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+
+// Object data itself goes to the usbfn HDI by fd, these cover the parts that pass through this process.
+class MtpFileIoUtils {
+public:
+    // writes a chunk already in memory, such as the data that came with the first SendObject packet
+    EXPORT static int32_t WriteAll(int fd, const uint8_t *data, size_t size);
+    // starts reading [offset, offset + length) into the page cache so that the next GetPartialObject
+    // of a sequential reader finds its data there while the current one is still on the bus
+    EXPORT static void ReadAhead(int fd, int64_t offset, int64_t length);
+};
+} // namespace Media
+} // namespace OHOS
+#endif  // FRAMEWORKS_SERVICES_MEDIA_MTP_INCLUDE_MTP_FILE_IO_UTILS_H_
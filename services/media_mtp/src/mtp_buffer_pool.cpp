@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mtp_buffer_pool.h"
+
+namespace OHOS {
+namespace Media {
+MtpBufferPool &MtpBufferPool::GetInstance()
+{
+    static MtpBufferPool instance;
+    return instance;
+}
+
+std::vector<uint8_t> MtpBufferPool::Acquire(size_t minCapacity)
+{
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // prefer the smallest idle buffer that already fits, otherwise grow the largest one
+        size_t picked = idleBuffers_.size();
+        for (size_t i = 0; i < idleBuffers_.size(); i++) {
+            if (picked == idleBuffers_.size()) {
+                picked = i;
+                continue;
+            }
+            size_t capacity = idleBuffers_[i].capacity();
+            size_t pickedCapacity = idleBuffers_[picked].capacity();
+            bool better = (pickedCapacity >= minCapacity) ?
+                (capacity >= minCapacity && capacity < pickedCapacity) : (capacity > pickedCapacity);
+            picked = better ? i : picked;
+        }
+        if (picked < idleBuffers_.size()) {
+            buffer.swap(idleBuffers_[picked]);
+            idleBuffers_[picked].swap(idleBuffers_.back());
+            idleBuffers_.pop_back();
+        }
+    }
+    buffer.clear();
+    buffer.reserve(minCapacity);
+    return buffer;
+}
+
+void MtpBufferPool::Release(std::vector<uint8_t> &&buffer)
+{
+    if (buffer.capacity() == 0 || buffer.capacity() > MAX_POOLED_CAPACITY) {
+        std::vector<uint8_t>().swap(buffer);
+        return;
+    }
+    buffer.clear();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idleBuffers_.size() >= MAX_IDLE_BUFFERS) {
+        std::vector<uint8_t>().swap(buffer);
+        return;
+    }
+    idleBuffers_.push_back(std::move(buffer));
+}
+
+size_t MtpBufferPool::GetIdleCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idleBuffers_.size();
+}
+
+void MtpBufferPool::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::vector<uint8_t>>().swap(idleBuffers_);
+}
+} // namespace Media
+} // namespace OHOS
@@ -18,6 +18,7 @@
 #include "media_log.h"
 #include "media_mtp_utils.h"
 #include "medialibrary_tracer.h"
+#include "mtp_buffer_pool.h"
 #include "mtp_dfx_reporter.h"
 #include "mtp_operation_utils.h"
 #include "mtp_packet_tools.h"
@@ -95,6 +96,10 @@ int MtpDriver::Read(std::vector<uint8_t> &outBuffer, uint32_t &outReadSize)
     }
 
     MEDIA_DEBUG_LOG("MtpDriver::Read start");
+    if (outBuffer.capacity() < outReadSize) {
+        MtpBufferPool::GetInstance().Release(std::move(outBuffer));
+        outBuffer = MtpBufferPool::GetInstance().Acquire(outReadSize);
+    }
     outBuffer.resize(outReadSize);
 
     tracer.Start("MTP usbfnMtpInterface->Read");
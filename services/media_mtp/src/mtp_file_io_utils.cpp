@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define MLOG_TAG "MtpFileIoUtils"
+#include "mtp_file_io_utils.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include "media_log.h"
+#include "medialibrary_errno.h"
+
+namespace OHOS {
+namespace Media {
+int32_t MtpFileIoUtils::WriteAll(int fd, const uint8_t *data, size_t size)
+{
+    CHECK_AND_RETURN_RET(size > 0, MTP_SUCCESS);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0 && data != nullptr, MTP_ERROR_INCOMPLETE_TRANSFER, "WriteAll invalid param");
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = write(fd, data + written, size - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        CHECK_AND_RETURN_RET_LOG(ret > 0, MTP_ERROR_INCOMPLETE_TRANSFER, "write error = %{public}d", errno);
+        written += static_cast<size_t>(ret);
+    }
+    return MTP_SUCCESS;
+}
+
+void MtpFileIoUtils::ReadAhead(int fd, int64_t offset, int64_t length)
+{
+    CHECK_AND_RETURN(fd >= 0 && offset >= 0 && length > 0);
+    int ret = posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+    CHECK_AND_PRINT_LOG(ret == 0, "ReadAhead fadvise error = %{public}d", ret);
+}
+} // namespace Media
+} // namespace OHOS
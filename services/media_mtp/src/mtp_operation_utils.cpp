@@ -25,6 +25,7 @@
 #include "media_log.h"
 #include "media_mtp_utils.h"
 #include "mtp_dfx_reporter.h"
+#include "mtp_file_io_utils.h"
 #include "mtp_manager.h"
 #include "mtp_packet_tools.h"
 #include "mtp_operation_context.h"
@@ -344,6 +345,10 @@ uint16_t MtpOperationUtils::GetObjectDataDeal()
     }
     object.command = context_->operationCode;
     object.transaction_id = context_->transactionID;
+    if (context_->operationCode == MTP_OPERATION_GET_PARTIAL_OBJECT_CODE) {
+        // hosts read large objects window by window, the next window is read from disk while this one is sent
+        MtpFileIoUtils::ReadAhead(fd, object.offset + object.length, object.length);
+    }
     result = context_->mtpDriver->SendObj(object);
     PreDealFd(result < 0, fd);
     CHECK_AND_RETURN_RET_LOG(result >= 0, MTP_ERROR_INCOMPLETE_TRANSFER,
@@ -397,9 +402,9 @@ int32_t MtpOperationUtils::DoRecevieSendObject()
     CHECK_AND_RETURN_RET_LOG(errorCode == MTP_SUCCESS, errorCode, "DoRecevieSendObject GetFd fail!");
 
     uint32_t initialData = dataBuffer.size() < HEADER_LEN  ? 0 : dataBuffer.size() - HEADER_LEN;
-    errorCode = write(fd, &dataBuffer[HEADER_LEN], initialData);
-    PreDealFd(errorCode < 0, fd);
-    CHECK_AND_RETURN_RET_LOG(errorCode >= 0, MTP_ERROR_RESPONSE_GENERAL,
+    errorCode = MtpFileIoUtils::WriteAll(fd, dataBuffer.data() + (dataBuffer.size() - initialData), initialData);
+    PreDealFd(errorCode != MTP_SUCCESS, fd);
+    CHECK_AND_RETURN_RET_LOG(errorCode == MTP_SUCCESS, MTP_ERROR_RESPONSE_GENERAL,
         "DoRecevieSendObject write error = %{public}d", errno);
 
     MtpFileRange object;
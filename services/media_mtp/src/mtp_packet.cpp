@@ -13,8 +13,10 @@
 * limitations under the License.
 */
 #include "mtp_packet.h"
+#include <algorithm>
 #include "media_log.h"
 #include "media_mtp_utils.h"
+#include "mtp_buffer_pool.h"
 #include "mtp_constants.h"
 #include "packet_payload_factory.h"
 using namespace std;
@@ -22,6 +24,15 @@ namespace OHOS {
 namespace Media {
 const int EVENT_LENGTH = 16;
 const uint32_t BATCH_SIZE = 200000;
+const uint32_t CONTAINER_LENGTH_BYTES = 4;
+const uint32_t BITS_PER_BYTE = 8;
+
+static void PatchContainerLength(std::vector<uint8_t> &buffer, size_t offset, uint32_t length)
+{
+    for (uint32_t i = 0; i < CONTAINER_LENGTH_BYTES; i++) {
+        buffer[offset + i] = static_cast<uint8_t>((length >> (i * BITS_PER_BYTE)) & 0xFF);
+    }
+}
 
 MtpPacket::MtpPacket(std::shared_ptr<MtpOperationContext> &context)
     : context_(context), readSize_(0), headerData_(nullptr), payloadData_(nullptr)
@@ -35,6 +46,8 @@ MtpPacket::MtpPacket(std::shared_ptr<MtpOperationContext> &context, const shared
 
 MtpPacket::~MtpPacket()
 {
+    MtpBufferPool::GetInstance().Release(std::move(readBuffer_));
+    MtpBufferPool::GetInstance().Release(std::move(writeBuffer_));
 }
 
 void MtpPacket::Init(std::shared_ptr<HeaderData> &headerData)
@@ -72,7 +85,8 @@ void MtpPacket::Reset()
     readSize_ = 0;
     headerData_ = nullptr;
     payloadData_ = nullptr;
-    std::vector<uint8_t>().swap(writeBuffer_);
+    MtpBufferPool::GetInstance().Release(std::move(writeBuffer_));
+    writeBuffer_.clear();
 }
 
 void MtpPacket::Stop()
@@ -129,7 +143,8 @@ int MtpPacket::Read()
     CHECK_AND_RETURN_RET_LOG(mtpDriver_ != nullptr,
         MTP_ERROR_DRIVER_OPEN_FAILED, "Read failed, mtpDriver_ is nullptr");
 
-    std::vector<uint8_t>().swap(readBuffer_);
+    // keep the capacity of the previous container, the driver only resizes within it
+    readBuffer_.clear();
     int errorCode = mtpDriver_->Read(readBuffer_, readSize_);
     return errorCode;
 }
@@ -151,12 +166,14 @@ int MtpPacket::Write(int32_t &result)
     // when the write buffer is too large, it needs to be split into multiple calls.
     if (writeBuffer_.size() > BATCH_SIZE) {
         uint32_t total = writeBuffer_.size();
-        for (uint32_t i = 0; i < writeBuffer_.size(); i += BATCH_SIZE) {
+        std::vector<uint8_t> batch = MtpBufferPool::GetInstance().Acquire(BATCH_SIZE);
+        for (uint32_t i = 0; i < total; i += BATCH_SIZE) {
             uint32_t end = std::min(i + BATCH_SIZE, total);
-            std::vector<uint8_t> batch(writeBuffer_.begin() + i, writeBuffer_.begin() + end);
-            mtpDriver_->Write(batch, end, result);
-            std::vector<uint8_t>().swap(batch);
+            uint32_t batchSize = end - i;
+            batch.assign(writeBuffer_.begin() + i, writeBuffer_.begin() + end);
+            mtpDriver_->Write(batch, batchSize, result);
         }
+        MtpBufferPool::GetInstance().Release(std::move(batch));
     } else {
         mtpDriver_->Write(writeBuffer_, writeSize_, result);
     }
@@ -178,14 +195,25 @@ int MtpPacket::Maker(bool isPayload)
     CHECK_AND_RETURN_RET_LOG(payloadData_ != nullptr, MTP_FAIL, "Maker failed, payloadData_ is nullptr");
     CHECK_AND_RETURN_RET_LOG(headerData_ != nullptr, MTP_FAIL, "Maker failed, headerData_ is nullptr");
 
-    writeSize_ = payloadData_->CalculateSize() + PACKET_HEADER_LENGETH;
-    headerData_->SetContainerLength(writeSize_);
+    if (writeBuffer_.capacity() == 0) {
+        writeBuffer_ = MtpBufferPool::GetInstance().Acquire(std::max(writeSize_, READ_BUFFER_MAX_SIZE));
+    }
+    // assemble header and payload in one pass and patch the container length afterwards,
+    // instead of building the payload once more just to learn its size
+    size_t headerOffset = writeBuffer_.size();
+    headerData_->SetContainerLength(PACKET_HEADER_LENGETH);
 
     int errorCode = MakeHead();
     CHECK_AND_RETURN_RET_LOG(errorCode == MTP_SUCCESS, errorCode, "MakeHead fail err: %{public}d", errorCode);
 
     errorCode = MakerPayload();
     CHECK_AND_RETURN_RET_LOG(errorCode == MTP_SUCCESS, errorCode, "MakeHead fail err: %{public}d", errorCode);
+    CHECK_AND_RETURN_RET_LOG(writeBuffer_.size() >= headerOffset + PACKET_HEADER_LENGETH, MTP_FAIL,
+        "Maker failed, header is missing");
+
+    writeSize_ = static_cast<uint32_t>(writeBuffer_.size() - headerOffset);
+    headerData_->SetContainerLength(writeSize_);
+    PatchContainerLength(writeBuffer_, headerOffset, writeSize_);
     return MTP_SUCCESS;
 }
 
@@ -16,6 +16,8 @@
 #ifndef OHOS_MEDIA_OBSERVER_MANAGER_H
 #define OHOS_MEDIA_OBSERVER_MANAGER_H
 
+#include <map>
+#include <memory>
 #include <mutex>
 
 #include "i_observer_manager_interface.h"
@@ -30,6 +32,22 @@ namespace Notification {
 
 using UriOperation = std::function<void(std::unordered_set<std::string>&, const std::string&)>;
 
+// 单个uri的注册表只读快照, 只在该uri的注册变更时重建
+struct ObserverBucket {
+    std::vector<ObserverInfo> observers;
+    // 单资产/单相册id -> 该id在observers中的下标
+    std::unordered_map<std::string, std::vector<size_t>> singleIdIndex;
+    // callingTokenId -> 该应用注册的observer个数
+    std::unordered_map<uint32_t, size_t> tokenCounts;
+    // 所有observer监听的singleId总数
+    size_t singleListenSize = 0;
+};
+
+// 注册表的只读快照, 注册变更时只重建变更uri的bucket, 其余bucket与上一个快照共享, 分发线程持有后无需加锁
+struct ObserverSnapshot {
+    std::unordered_map<NotifyUriType, std::shared_ptr<const ObserverBucket>> buckets;
+};
+
 class MediaObserverManager : public Notification::IObserverManager {
 public:
     EXPORT MediaObserverManager();
@@ -60,13 +78,21 @@ public:
         const std::string &singleId);
     EXPORT bool CheckSingleListenSize(const NotifyUriType &registerUri);
     EXPORT bool CheckSingleProcessSize(const NotifyUriType &registerUri);
+    EXPORT std::shared_ptr<const ObserverSnapshot> GetObserverSnapshot();
+    EXPORT std::shared_ptr<const ObserverBucket> GetObserverBucket(const NotifyUriType &uri);
+    EXPORT std::vector<ObserverInfo> FindObserverBySingleId(const NotifyUriType &uri, const std::string &singleId);
 private:
     int32_t RemoveObsDeathRecipient(const wptr<IRemoteObject> &object);
+    // 调用方需持有mutex_, 只重建uris对应的bucket
+    void PublishSnapshotLocked(const std::unordered_set<NotifyUriType> &uris);
     void ExeForReconnect(const NotifyUriType &registerUri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver);
 
 private:
     std::mutex mutex_;
     std::unordered_map<NotifyUriType, std::vector<ObserverInfo>> observers_;
+    // 客户端 -> 其注册过的uri, 客户端死亡时只遍历这些uri
+    std::map<IRemoteObject *, std::unordered_set<NotifyUriType>> callerUris_;
+    std::shared_ptr<const ObserverSnapshot> snapshot_ = std::make_shared<const ObserverSnapshot>();
     std::map<sptr<IRemoteObject>, sptr<ObserverCallbackRecipient>> obsCallbackPecipients_;
     static std::shared_ptr<Media::Notification::MediaObserverManager> observerManager_;
     static std::mutex instanceMutex_;
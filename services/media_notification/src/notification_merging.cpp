@@ -60,6 +60,23 @@ std::vector<ObserverInfo> NotificationMerging::findObservers(NotifyUriType notif
     return manager->FindObserver(notifyUriType);
 }
 
+static bool HasObservedSingleId(const std::shared_ptr<const ObserverBucket> &bucket,
+    const std::vector<std::variant<PhotoAssetChangeData, AlbumChangeData>> &innerChanges)
+{
+    CHECK_AND_RETURN_RET(bucket != nullptr, false);
+    const auto &singleIdIndex = bucket->singleIdIndex;
+    for (const auto &it : innerChanges) {
+        if (const auto *photoData = std::get_if<PhotoAssetChangeData>(&it)) {
+            CHECK_AND_RETURN_RET(singleIdIndex.count(to_string(photoData->infoBeforeChange_.fileId_)) == 0 &&
+                singleIdIndex.count(to_string(photoData->infoAfterChange_.fileId_)) == 0, true);
+        } else if (const auto *albumData = std::get_if<AlbumChangeData>(&it)) {
+            CHECK_AND_RETURN_RET(singleIdIndex.count(to_string(albumData->infoBeforeChange_.albumId_)) == 0 &&
+                singleIdIndex.count(to_string(albumData->infoAfterChange_.albumId_)) == 0, true);
+        }
+    }
+    return false;
+}
+
 static void FilterSingleChanges(MediaChangeInfo& outerElem, std::vector<NotifyInfo>& notifyInfos,
     std::shared_ptr<Notification::MediaObserverManager> manager, bool isPhotoAsset)
 {
@@ -67,6 +84,8 @@ static void FilterSingleChanges(MediaChangeInfo& outerElem, std::vector<NotifyIn
     CHECK_AND_RETURN_LOG(!innerChanges.empty(), "FilterSingleChanges: innerChanges is empty, skip");
     const NotifyUriType notifyUri = isPhotoAsset ?
         NotifyUriType::SINGLE_PHOTO_URI : NotifyUriType::SINGLE_PHOTO_ALBUM_URI;
+    // 按id索引先判断本批变更是否有被单独监听的资产/相册, 没有则无需逐个observer比对
+    CHECK_AND_RETURN(HasObservedSingleId(manager->GetObserverBucket(notifyUri), innerChanges));
     Notification::NotifyUriType sourceUri = isPhotoAsset ?
         NotifyUriType::PHOTO_URI : NotifyUriType::PHOTO_ALBUM_URI;
     std::vector<ObserverInfo> obsInfos = manager->FindObserver(notifyUri);
@@ -78,6 +78,8 @@ int32_t MediaObserverManager::AddObserver(const NotifyUriType &uri,
     std::lock_guard<std::mutex> lock(mutex_);
     if (observers_.find(uri) == observers_.end()) {
         observers_[uri].push_back(obsInfo);
+        callerUris_[dataObserver->AsObject().GetRefPtr()].insert(uri);
+        PublishSnapshotLocked({ uri });
     } else {
         auto it = std::find_if(observers_[uri].begin(), observers_[uri].end(),
         [dataObserver](const ObserverInfo& obsInfo) {
@@ -85,6 +87,8 @@ int32_t MediaObserverManager::AddObserver(const NotifyUriType &uri,
         });
         if (it == observers_[uri].end()) {
             observers_[uri].push_back(obsInfo);
+            callerUris_[dataObserver->AsObject().GetRefPtr()].insert(uri);
+            PublishSnapshotLocked({ uri });
         } else {
             MEDIA_INFO_LOG("the uri has already been registered with the same observer");
             return E_DATAOBSERVER_IS_REPEATED;
@@ -116,22 +120,26 @@ int32_t MediaObserverManager::RemoveObserver(const wptr<IRemoteObject> &object)
     }
 
     std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<NotifyUriType> deleteUris;
-    for (auto it = observers_.begin(); it != observers_.end(); ++it) {
-        auto index = std::find_if(it->second.begin(), it->second.end(),
-        [object](const ObserverInfo& s) {
-            return s.observer->AsObject() == object;
-        });
-        if (index != it->second.end()) {
-            it->second.erase(index);
-            MEDIA_INFO_LOG("RemoveObserver, uri is %{public}d", static_cast<int>(it->first));
-        }
-        if (it->second.empty() && observers_.find(it->first) != observers_.end()) {
-            deleteUris.push_back(it->first);
+    // 只遍历该客户端注册过的uri, 不再扫描整张注册表
+    auto callerIter = callerUris_.find(object.promote().GetRefPtr());
+    if (callerIter != callerUris_.end()) {
+        for (const auto &uri : callerIter->second) {
+            auto it = observers_.find(uri);
+            CHECK_AND_CONTINUE(it != observers_.end());
+            auto index = std::find_if(it->second.begin(), it->second.end(),
+                [object](const ObserverInfo& s) {
+                    return s.observer->AsObject() == object;
+                });
+            if (index != it->second.end()) {
+                it->second.erase(index);
+                MEDIA_INFO_LOG("RemoveObserver, uri is %{public}d", static_cast<int>(it->first));
+            }
+            if (it->second.empty()) {
+                observers_.erase(it);
+            }
         }
-    }
-    for (const auto &it: deleteUris) {
-        observers_.erase(it);
+        PublishSnapshotLocked(callerIter->second);
+        callerUris_.erase(callerIter);
     }
     int32_t ret = RemoveObsDeathRecipient(object);
     if (ret != E_OK) {
@@ -156,15 +164,51 @@ int32_t MediaObserverManager::RemoveObsDeathRecipient(const wptr<IRemoteObject>
     return E_OK;
 }
 
+void MediaObserverManager::PublishSnapshotLocked(const std::unordered_set<NotifyUriType> &uris)
+{
+    // 只拷贝bucket指针, 未变更uri的bucket与上一个快照共享
+    auto snapshot = std::make_shared<ObserverSnapshot>(*GetObserverSnapshot());
+    for (const auto &uri : uris) {
+        auto observersIter = observers_.find(uri);
+        if (observersIter == observers_.end()) {
+            snapshot->buckets.erase(uri);
+            continue;
+        }
+        auto bucket = std::make_shared<ObserverBucket>();
+        bucket->observers = observersIter->second;
+        for (size_t i = 0; i < bucket->observers.size(); i++) {
+            bucket->tokenCounts[bucket->observers[i].callingTokenId]++;
+            bucket->singleListenSize += bucket->observers[i].singleIds.size();
+            for (const auto &singleId : bucket->observers[i].singleIds) {
+                bucket->singleIdIndex[singleId].push_back(i);
+            }
+        }
+        snapshot->buckets[uri] = std::move(bucket);
+    }
+    std::atomic_store(&snapshot_, std::shared_ptr<const ObserverSnapshot>(std::move(snapshot)));
+}
+
+std::shared_ptr<const ObserverSnapshot> MediaObserverManager::GetObserverSnapshot()
+{
+    return std::atomic_load(&snapshot_);
+}
+
+std::shared_ptr<const ObserverBucket> MediaObserverManager::GetObserverBucket(const NotifyUriType &uri)
+{
+    auto snapshot = GetObserverSnapshot();
+    auto iter = snapshot->buckets.find(uri);
+    CHECK_AND_RETURN_RET(iter != snapshot->buckets.end(), nullptr);
+    return iter->second;
+}
+
 std::vector<ObserverInfo> MediaObserverManager::FindObserver(const NotifyUriType &uri)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iter = observers_.find(uri);
-    if (iter == observers_.end()) {
+    auto bucket = GetObserverBucket(uri);
+    if (bucket == nullptr) {
         MEDIA_ERR_LOG("failed to find observer, uri is not exist");
         return {};
     }
-    return iter->second;
+    return bucket->observers;
 }
 
 int32_t MediaObserverManager::RemoveObserverWithUri(const NotifyUriType &uri,
@@ -191,6 +235,14 @@ int32_t MediaObserverManager::RemoveObserverWithUri(const NotifyUriType &uri,
     if (observersIter->second.empty()) {
         observers_.erase(observersIter);
     }
+    auto callerIter = callerUris_.find(dataObserver->AsObject().GetRefPtr());
+    if (callerIter != callerUris_.end()) {
+        callerIter->second.erase(uri);
+        if (callerIter->second.empty()) {
+            callerUris_.erase(callerIter);
+        }
+    }
+    PublishSnapshotLocked({ uri });
     ret = RemoveObsDeathRecipient(dataObserver->AsObject());
     if (ret != E_OK) {
         MEDIA_WARN_LOG("failed to remove obsDeathRecipient");
@@ -208,23 +260,36 @@ bool MediaObserverManager::FindSingleObserverWithUri(const NotifyUriType &uri,
         MEDIA_ERR_LOG("Permission verification failed");
         return false;
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto observersIter = observers_.find(uri);
-    if (observersIter == observers_.end()) {
+    auto bucket = GetObserverBucket(uri);
+    if (bucket == nullptr) {
         MEDIA_ERR_LOG("uri is not exist");
         return false;
     }
-    auto iter = std::find_if(observersIter->second.begin(), observersIter->second.end(),
-        [callingTokenId](const ObserverInfo& s) {
-        return s.callingTokenId == callingTokenId;
-    });
-    return iter != observersIter->second.end();
+    return bucket->tokenCounts.count(callingTokenId) > 0;
 }
 
 std::unordered_map<NotifyUriType, std::vector<ObserverInfo>> MediaObserverManager::GetObservers()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return this->observers_;
+    std::unordered_map<NotifyUriType, std::vector<ObserverInfo>> observers;
+    for (const auto &[uri, bucket] : GetObserverSnapshot()->buckets) {
+        observers.emplace(uri, bucket->observers);
+    }
+    return observers;
+}
+
+std::vector<ObserverInfo> MediaObserverManager::FindObserverBySingleId(const NotifyUriType &uri,
+    const std::string &singleId)
+{
+    auto bucket = GetObserverBucket(uri);
+    CHECK_AND_RETURN_RET(bucket != nullptr, {});
+    auto idIter = bucket->singleIdIndex.find(singleId);
+    CHECK_AND_RETURN_RET(idIter != bucket->singleIdIndex.end(), {});
+    std::vector<ObserverInfo> obsInfos;
+    obsInfos.reserve(idIter->second.size());
+    for (size_t index : idIter->second) {
+        obsInfos.push_back(bucket->observers[index]);
+    }
+    return obsInfos;
 }
 
 int32_t MediaObserverManager::CheckSingleOperationPermissionsAndLimit(const NotifyUriType& registerUri,
@@ -305,6 +370,7 @@ int32_t MediaObserverManager::ProcessSingleObserverSingleIds(const NotifyUriType
         return E_DATAOBSERVER_IS_NULL;
     }
     operation(obsIter->singleIds, singleId);
+    PublishSnapshotLocked({ registerUri });
     return E_OK;
 }
 
@@ -329,13 +395,12 @@ int32_t MediaObserverManager::RemoveSingleObserverSingleIds(const NotifyUriType
 bool MediaObserverManager::FindSingleObserver(const NotifyUriType &uri,
     std::vector<ObserverInfo> &obsInfos)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iter = observers_.find(uri);
-    if (iter == observers_.end()) {
+    auto bucket = GetObserverBucket(uri);
+    if (bucket == nullptr) {
         MEDIA_ERR_LOG("failed to find single observer, uri is not exist");
         return false;
     }
-    obsInfos = iter->second;
+    obsInfos = bucket->observers;
     return true;
 }
 
@@ -365,15 +430,8 @@ bool MediaObserverManager::CheckSingleListenSize(const NotifyUriType &registerUr
         registerUri != NotifyUriType::SINGLE_PHOTO_ALBUM_URI) {
         return true;
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::size_t listenSize = 0;
-    auto it = observers_.find(registerUri);
-    if (it != observers_.end()) {
-        const std::vector<ObserverInfo>& observerList = it->second;
-        for (const auto& observer : observerList) {
-            listenSize += observer.singleIds.size();
-        }
-    }
+    auto bucket = GetObserverBucket(registerUri);
+    std::size_t listenSize = bucket != nullptr ? bucket->singleListenSize : 0;
     MEDIA_INFO_LOG("CheckSingleListenSize: listenSize is %{public}" PRId64, static_cast<int64_t>(listenSize));
     if (registerUri == NotifyUriType::SINGLE_PHOTO_URI) {
         return listenSize < MAX_SINGLE_ASSET;
@@ -387,12 +445,8 @@ bool MediaObserverManager::CheckSingleProcessSize(const NotifyUriType &registerU
         registerUri != NotifyUriType::SINGLE_PHOTO_ALBUM_URI) {
         return true;
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::size_t processSize = 0;
-    auto it = observers_.find(registerUri);
-    if (it != observers_.end()) {
-        processSize = it->second.size();
-    }
+    auto bucket = GetObserverBucket(registerUri);
+    std::size_t processSize = bucket != nullptr ? bucket->observers.size() : 0;
     MEDIA_INFO_LOG("CheckSingleRegisterSize: processSize is %{public}" PRId64, static_cast<int64_t>(processSize));
     if (registerUri == NotifyUriType::SINGLE_PHOTO_URI) {
         return processSize < MAX_SINGLE_ASSET_PROCESS;
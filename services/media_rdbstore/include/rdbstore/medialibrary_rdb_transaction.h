@@ -104,6 +104,8 @@ public:
 
 private:
     void SetIsOperate(const std::pair<int32_t, NativeRdb::Results> &result);
+    void RecordIndexProgress(const std::string &table, const NativeRdb::ValuesBucket *values, int64_t fileId = 0);
+    void ApplyIndexProgress();
 
     // Insert
     int32_t InsertInternal(int64_t &outRowId, const std::string &table, const NativeRdb::ValuesBucket &row);
@@ -122,6 +124,9 @@ private:
     DfxTransaction reporter_;
     // 接入精准刷新框架时，查询修改前的数据不用事务，防止事务升级
     bool isOperate_ = false;
+    // 事务内写入的影响搜索索引进度统计的文件，提交后再刷新计数，文件未知时提交后标记计数待校准
+    std::vector<int32_t> indexProgressFileIds_;
+    bool isIndexProgressDirty_ = false;
 };
 } // namespace OHOS::Media
 
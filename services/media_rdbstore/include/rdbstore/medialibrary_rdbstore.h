@@ -145,6 +145,10 @@ public:
         EditAndAttachmentUpdateType updateType = EditAndAttachmentUpdateType::EDIT_AND_ATTACHMENT_SIZE);
     EXPORT static int32_t UpdateAttachmentSize(std::shared_ptr<MediaLibraryRdbStore> rdbStore,
         const std::string &photoId, uint64_t attachmentSize);
+    // 写入Photos表的列影响搜索索引进度统计时返回 true，values 为空表示整行插入或删除
+    EXPORT static bool IsIndexProgressChanged(const std::string &table, const NativeRdb::ValuesBucket *values);
+    // 写入生效后按文件刷新搜索索引进度计数，文件未知时标记计数待校准
+    EXPORT static void UpdateIndexProgress(const std::vector<int32_t> &fileIds);
 
 private:
     // Insert
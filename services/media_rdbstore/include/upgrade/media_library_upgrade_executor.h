@@ -30,6 +30,8 @@ namespace Media {
  * @brief 升级执行器
  *
  * 负责执行升级任务，处理升级状态管理和错误上报
+ * 同步升级的任务按组在同一事务内执行，减少启动阶段逐条 DDL 的提交开销；
+ * 开启事务或提交失败时回退为逐个任务执行。
  */
 class UpgradeExecutor {
 public:
@@ -92,8 +94,36 @@ private:
      * @param ret 返回码
      */
     void NotifyUpgradeComplete(const std::shared_ptr<IUpgradeTask>& task, int32_t ret);
+
+    /**
+     * @brief 通知升级进度
+     * @param tasks 待执行任务列表
+     * @param currentVersion 当前版本
+     * @param completedCount 已完成任务数
+     */
+    void NotifyUpgradeProgress(const std::vector<std::shared_ptr<IUpgradeTask>>& tasks,
+                               int32_t currentVersion,
+                               int32_t completedCount);
     void SetRdbConfigVersion(int32_t version);
 
+    /**
+     * @brief 任务执行后的状态记录与结果上报
+     * @param task 升级任务
+     * @param ret 任务返回码
+     * @param isSync 是否同步升级
+     * @return 错误码
+     */
+    int32_t FinishTask(const std::shared_ptr<IUpgradeTask>& task, int32_t ret, bool isSync);
+
+    /**
+     * @brief 在同一事务内执行一组同步任务，失败时回退为逐个执行
+     * @param tasks 任务组
+     * @param store 数据库存储对象
+     * @return 失败任务数
+     */
+    int32_t ExecuteTaskGroup(const std::vector<std::shared_ptr<IUpgradeTask>>& tasks,
+                             NativeRdb::RdbStore& store);
+
     std::shared_ptr<IUpgradeObserver> observer_;
     std::string upgradeEventPath_;
     std::string rdbConfigPath_;
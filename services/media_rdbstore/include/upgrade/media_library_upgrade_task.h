@@ -64,6 +64,12 @@ public:
      * @return true 表示同步任务，false 表示异步任务
      */
     virtual bool IsSync() const = 0;
+
+    /**
+     * @brief 是否可以与相邻任务在同一事务内执行
+     * @return true 表示任务只执行 DDL 命令，不自行开启事务
+     */
+    virtual bool CanGroupInTransaction() const { return false; }
 };
 
 /**
@@ -165,6 +171,8 @@ public:
     std::string GetName() const override { return name_; }
     std::string GetModuleName() const override { return moduleName_; }
     bool IsSync() const override { return isSync_; }
+    // module 级任务只通过 SqlBuilder 命令执行升级
+    bool CanGroupInTransaction() const override { return true; }
 
 private:
     int32_t version_;
@@ -134,8 +134,9 @@
     "(CASE WHEN NEW.subtype = 1 THEN -1 ELSE 0 END)); " \
     "END"
 
+// 异步回填, 与插入触发器写入的记录按 file_id 去重
 #define SQL_INIT_TAB_ANALYSIS_TOTAL \
-    "INSERT INTO tab_analysis_total (" \
+    "INSERT OR IGNORE INTO tab_analysis_total (" \
     "file_id, " \
     "status, " \
     "ocr, " \
@@ -145,7 +146,7 @@
     "CASE WHEN date_trashed > 0 THEN 2 ELSE 0 END," \
     "0," \
     "CASE WHEN subtype = 1 THEN -1 ELSE 0 END," \
-    "CASE WHEN subtype = 1 THEN -1 ELSE 0 END" \
+    "CASE WHEN subtype = 1 THEN -1 ELSE 0 END " \
     "FROM Photos WHERE MEDIA_TYPE = 1"
 
 #define SQL_UPGRADE_CREATE_TAB_ANALYSIS_CAPTION \
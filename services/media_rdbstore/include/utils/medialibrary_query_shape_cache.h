@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_MEDIALIBRARY_QUERY_SHAPE_CACHE_H
+#define OHOS_MEDIALIBRARY_QUERY_SHAPE_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "abs_rdb_predicates.h"
+#include "value_object.h"
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+/**
+ * @brief Caches the query sql of predicates by shape: the where clause with its literals replaced by placeholders.
+ * Repeated lookups of the same shape skip building the sql and hand the same statement text to the database, so
+ * that only the values are bound again.
+ */
+class MediaLibraryQueryShapeCache {
+public:
+    EXPORT static MediaLibraryQueryShapeCache &GetInstance();
+    EXPORT explicit MediaLibraryQueryShapeCache(size_t capacity);
+
+    // returns false if the where clause cannot be normalised, the caller queries by predicates then
+    EXPORT bool GetQuerySql(const NativeRdb::AbsRdbPredicates &predicates, const std::vector<std::string> &columns,
+        std::string &sql, std::vector<NativeRdb::ValueObject> &bindArgs);
+    // replaces numeric and string literals by placeholders and merges them with whereArgs in placeholder order
+    EXPORT static bool NormalizeWhereClause(const std::string &whereClause,
+        const std::vector<NativeRdb::ValueObject> &whereArgs, std::string &shape,
+        std::vector<NativeRdb::ValueObject> &bindArgs, size_t &literalCount);
+    EXPORT void Clear();
+    EXPORT size_t GetSize();
+
+private:
+    using ShapeList = std::list<std::pair<std::string, std::string>>;
+
+    static std::string GetShapeKey(const NativeRdb::AbsRdbPredicates &predicates,
+        const std::vector<std::string> &columns, const std::string &shape);
+    bool FindSql(const std::string &key, std::string &sql);
+    void InsertSql(const std::string &key, const std::string &sql);
+
+    size_t capacity_;
+    std::mutex mutex_;
+    // most recently used shape at the front, each entry is the shape key and its sql
+    ShapeList shapes_;
+    std::unordered_map<std::string, ShapeList::iterator> shapeMap_;
+};
+} // namespace Media
+} // namespace OHOS
+#endif // OHOS_MEDIALIBRARY_QUERY_SHAPE_CACHE_H
@@ -107,6 +107,7 @@ int32_t TransactionOperations::Commit()
         MEDIA_ERR_LOG("transaction commit fail!, ret:%{public}d", ret);
     } else {
         reporter_.ReportIfTimeout();
+        ApplyIndexProgress();
     }
     return ret;
 }
@@ -125,6 +126,7 @@ int32_t TransactionOperations::Finish()
         MEDIA_ERR_LOG("transaction commit fail!, ret:%{public}d", ret);
     } else {
         reporter_.ReportIfTimeout();
+        ApplyIndexProgress();
     }
 #ifdef CLOUD_SYNC_MANAGER
     if (isSkipCloudSync_) {
@@ -191,6 +193,8 @@ int32_t TransactionOperations::Rollback()
     }
     auto ret = transaction_->Rollback();
     transaction_ = nullptr;
+    indexProgressFileIds_.clear();
+    isIndexProgressDirty_ = false;
     if (ret != NativeRdb::E_OK) {
         reporter_.ReportError(DfxTransaction::AbnormalType::ROLLBACK_ERROR, ret);
         MEDIA_ERR_LOG("Rollback fail:%{public}d", ret);
@@ -257,6 +261,7 @@ int32_t TransactionOperations::UpdateWithDateTime(NativeRdb::ValuesBucket &value
         MediaLibraryRestore::GetInstance().CheckRestore(err);
         return E_HAS_DB_ERROR;
     }
+    CHECK_AND_EXECUTE(changedRows <= 0, RecordIndexProgress(predicates.GetTableName(), &tmpValues));
     return changedRows;
 }
 
@@ -273,6 +278,7 @@ int32_t TransactionOperations::Update(
         MediaLibraryRestore::GetInstance().CheckRestore(err);
         return err;
     }
+    CHECK_AND_EXECUTE(changedRows <= 0, RecordIndexProgress(predicates.GetTableName(), &values));
     return err;
 }
 
@@ -299,6 +305,7 @@ int32_t TransactionOperations::Update(MediaLibraryCommand &cmd, int32_t &changed
         MediaLibraryRestore::GetInstance().CheckRestore(ret);
         return E_HAS_DB_ERROR;
     }
+    CHECK_AND_EXECUTE(changedRows <= 0, RecordIndexProgress(cmd.GetTableName(), &tmpValues));
     return ret;
 }
 
@@ -336,6 +343,7 @@ int32_t TransactionOperations::BatchInsert(int64_t &changeRows, const std::strin
         MediaLibraryRestore::GetInstance().CheckRestore(ret);
         return E_HAS_DB_ERROR;
     }
+    CHECK_AND_EXECUTE(changeRows <= 0, RecordIndexProgress(table, nullptr));
     MEDIA_DEBUG_LOG("transaction_->BatchInsert end, changeRows = %{public}" PRId64 ", ret = %{public}d",
         changeRows, ret);
     return ret;
@@ -373,6 +381,7 @@ int32_t TransactionOperations::BatchInsertInternal(int64_t &outRowId, const std:
         MediaLibraryRestore::GetInstance().CheckRestore(ret);
         return E_HAS_DB_ERROR;
     }
+    CHECK_AND_EXECUTE(outRowId <= 0, RecordIndexProgress(table, nullptr));
     MEDIA_DEBUG_LOG("transaction_->BatchInsert end, rowId = %{public}" PRId64 ", ret = %{public}d", outRowId, ret);
     return ret;
 }
@@ -410,6 +419,7 @@ int32_t TransactionOperations::InsertInternal(int64_t &outRowId, const std::stri
         return E_HAS_DB_ERROR;
     }
     isOperate_ = true;
+    RecordIndexProgress(table, nullptr, outRowId);
     MEDIA_DEBUG_LOG("transaction_->Insert end, rowId = %{public}" PRId64 ", ret = %{public}d", outRowId, ret);
     return ret;
 }
@@ -436,6 +446,7 @@ int32_t TransactionOperations::DeleteInternal(const AbsRdbPredicates &predicates
         ret = res.first;
         deletedRows = res.second;
     }
+    CHECK_AND_EXECUTE(ret != NativeRdb::E_OK || deletedRows <= 0, RecordIndexProgress(tableName, nullptr));
     return ret;
 }
 
@@ -478,6 +489,8 @@ pair<int32_t, NativeRdb::Results> TransactionOperations::BatchInsertWithReturn(
     retWithResults = transaction_->BatchInsert(table, refRows, { returningField },
         resolution);
     SetIsOperate(retWithResults);
+    CHECK_AND_EXECUTE(retWithResults.first != NativeRdb::E_OK || retWithResults.second.changed <= 0,
+        RecordIndexProgress(table, nullptr));
     return retWithResults;
 }
 
@@ -491,6 +504,8 @@ pair<int32_t, NativeRdb::Results> TransactionOperations::UpdateWithReturn(
 
     retWithResults = transaction_->Update(values, predicates, { returningField });
     SetIsOperate(retWithResults);
+    CHECK_AND_EXECUTE(retWithResults.first != NativeRdb::E_OK || retWithResults.second.changed <= 0,
+        RecordIndexProgress(predicates.GetTableName(), &values));
     return retWithResults;
 }
 
@@ -504,6 +519,8 @@ pair<int32_t, NativeRdb::Results> TransactionOperations::DeleteWithReturn(const
 
     retWithResults = transaction_->Delete(predicates, { returningField });
     SetIsOperate(retWithResults);
+    CHECK_AND_EXECUTE(retWithResults.first != NativeRdb::E_OK || retWithResults.second.changed <= 0,
+        RecordIndexProgress(predicates.GetTableName(), nullptr));
     return retWithResults;
 }
 
@@ -557,4 +574,27 @@ void TransactionOperations::SetIsOperate(const pair<int32_t, NativeRdb::Results>
         isOperate_ = true;
     }
 }
+
+void TransactionOperations::RecordIndexProgress(const std::string &table, const NativeRdb::ValuesBucket *values,
+    int64_t fileId)
+{
+    CHECK_AND_RETURN(MediaLibraryRdbStore::IsIndexProgressChanged(table, values));
+    if (fileId > 0) {
+        indexProgressFileIds_.push_back(static_cast<int32_t>(fileId));
+        return;
+    }
+    isIndexProgressDirty_ = true;
+}
+
+// 事务提交前其他连接读不到本事务的写入，提交后才刷新搜索索引进度计数
+void TransactionOperations::ApplyIndexProgress()
+{
+    if (isIndexProgressDirty_) {
+        MediaLibraryRdbStore::UpdateIndexProgress({});
+    } else if (!indexProgressFileIds_.empty()) {
+        MediaLibraryRdbStore::UpdateIndexProgress(indexProgressFileIds_);
+    }
+    indexProgressFileIds_.clear();
+    isIndexProgressDirty_ = false;
+}
 } // namespace OHOS::Media
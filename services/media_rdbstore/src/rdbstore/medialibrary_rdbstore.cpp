@@ -16,6 +16,7 @@
 
 #include "medialibrary_rdbstore.h"
 
+#include <algorithm>
 #include <regex>
 #include <thread>
 #include <chrono>
@@ -41,6 +42,7 @@
 #endif
 #include "medialibrary_notify.h"
 #include "medialibrary_operation_record.h"
+#include "medialibrary_query_shape_cache.h"
 #include "moving_photo_processor.h"
 #include "parameters.h"
 #include "parameter.h"
@@ -56,6 +58,7 @@
 #include "shooting_mode_column.h"
 #include "story_db_sqls.h"
 #include "preferences_helper.h"
+#include "preferences_write_back.h"
 #include "thumbnail_service.h"
 #include "table_event_handler.h"
 #include "values_buckets.h"
@@ -84,6 +87,9 @@
 #include "medialibrary_rdb_helper.h"
 #include "rdb_table_strategy_manager.h"
 #include "share_member_column.h"
+#ifdef MEDIALIBRARY_FEATURE_ANALYSIS_DATA
+#include "search_index_progress_counter.h"
+#endif
 
 using namespace std;
 using namespace OHOS::NativeRdb;
@@ -1146,6 +1152,7 @@ MediaLibraryRdbStore::~MediaLibraryRdbStore() = default;
 void MediaLibraryRdbStore::Stop()
 {
     rdbStore_ = nullptr;
+    MediaLibraryQueryShapeCache::GetInstance().Clear();
 }
 
 bool MediaLibraryRdbStore::CheckRdbStore()
@@ -1158,6 +1165,38 @@ shared_ptr<NativeRdb::RdbStore> MediaLibraryRdbStore::GetRaw()
     return rdbStore_;
 }
 
+// 图片可见性及类型等影响搜索索引进度统计的列变化时，需刷新计数
+bool MediaLibraryRdbStore::IsIndexProgressChanged(const std::string &table, const ValuesBucket *values)
+{
+    CHECK_AND_RETURN_RET(table == PhotoColumn::PHOTOS_TABLE, false);
+    static const std::vector<std::string> INDEX_PROGRESS_COLUMNS = { MediaColumn::MEDIA_DATE_TRASHED,
+        MediaColumn::MEDIA_HIDDEN, MediaColumn::MEDIA_TIME_PENDING, MediaColumn::MEDIA_TYPE,
+        PhotoColumn::PHOTO_CLEAN_FLAG, PhotoColumn::PHOTO_BURST_COVER_LEVEL, PhotoColumn::PHOTO_LATITUDE,
+        PhotoColumn::PHOTO_LONGITUDE };
+    return values == nullptr || std::any_of(INDEX_PROGRESS_COLUMNS.begin(), INDEX_PROGRESS_COLUMNS.end(),
+        [values](const std::string &column) { return values->HasColumn(column); });
+}
+
+void MediaLibraryRdbStore::UpdateIndexProgress(const std::vector<int32_t> &fileIds)
+{
+#ifdef MEDIALIBRARY_FEATURE_ANALYSIS_DATA
+    if (fileIds.empty()) {
+        SearchIndexProgressCounter::GetInstance().MarkDirty();
+        return;
+    }
+    SearchIndexProgressCounter::GetInstance().UpdateFiles(fileIds);
+#endif
+}
+
+// 插入Photos表时触发器同步写入搜索及分析总表，按新文件刷新计数；fileId 未知时标记计数待校准
+static void RefreshIndexProgress(const std::string &table, const ValuesBucket *values, int64_t fileId = 0)
+{
+    CHECK_AND_RETURN(MediaLibraryRdbStore::IsIndexProgressChanged(table, values));
+    std::vector<int32_t> fileIds;
+    CHECK_AND_EXECUTE(fileId <= 0, fileIds.push_back(static_cast<int32_t>(fileId)));
+    MediaLibraryRdbStore::UpdateIndexProgress(fileIds);
+}
+
 int32_t MediaLibraryRdbStore::Insert(MediaLibraryCommand &cmd, int64_t &rowId)
 {
     MediaLibraryTracer tracer;
@@ -1200,6 +1239,7 @@ int32_t MediaLibraryRdbStore::InsertInternal(int64_t &outRowId, const std::strin
         MediaLibraryRestore::GetInstance().CheckRestore(ret);
         return E_HAS_DB_ERROR;
     }
+    RefreshIndexProgress(table, nullptr, outRowId);
     MEDIA_DEBUG_LOG("rdbStore_->Insert end, outRowId = %d, ret = %{public}d", (int)outRowId, ret);
     return ret;
 }
@@ -1248,6 +1288,7 @@ int32_t MediaLibraryRdbStore::BatchInsertInternal(int64_t &outRowId, const std::
         MediaLibraryRestore::GetInstance().CheckRestore(ret);
         return E_HAS_DB_ERROR;
     }
+    CHECK_AND_EXECUTE(outRowId <= 0, RefreshIndexProgress(table, nullptr));
     MEDIA_DEBUG_LOG("rdbStore_->BatchInsert end, rowId = %d, ret = %{public}d", (int)outRowId, ret);
     return ret;
 }
@@ -1280,6 +1321,7 @@ int32_t MediaLibraryRdbStore::DeleteInternal(const AbsRdbPredicates &predicates,
     }
     bool isValid = (tableName == PhotoColumn::PHOTOS_TABLE) || (tableName == PhotoAlbumColumns::TABLE);
     isValid = isValid && (deletedRows > 0);
+    CHECK_AND_EXECUTE(deletedRows <= 0, RefreshIndexProgress(tableName, nullptr));
     CHECK_AND_EXECUTE(!isValid, CloudSyncHelper::GetInstance()->StartSync());
     return ret;
 }
@@ -1322,6 +1364,7 @@ int32_t MediaLibraryRdbStore::Update(MediaLibraryCommand &cmd, int32_t &changedR
         MediaLibraryRestore::GetInstance().CheckRestore(ret);
         return E_HAS_DB_ERROR;
     }
+    RefreshIndexProgress(cmd.GetTableName(), &tmpValues);
     return ret;
 }
 
@@ -1405,7 +1448,14 @@ std::shared_ptr<NativeRdb::ResultSet> MediaLibraryRdbStore::QueryInternal(const
     RdbTableStrategyManager::GetInstance().ExtendQueryFilters(const_cast<AbsRdbPredicates &>(predicates), config);
     PrintPredicatesInfo(predicates, columns);
 
-    auto resultSet = MediaLibraryRdbStore::GetRaw()->QueryByStep(predicates, columns, preCount);
+    std::shared_ptr<NativeRdb::ResultSet> resultSet;
+    std::string sql;
+    std::vector<ValueObject> bindArgs;
+    if (MediaLibraryQueryShapeCache::GetInstance().GetQuerySql(predicates, columns, sql, bindArgs)) {
+        resultSet = MediaLibraryRdbStore::GetRaw()->QueryByStep(sql, bindArgs, preCount);
+    } else {
+        resultSet = MediaLibraryRdbStore::GetRaw()->QueryByStep(predicates, columns, preCount);
+    }
     MediaLibraryRestore::GetInstance().CheckResultSet(resultSet);
     if (resultSet == nullptr) {
         VariantMap map = {{KEY_ERR_FILE, __FILE__}, {KEY_ERR_LINE, __LINE__}, {KEY_ERR_CODE, E_HAS_DB_ERROR},
@@ -1480,7 +1530,7 @@ int32_t MediaLibraryRdbStore::UpdateWithDateTime(ValuesBucket &values, const Abs
         MediaLibraryRestore::GetInstance().CheckRestore(err);
         return E_HAS_DB_ERROR;
     }
-
+    RefreshIndexProgress(predicates.GetTableName(), &tmpValues);
     return changedRows;
 }
 
@@ -2492,7 +2542,6 @@ static int32_t AddAnalysisTables(RdbStore &store)
         CREATE_VISION_UPDATE_TRIGGER,
         CREATE_VISION_DELETE_TRIGGER,
         CREATE_VISION_INSERT_TRIGGER,
-        INIT_TAB_ANALYSIS_TOTAL,
     };
     MEDIA_INFO_LOG("start init vision db");
     return ExecSqls(executeSqlStrs, store);
@@ -5619,7 +5668,7 @@ static void UpgradeFromAllVersionFirstPart(RdbStore &store, unordered_map<string
         if (prefs != nullptr) {
             // before current version, detail time column has existed, need to fix other information
             prefs->PutInt(DETAIL_TIME_FIXED, NEED_FIXED);
-            prefs->FlushSync();
+            PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
             MEDIA_INFO_LOG("DETAIL_TIME_FIXED set to: %{public}d", NEED_FIXED);
         }
         MEDIA_INFO_LOG("DETAIL_TIME_FIXED prefs errCode: %{public}d", errCode);
@@ -5640,7 +5689,7 @@ static void UpgradeFromAllVersionFirstPart(RdbStore &store, unordered_map<string
         if (prefs != nullptr) {
             // before current version, thumbnail visible column has existed, need to fix other information
             prefs->PutInt(THUMBNAIL_VISIBLE_FIXED, NEED_FIXED);
-            prefs->FlushSync();
+            PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
             MEDIA_INFO_LOG("THUMBNAIL_VISIBLE_FIXED set to: %{public}d", NEED_FIXED);
         }
         MEDIA_INFO_LOG("THUMBNAIL_VISIBLE_FIXED prefs errCode: %{public}d", errCode);
@@ -6280,7 +6329,7 @@ static int32_t AsyncUpgradeFromAllVersionFirstPart(RdbStore& rdbStore)
             errCode = UpdateDateTakenIndex(rdbStore);
             ThumbnailService::GetInstance()->AstcChangeKeyFromDateAddedToDateTaken();
             prefs->PutInt(DETAIL_TIME_FIXED, ALREADY_FIXED);
-            prefs->FlushSync();
+            PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
             MEDIA_INFO_LOG("detailTimeFixed set to: %{public}d", ALREADY_FIXED);
         }
     }
@@ -6301,7 +6350,7 @@ static int32_t AsyncUpgradeFromAllVersionFirstPart(RdbStore& rdbStore)
         if (thumbnailVisibleFixed == NEED_FIXED) {
             errCode = UpdateThumbnailVisibleAndIdx(rdbStore);
             prefs->PutInt(THUMBNAIL_VISIBLE_FIXED, ALREADY_FIXED);
-            prefs->FlushSync();
+            PreferencesWriteBack::GetInstance().MarkDirty(prefs, true);
             MEDIA_INFO_LOG("thumbnailVisibleFixed set to: %{public}d", ALREADY_FIXED);
         }
         MEDIA_INFO_LOG("prefs errCode: %{public}d", errCode);
@@ -6493,9 +6542,11 @@ int MediaLibraryRdbStore::Update(int &changedRows, const std::string &table, con
 
     CHECK_AND_RETURN_RET_LOG(MediaLibraryRdbStore::CheckRdbStore(), E_HAS_DB_ERROR,
         "Pointer rdbStore_ is nullptr. Maybe it didn't init successfully.");
-    return MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
+    int32_t ret = MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
         return MediaLibraryRdbStore::GetRaw()->Update(changedRows, table, row, whereClause, args);
     });
+    CHECK_AND_EXECUTE(ret != NativeRdb::E_OK || changedRows <= 0, RefreshIndexProgress(table, &row));
+    return ret;
 }
 
 std::string MediaLibraryRdbStore::ObtainDistributedTableName(const std::string &device, const std::string &table,
@@ -6567,9 +6618,12 @@ int MediaLibraryRdbStore::Update(int &changedRows, const ValuesBucket &row, cons
 
     CHECK_AND_RETURN_RET_LOG(MediaLibraryRdbStore::CheckRdbStore(), E_HAS_DB_ERROR,
         "Pointer rdbStore_ is nullptr. Maybe it didn't init successfully.");
-    return MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
+    int32_t ret = MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
         return MediaLibraryRdbStore::GetRaw()->Update(changedRows, row, predicates);
     });
+    CHECK_AND_EXECUTE(ret != NativeRdb::E_OK || changedRows <= 0,
+        RefreshIndexProgress(predicates.GetTableName(), &row));
+    return ret;
 }
 
 int MediaLibraryRdbStore::Delete(int &deletedRows, const std::string &table, const std::string &whereClause,
@@ -6581,9 +6635,11 @@ int MediaLibraryRdbStore::Delete(int &deletedRows, const std::string &table, con
 
     CHECK_AND_RETURN_RET_LOG(MediaLibraryRdbStore::CheckRdbStore(), E_HAS_DB_ERROR,
         "Pointer rdbStore_ is nullptr. Maybe it didn't init successfully.");
-    return MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
+    int32_t ret = MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
         return MediaLibraryRdbStore::GetRaw()->Delete(deletedRows, table, whereClause, args);
     });
+    CHECK_AND_EXECUTE(ret != NativeRdb::E_OK || deletedRows <= 0, RefreshIndexProgress(table, nullptr));
+    return ret;
 }
 
 int MediaLibraryRdbStore::Delete(int &deletedRows, const AbsRdbPredicates &predicates)
@@ -6594,9 +6650,12 @@ int MediaLibraryRdbStore::Delete(int &deletedRows, const AbsRdbPredicates &predi
 
     CHECK_AND_RETURN_RET_LOG(MediaLibraryRdbStore::CheckRdbStore(), E_HAS_DB_ERROR,
         "Pointer rdbStore_ is nullptr. Maybe it didn't init successfully.");
-    return MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
+    int32_t ret = MediaLibraryRdbHelper::ExecSqlWithRetry([&]() {
         return MediaLibraryRdbStore::GetRaw()->Delete(deletedRows, predicates);
     });
+    CHECK_AND_EXECUTE(ret != NativeRdb::E_OK || deletedRows <= 0,
+        RefreshIndexProgress(predicates.GetTableName(), nullptr));
+    return ret;
 }
 
 pair<int32_t, NativeRdb::Results> MediaLibraryRdbStore::BatchInsertWithReturn(const string &table,
@@ -6631,6 +6690,7 @@ pair<int32_t, NativeRdb::Results> MediaLibraryRdbStore::BatchInsertWithReturn(co
         return {ret, -1};
     }
 
+    CHECK_AND_EXECUTE(retWithResults.second.changed <= 0, RefreshIndexProgress(table, nullptr));
     MEDIA_DEBUG_LOG("rdbStore_->BatchInsert end, ret = %{public}d", ret);
     return retWithResults;
 }
@@ -6676,6 +6736,8 @@ pair<int32_t, NativeRdb::Results> MediaLibraryRdbStore::UpdateWithReturn(const V
         retWithResults = MediaLibraryRdbStore::GetRaw()->Update(row, predicates, { returningField });
         return retWithResults.first;
     });
+    CHECK_AND_EXECUTE(retWithResults.first != NativeRdb::E_OK || retWithResults.second.changed <= 0,
+        RefreshIndexProgress(predicates.GetTableName(), &row));
 
     return retWithResults;
 }
@@ -6695,6 +6757,8 @@ pair<int32_t, NativeRdb::Results> MediaLibraryRdbStore::DeleteWithReturn(const A
         retWithResults = MediaLibraryRdbStore::GetRaw()->Delete(predicates, { returningField });
         return retWithResults.first;
     });
+    CHECK_AND_EXECUTE(retWithResults.first != NativeRdb::E_OK || retWithResults.second.changed <= 0,
+        RefreshIndexProgress(predicates.GetTableName(), nullptr));
     return retWithResults;
 }
 
@@ -16,6 +16,9 @@
 #define MLOG_TAG "Media_Upgrade"
 
 #include "media_library_upgrade_executor.h"
+
+#include <set>
+
 #include "media_log.h"
 
 namespace OHOS {
@@ -73,12 +76,16 @@ bool UpgradeExecutor::ShouldExecuteTask(const std::shared_ptr<IUpgradeTask>& tas
 int32_t UpgradeExecutor::ExecuteTask(const std::shared_ptr<IUpgradeTask>& task,
     NativeRdb::RdbStore& store, bool isSync)
 {
-    int32_t version = task->GetVersion();
-
     NotifyUpgradeStart(task);
 
     // 执行升级任务
     int32_t ret = task->Execute(store);
+    return FinishTask(task, ret, isSync);
+}
+
+int32_t UpgradeExecutor::FinishTask(const std::shared_ptr<IUpgradeTask>& task, int32_t ret, bool isSync)
+{
+    int32_t version = task->GetVersion();
 
     NotifyUpgradeComplete(task, ret);
 
@@ -106,6 +113,39 @@ int32_t UpgradeExecutor::ExecuteTask(const std::shared_ptr<IUpgradeTask>& task,
     return NativeRdb::E_OK;
 }
 
+int32_t UpgradeExecutor::ExecuteTaskGroup(const std::vector<std::shared_ptr<IUpgradeTask>>& tasks,
+    NativeRdb::RdbStore& store)
+{
+    int32_t failedCount = 0;
+    int32_t errCode = store.BeginTransaction();
+    if (errCode == NativeRdb::E_OK) {
+        std::vector<int32_t> results;
+        for (const auto& task : tasks) {
+            NotifyUpgradeStart(task);
+            results.push_back(task->Execute(store));
+        }
+        errCode = store.Commit();
+        if (errCode == NativeRdb::E_OK) {
+            // 提交成功后再记录升级状态，保证状态与表结构一致
+            for (size_t i = 0; i < tasks.size(); i++) {
+                failedCount += FinishTask(tasks[i], results[i], true) != NativeRdb::E_OK ? 1 : 0;
+            }
+            MEDIA_INFO_LOG("Task group of %{public}zu tasks committed", tasks.size());
+            return failedCount;
+        }
+        MEDIA_ERR_LOG("Commit task group failed: %{public}d, rollback and execute one by one", errCode);
+        store.RollBack();
+    } else {
+        // 外部已开启事务等场景下无法分组，逐个执行
+        MEDIA_WARN_LOG("Begin transaction for task group failed: %{public}d", errCode);
+    }
+
+    for (const auto& task : tasks) {
+        failedCount += ExecuteTask(task, store, true) != NativeRdb::E_OK ? 1 : 0;
+    }
+    return failedCount;
+}
+
 void UpgradeExecutor::NotifyUpgradeStart(const std::shared_ptr<IUpgradeTask>& task)
 {
     if (observer_ != nullptr) {
@@ -120,22 +160,61 @@ void UpgradeExecutor::NotifyUpgradeComplete(const std::shared_ptr<IUpgradeTask>&
     }
 }
 
+void UpgradeExecutor::NotifyUpgradeProgress(const std::vector<std::shared_ptr<IUpgradeTask>>& tasks,
+    int32_t currentVersion, int32_t completedCount)
+{
+    if (observer_ != nullptr && !tasks.empty()) {
+        observer_->OnUpgradeProgress(currentVersion, tasks.back()->GetVersion(), completedCount,
+            static_cast<int32_t>(tasks.size()));
+    }
+}
+
 int32_t UpgradeExecutor::ExecuteTasks(const std::vector<std::shared_ptr<IUpgradeTask>>& tasks,
     NativeRdb::RdbStore& store, int32_t currentVersion, bool isSync)
 {
-    int32_t failedCount = 0;
-
-    // 责任链模式：按顺序执行升级任务
+    std::vector<std::shared_ptr<IUpgradeTask>> pendingTasks;
+    std::set<int32_t> pendingVersions;
     for (const auto& task : tasks) {
         if (!ShouldExecuteTask(task, currentVersion, isSync)) {
             continue;
         }
+        // 同一版本的升级状态在首个任务完成后即已设置，后续同版本任务保持跳过
+        int32_t version = task->GetVersion();
+        if (version >= STATUS_MANAGEMENT_START_VERSION && !pendingVersions.insert(version).second) {
+            MEDIA_INFO_LOG("Task %{public}s (version %{public}d) skipped: already upgraded",
+                task->GetName().c_str(), version);
+            continue;
+        }
+        pendingTasks.push_back(task);
+    }
 
+    int32_t failedCount = 0;
+    int32_t completedCount = 0;
+    std::vector<std::shared_ptr<IUpgradeTask>> group;
+    auto flushGroup = [&]() {
+        if (group.empty()) {
+            return;
+        }
+        failedCount += ExecuteTaskGroup(group, store);
+        completedCount += static_cast<int32_t>(group.size());
+        group.clear();
+        NotifyUpgradeProgress(pendingTasks, currentVersion, completedCount);
+    };
+
+    // 责任链模式：按顺序执行升级任务，同步升级中相邻的可分组任务合并为一个事务
+    for (const auto& task : pendingTasks) {
+        if (isSync && task->CanGroupInTransaction()) {
+            group.push_back(task);
+            continue;
+        }
+        flushGroup();
         int32_t ret = ExecuteTask(task, store, isSync);
         if (ret != NativeRdb::E_OK) {
             failedCount++;
         }
+        NotifyUpgradeProgress(pendingTasks, currentVersion, ++completedCount);
     }
+    flushGroup();
 
     // 同步任务全部完成时，记录旧版本号
     if (isSync) {
@@ -23,6 +23,7 @@
 #include "media_library_upgrade_helper.h"
 #include "result_set_utils.h"
 #include <chrono>
+#include <cinttypes>
 
 namespace OHOS {
 namespace Media {
@@ -78,6 +79,12 @@ int32_t UpgradeManager::DoUpgrade(NativeRdb::RdbStore& store, bool isSync)
     if (!isCloned_) {
         RdbUpgradeUtils::ReportUpgradeDfxMessages(startTime, currentVersion_, targetVersion_, isSync);
     }
+    if (isSync) {
+        // 同步升级完成后数据库即可对外提供服务，异步任务在后台继续执行
+        int64_t usableTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() - startTime;
+        MEDIA_INFO_LOG("Store usable after sync upgrade, cost: %{public}" PRId64 " ms", usableTime);
+    }
     if (ret != NativeRdb::E_OK) {
         MEDIA_ERR_LOG("ExecuteTasks failed");
         return ret;
@@ -40,13 +40,21 @@ static vector<pair<int32_t, int32_t>> VersionAddVisionTable(NativeRdb::RdbStore&
                            .AddRawSql(SQL_CREATE_VISION_UPDATE_TRIGGER)
                            .AddRawSql(SQL_CREATE_VISION_DELETE_TRIGGER)
                            .AddRawSql(SQL_CREATE_VISION_INSERT_TRIGGER)
-                           .AddRawSql(SQL_INIT_TAB_ANALYSIS_TOTAL)
                            .Build();
 
     return UpgradeHelper::ExecuteCommands(commands, store);
 }
 REGISTER_SYNC_UPGRADE_MODULE_TASK(VERSION_ADD_VISION_TABLE, VISION_MODULE_NAME, VersionAddVisionTable)
 
+// VERSION_ADD_VISION_TABLE: 存量图片回填分析总表, 启动后不依赖该数据, 在异步阶段执行
+static vector<pair<int32_t, int32_t>> VersionInitVisionTotal(NativeRdb::RdbStore& store)
+{
+    SqlBuilder builder;
+    auto commands = builder.AddRawSql(SQL_INIT_TAB_ANALYSIS_TOTAL).Build();
+    return UpgradeHelper::ExecuteCommands(commands, store);
+}
+REGISTER_ASYNC_UPGRADE_MODULE_TASK(VERSION_ADD_VISION_TABLE, VISION_MODULE_NAME, VersionInitVisionTotal)
+
 static vector<pair<int32_t, int32_t>> VersionAddCaptionTable(NativeRdb::RdbStore& store)
 {
     SqlBuilder builder;
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MLOG_TAG "MediaLibraryQueryShapeCache"
+
+#include "medialibrary_query_shape_cache.h"
+
+#include <cctype>
+#include <chrono>
+
+#include "dfx_query_statistic.h"
+#include "media_log.h"
+#include "rdb_sql_utils.h"
+
+using namespace OHOS::NativeRdb;
+
+namespace OHOS {
+namespace Media {
+static constexpr size_t QUERY_SHAPE_CACHE_CAPACITY = 128;
+// a longer literal list, such as a large IN clause, is not worth a shape of its own
+static constexpr size_t MAX_NORMALIZED_LITERAL_NUM = 64;
+// digits of the largest literal that is still parsed as an int64
+static constexpr size_t MAX_INTEGER_LITERAL_LEN = 18;
+static constexpr char SHAPE_KEY_SEPARATOR = '\x1f';
+
+static bool IsIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// true if the character before pos continues an identifier, a qualified name or a number
+static bool IsAfterIdentifier(const std::string &text, size_t pos)
+{
+    return pos > 0 && (IsIdentifierChar(text[pos - 1]) || text[pos - 1] == '.');
+}
+
+// copies a quoted token verbatim, returns the position after its closing quote or npos if it is not closed
+static size_t CopyQuoted(const std::string &text, size_t pos, char closeQuote, std::string &shape)
+{
+    size_t end = pos + 1;
+    while (end < text.size()) {
+        if (text[end] != closeQuote) {
+            end++;
+            continue;
+        }
+        // a doubled quote is an escaped quote
+        if (closeQuote != ']' && end + 1 < text.size() && text[end + 1] == closeQuote) {
+            end += 2;
+            continue;
+        }
+        shape.append(text, pos, end + 1 - pos);
+        return end + 1;
+    }
+    return std::string::npos;
+}
+
+static size_t ParseStringLiteral(const std::string &text, size_t pos, std::string &value)
+{
+    size_t end = pos + 1;
+    while (end < text.size()) {
+        if (text[end] != '\'') {
+            value.push_back(text[end++]);
+            continue;
+        }
+        if (end + 1 < text.size() && text[end + 1] == '\'') {
+            value.push_back('\'');
+            end += 2;
+            continue;
+        }
+        return end + 1;
+    }
+    return std::string::npos;
+}
+
+// parses a decimal literal, returns pos if the token is not a plain integer or real such as 0x1F or 1e5
+static size_t ParseNumericLiteral(const std::string &text, size_t pos, ValueObject &value)
+{
+    size_t end = pos;
+    while (end < text.size() && std::isdigit(static_cast<unsigned char>(text[end]))) {
+        end++;
+    }
+    bool isReal = false;
+    if (end + 1 < text.size() && text[end] == '.' && std::isdigit(static_cast<unsigned char>(text[end + 1]))) {
+        isReal = true;
+        end++;
+        while (end < text.size() && std::isdigit(static_cast<unsigned char>(text[end]))) {
+            end++;
+        }
+    }
+    if (end < text.size() && (IsIdentifierChar(text[end]) || text[end] == '.')) {
+        return pos;
+    }
+    std::string token = text.substr(pos, end - pos);
+    if (isReal) {
+        value = ValueObject(std::stod(token));
+        return end;
+    }
+    if (token.size() > MAX_INTEGER_LITERAL_LEN) {
+        return pos;
+    }
+    value = ValueObject(static_cast<int64_t>(std::stoll(token)));
+    return end;
+}
+
+static std::string ToUpper(const std::string &word)
+{
+    std::string upper = word;
+    for (auto &c : upper) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return upper;
+}
+
+MediaLibraryQueryShapeCache &MediaLibraryQueryShapeCache::GetInstance()
+{
+    static MediaLibraryQueryShapeCache instance(QUERY_SHAPE_CACHE_CAPACITY);
+    return instance;
+}
+
+MediaLibraryQueryShapeCache::MediaLibraryQueryShapeCache(size_t capacity) : capacity_(capacity) {}
+
+bool MediaLibraryQueryShapeCache::NormalizeWhereClause(const std::string &whereClause,
+    const std::vector<ValueObject> &whereArgs, std::string &shape, std::vector<ValueObject> &bindArgs,
+    size_t &literalCount)
+{
+    shape.clear();
+    shape.reserve(whereClause.size());
+    bindArgs.clear();
+    literalCount = 0;
+    size_t argIndex = 0;
+    std::string lastWord;
+    size_t pos = 0;
+    while (pos < whereClause.size()) {
+        char c = whereClause[pos];
+        if (c == '\'' && !IsAfterIdentifier(whereClause, pos)) {
+            std::string value;
+            pos = ParseStringLiteral(whereClause, pos, value);
+            CHECK_AND_RETURN_RET(pos != std::string::npos, false);
+            bindArgs.emplace_back(value);
+            shape.push_back('?');
+            literalCount++;
+        } else if (c == '\'' || c == '"' || c == '`' || c == '[') {
+            // blob literals and quoted identifiers are part of the shape
+            pos = CopyQuoted(whereClause, pos, c == '[' ? ']' : c, shape);
+            CHECK_AND_RETURN_RET(pos != std::string::npos, false);
+        } else if (c == '?') {
+            // numbered parameters and arguments missing for a placeholder are left to the database to report
+            CHECK_AND_RETURN_RET(argIndex < whereArgs.size(), false);
+            CHECK_AND_RETURN_RET(pos + 1 >= whereClause.size() ||
+                !std::isdigit(static_cast<unsigned char>(whereClause[pos + 1])), false);
+            bindArgs.push_back(whereArgs[argIndex++]);
+            shape.push_back('?');
+            pos++;
+        } else if (std::isdigit(static_cast<unsigned char>(c)) && !IsAfterIdentifier(whereClause, pos)) {
+            ValueObject value;
+            size_t end = ParseNumericLiteral(whereClause, pos, value);
+            if (end == pos) {
+                while (end < whereClause.size() && (IsIdentifierChar(whereClause[end]) || whereClause[end] == '.')) {
+                    end++;
+                }
+                shape.append(whereClause, pos, end - pos);
+            } else {
+                bindArgs.push_back(value);
+                shape.push_back('?');
+                literalCount++;
+            }
+            pos = end;
+        } else if (IsIdentifierChar(c)) {
+            size_t end = pos;
+            while (end < whereClause.size() && IsIdentifierChar(whereClause[end])) {
+                end++;
+            }
+            std::string word = ToUpper(whereClause.substr(pos, end - pos));
+            // a literal in the ORDER BY or GROUP BY of a subquery may be a column position, keep those as is
+            CHECK_AND_RETURN_RET(word != "BY" || (lastWord != "ORDER" && lastWord != "GROUP"), false);
+            lastWord = word;
+            shape.append(whereClause, pos, end - pos);
+            pos = end;
+        } else {
+            CHECK_AND_RETURN_RET(!(c == '-' && pos + 1 < whereClause.size() && whereClause[pos + 1] == '-'), false);
+            CHECK_AND_RETURN_RET(!(c == '/' && pos + 1 < whereClause.size() && whereClause[pos + 1] == '*'), false);
+            shape.push_back(c);
+            pos++;
+        }
+        CHECK_AND_RETURN_RET(literalCount <= MAX_NORMALIZED_LITERAL_NUM, false);
+    }
+    return argIndex == whereArgs.size();
+}
+
+std::string MediaLibraryQueryShapeCache::GetShapeKey(const AbsRdbPredicates &predicates,
+    const std::vector<std::string> &columns, const std::string &shape)
+{
+    std::string key;
+    key.append(predicates.IsDistinct() ? "1" : "0").push_back(SHAPE_KEY_SEPARATOR);
+    key.append(predicates.GetTableName()).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(predicates.GetJoinClause()).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(shape).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(predicates.GetGroup()).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(predicates.GetIndex()).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(predicates.GetOrder()).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(std::to_string(predicates.GetLimit())).push_back(SHAPE_KEY_SEPARATOR);
+    key.append(std::to_string(predicates.GetOffset()));
+    for (const auto &column : columns) {
+        key.push_back(SHAPE_KEY_SEPARATOR);
+        key.append(column);
+    }
+    return key;
+}
+
+bool MediaLibraryQueryShapeCache::FindSql(const std::string &key, std::string &sql)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = shapeMap_.find(key);
+    if (it == shapeMap_.end()) {
+        return false;
+    }
+    shapes_.splice(shapes_.begin(), shapes_, it->second);
+    sql = it->second->second;
+    return true;
+}
+
+void MediaLibraryQueryShapeCache::InsertSql(const std::string &key, const std::string &sql)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_AND_RETURN(capacity_ > 0);
+    auto it = shapeMap_.find(key);
+    if (it != shapeMap_.end()) {
+        shapes_.splice(shapes_.begin(), shapes_, it->second);
+        return;
+    }
+    shapes_.emplace_front(key, sql);
+    shapeMap_.emplace(key, shapes_.begin());
+    while (shapes_.size() > capacity_) {
+        shapeMap_.erase(shapes_.back().first);
+        shapes_.pop_back();
+        DfxQueryStatistic::GetInstance().AddEvict();
+    }
+}
+
+static uint64_t GetCostUs(std::chrono::steady_clock::time_point startTime)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+}
+
+bool MediaLibraryQueryShapeCache::GetQuerySql(const AbsRdbPredicates &predicates,
+    const std::vector<std::string> &columns, std::string &sql, std::vector<ValueObject> &bindArgs)
+{
+    // hits pay for normalising and the shape key too, so the whole call is timed to report the net saving
+    auto startTime = std::chrono::steady_clock::now();
+    std::string shape;
+    size_t literalCount = 0;
+    if (!NormalizeWhereClause(predicates.GetWhereClause(), predicates.GetBindArgs(), shape, bindArgs,
+        literalCount)) {
+        DfxQueryStatistic::GetInstance().AddBypass(GetCostUs(startTime));
+        return false;
+    }
+    std::string key = GetShapeKey(predicates, columns, shape);
+    if (FindSql(key, sql)) {
+        DfxQueryStatistic::GetInstance().AddHit(literalCount, GetCostUs(startTime));
+        return true;
+    }
+
+    auto buildStartTime = std::chrono::steady_clock::now();
+    AbsRdbPredicates shapePredicates = predicates;
+    shapePredicates.SetWhereClause(shape);
+    sql = RdbSqlUtils::BuildQueryString(shapePredicates, columns);
+    uint64_t buildCostUs = GetCostUs(buildStartTime);
+    InsertSql(key, sql);
+    DfxQueryStatistic::GetInstance().AddMiss(literalCount, buildCostUs, GetCostUs(startTime));
+    return true;
+}
+
+void MediaLibraryQueryShapeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    shapes_.clear();
+    shapeMap_.clear();
+}
+
+size_t MediaLibraryQueryShapeCache::GetSize()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return shapes_.size();
+}
+} // namespace Media
+} // namespace OHOS
@@ -25,6 +25,7 @@
 #include "image_source.h"
 #include "image_type.h"
 #include "metadata.h"
+#include "metadata_header_parser.h"
 
 namespace OHOS {
 namespace Media {
@@ -35,6 +36,8 @@ public:
     EXPORT static int32_t Extract(std::unique_ptr<Metadata> &data,
         bool isCameraShotMovingPhoto = false, int32_t scene = 0);
     EXPORT static int32_t ExtractAVMetadata(std::unique_ptr<Metadata> &data, int32_t scene = 0);
+    // Only width, height, orientation and duration, read from container headers when possible
+    EXPORT static int32_t ExtractBasicMetadata(std::unique_ptr<Metadata> &data);
     EXPORT static int32_t ExtractImageMetadata(std::unique_ptr<Metadata> &data);
     static int32_t ExtractImageExif(std::unique_ptr<ImageSource> &imageSource, std::unique_ptr<Metadata> &data);
     EXPORT static int32_t BuildMetaData(
@@ -46,6 +49,7 @@ private:
 
     EXPORT static void FillExtractedMetadata(const std::unordered_map<int32_t, std::string> &metadataMap,
         std::shared_ptr<Meta> &meta, std::unique_ptr<Metadata> &data);
+    static int32_t ExtractImageMetadataByHeader(const HeaderMetadata &header, std::unique_ptr<Metadata> &data);
     static int32_t CombineMovingPhotoMetadata(std::unique_ptr<Metadata> &data, bool isCameraShotMovingPhoto = false);
     EXPORT static void ExtractImageTimeInfo(
         const std::unique_ptr<ImageSource> &imageSource, std::unique_ptr<Metadata> &data);
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef METADATA_HEADER_PARSER_H
+#define METADATA_HEADER_PARSER_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace Media {
+#define EXPORT __attribute__ ((visibility ("default")))
+
+enum class HeaderContainerType : int32_t {
+    UNKNOWN = 0,
+    JPEG,
+    PNG,
+    HEIF,
+    MP4,
+};
+
+struct HeaderMetadata {
+    HeaderContainerType containerType {HeaderContainerType::UNKNOWN};
+    std::string mimeType;
+    int32_t width {0};
+    int32_t height {0};
+    // raw exif orientation value, 1 ~ 8, 0 when the container carries none
+    int32_t exifOrientation {0};
+    // rotation in degrees, as stored by the container (exif orientation, HEIF irot or MP4 track matrix)
+    int32_t rotation {0};
+    int32_t duration {0};
+    bool hasExif {false};
+    // segments/chunks the header parser does not interpret, e.g. XMP, MPF, ICC profile or gain map
+    bool hasExtraMetadata {false};
+};
+
+/**
+ * Reads dimensions, orientation and duration from the container headers of
+ * JPEG/EXIF, PNG, HEIF and MP4 files through a small bounded read window, without decoding
+ * any image or demuxing any stream. Returns E_OK only when the container is fully understood,
+ * callers fall back to ImageSource/AVMetadataHelper otherwise.
+ */
+class MetadataHeaderParser {
+public:
+    EXPORT static int32_t Parse(const std::string &path, HeaderMetadata &header);
+    EXPORT static int32_t ParseFd(int32_t fd, int64_t fileSize, HeaderMetadata &header);
+
+private:
+    MetadataHeaderParser() = delete;
+    ~MetadataHeaderParser() = delete;
+};
+} // namespace Media
+} // namespace OHOS
+#endif /* METADATA_HEADER_PARSER_H */
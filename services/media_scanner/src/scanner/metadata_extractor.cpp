@@ -197,6 +197,9 @@ static std::tuple<int64_t, std::string> TryGetFromGPSTime(const unique_ptr<Image
 
 static std::tuple<int64_t, std::string> GetShootingTimeByExif(const unique_ptr<ImageSource> &imageSource)
 {
+    if (imageSource == nullptr) {
+        return {0, ""};
+    }
     auto result = TryGetFromDateTimeOriginal(imageSource);
     if (std::get<0>(result) > 0) {
         return result;
@@ -207,6 +210,9 @@ static std::tuple<int64_t, std::string> GetShootingTimeByExif(const unique_ptr<I
 
 static std::tuple<int64_t, std::string> GetModifiedTimeByExif(const unique_ptr<ImageSource> &imageSource)
 {
+    if (imageSource == nullptr) {
+        return {0, ""};
+    }
     string timeString;
     uint32_t err = imageSource->GetImagePropertyString(0, PHOTO_DATA_IMAGE_DATE_TIME, timeString);
     if (err == E_OK && !timeString.empty() && timeString.compare(ZEROTIMESTRING) != 0) {
@@ -402,10 +408,65 @@ static void ExtractImageExifRotate(
     data->SetExifRotate(exifRotate);
 }
 
+static bool CanExtractImageByHeader(const HeaderMetadata &header)
+{
+    // Only plain files take the header path: anything carrying exif, xmp, icc or gain map
+    // needs ImageSource to produce the same all_exif, hdr and rotate columns.
+    bool isPlainContainer = header.containerType == HeaderContainerType::JPEG ||
+        header.containerType == HeaderContainerType::PNG;
+    return isPlainContainer && !header.hasExif && !header.hasExtraMetadata;
+}
+
+// HEIF and the other image containers always carry metadata the header path does not fill,
+// so only jpeg and png are worth the extra header read.
+static bool IsHeaderExtractableMimeType(const std::string &mimeType)
+{
+    return mimeType == "image/jpeg" || mimeType == "image/png";
+}
+
+static void FillEmptyImageExif(std::unique_ptr<Metadata> &data)
+{
+    nlohmann::json exifJson;
+    exifJson[PHOTO_DATA_IMAGE_ORIENTATION] = 0;
+    exifJson[PHOTO_DATA_IMAGE_GPS_LONGITUDE] = 0;
+    exifJson[PHOTO_DATA_IMAGE_GPS_LATITUDE] = 0;
+    data->SetFrontCamera("0");
+    for (auto &exifKey : exifInfoKeys) {
+        exifJson[exifKey] = "";
+    }
+    exifJson[PHOTO_DATA_IMAGE_IMAGE_DESCRIPTION] =
+        AppFileService::SandboxHelper::Encode(exifJson[PHOTO_DATA_IMAGE_IMAGE_DESCRIPTION]);
+    data->SetAllExif(exifJson.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+    data->SetLastVisitTime(MediaFileUtils::UTCTimeMilliSeconds());
+}
+
+int32_t MetadataExtractor::ExtractImageMetadataByHeader(const HeaderMetadata &header,
+    std::unique_ptr<Metadata> &data)
+{
+    MediaLibraryTracer tracer;
+    tracer.Start("ExtractImageMetadataByHeader");
+    data->SetFileWidth(header.width);
+    data->SetFileHeight(header.height);
+    data->SetFileMimeType(header.mimeType);
+    data->SetFileAspectRatio(MediaFileUtils::CalculateAspectRatio(header.height, header.width));
+    std::unique_ptr<ImageSource> noExifSource;
+    ExtractImageTimeInfo(noExifSource, data);
+    data->SetExifRotate(static_cast<int32_t>(ExifRotateType::TOP_LEFT));
+    data->SetDynamicRangeType(static_cast<int32_t>(DynamicRangeType::SDR));
+    FillEmptyImageExif(data);
+    return E_OK;
+}
+
 int32_t MetadataExtractor::ExtractImageMetadata(std::unique_ptr<Metadata> &data)
 {
     uint32_t err = 0;
 
+    HeaderMetadata header;
+    if (IsHeaderExtractableMimeType(data->GetFileMimeType()) &&
+        MetadataHeaderParser::Parse(data->GetFilePath(), header) == E_OK && CanExtractImageByHeader(header)) {
+        return ExtractImageMetadataByHeader(header, data);
+    }
+
     SourceOptions opts;
     opts.formatHint = "image/" + data->GetFileExtension();
     std::unique_ptr<ImageSource> imageSource =
@@ -911,6 +972,29 @@ int32_t MetadataExtractor::CombineMovingPhotoMetadata(std::unique_ptr<Metadata>
     return E_OK;
 }
 
+int32_t MetadataExtractor::ExtractBasicMetadata(std::unique_ptr<Metadata> &data)
+{
+    HeaderMetadata header;
+    int32_t ret = MetadataHeaderParser::Parse(data->GetFilePath(), header);
+    bool isMatchedType = (data->GetFileMediaType() == MEDIA_TYPE_IMAGE) ==
+        (header.containerType != HeaderContainerType::MP4);
+    if (ret != E_OK || !isMatchedType) {
+        MEDIA_DEBUG_LOG("Header parse unsupported, fallback to full extract, ret: %{public}d", ret);
+        return Extract(data);
+    }
+    data->SetFileWidth(header.width);
+    data->SetFileHeight(header.height);
+    data->SetFileAspectRatio(MediaFileUtils::CalculateAspectRatio(header.height, header.width));
+    data->SetOrientation(header.rotation);
+    if (header.exifOrientation > 0) {
+        data->SetExifRotate(header.exifOrientation);
+    }
+    if (header.containerType == HeaderContainerType::MP4) {
+        data->SetFileDuration(header.duration);
+    }
+    return E_OK;
+}
+
 int32_t MetadataExtractor::Extract(std::unique_ptr<Metadata> &data, bool isCameraShotMovingPhoto, int32_t scene)
 {
     if (data->GetFileMediaType() == MEDIA_TYPE_IMAGE) {
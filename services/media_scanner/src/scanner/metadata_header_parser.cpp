@@ -0,0 +1,638 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define MLOG_TAG "MetadataHeaderParser"
+
+#include "metadata_header_parser.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "media_file_utils.h"
+#include "media_log.h"
+#include "medialibrary_errno.h"
+
+namespace OHOS {
+namespace Media {
+using namespace std;
+
+namespace {
+constexpr size_t READ_WINDOW_SIZE = 64 * 1024;
+constexpr size_t MAX_TOTAL_READ_SIZE = 1024 * 1024;
+constexpr int32_t MAX_JPEG_SEGMENTS = 64;
+constexpr int32_t MAX_PNG_CHUNKS = 64;
+constexpr int32_t MAX_BOX_COUNT = 256;
+constexpr int32_t MAX_IFD_ENTRIES = 512;
+constexpr int32_t SEC_TO_MSEC_NUM = 1000;
+constexpr int32_t DEGREES_90 = 90;
+constexpr int32_t DEGREES_180 = 180;
+constexpr int32_t DEGREES_270 = 270;
+
+constexpr uint8_t JPEG_MARKER_PREFIX = 0xFF;
+constexpr uint8_t JPEG_SOI = 0xD8;
+constexpr uint8_t JPEG_EOI = 0xD9;
+constexpr uint8_t JPEG_SOS = 0xDA;
+constexpr uint8_t JPEG_APP0 = 0xE0;
+constexpr uint8_t JPEG_APP1 = 0xE1;
+constexpr uint8_t JPEG_APP15 = 0xEF;
+constexpr uint8_t JPEG_SOF0 = 0xC0;
+constexpr uint8_t JPEG_SOF15 = 0xCF;
+constexpr uint8_t JPEG_DHT = 0xC4;
+constexpr uint8_t JPEG_JPG = 0xC8;
+constexpr uint8_t JPEG_DAC = 0xCC;
+constexpr uint8_t JPEG_TEM = 0x01;
+constexpr uint8_t JPEG_RST0 = 0xD0;
+constexpr uint8_t JPEG_RST7 = 0xD7;
+constexpr size_t JPEG_SEGMENT_HEADER_SIZE = 4;
+constexpr size_t JPEG_SOF_SIZE = 9;
+const uint8_t EXIF_HEADER[] = { 'E', 'x', 'i', 'f', 0, 0 };
+
+const uint8_t PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr size_t PNG_CHUNK_HEADER_SIZE = 8;
+constexpr size_t PNG_CHUNK_CRC_SIZE = 4;
+constexpr size_t PNG_IHDR_SIZE = 13;
+const vector<string> PNG_PLAIN_CHUNKS = {
+    "PLTE", "tRNS", "gAMA", "cHRM", "sRGB", "sBIT", "bKGD", "pHYs", "tIME", "tEXt", "zTXt",
+};
+
+constexpr uint16_t TIFF_MAGIC = 42;
+constexpr size_t TIFF_HEADER_SIZE = 8;
+constexpr size_t IFD_ENTRY_SIZE = 12;
+constexpr uint16_t TIFF_TYPE_SHORT = 3;
+constexpr uint16_t TAG_ORIENTATION = 0x0112;
+constexpr size_t INLINE_VALUE_SIZE = 4;
+
+constexpr size_t BOX_HEADER_SIZE = 8;
+constexpr size_t LARGE_BOX_HEADER_SIZE = 16;
+constexpr size_t FULL_BOX_HEADER_SIZE = 4;
+constexpr size_t FTYP_MAX_SIZE = 256;
+constexpr size_t BRAND_SIZE = 4;
+constexpr size_t MVHD_V0_SIZE = 20;
+constexpr size_t MVHD_V1_SIZE = 32;
+constexpr size_t TKHD_V0_SIZE = 80;
+constexpr size_t TKHD_V1_SIZE = 92;
+constexpr size_t TKHD_V0_MATRIX_OFFSET = 36;
+constexpr size_t TKHD_V1_MATRIX_OFFSET = 48;
+constexpr size_t TKHD_MATRIX_SIZE = 36;
+constexpr size_t HDLR_TYPE_OFFSET = 8;
+constexpr size_t ISPE_SIZE = 12;
+constexpr int32_t FIXED_POINT_SHIFT = 16;
+constexpr uint32_t IPMA_LARGE_INDEX_FLAG = 1;
+constexpr uint16_t IPMA_LARGE_INDEX_MASK = 0x7FFF;
+constexpr uint8_t IPMA_SMALL_INDEX_MASK = 0x7F;
+constexpr uint8_t IROT_ANGLE_MASK = 0x03;
+
+const vector<string> HEIF_BRANDS = { "heic", "heix", "heim", "heis", "hevc", "hevx", "mif1", "msf1" };
+const vector<string> MP4_BRANDS = {
+    "isom", "iso2", "iso4", "iso5", "iso6", "mp41", "mp42", "avc1", "qt  ", "M4V ", "3gp4", "3gp5", "3gp6",
+};
+} // namespace
+
+class HeaderReader {
+public:
+    HeaderReader(int32_t fd, int64_t fileSize) : fd_(fd), fileSize_(fileSize) {}
+
+    // The returned pointer stays valid until the next Read call.
+    const uint8_t *Read(int64_t offset, size_t len)
+    {
+        bool cond = offset < 0 || len == 0 || len > READ_WINDOW_SIZE ||
+            offset > fileSize_ || static_cast<int64_t>(len) > fileSize_ - offset;
+        CHECK_AND_RETURN_RET(!cond, nullptr);
+        if (windowStart_ >= 0 && offset >= windowStart_ &&
+            offset + static_cast<int64_t>(len) <= windowStart_ + static_cast<int64_t>(windowLen_)) {
+            return window_.data() + (offset - windowStart_);
+        }
+        size_t toRead = static_cast<size_t>(std::min<int64_t>(READ_WINDOW_SIZE, fileSize_ - offset));
+        CHECK_AND_RETURN_RET_LOG(totalRead_ + toRead <= MAX_TOTAL_READ_SIZE, nullptr,
+            "Header read budget exhausted, totalRead: %{public}zu", totalRead_);
+        window_.resize(READ_WINDOW_SIZE);
+        size_t readLen = 0;
+        while (readLen < toRead) {
+            ssize_t ret = pread(fd_, window_.data() + readLen, toRead - readLen, offset + readLen);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            CHECK_AND_RETURN_RET_LOG(ret > 0, nullptr, "pread failed, errno: %{public}d", errno);
+            readLen += static_cast<size_t>(ret);
+        }
+        totalRead_ += readLen;
+        windowStart_ = offset;
+        windowLen_ = readLen;
+        return window_.data();
+    }
+
+    int64_t Size() const
+    {
+        return fileSize_;
+    }
+
+private:
+    int32_t fd_ {-1};
+    int64_t fileSize_ {0};
+    int64_t windowStart_ {-1};
+    size_t windowLen_ {0};
+    size_t totalRead_ {0};
+    vector<uint8_t> window_;
+};
+
+static inline uint16_t ReadBe16(const uint8_t *p)
+{
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t ReadBe32(const uint8_t *p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+        (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline uint64_t ReadBe64(const uint8_t *p)
+{
+    return (static_cast<uint64_t>(ReadBe32(p)) << 32) | ReadBe32(p + sizeof(uint32_t));
+}
+
+static int32_t ConvertExifOrientationToRotation(int32_t exifOrientation)
+{
+    switch (exifOrientation) {
+        case 3:
+            return DEGREES_180;
+        case 6:
+            return DEGREES_90;
+        case 8:
+            return DEGREES_270;
+        default:
+            return 0;
+    }
+}
+
+class TiffParser {
+public:
+    TiffParser(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    bool Parse(HeaderMetadata &header)
+    {
+        CHECK_AND_RETURN_RET(size_ >= TIFF_HEADER_SIZE, false);
+        if (data_[0] == 'I' && data_[1] == 'I') {
+            littleEndian_ = true;
+        } else if (data_[0] == 'M' && data_[1] == 'M') {
+            littleEndian_ = false;
+        } else {
+            return false;
+        }
+        CHECK_AND_RETURN_RET(Read16(2) == TIFF_MAGIC, false);
+        return ParseIfd(Read32(4), [&](uint16_t tag, uint16_t type, size_t entry) {
+            if (tag == TAG_ORIENTATION && type == TIFF_TYPE_SHORT) {
+                header.exifOrientation = Read16(entry + IFD_ENTRY_SIZE - INLINE_VALUE_SIZE);
+                header.rotation = ConvertExifOrientationToRotation(header.exifOrientation);
+            }
+        });
+    }
+
+private:
+    template <typename Visitor>
+    bool ParseIfd(uint32_t offset, Visitor visitor)
+    {
+        CHECK_AND_RETURN_RET(offset <= size_ && size_ - offset >= sizeof(uint16_t), false);
+        uint16_t count = Read16(offset);
+        CHECK_AND_RETURN_RET(count <= MAX_IFD_ENTRIES, false);
+        size_t entries = offset + sizeof(uint16_t);
+        CHECK_AND_RETURN_RET(size_ - entries >= static_cast<size_t>(count) * IFD_ENTRY_SIZE, false);
+        for (uint16_t i = 0; i < count; i++) {
+            size_t entry = entries + i * IFD_ENTRY_SIZE;
+            visitor(Read16(entry), Read16(entry + sizeof(uint16_t)), entry);
+        }
+        return true;
+    }
+
+    uint16_t Read16(size_t offset) const
+    {
+        const uint8_t *p = data_ + offset;
+        return littleEndian_ ? static_cast<uint16_t>(p[0] | (p[1] << 8)) : ReadBe16(p);
+    }
+
+    uint32_t Read32(size_t offset) const
+    {
+        const uint8_t *p = data_ + offset;
+        return littleEndian_ ? (static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+            (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24)) : ReadBe32(p);
+    }
+
+    const uint8_t *data_ {nullptr};
+    size_t size_ {0};
+    bool littleEndian_ {false};
+};
+
+static bool IsJpegSofMarker(uint8_t marker)
+{
+    return marker >= JPEG_SOF0 && marker <= JPEG_SOF15 &&
+        marker != JPEG_DHT && marker != JPEG_JPG && marker != JPEG_DAC;
+}
+
+static int32_t ParseJpeg(HeaderReader &reader, HeaderMetadata &header)
+{
+    header.containerType = HeaderContainerType::JPEG;
+    header.mimeType = "image/jpeg";
+    int64_t pos = sizeof(uint16_t);
+    for (int32_t i = 0; i < MAX_JPEG_SEGMENTS; i++) {
+        const uint8_t *seg = reader.Read(pos, JPEG_SEGMENT_HEADER_SIZE);
+        CHECK_AND_RETURN_RET_LOG(seg != nullptr && seg[0] == JPEG_MARKER_PREFIX, E_ERR, "Invalid jpeg segment");
+        uint8_t marker = seg[1];
+        if (marker == JPEG_MARKER_PREFIX) {
+            pos++;
+            continue;
+        }
+        CHECK_AND_RETURN_RET(marker != JPEG_SOS && marker != JPEG_EOI, E_ERR);
+        if (marker == JPEG_TEM || (marker >= JPEG_RST0 && marker <= JPEG_RST7)) {
+            pos += sizeof(uint16_t);
+            continue;
+        }
+        uint16_t len = ReadBe16(seg + sizeof(uint16_t));
+        CHECK_AND_RETURN_RET(len >= sizeof(uint16_t), E_ERR);
+        if (IsJpegSofMarker(marker)) {
+            const uint8_t *sof = reader.Read(pos, JPEG_SOF_SIZE);
+            CHECK_AND_RETURN_RET(sof != nullptr, E_ERR);
+            header.height = ReadBe16(sof + 5);
+            header.width = ReadBe16(sof + 7);
+            return (header.width > 0 && header.height > 0) ? E_OK : E_ERR;
+        }
+        size_t payloadLen = len - sizeof(uint16_t);
+        if (marker == JPEG_APP1 && payloadLen > sizeof(EXIF_HEADER)) {
+            const uint8_t *payload = reader.Read(pos + JPEG_SEGMENT_HEADER_SIZE, payloadLen);
+            CHECK_AND_RETURN_RET(payload != nullptr, E_ERR);
+            if (memcmp(payload, EXIF_HEADER, sizeof(EXIF_HEADER)) == 0 && !header.hasExif) {
+                header.hasExif = true;
+                TiffParser tiff(payload + sizeof(EXIF_HEADER), payloadLen - sizeof(EXIF_HEADER));
+                CHECK_AND_RETURN_RET_LOG(tiff.Parse(header), E_ERR, "Invalid exif in jpeg");
+            } else {
+                header.hasExtraMetadata = true;
+            }
+        } else if (marker > JPEG_APP0 && marker <= JPEG_APP15) {
+            header.hasExtraMetadata = true;
+        }
+        pos += sizeof(uint16_t) + len;
+    }
+    MEDIA_WARN_LOG("No SOF found in the first %{public}d jpeg segments", MAX_JPEG_SEGMENTS);
+    return E_ERR;
+}
+
+static int32_t ParsePng(HeaderReader &reader, HeaderMetadata &header)
+{
+    header.containerType = HeaderContainerType::PNG;
+    header.mimeType = "image/png";
+    int64_t pos = sizeof(PNG_SIGNATURE);
+    const uint8_t *ihdr = reader.Read(pos, PNG_CHUNK_HEADER_SIZE + PNG_IHDR_SIZE);
+    CHECK_AND_RETURN_RET(ihdr != nullptr && memcmp(ihdr + sizeof(uint32_t), "IHDR", BRAND_SIZE) == 0, E_ERR);
+    header.width = static_cast<int32_t>(ReadBe32(ihdr + PNG_CHUNK_HEADER_SIZE));
+    header.height = static_cast<int32_t>(ReadBe32(ihdr + PNG_CHUNK_HEADER_SIZE + sizeof(uint32_t)));
+    CHECK_AND_RETURN_RET(header.width > 0 && header.height > 0, E_ERR);
+
+    for (int32_t i = 0; i < MAX_PNG_CHUNKS; i++) {
+        const uint8_t *chunk = reader.Read(pos, PNG_CHUNK_HEADER_SIZE);
+        CHECK_AND_RETURN_RET(chunk != nullptr, E_ERR);
+        uint32_t len = ReadBe32(chunk);
+        string type(reinterpret_cast<const char *>(chunk + sizeof(uint32_t)), BRAND_SIZE);
+        if (type == "IDAT" || type == "IEND") {
+            return E_OK;
+        }
+        if (type == "eXIf" && !header.hasExif) {
+            header.hasExif = true;
+            const uint8_t *payload = reader.Read(pos + PNG_CHUNK_HEADER_SIZE, len);
+            CHECK_AND_RETURN_RET(payload != nullptr, E_ERR);
+            TiffParser tiff(payload, len);
+            CHECK_AND_RETURN_RET_LOG(tiff.Parse(header), E_ERR, "Invalid exif in png");
+        } else if (type != "IHDR" &&
+            std::find(PNG_PLAIN_CHUNKS.begin(), PNG_PLAIN_CHUNKS.end(), type) == PNG_PLAIN_CHUNKS.end()) {
+            header.hasExtraMetadata = true;
+        }
+        pos += static_cast<int64_t>(PNG_CHUNK_HEADER_SIZE) + len + PNG_CHUNK_CRC_SIZE;
+    }
+    return E_OK;
+}
+
+struct BoxInfo {
+    string type;
+    int64_t offset {0};
+    int64_t headerSize {0};
+    int64_t size {0};
+};
+
+static bool ReadBox(HeaderReader &reader, int64_t offset, int64_t end, BoxInfo &box)
+{
+    CHECK_AND_RETURN_RET(end - offset >= static_cast<int64_t>(BOX_HEADER_SIZE), false);
+    const uint8_t *p = reader.Read(offset, BOX_HEADER_SIZE);
+    CHECK_AND_RETURN_RET(p != nullptr, false);
+    box.offset = offset;
+    box.type.assign(reinterpret_cast<const char *>(p + sizeof(uint32_t)), BRAND_SIZE);
+    box.headerSize = BOX_HEADER_SIZE;
+    uint64_t size = ReadBe32(p);
+    if (size == 1) {
+        p = reader.Read(offset, LARGE_BOX_HEADER_SIZE);
+        CHECK_AND_RETURN_RET(p != nullptr, false);
+        size = ReadBe64(p + BOX_HEADER_SIZE);
+        box.headerSize = LARGE_BOX_HEADER_SIZE;
+    } else if (size == 0) {
+        size = static_cast<uint64_t>(end - offset);
+    }
+    CHECK_AND_RETURN_RET(size >= static_cast<uint64_t>(box.headerSize) &&
+        size <= static_cast<uint64_t>(end - offset), false);
+    box.size = static_cast<int64_t>(size);
+    return true;
+}
+
+template <typename Visitor>
+static bool VisitBoxes(HeaderReader &reader, int64_t begin, int64_t end, Visitor visitor)
+{
+    int64_t pos = begin;
+    for (int32_t i = 0; i < MAX_BOX_COUNT && pos < end; i++) {
+        BoxInfo box;
+        CHECK_AND_RETURN_RET(ReadBox(reader, pos, end, box), false);
+        if (!visitor(box)) {
+            return true;
+        }
+        pos += box.size;
+    }
+    return true;
+}
+
+static bool FindBox(HeaderReader &reader, int64_t begin, int64_t end, const string &type, BoxInfo &found)
+{
+    bool isFound = false;
+    VisitBoxes(reader, begin, end, [&](const BoxInfo &box) {
+        if (box.type == type) {
+            found = box;
+            isFound = true;
+        }
+        return !isFound;
+    });
+    return isFound;
+}
+
+static bool HasBrand(const uint8_t *ftyp, size_t size, const vector<string> &brands)
+{
+    // major brand, minor version, then compatible brands
+    for (size_t pos = 0; pos + BRAND_SIZE <= size; pos += BRAND_SIZE) {
+        if (pos == BRAND_SIZE) {
+            continue;
+        }
+        string brand(reinterpret_cast<const char *>(ftyp + pos), BRAND_SIZE);
+        if (std::find(brands.begin(), brands.end(), brand) != brands.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int32_t ParseMvhd(HeaderReader &reader, const BoxInfo &mvhd, HeaderMetadata &header)
+{
+    int64_t payload = mvhd.offset + mvhd.headerSize;
+    const uint8_t *p = reader.Read(payload, FULL_BOX_HEADER_SIZE + MVHD_V1_SIZE);
+    if (p == nullptr) {
+        p = reader.Read(payload, FULL_BOX_HEADER_SIZE + MVHD_V0_SIZE);
+    }
+    CHECK_AND_RETURN_RET(p != nullptr, E_ERR);
+    uint8_t version = p[0];
+    const uint8_t *body = p + FULL_BOX_HEADER_SIZE;
+    uint32_t timescale = 0;
+    uint64_t duration = 0;
+    if (version == 1) {
+        CHECK_AND_RETURN_RET(mvhd.size - mvhd.headerSize >=
+            static_cast<int64_t>(FULL_BOX_HEADER_SIZE + MVHD_V1_SIZE), E_ERR);
+        timescale = ReadBe32(body + 2 * sizeof(uint64_t));
+        duration = ReadBe64(body + 2 * sizeof(uint64_t) + sizeof(uint32_t));
+    } else {
+        timescale = ReadBe32(body + 2 * sizeof(uint32_t));
+        duration = ReadBe32(body + 3 * sizeof(uint32_t));
+    }
+    CHECK_AND_RETURN_RET_LOG(timescale > 0, E_ERR, "Invalid mvhd timescale");
+    header.duration = static_cast<int32_t>(duration * SEC_TO_MSEC_NUM / timescale);
+    return E_OK;
+}
+
+static int32_t ConvertMatrixToRotation(const uint8_t *matrix)
+{
+    int32_t a = static_cast<int32_t>(ReadBe32(matrix)) >> FIXED_POINT_SHIFT;
+    int32_t b = static_cast<int32_t>(ReadBe32(matrix + sizeof(uint32_t))) >> FIXED_POINT_SHIFT;
+    if (a == 0 && b == 1) {
+        return DEGREES_90;
+    }
+    if (a == -1 && b == 0) {
+        return DEGREES_180;
+    }
+    if (a == 0 && b == -1) {
+        return DEGREES_270;
+    }
+    return 0;
+}
+
+static bool IsVideoTrack(HeaderReader &reader, const BoxInfo &trak)
+{
+    BoxInfo mdia;
+    BoxInfo hdlr;
+    CHECK_AND_RETURN_RET(FindBox(reader, trak.offset + trak.headerSize, trak.offset + trak.size, "mdia", mdia),
+        false);
+    CHECK_AND_RETURN_RET(FindBox(reader, mdia.offset + mdia.headerSize, mdia.offset + mdia.size, "hdlr", hdlr),
+        false);
+    const uint8_t *p = reader.Read(hdlr.offset + hdlr.headerSize, HDLR_TYPE_OFFSET + BRAND_SIZE);
+    return p != nullptr && memcmp(p + HDLR_TYPE_OFFSET, "vide", BRAND_SIZE) == 0;
+}
+
+static bool ParseTkhd(HeaderReader &reader, const BoxInfo &trak, HeaderMetadata &header)
+{
+    BoxInfo tkhd;
+    CHECK_AND_RETURN_RET(FindBox(reader, trak.offset + trak.headerSize, trak.offset + trak.size, "tkhd", tkhd),
+        false);
+    const uint8_t *p = reader.Read(tkhd.offset + tkhd.headerSize, FULL_BOX_HEADER_SIZE);
+    CHECK_AND_RETURN_RET(p != nullptr, false);
+    bool isV1 = p[0] == 1;
+    size_t bodySize = isV1 ? TKHD_V1_SIZE : TKHD_V0_SIZE;
+    size_t matrixOffset = isV1 ? TKHD_V1_MATRIX_OFFSET : TKHD_V0_MATRIX_OFFSET;
+    p = reader.Read(tkhd.offset + tkhd.headerSize, FULL_BOX_HEADER_SIZE + bodySize);
+    CHECK_AND_RETURN_RET(p != nullptr, false);
+    const uint8_t *matrix = p + FULL_BOX_HEADER_SIZE + matrixOffset;
+    header.rotation = ConvertMatrixToRotation(matrix);
+    header.width = static_cast<int32_t>(ReadBe32(matrix + TKHD_MATRIX_SIZE) >> FIXED_POINT_SHIFT);
+    header.height = static_cast<int32_t>(ReadBe32(matrix + TKHD_MATRIX_SIZE + sizeof(uint32_t)) >>
+        FIXED_POINT_SHIFT);
+    return header.width > 0 && header.height > 0;
+}
+
+static int32_t ParseMp4(HeaderReader &reader, HeaderMetadata &header)
+{
+    header.containerType = HeaderContainerType::MP4;
+    header.mimeType = "video/mp4";
+    BoxInfo moov;
+    CHECK_AND_RETURN_RET_LOG(FindBox(reader, 0, reader.Size(), "moov", moov), E_ERR, "No moov box");
+    int64_t begin = moov.offset + moov.headerSize;
+    int64_t end = moov.offset + moov.size;
+    BoxInfo mvhd;
+    CHECK_AND_RETURN_RET_LOG(FindBox(reader, begin, end, "mvhd", mvhd), E_ERR, "No mvhd box");
+    CHECK_AND_RETURN_RET(ParseMvhd(reader, mvhd, header) == E_OK, E_ERR);
+
+    bool hasVideo = false;
+    VisitBoxes(reader, begin, end, [&](const BoxInfo &box) {
+        if (box.type == "trak" && IsVideoTrack(reader, box)) {
+            hasVideo = ParseTkhd(reader, box, header);
+        }
+        return !hasVideo;
+    });
+    CHECK_AND_RETURN_RET_LOG(hasVideo, E_ERR, "No video track in moov");
+    return E_OK;
+}
+
+static bool ParseIpma(const uint8_t *p, size_t size, uint32_t primaryId, vector<uint32_t> &indexes)
+{
+    CHECK_AND_RETURN_RET(size >= FULL_BOX_HEADER_SIZE + sizeof(uint32_t), false);
+    uint8_t version = p[0];
+    uint32_t flags = ReadBe32(p) & 0x00FFFFFF;
+    uint32_t entryCount = ReadBe32(p + FULL_BOX_HEADER_SIZE);
+    size_t pos = FULL_BOX_HEADER_SIZE + sizeof(uint32_t);
+    size_t idSize = version < 1 ? sizeof(uint16_t) : sizeof(uint32_t);
+    size_t assocSize = (flags & IPMA_LARGE_INDEX_FLAG) ? sizeof(uint16_t) : sizeof(uint8_t);
+    for (uint32_t i = 0; i < entryCount; i++) {
+        CHECK_AND_RETURN_RET(size - pos >= idSize + sizeof(uint8_t), false);
+        uint32_t itemId = idSize == sizeof(uint16_t) ? ReadBe16(p + pos) : ReadBe32(p + pos);
+        pos += idSize;
+        uint8_t assocCount = p[pos++];
+        CHECK_AND_RETURN_RET(size - pos >= assocCount * assocSize, false);
+        for (uint8_t j = 0; j < assocCount && itemId == primaryId; j++) {
+            indexes.push_back(assocSize == sizeof(uint16_t) ?
+                (ReadBe16(p + pos + j * assocSize) & IPMA_LARGE_INDEX_MASK) :
+                (p[pos + j] & IPMA_SMALL_INDEX_MASK));
+        }
+        CHECK_AND_RETURN_RET(itemId != primaryId, true);
+        pos += assocCount * assocSize;
+    }
+    return false;
+}
+
+static uint32_t ReadPrimaryItemId(HeaderReader &reader, int64_t begin, int64_t end)
+{
+    BoxInfo pitm;
+    CHECK_AND_RETURN_RET(FindBox(reader, begin, end, "pitm", pitm), 0);
+    const uint8_t *p = reader.Read(pitm.offset + pitm.headerSize, FULL_BOX_HEADER_SIZE + sizeof(uint16_t));
+    CHECK_AND_RETURN_RET(p != nullptr, 0);
+    if (p[0] == 0) {
+        return ReadBe16(p + FULL_BOX_HEADER_SIZE);
+    }
+    p = reader.Read(pitm.offset + pitm.headerSize, FULL_BOX_HEADER_SIZE + sizeof(uint32_t));
+    return p == nullptr ? 0 : ReadBe32(p + FULL_BOX_HEADER_SIZE);
+}
+
+static int32_t ParseHeif(HeaderReader &reader, HeaderMetadata &header)
+{
+    header.containerType = HeaderContainerType::HEIF;
+    header.mimeType = "image/heif";
+    // exif, xmp and gain map live in separate items that are not resolved here
+    header.hasExtraMetadata = true;
+    BoxInfo meta;
+    CHECK_AND_RETURN_RET_LOG(FindBox(reader, 0, reader.Size(), "meta", meta), E_ERR, "No meta box");
+    int64_t begin = meta.offset + meta.headerSize + FULL_BOX_HEADER_SIZE;
+    int64_t end = meta.offset + meta.size;
+    uint32_t primaryId = ReadPrimaryItemId(reader, begin, end);
+    CHECK_AND_RETURN_RET_LOG(primaryId != 0, E_ERR, "No primary item");
+
+    BoxInfo iprp;
+    BoxInfo ipco;
+    BoxInfo ipma;
+    CHECK_AND_RETURN_RET(FindBox(reader, begin, end, "iprp", iprp), E_ERR);
+    int64_t iprpBegin = iprp.offset + iprp.headerSize;
+    int64_t iprpEnd = iprp.offset + iprp.size;
+    CHECK_AND_RETURN_RET(FindBox(reader, iprpBegin, iprpEnd, "ipco", ipco), E_ERR);
+    CHECK_AND_RETURN_RET(FindBox(reader, iprpBegin, iprpEnd, "ipma", ipma), E_ERR);
+    size_t ipmaSize = static_cast<size_t>(ipma.size - ipma.headerSize);
+    const uint8_t *ipmaData = reader.Read(ipma.offset + ipma.headerSize, ipmaSize);
+    CHECK_AND_RETURN_RET_LOG(ipmaData != nullptr, E_ERR, "ipma exceeds read window");
+    vector<uint32_t> indexes;
+    CHECK_AND_RETURN_RET(ParseIpma(ipmaData, ipmaSize, primaryId, indexes), E_ERR);
+
+    uint32_t propertyIndex = 0;
+    VisitBoxes(reader, ipco.offset + ipco.headerSize, ipco.offset + ipco.size, [&](const BoxInfo &box) {
+        propertyIndex++;
+        if (std::find(indexes.begin(), indexes.end(), propertyIndex) == indexes.end()) {
+            return true;
+        }
+        int64_t payload = box.offset + box.headerSize;
+        if (box.type == "ispe") {
+            const uint8_t *p = reader.Read(payload, ISPE_SIZE);
+            if (p != nullptr) {
+                header.width = static_cast<int32_t>(ReadBe32(p + FULL_BOX_HEADER_SIZE));
+                header.height = static_cast<int32_t>(ReadBe32(p + FULL_BOX_HEADER_SIZE + sizeof(uint32_t)));
+            }
+        } else if (box.type == "irot") {
+            const uint8_t *p = reader.Read(payload, sizeof(uint8_t));
+            // irot is anti-clockwise, rotation is reported clockwise as with exif
+            int32_t angle = (p == nullptr) ? 0 : (p[0] & IROT_ANGLE_MASK) * DEGREES_90;
+            header.rotation = (angle == 0) ? 0 : (DEGREES_90 * 4 - angle);
+        }
+        return true;
+    });
+    return (header.width > 0 && header.height > 0) ? E_OK : E_ERR;
+}
+
+static int32_t ParseIsoBmff(HeaderReader &reader, HeaderMetadata &header)
+{
+    BoxInfo ftyp;
+    CHECK_AND_RETURN_RET(ReadBox(reader, 0, reader.Size(), ftyp) && ftyp.type == "ftyp", E_ERR);
+    size_t ftypSize = static_cast<size_t>(std::min<int64_t>(ftyp.size - ftyp.headerSize, FTYP_MAX_SIZE));
+    const uint8_t *brands = reader.Read(ftyp.headerSize, ftypSize);
+    CHECK_AND_RETURN_RET(brands != nullptr, E_ERR);
+    if (HasBrand(brands, ftypSize, HEIF_BRANDS)) {
+        return ParseHeif(reader, header);
+    }
+    if (HasBrand(brands, ftypSize, MP4_BRANDS)) {
+        return ParseMp4(reader, header);
+    }
+    return E_ERR;
+}
+
+int32_t MetadataHeaderParser::ParseFd(int32_t fd, int64_t fileSize, HeaderMetadata &header)
+{
+    CHECK_AND_RETURN_RET_LOG(fd >= 0 && fileSize > 0, E_INVALID_ARGUMENTS, "Invalid fd or file size");
+    HeaderReader reader(fd, fileSize);
+    const uint8_t *magic = reader.Read(0, std::min<int64_t>(sizeof(PNG_SIGNATURE), fileSize));
+    CHECK_AND_RETURN_RET(magic != nullptr && fileSize >= static_cast<int64_t>(sizeof(PNG_SIGNATURE)), E_ERR);
+
+    int32_t ret = E_ERR;
+    if (magic[0] == JPEG_MARKER_PREFIX && magic[1] == JPEG_SOI) {
+        ret = ParseJpeg(reader, header);
+    } else if (memcmp(magic, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0) {
+        ret = ParsePng(reader, header);
+    } else if (memcmp(magic + sizeof(uint32_t), "ftyp", BRAND_SIZE) == 0) {
+        ret = ParseIsoBmff(reader, header);
+    }
+    return ret;
+}
+
+int32_t MetadataHeaderParser::Parse(const string &path, HeaderMetadata &header)
+{
+    int32_t fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, E_SYSCALL, "Open file failed, errno: %{public}d, path: %{public}s",
+        errno, MediaFileUtils::DesensitizePath(path).c_str());
+    struct stat64 st;
+    if (fstat64(fd, &st) != 0) {
+        MEDIA_ERR_LOG("Get file state failed, errno: %{public}d", errno);
+        (void)close(fd);
+        return E_SYSCALL;
+    }
+    int32_t ret = ParseFd(fd, static_cast<int64_t>(st.st_size), header);
+    (void)close(fd);
+    return ret;
+}
+} // namespace Media
+} // namespace OHOS